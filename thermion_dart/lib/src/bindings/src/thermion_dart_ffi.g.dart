@@ -373,6 +373,19 @@ external ffi.Pointer<TFilamentAsset> GltfAssetLoader_load(
   int numInstances,
 );
 
+@ffi.Native<
+    ffi.Pointer<TFilamentAsset> Function(
+        ffi.Pointer<TEngine>,
+        ffi.Pointer<TGltfAssetLoader>,
+        ffi.Pointer<ffi.Char>,
+        ffi.Uint8)>(isLeaf: true)
+external ffi.Pointer<TFilamentAsset> GltfAssetLoader_loadFile(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<TGltfAssetLoader> tAssetLoader,
+  ffi.Pointer<ffi.Char> path,
+  int numInstances,
+);
+
 @ffi.Native<
     ffi.Pointer<TMaterialInstance> Function(ffi.Pointer<TRenderableManager>,
         ffi.Pointer<TFilamentAsset>)>(isLeaf: true)
@@ -794,6 +807,17 @@ external ffi.Pointer<TLinearImage> Image_decode(
   bool alpha,
 );
 
+@ffi.Native<
+    ffi.Pointer<TTexture> Function(ffi.Pointer<TEngine>, ffi.Pointer<ffi.Uint8>,
+        ffi.Size, ffi.Bool, ffi.Bool)>(isLeaf: true)
+external ffi.Pointer<TTexture> Image_decodeToTexture(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<ffi.Uint8> data,
+  int length,
+  bool sRGB,
+  bool generateMipmaps,
+);
+
 @ffi.Native<ffi.Pointer<ffi.Float> Function(ffi.Pointer<TLinearImage>)>(
     isLeaf: true)
 external ffi.Pointer<ffi.Float> Image_getBytes(
@@ -1403,10 +1427,11 @@ external ffi.Pointer<TOverlayManager> OverlayManager_create(
 );
 
 @ffi.Native<
-    ffi.Void Function(ffi.Pointer<TOverlayManager>, EntityId,
-        ffi.Pointer<TMaterialInstance>)>(isLeaf: true)
+    ffi.Void Function(ffi.Pointer<TOverlayManager>, ffi.Pointer<TSceneAsset>,
+        EntityId, ffi.Pointer<TMaterialInstance>)>(isLeaf: true)
 external void OverlayManager_addComponent(
   ffi.Pointer<TOverlayManager> tOverlayManager,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
   int entityId,
   ffi.Pointer<TMaterialInstance> tMaterialInstance,
 );
@@ -1426,6 +1451,238 @@ external void OverlayManager_setRenderTarget(
   ffi.Pointer<TRenderTarget> tRenderTarget,
 );
 
+@ffi.Native<ffi.Void Function(ffi.Pointer<TOverlayManager>)>(isLeaf: true)
+external void OverlayManager_invalidate(
+  ffi.Pointer<TOverlayManager> tOverlayManager,
+);
+
+@ffi.Native<ffi.Pointer<TLodManager> Function(ffi.Pointer<TEngine>, ffi.Pointer<TView>)>(
+    isLeaf: true)
+external ffi.Pointer<TLodManager> LodManager_create(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<TView> tView,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TLodManager>)>(isLeaf: true)
+external void LodManager_destroy(
+  ffi.Pointer<TLodManager> tLodManager,
+);
+
+@ffi.Native<
+    ffi.Bool Function(
+        ffi.Pointer<TLodManager>, ffi.Pointer<TSceneAsset>)>(isLeaf: true)
+external bool LodManager_addComponent(
+  ffi.Pointer<TLodManager> tLodManager,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TLodManager>, EntityId)>(
+    isLeaf: true)
+external void LodManager_removeComponent(
+  ffi.Pointer<TLodManager> tLodManager,
+  int entityId,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TLodManager>, ffi.Float)>(
+    isLeaf: true)
+external void LodManager_setBias(
+  ffi.Pointer<TLodManager> tLodManager,
+  double bias,
+);
+
+@ffi.Native<ffi.Float Function(ffi.Pointer<TLodManager>)>(isLeaf: true)
+external double LodManager_getBias(
+  ffi.Pointer<TLodManager> tLodManager,
+);
+
+@ffi.Native<ffi.Int32 Function(ffi.Pointer<TLodManager>, EntityId)>(
+    isLeaf: true)
+external int LodManager_getCurrentLevel(
+  ffi.Pointer<TLodManager> tLodManager,
+  int entityId,
+);
+
+@ffi.Native<ffi.Pointer<TGltfImporter> Function(ffi.Uint64)>(isLeaf: true)
+external ffi.Pointer<TGltfImporter> GltfImporter_create(
+  int budgetInNanos,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TGltfImporter>)>(isLeaf: true)
+external void GltfImporter_destroy(
+  ffi.Pointer<TGltfImporter> tGltfImporter,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TGltfImporter>, ffi.Uint64)>(
+    isLeaf: true)
+external void GltfImporter_setBudget(
+  ffi.Pointer<TGltfImporter> tGltfImporter,
+  int budgetInNanos,
+);
+
+@ffi.Native<
+    ffi.Bool Function(ffi.Pointer<TGltfImporter>,
+        ffi.Pointer<TGltfResourceLoader>, ffi.Pointer<TFilamentAsset>)>(isLeaf: true)
+external bool GltfImporter_begin(
+  ffi.Pointer<TGltfImporter> tGltfImporter,
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+  ffi.Pointer<TFilamentAsset> tFilamentAsset,
+);
+
+@ffi.Native<
+    ffi.Float Function(ffi.Pointer<TGltfImporter>,
+        ffi.Pointer<TFilamentAsset>)>(isLeaf: true)
+external double GltfImporter_getProgress(
+  ffi.Pointer<TGltfImporter> tGltfImporter,
+  ffi.Pointer<TFilamentAsset> tFilamentAsset,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TGltfImporter>,
+        ffi.Pointer<TFilamentAsset>)>(isLeaf: true)
+external void GltfImporter_cancel(
+  ffi.Pointer<TGltfImporter> tGltfImporter,
+  ffi.Pointer<TFilamentAsset> tFilamentAsset,
+);
+
+@ffi.Native<
+    ffi.Pointer<TCollisionComponentManager> Function(
+        ffi.Pointer<TTransformManager>)>(isLeaf: true)
+external ffi.Pointer<TCollisionComponentManager> CollisionManager_create(
+  ffi.Pointer<TTransformManager> tTransformManager,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TCollisionComponentManager>)>(
+    isLeaf: true)
+external void CollisionManager_destroy(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TCollisionComponentManager>,
+        EntityId,
+        Aabb3,
+        ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(EntityId entityId1, EntityId entityId2)>>,
+        ffi.Bool)>(isLeaf: true)
+external void CollisionManager_addComponent(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  int entityId,
+  Aabb3 boundingBox,
+  ffi.Pointer<
+          ffi.NativeFunction<
+              ffi.Void Function(EntityId entityId1, EntityId entityId2)>>
+      callback,
+  bool affectsTransform,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TCollisionComponentManager>, EntityId)>(isLeaf: true)
+external void CollisionManager_removeComponent(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  int entityId,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TCollisionComponentManager>, EntityId)>(isLeaf: true)
+external void CollisionManager_markDirty(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  int entityId,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TCollisionComponentManager>)>(
+    isLeaf: true)
+external void CollisionManager_update(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+);
+
+@ffi.Native<
+    ffi.Uint32 Function(ffi.Pointer<TCollisionComponentManager>,
+        ffi.Pointer<EntityId>, ffi.Uint32)>(isLeaf: true)
+external int CollisionManager_collideAll(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  ffi.Pointer<EntityId> outPairs,
+  int maxPairs,
+);
+
+@ffi.Native<ffi.Pointer<TGltfAssetCache> Function(ffi.Uint64)>(isLeaf: true)
+external ffi.Pointer<TGltfAssetCache> GltfAssetCache_create(
+  int budgetInBytes,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TGltfAssetCache>)>(isLeaf: true)
+external void GltfAssetCache_destroy(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+);
+
+@ffi.Native<
+    ffi.Uint64 Function(ffi.Pointer<ffi.Uint8>, ffi.Size,
+        ffi.Pointer<ffi.Char>)>(isLeaf: true)
+external int GltfAssetCache_computeKey(
+  ffi.Pointer<ffi.Uint8> data,
+  int length,
+  ffi.Pointer<ffi.Char> resourceUri,
+);
+
+@ffi.Native<
+    ffi.Uint64 Function(ffi.Pointer<TGltfAssetCache>, ffi.Pointer<ffi.Char>,
+        ffi.Pointer<ffi.Char>, ffi.Pointer<ffi.Uint64>)>(isLeaf: true)
+external int GltfAssetCache_computeFileKey(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  ffi.Pointer<ffi.Char> path,
+  ffi.Pointer<ffi.Char> resourceUri,
+  ffi.Pointer<ffi.Uint64> outLength,
+);
+
+@ffi.Native<
+    ffi.Pointer<TSceneAsset> Function(
+        ffi.Pointer<TGltfAssetCache>,
+        ffi.Uint64,
+        ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
+        ffi.Int)>(isLeaf: true)
+external ffi.Pointer<TSceneAsset> GltfAssetCache_acquire(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  int key,
+  ffi.Pointer<ffi.Pointer<TMaterialInstance>> tMaterialInstances,
+  int materialInstanceCount,
+);
+
+@ffi.Native<
+    ffi.Pointer<TSceneAsset> Function(ffi.Pointer<TGltfAssetCache>, ffi.Uint64,
+        ffi.Pointer<TSceneAsset>, ffi.Uint64)>(isLeaf: true)
+external ffi.Pointer<TSceneAsset> GltfAssetCache_insert(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  int key,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  int sizeInBytes,
+);
+
+@ffi.Native<
+    ffi.Bool Function(
+        ffi.Pointer<TGltfAssetCache>, ffi.Pointer<TSceneAsset>)>(isLeaf: true)
+external bool GltfAssetCache_release(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TGltfAssetCache>, ffi.Uint64)>(
+    isLeaf: true)
+external void GltfAssetCache_setBudget(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  int budgetInBytes,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TGltfAssetCache>,
+        ffi.Pointer<TGltfAssetCacheStats>)>(isLeaf: true)
+external void GltfAssetCache_getStats(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  ffi.Pointer<TGltfAssetCacheStats> out,
+);
+
 @ffi.Native<
     ffi.Pointer<TRenderTicker> Function(
         ffi.Pointer<TEngine>, ffi.Pointer<TRenderer>)>(isLeaf: true)
@@ -1488,6 +1745,74 @@ external void RenderTicker_setOverlayManager(
   ffi.Pointer<TOverlayManager> tOverlayManager,
 );
 
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRenderTicker>, ffi.Pointer<TLodManager>)>(isLeaf: true)
+external void RenderTicker_setLodManager(
+  ffi.Pointer<TRenderTicker> tRenderTicker,
+  ffi.Pointer<TLodManager> tLodManager,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TRenderTicker>,
+        ffi.Pointer<TCollisionComponentManager>)>(isLeaf: true)
+external void RenderTicker_setCollisionManager(
+  ffi.Pointer<TRenderTicker> tRenderTicker,
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRenderTicker>, ffi.Pointer<TGltfImporter>)>(isLeaf: true)
+external void RenderTicker_setGltfImporter(
+  ffi.Pointer<TRenderTicker> tRenderTicker,
+  ffi.Pointer<TGltfImporter> tGltfImporter,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TRenderTicker>, ffi.Uint64)>(
+    isLeaf: true)
+external void RenderTicker_setTargetFrameInterval(
+  ffi.Pointer<TRenderTicker> tRenderTicker,
+  int intervalInNanos,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TRenderTicker>, ffi.Uint64)>(
+    isLeaf: true)
+external void RenderTicker_onVsync(
+  ffi.Pointer<TRenderTicker> tRenderTicker,
+  int vsyncTimeInNanos,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TRenderTicker>,
+        ffi.Pointer<TFrameSchedulerStats>)>(isLeaf: true)
+external void RenderTicker_getFrameSchedulerStats(
+  ffi.Pointer<TRenderTicker> tRenderTicker,
+  ffi.Pointer<TFrameSchedulerStats> out,
+);
+
+@ffi.Native<
+    ffi.Uint32 Function(ffi.Pointer<TRenderTicker>, ffi.Pointer<TFrameTiming>,
+        ffi.Uint32)>(isLeaf: true)
+external int RenderTicker_getFrameStats(
+  ffi.Pointer<TRenderTicker> tRenderTicker,
+  ffi.Pointer<TFrameTiming> out,
+  int maxFrames,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Bool)>(isLeaf: true)
+external void TraceRecorder_setEnabled(
+  bool enabled,
+);
+
+@ffi.Native<ffi.Void Function()>(isLeaf: true)
+external void TraceRecorder_clear();
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Char>)>(isLeaf: true)
+external bool TraceRecorder_dump(
+  ffi.Pointer<ffi.Char> path,
+);
+
 @ffi.Native<
     ffi.Pointer<TEngine> Function(ffi.UnsignedInt, ffi.Pointer<ffi.Void>,
         ffi.Pointer<ffi.Void>, ffi.Uint8, ffi.Bool)>(isLeaf: true)
@@ -1723,6 +2048,13 @@ external void Fence_waitAndDestroy(
   ffi.Pointer<TFence> tFence,
 );
 
+@ffi.Native<ffi.Uint32 Function(ffi.Pointer<ffi.Uint8>, ffi.Size)>(
+    isLeaf: true)
+external int CommandBuffer_execute(
+  ffi.Pointer<ffi.Uint8> commands,
+  int length,
+);
+
 @ffi.Native<ffi.Void Function()>(isLeaf: true)
 external void RenderThread_create();
 
@@ -1744,6 +2076,21 @@ external void RenderThread_addTask(
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function()>> task,
 );
 
+@ffi.Native<ffi.Void Function(ffi.Pointer<TRenderThreadStats>)>(isLeaf: true)
+external void RenderThread_getStats(
+  ffi.Pointer<TRenderThreadStats> out,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<ffi.Uint8>, ffi.Size, ffi.Uint32,
+        VoidCallback)>(isLeaf: true)
+external void RenderThread_submitCommands(
+  ffi.Pointer<ffi.Uint8> commands,
+  int length,
+  int requestId,
+  VoidCallback onComplete,
+);
+
 @ffi.Native<
     ffi.Void Function(ffi.Pointer<TRenderTicker>, ffi.Uint64, ffi.Uint32,
         VoidCallback)>(isLeaf: true)
@@ -2434,68 +2781,152 @@ external void SceneAsset_createGeometryRenderThread(
 );
 
 @ffi.Native<
-    ffi.Void Function(
-        ffi.Pointer<TMaterialProvider>,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Int,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Uint8,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Uint8,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Bool,
-        ffi.Pointer<
-            ffi.NativeFunction<
-                ffi.Void Function(
-                    ffi.Pointer<TMaterialInstance>)>>)>(isLeaf: true)
-external void MaterialProvider_createMaterialInstanceRenderThread(
-  ffi.Pointer<TMaterialProvider> tMaterialProvider,
-  bool doubleSided,
-  bool unlit,
-  bool hasVertexColors,
-  bool hasBaseColorTexture,
-  bool hasNormalTexture,
-  bool hasOcclusionTexture,
-  bool hasEmissiveTexture,
-  bool useSpecularGlossiness,
-  int alphaMode,
-  bool enableDiagnostics,
-  bool hasMetallicRoughnessTexture,
-  int metallicRoughnessUV,
-  bool hasSpecularGlossinessTexture,
-  int specularGlossinessUV,
-  int baseColorUV,
-  bool hasClearCoatTexture,
+        ffi.Void Function(
+            ffi.Pointer<TEngine>,
+            ffi.Pointer<ffi.Float>,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Float>,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Float>,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Uint32>,
+            ffi.Uint32,
+            ffi.UnsignedInt,
+            ffi.Bool,
+            ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
+            ffi.Int,
+            ffi.Pointer<
+                ffi
+                .NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>)>(
+    isLeaf: true)
+external void SceneAsset_createGeometryUint32RenderThread(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<ffi.Float> vertices,
+  int numVertices,
+  ffi.Pointer<ffi.Float> normals,
+  int numNormals,
+  ffi.Pointer<ffi.Float> uvs,
+  int numUvs,
+  ffi.Pointer<ffi.Uint32> indices,
+  int numIndices,
+  int tPrimitiveType,
+  bool pickable,
+  ffi.Pointer<ffi.Pointer<TMaterialInstance>> materialInstances,
+  int materialInstanceCount,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>
+      callback,
+);
+
+@ffi.Native<
+        ffi.Void Function(
+            ffi.Pointer<TEngine>,
+            ffi.Pointer<ffi.Float>,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Float>,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Float>,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Float>,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Uint32>,
+            ffi.Uint32,
+            ffi.UnsignedInt,
+            ffi.Bool,
+            TVertexFormat,
+            ffi.Bool,
+            ffi.Pointer<TOptimizationReport>,
+            ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
+            ffi.Int,
+            ffi.Pointer<
+                ffi
+                .NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>)>(
+    isLeaf: true)
+external void SceneAsset_createGeometryWithFormatRenderThread(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<ffi.Float> vertices,
+  int numVertices,
+  ffi.Pointer<ffi.Float> normals,
+  int numNormals,
+  ffi.Pointer<ffi.Float> uvs,
+  int numUvs,
+  ffi.Pointer<ffi.Float> colors,
+  int numColors,
+  ffi.Pointer<ffi.Uint32> indices,
+  int numIndices,
+  int tPrimitiveType,
+  bool pickable,
+  TVertexFormat format,
+  bool optimize,
+  ffi.Pointer<TOptimizationReport> outOptimizationReport,
+  ffi.Pointer<ffi.Pointer<TMaterialInstance>> materialInstances,
+  int materialInstanceCount,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>
+      callback,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TMaterialProvider>,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Int,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Uint8,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Uint8,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Bool,
+        ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(
+                    ffi.Pointer<TMaterialInstance>)>>)>(isLeaf: true)
+external void MaterialProvider_createMaterialInstanceRenderThread(
+  ffi.Pointer<TMaterialProvider> tMaterialProvider,
+  bool doubleSided,
+  bool unlit,
+  bool hasVertexColors,
+  bool hasBaseColorTexture,
+  bool hasNormalTexture,
+  bool hasOcclusionTexture,
+  bool hasEmissiveTexture,
+  bool useSpecularGlossiness,
+  int alphaMode,
+  bool enableDiagnostics,
+  bool hasMetallicRoughnessTexture,
+  int metallicRoughnessUV,
+  bool hasSpecularGlossinessTexture,
+  int specularGlossinessUV,
+  int baseColorUV,
+  bool hasClearCoatTexture,
   int clearCoatUV,
   bool hasClearCoatRoughnessTexture,
   int clearCoatRoughnessUV,
@@ -2585,6 +3016,26 @@ external void Image_decodeRenderThread(
       onComplete,
 );
 
+@ffi.Native<
+        ffi.Void Function(
+            ffi.Pointer<TEngine>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Size,
+            ffi.Bool,
+            ffi.Bool,
+            ffi.Pointer<
+                ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TTexture>)>>)>(
+    isLeaf: true)
+external void Image_decodeToTextureRenderThread(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<ffi.Uint8> data,
+  int length,
+  bool sRGB,
+  bool generateMipmaps,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TTexture>)>>
+      onComplete,
+);
+
 @ffi.Native<
         ffi.Void Function(
             ffi.Pointer<TLinearImage>,
@@ -2987,102 +3438,593 @@ external void GltfResourceLoader_asyncGetLoadProgressRenderThread(
 );
 
 @ffi.Native<
-    ffi.Void Function(
-        ffi.Pointer<TEngine>,
-        ffi.Pointer<TGltfAssetLoader>,
-        ffi.Pointer<ffi.Uint8>,
-        ffi.Size,
-        ffi.Uint8,
-        ffi.Pointer<
-            ffi.NativeFunction<
-                ffi.Void Function(ffi.Pointer<TFilamentAsset>)>>)>(isLeaf: true)
-external void GltfAssetLoader_loadRenderThread(
-  ffi.Pointer<TEngine> tEngine,
-  ffi.Pointer<TGltfAssetLoader> tAssetLoader,
-  ffi.Pointer<ffi.Uint8> data,
-  int length,
-  int numInstances,
-  ffi.Pointer<
-          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TFilamentAsset>)>>
-      callback,
+        ffi.Void Function(
+            ffi.Pointer<TGltfResourceLoader>,
+            ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>>)>(
+    isLeaf: true)
+external void GltfResourceLoader_addResourceFileRenderThread(
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+  ffi.Pointer<ffi.Char> uri,
+  ffi.Pointer<ffi.Char> path,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>> callback,
 );
 
 @ffi.Native<
-    ffi.Void Function(ffi.Pointer<TScene>, ffi.Pointer<TFilamentAsset>,
-        ffi.Uint32, VoidCallback)>(isLeaf: true)
-external void Scene_addFilamentAssetRenderThread(
-  ffi.Pointer<TScene> tScene,
-  ffi.Pointer<TFilamentAsset> tAsset,
+    ffi.Void Function(
+        ffi.Pointer<TGltfImporter>, ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void GltfImporter_destroyRenderThread(
+  ffi.Pointer<TGltfImporter> tGltfImporter,
   int requestId,
   VoidCallback onComplete,
 );
 
 @ffi.Native<
         ffi.Void Function(
-            ffi.Pointer<TEngine>,
-            ffi.Pointer<TGltfAssetLoader>,
+            ffi.Pointer<TGltfImporter>,
             ffi.Pointer<TGltfResourceLoader>,
-            ffi.Pointer<TNameComponentManager>,
-            ffi.Pointer<TView>,
-            ffi.Pointer<TMaterial>,
-            ffi.UnsignedInt,
-            ffi.Pointer<
-                ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TGizmo>)>>)>(
+            ffi.Pointer<TFilamentAsset>,
+            ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>>)>(
     isLeaf: true)
-external void Gizmo_createRenderThread(
-  ffi.Pointer<TEngine> tEngine,
-  ffi.Pointer<TGltfAssetLoader> tAssetLoader,
+external void GltfImporter_beginRenderThread(
+  ffi.Pointer<TGltfImporter> tGltfImporter,
   ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
-  ffi.Pointer<TNameComponentManager> tNameComponentManager,
-  ffi.Pointer<TView> tView,
-  ffi.Pointer<TMaterial> tMaterial,
-  int tGizmoType,
-  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TGizmo>)>>
-      callback,
+  ffi.Pointer<TFilamentAsset> tFilamentAsset,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>> callback,
 );
 
-@ffi.Native<ffi.Pointer<TGltfResourceLoader> Function(ffi.Pointer<TEngine>)>(
-    isLeaf: true)
-external ffi.Pointer<TGltfResourceLoader> GltfResourceLoader_create(
-  ffi.Pointer<TEngine> tEngine,
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TGltfImporter>, ffi.Pointer<TFilamentAsset>,
+        ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void GltfImporter_cancelRenderThread(
+  ffi.Pointer<TGltfImporter> tGltfImporter,
+  ffi.Pointer<TFilamentAsset> tFilamentAsset,
+  int requestId,
+  VoidCallback onComplete,
 );
 
 @ffi.Native<
     ffi.Void Function(
-        ffi.Pointer<TEngine>, ffi.Pointer<TGltfResourceLoader>)>(isLeaf: true)
-external void GltfResourceLoader_destroy(
-  ffi.Pointer<TEngine> tEngine,
-  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+        ffi.Pointer<TGltfAssetCache>, ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void GltfAssetCache_destroyRenderThread(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  int requestId,
+  VoidCallback onComplete,
 );
 
 @ffi.Native<
-    ffi.Bool Function(ffi.Pointer<TGltfResourceLoader>,
-        ffi.Pointer<TFilamentAsset>)>(isLeaf: true)
-external bool GltfResourceLoader_asyncBeginLoad(
-  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
-  ffi.Pointer<TFilamentAsset> tFilamentAsset,
-);
-
-@ffi.Native<ffi.Void Function(ffi.Pointer<TGltfResourceLoader>)>(isLeaf: true)
-external void GltfResourceLoader_asyncUpdateLoad(
-  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+        ffi.Void Function(
+            ffi.Pointer<TGltfAssetCache>,
+            ffi.Uint64,
+            ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
+            ffi.Int,
+            ffi.Pointer<
+                ffi
+                .NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>)>(
+    isLeaf: true)
+external void GltfAssetCache_acquireRenderThread(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  int key,
+  ffi.Pointer<ffi.Pointer<TMaterialInstance>> tMaterialInstances,
+  int materialInstanceCount,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>
+      callback,
 );
 
-@ffi.Native<ffi.Float Function(ffi.Pointer<TGltfResourceLoader>)>(isLeaf: true)
-external double GltfResourceLoader_asyncGetLoadProgress(
-  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+@ffi.Native<
+        ffi.Void Function(
+            ffi.Pointer<TGltfAssetCache>,
+            ffi.Uint64,
+            ffi.Pointer<TSceneAsset>,
+            ffi.Uint64,
+            ffi.Pointer<
+                ffi
+                .NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>)>(
+    isLeaf: true)
+external void GltfAssetCache_insertRenderThread(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  int key,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  int sizeInBytes,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>
+      callback,
 );
 
 @ffi.Native<
-    ffi.Void Function(ffi.Pointer<TGltfResourceLoader>, ffi.Pointer<ffi.Char>,
-        ffi.Pointer<ffi.Uint8>, ffi.Size)>(isLeaf: true)
-external void GltfResourceLoader_addResourceData(
-  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+        ffi.Void Function(
+            ffi.Pointer<TGltfAssetCache>,
+            ffi.Pointer<TSceneAsset>,
+            ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>>)>(
+    isLeaf: true)
+external void GltfAssetCache_releaseRenderThread(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>> callback,
+);
+
+@ffi.Native<
+        ffi.Void Function(
+            ffi.Pointer<TGltfAssetCache>,
+            ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.Uint64>,
+            ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Uint64)>>)>(
+    isLeaf: true)
+external void GltfAssetCache_computeFileKeyRenderThread(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  ffi.Pointer<ffi.Char> path,
+  ffi.Pointer<ffi.Char> resourceUri,
+  ffi.Pointer<ffi.Uint64> outLength,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Uint64)>> callback,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TGltfAssetCache>, ffi.Uint64, ffi.Uint32,
+        VoidCallback)>(isLeaf: true)
+external void GltfAssetCache_setBudgetRenderThread(
+  ffi.Pointer<TGltfAssetCache> tGltfAssetCache,
+  int budgetInBytes,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TTransformManager>,
+        ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(
+                    ffi.Pointer<TCollisionComponentManager>)>>)>(isLeaf: true)
+external void CollisionManager_createRenderThread(
+  ffi.Pointer<TTransformManager> tTransformManager,
+  ffi.Pointer<
+          ffi.NativeFunction<
+              ffi.Void Function(ffi.Pointer<TCollisionComponentManager>)>>
+      onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TCollisionComponentManager>, ffi.Uint32,
+        VoidCallback)>(isLeaf: true)
+external void CollisionManager_destroyRenderThread(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TCollisionComponentManager>,
+        EntityId,
+        Aabb3,
+        ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(EntityId entityId1, EntityId entityId2)>>,
+        ffi.Bool,
+        ffi.Uint32,
+        VoidCallback)>(isLeaf: true)
+external void CollisionManager_addComponentRenderThread(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  int entityId,
+  Aabb3 boundingBox,
+  ffi.Pointer<
+          ffi.NativeFunction<
+              ffi.Void Function(EntityId entityId1, EntityId entityId2)>>
+      callback,
+  bool affectsTransform,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TCollisionComponentManager>, EntityId,
+        ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void CollisionManager_removeComponentRenderThread(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  int entityId,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TCollisionComponentManager>, EntityId,
+        ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void CollisionManager_markDirtyRenderThread(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  int entityId,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TCollisionComponentManager>,
+        ffi.Pointer<EntityId>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Uint32)>>)>(
+    isLeaf: true)
+external void CollisionManager_collideAllRenderThread(
+  ffi.Pointer<TCollisionComponentManager> tCollisionManager,
+  ffi.Pointer<EntityId> outPairs,
+  int maxPairs,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Uint32)>> onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TSceneAsset>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
+        ffi.Int,
+        ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(ffi.Pointer<TSceneAsset>)>>)>(isLeaf: true)
+external void SceneAsset_createInstancedRenderThread(
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  int instanceCount,
+  ffi.Pointer<ffi.Pointer<TMaterialInstance>> tMaterialInstances,
+  int materialInstanceCount,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TSceneAsset>)>>
+      onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TSceneAsset>,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Uint32,
+        ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>>)>(
+    isLeaf: true)
+external void SceneAsset_setInstanceTransformsRenderThread(
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  ffi.Pointer<ffi.Float> transforms,
+  int count,
+  int offset,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>> onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TSceneAsset>, ffi.Uint32, ffi.Float,
+        ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>>)>(
+    isLeaf: true)
+external void SceneAsset_generateLodsRenderThread(
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  int levelCount,
+  double reduction,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>> onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TEngine>,
+        ffi.Pointer<TView>,
+        ffi.Pointer<
+            ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TLodManager>)>>)>(
+    isLeaf: true)
+external void LodManager_createRenderThread(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<TView> tView,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TLodManager>)>>
+      onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TLodManager>, ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void LodManager_destroyRenderThread(
+  ffi.Pointer<TLodManager> tLodManager,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TLodManager>, ffi.Pointer<TSceneAsset>,
+        ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>>)>(
+    isLeaf: true)
+external void LodManager_addComponentRenderThread(
+  ffi.Pointer<TLodManager> tLodManager,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>> onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TLodManager>, EntityId, ffi.Uint32,
+        VoidCallback)>(isLeaf: true)
+external void LodManager_removeComponentRenderThread(
+  ffi.Pointer<TLodManager> tLodManager,
+  int entityId,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TOverlayManager>,
+        ffi.Pointer<TSceneAsset>,
+        EntityId,
+        ffi.Pointer<TMaterialInstance>,
+        ffi.Uint32,
+        VoidCallback)>(isLeaf: true)
+external void OverlayManager_addComponentRenderThread(
+  ffi.Pointer<TOverlayManager> tOverlayManager,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  int entityId,
+  ffi.Pointer<TMaterialInstance> tMaterialInstance,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TOverlayManager>, EntityId, ffi.Uint32,
+        VoidCallback)>(isLeaf: true)
+external void OverlayManager_removeComponentRenderThread(
+  ffi.Pointer<TOverlayManager> tOverlayManager,
+  int entityId,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TEngine>,
+        ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(ffi.Pointer<TRayPicker>)>>)>(isLeaf: true)
+external void RayPicker_createRenderThread(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TRayPicker>)>>
+      onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRayPicker>, ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void RayPicker_destroyRenderThread(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRayPicker>,
+        ffi.Pointer<TSceneAsset>,
+        ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>>)>(
+    isLeaf: true)
+external void RayPicker_addSceneAssetRenderThread(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>> onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TRayPicker>, ffi.Pointer<TSceneAsset>,
+        ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void RayPicker_removeSceneAssetRenderThread(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRayPicker>,
+        EntityId,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Uint32>,
+        ffi.Uint32,
+        ffi.Uint32,
+        VoidCallback)>(isLeaf: true)
+external void RayPicker_setTrianglesRenderThread(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  int entityId,
+  ffi.Pointer<ffi.Float> positions,
+  int numVertices,
+  ffi.Pointer<ffi.Uint32> indices,
+  int numIndices,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRayPicker>, EntityId, ffi.Uint32, VoidCallback)>(
+    isLeaf: true)
+external void RayPicker_removeTrianglesRenderThread(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  int entityId,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRayPicker>,
+        ffi.Pointer<TView>,
+        ffi.Pointer<TRay>,
+        ffi.Uint32,
+        ffi.Bool,
+        ffi.Pointer<TRayHit>,
+        ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Uint32)>>)>(
+    isLeaf: true)
+external void RayPicker_pickRenderThread(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  ffi.Pointer<TView> tView,
+  ffi.Pointer<TRay> rays,
+  int numRays,
+  bool refine,
+  ffi.Pointer<TRayHit> hits,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Uint32)>> onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRayPicker>,
+        ffi.Pointer<TView>,
+        ffi.Uint32,
+        ffi.Uint32,
+        ffi.Bool,
+        ffi.Pointer<TRayHit>,
+        ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>>)>(
+    isLeaf: true)
+external void RayPicker_pickViewRenderThread(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  ffi.Pointer<TView> tView,
+  int x,
+  int y,
+  bool refine,
+  ffi.Pointer<TRayHit> hit,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Bool)>> onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TEngine>,
+        ffi.Pointer<TGltfAssetLoader>,
+        ffi.Pointer<ffi.Uint8>,
+        ffi.Size,
+        ffi.Uint8,
+        ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(ffi.Pointer<TFilamentAsset>)>>)>(isLeaf: true)
+external void GltfAssetLoader_loadRenderThread(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<TGltfAssetLoader> tAssetLoader,
+  ffi.Pointer<ffi.Uint8> data,
+  int length,
+  int numInstances,
+  ffi.Pointer<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TFilamentAsset>)>>
+      callback,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TEngine>,
+        ffi.Pointer<TGltfAssetLoader>,
+        ffi.Pointer<ffi.Char>,
+        ffi.Uint8,
+        ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(ffi.Pointer<TFilamentAsset>)>>)>(isLeaf: true)
+external void GltfAssetLoader_loadFileRenderThread(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<TGltfAssetLoader> tAssetLoader,
+  ffi.Pointer<ffi.Char> path,
+  int numInstances,
+  ffi.Pointer<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TFilamentAsset>)>>
+      callback,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TTransformManager>, EntityId, double4x4,
+        ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void TransformManager_setTransformRenderThread(
+  ffi.Pointer<TTransformManager> tTransformManager,
+  int entityId,
+  double4x4 transform,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TScene>, ffi.Pointer<TFilamentAsset>,
+        ffi.Uint32, VoidCallback)>(isLeaf: true)
+external void Scene_addFilamentAssetRenderThread(
+  ffi.Pointer<TScene> tScene,
+  ffi.Pointer<TFilamentAsset> tAsset,
+  int requestId,
+  VoidCallback onComplete,
+);
+
+@ffi.Native<
+        ffi.Void Function(
+            ffi.Pointer<TEngine>,
+            ffi.Pointer<TGltfAssetLoader>,
+            ffi.Pointer<TGltfResourceLoader>,
+            ffi.Pointer<TNameComponentManager>,
+            ffi.Pointer<TView>,
+            ffi.Pointer<TMaterial>,
+            ffi.UnsignedInt,
+            ffi.Pointer<
+                ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TGizmo>)>>)>(
+    isLeaf: true)
+external void Gizmo_createRenderThread(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<TGltfAssetLoader> tAssetLoader,
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+  ffi.Pointer<TNameComponentManager> tNameComponentManager,
+  ffi.Pointer<TView> tView,
+  ffi.Pointer<TMaterial> tMaterial,
+  int tGizmoType,
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<TGizmo>)>>
+      callback,
+);
+
+@ffi.Native<ffi.Pointer<TGltfResourceLoader> Function(ffi.Pointer<TEngine>)>(
+    isLeaf: true)
+external ffi.Pointer<TGltfResourceLoader> GltfResourceLoader_create(
+  ffi.Pointer<TEngine> tEngine,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TEngine>, ffi.Pointer<TGltfResourceLoader>)>(isLeaf: true)
+external void GltfResourceLoader_destroy(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TGltfResourceLoader>,
+        ffi.Pointer<TKtx2DecodeStats>)>(isLeaf: true)
+external void GltfResourceLoader_getKtx2DecodeStats(
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+  ffi.Pointer<TKtx2DecodeStats> out,
+);
+
+@ffi.Native<
+    ffi.Bool Function(ffi.Pointer<TGltfResourceLoader>,
+        ffi.Pointer<TFilamentAsset>)>(isLeaf: true)
+external bool GltfResourceLoader_asyncBeginLoad(
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+  ffi.Pointer<TFilamentAsset> tFilamentAsset,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TGltfResourceLoader>)>(isLeaf: true)
+external void GltfResourceLoader_asyncUpdateLoad(
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+);
+
+@ffi.Native<ffi.Float Function(ffi.Pointer<TGltfResourceLoader>)>(isLeaf: true)
+external double GltfResourceLoader_asyncGetLoadProgress(
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TGltfResourceLoader>, ffi.Pointer<ffi.Char>,
+        ffi.Pointer<ffi.Uint8>, ffi.Size)>(isLeaf: true)
+external void GltfResourceLoader_addResourceData(
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
   ffi.Pointer<ffi.Char> uri,
   ffi.Pointer<ffi.Uint8> data,
   int length,
 );
 
+@ffi.Native<
+    ffi.Bool Function(ffi.Pointer<TGltfResourceLoader>, ffi.Pointer<ffi.Char>,
+        ffi.Pointer<ffi.Char>)>(isLeaf: true)
+external bool GltfResourceLoader_addResourceFile(
+  ffi.Pointer<TGltfResourceLoader> tGltfResourceLoader,
+  ffi.Pointer<ffi.Char> uri,
+  ffi.Pointer<ffi.Char> path,
+);
+
 @ffi.Native<
     ffi.Bool Function(ffi.Pointer<TGltfResourceLoader>,
         ffi.Pointer<TFilamentAsset>)>(isLeaf: true)
@@ -3236,12 +4178,42 @@ external Aabb3 RenderableManager_getBoundingBox(
         ffi.Uint32,
         ffi.Pointer<ffi.Float>,
         ffi.Uint32,
-        ffi.Pointer<ffi.Uint16>,
+        ffi.Pointer<ffi.Uint16>,
+        ffi.Uint32,
+        ffi.UnsignedInt,
+        ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
+        ffi.Int)>(isLeaf: true)
+external ffi.Pointer<TSceneAsset> SceneAsset_createGeometry(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<ffi.Float> vertices,
+  int numVertices,
+  ffi.Pointer<ffi.Float> normals,
+  int numNormals,
+  ffi.Pointer<ffi.Float> uvs,
+  int numUvs,
+  ffi.Pointer<ffi.Uint16> indices,
+  int numIndices,
+  int tPrimitiveType,
+  ffi.Pointer<ffi.Pointer<TMaterialInstance>> materialInstances,
+  int materialInstanceCount,
+);
+
+@ffi.Native<
+    ffi.Pointer<TSceneAsset> Function(
+        ffi.Pointer<TEngine>,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Uint32>,
         ffi.Uint32,
         ffi.UnsignedInt,
+        ffi.Bool,
         ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
         ffi.Int)>(isLeaf: true)
-external ffi.Pointer<TSceneAsset> SceneAsset_createGeometry(
+external ffi.Pointer<TSceneAsset> SceneAsset_createGeometryUint32(
   ffi.Pointer<TEngine> tEngine,
   ffi.Pointer<ffi.Float> vertices,
   int numVertices,
@@ -3249,9 +4221,51 @@ external ffi.Pointer<TSceneAsset> SceneAsset_createGeometry(
   int numNormals,
   ffi.Pointer<ffi.Float> uvs,
   int numUvs,
-  ffi.Pointer<ffi.Uint16> indices,
+  ffi.Pointer<ffi.Uint32> indices,
+  int numIndices,
+  int tPrimitiveType,
+  bool pickable,
+  ffi.Pointer<ffi.Pointer<TMaterialInstance>> materialInstances,
+  int materialInstanceCount,
+);
+
+@ffi.Native<
+    ffi.Pointer<TSceneAsset> Function(
+        ffi.Pointer<TEngine>,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Float>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Uint32>,
+        ffi.Uint32,
+        ffi.UnsignedInt,
+        ffi.Bool,
+        TVertexFormat,
+        ffi.Bool,
+        ffi.Pointer<TOptimizationReport>,
+        ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
+        ffi.Int)>(isLeaf: true)
+external ffi.Pointer<TSceneAsset> SceneAsset_createGeometryWithFormat(
+  ffi.Pointer<TEngine> tEngine,
+  ffi.Pointer<ffi.Float> vertices,
+  int numVertices,
+  ffi.Pointer<ffi.Float> normals,
+  int numNormals,
+  ffi.Pointer<ffi.Float> uvs,
+  int numUvs,
+  ffi.Pointer<ffi.Float> colors,
+  int numColors,
+  ffi.Pointer<ffi.Uint32> indices,
   int numIndices,
   int tPrimitiveType,
+  bool pickable,
+  TVertexFormat format,
+  bool optimize,
+  ffi.Pointer<TOptimizationReport> outOptimizationReport,
   ffi.Pointer<ffi.Pointer<TMaterialInstance>> materialInstances,
   int materialInstanceCount,
 );
@@ -3354,6 +4368,12 @@ external int SceneAsset_getInstanceCount(
   ffi.Pointer<TSceneAsset> tSceneAsset,
 );
 
+@ffi.Native<ffi.Pointer<TSceneAsset> Function(ffi.Pointer<TSceneAsset>)>(
+    isLeaf: true)
+external ffi.Pointer<TSceneAsset> SceneAsset_getInstanceOwner(
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+);
+
 @ffi.Native<
     ffi.Pointer<TSceneAsset> Function(ffi.Pointer<TSceneAsset>,
         ffi.Pointer<ffi.Pointer<TMaterialInstance>>, ffi.Int)>(isLeaf: true)
@@ -3368,6 +4388,50 @@ external Aabb3 SceneAsset_getBoundingBox(
   ffi.Pointer<TSceneAsset> asset,
 );
 
+@ffi.Native<
+    ffi.Pointer<TSceneAsset> Function(
+        ffi.Pointer<TSceneAsset>,
+        ffi.Uint32,
+        ffi.Pointer<ffi.Pointer<TMaterialInstance>>,
+        ffi.Int)>(isLeaf: true)
+external ffi.Pointer<TSceneAsset> SceneAsset_createInstanced(
+  ffi.Pointer<TSceneAsset> asset,
+  int instanceCount,
+  ffi.Pointer<ffi.Pointer<TMaterialInstance>> materialInstances,
+  int materialInstanceCount,
+);
+
+@ffi.Native<
+    ffi.Bool Function(ffi.Pointer<TSceneAsset>, ffi.Pointer<ffi.Float>,
+        ffi.Uint32, ffi.Uint32)>(isLeaf: true)
+external bool SceneAsset_setInstanceTransforms(
+  ffi.Pointer<TSceneAsset> asset,
+  ffi.Pointer<ffi.Float> transforms,
+  int count,
+  int offset,
+);
+
+@ffi.Native<
+    ffi.Bool Function(
+        ffi.Pointer<TSceneAsset>, ffi.Uint32, ffi.Float)>(isLeaf: true)
+external bool SceneAsset_generateLods(
+  ffi.Pointer<TSceneAsset> asset,
+  int levelCount,
+  double reduction,
+);
+
+@ffi.Native<ffi.Uint32 Function(ffi.Pointer<TSceneAsset>)>(isLeaf: true)
+external int SceneAsset_getLodLevelCount(
+  ffi.Pointer<TSceneAsset> asset,
+);
+
+@ffi.Native<ffi.Uint32 Function(ffi.Pointer<TSceneAsset>, ffi.Uint32)>(
+    isLeaf: true)
+external int SceneAsset_getLodTriangleCount(
+  ffi.Pointer<TSceneAsset> asset,
+  int level,
+);
+
 @ffi.Native<
     ffi.Pointer<TAnimationManager> Function(
         ffi.Pointer<TEngine>, ffi.Pointer<TScene>)>(isLeaf: true)
@@ -3383,6 +4447,25 @@ external void AnimationManager_update(
   int frameTimeInNanos,
 );
 
+@ffi.Native<ffi.Void Function(ffi.Pointer<TAnimationManager>, ffi.Bool)>(
+    isLeaf: true)
+external void AnimationManager_setParallelUpdate(
+  ffi.Pointer<TAnimationManager> tAnimationManager,
+  bool parallelUpdate,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TAnimationManager>, ffi.Uint64)>(
+    isLeaf: true)
+external void AnimationManager_setFixedTimeStep(
+  ffi.Pointer<TAnimationManager> tAnimationManager,
+  int stepInNanos,
+);
+
+@ffi.Native<ffi.Uint64 Function(ffi.Pointer<TAnimationManager>)>(isLeaf: true)
+external int AnimationManager_getTime(
+  ffi.Pointer<TAnimationManager> tAnimationManager,
+);
+
 @ffi.Native<
     ffi.Bool Function(
         ffi.Pointer<TAnimationManager>, ffi.Pointer<TSceneAsset>)>(isLeaf: true)
@@ -3634,6 +4717,16 @@ external bool AnimationManager_setMorphTargetWeights(
   int numWeights,
 );
 
+@ffi.Native<
+    ffi.Int Function(ffi.Pointer<TAnimationManager>, EntityId,
+        ffi.Pointer<ffi.Float>, ffi.Int)>(isLeaf: true)
+external int AnimationManager_getMorphTargetWeights(
+  ffi.Pointer<TAnimationManager> tAnimationManager,
+  int entityId,
+  ffi.Pointer<ffi.Float> out,
+  int maxWeights,
+);
+
 @ffi.Native<
     ffi.Bool Function(ffi.Pointer<TAnimationManager>, ffi.Pointer<TSceneAsset>,
         ffi.Int, ffi.Int)>(isLeaf: true)
@@ -3644,6 +4737,77 @@ external bool AnimationManager_setGltfAnimationFrame(
   int frame,
 );
 
+@ffi.Native<ffi.Pointer<TRayPicker> Function(ffi.Pointer<TEngine>)>(
+    isLeaf: true)
+external ffi.Pointer<TRayPicker> RayPicker_create(
+  ffi.Pointer<TEngine> tEngine,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TRayPicker>)>(isLeaf: true)
+external void RayPicker_destroy(
+  ffi.Pointer<TRayPicker> tRayPicker,
+);
+
+@ffi.Native<
+    ffi.Bool Function(
+        ffi.Pointer<TRayPicker>, ffi.Pointer<TSceneAsset>)>(isLeaf: true)
+external bool RayPicker_addSceneAsset(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+);
+
+@ffi.Native<
+    ffi.Void Function(
+        ffi.Pointer<TRayPicker>, ffi.Pointer<TSceneAsset>)>(isLeaf: true)
+external void RayPicker_removeSceneAsset(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  ffi.Pointer<TSceneAsset> tSceneAsset,
+);
+
+@ffi.Native<
+    ffi.Void Function(ffi.Pointer<TRayPicker>, EntityId, ffi.Pointer<ffi.Float>,
+        ffi.Uint32, ffi.Pointer<ffi.Uint32>, ffi.Uint32)>(isLeaf: true)
+external void RayPicker_setTriangles(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  int entityId,
+  ffi.Pointer<ffi.Float> positions,
+  int numVertices,
+  ffi.Pointer<ffi.Uint32> indices,
+  int numIndices,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<TRayPicker>, EntityId)>(
+    isLeaf: true)
+external void RayPicker_removeTriangles(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  int entityId,
+);
+
+@ffi.Native<
+    ffi.Uint32 Function(ffi.Pointer<TRayPicker>, ffi.Pointer<TView>,
+        ffi.Pointer<TRay>, ffi.Uint32, ffi.Bool, ffi.Pointer<TRayHit>)>(
+    isLeaf: true)
+external int RayPicker_pick(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  ffi.Pointer<TView> tView,
+  ffi.Pointer<TRay> rays,
+  int numRays,
+  bool refine,
+  ffi.Pointer<TRayHit> hits,
+);
+
+@ffi.Native<
+    ffi.Bool Function(ffi.Pointer<TRayPicker>, ffi.Pointer<TView>, ffi.Uint32,
+        ffi.Uint32, ffi.Bool, ffi.Pointer<TRayHit>)>(isLeaf: true)
+external bool RayPicker_pickView(
+  ffi.Pointer<TRayPicker> tRayPicker,
+  ffi.Pointer<TView> tView,
+  int x,
+  int y,
+  bool refine,
+  ffi.Pointer<TRayHit> hit,
+);
+
 typedef VoidCallbackFunction = ffi.Void Function(ffi.Int32 requestId);
 typedef DartVoidCallbackFunction = void Function(int requestId);
 typedef VoidCallback = ffi.Pointer<ffi.NativeFunction<VoidCallbackFunction>>;
@@ -3720,6 +4884,14 @@ final class TKtx1Bundle extends ffi.Opaque {}
 
 final class TOverlayManager extends ffi.Opaque {}
 
+final class TLodManager extends ffi.Opaque {}
+
+final class TGltfImporter extends ffi.Opaque {}
+
+final class TGltfAssetCache extends ffi.Opaque {}
+
+final class TRayPicker extends ffi.Opaque {}
+
 final class double3 extends ffi.Struct {
   @ffi.Double()
   external double x;
@@ -3801,6 +4973,61 @@ final class Aabb3 extends ffi.Struct {
   external double halfExtentZ;
 }
 
+final class TRay extends ffi.Struct {
+  external double3 origin;
+
+  external double3 direction;
+}
+
+final class TRayHit extends ffi.Struct {
+  @EntityId()
+  external int entity;
+
+  @ffi.Float()
+  external double distance;
+
+  external double3 position;
+
+  @ffi.Int32()
+  external int instance;
+}
+
+sealed class TPositionFormat {
+  static const POSITION_FORMAT_FLOAT3 = 0;
+  static const POSITION_FORMAT_HALF4 = 1;
+
+  /// normalized to the bounding box; the renderable will be a child of the asset's entity
+  static const POSITION_FORMAT_SHORT4 = 2;
+}
+
+final class TVertexFormat extends ffi.Struct {
+  @ffi.UnsignedInt()
+  external int positions;
+
+  @ffi.Bool()
+  external bool halfUVs;
+
+  @ffi.Bool()
+  external bool shortTangents;
+
+  @ffi.Bool()
+  external bool byteColors;
+}
+
+final class TOptimizationReport extends ffi.Struct {
+  @ffi.Uint32()
+  external int vertexCountBefore;
+
+  @ffi.Uint32()
+  external int vertexCountAfter;
+
+  @ffi.Float()
+  external double acmrBefore;
+
+  @ffi.Float()
+  external double acmrAfter;
+}
+
 sealed class TGizmoType {
   static const GIZMO_TYPE_TRANSLATION = 0;
   static const GIZMO_TYPE_ROTATION = 1;
@@ -4290,6 +5517,198 @@ sealed class TBackend {
   static const BACKEND_NOOP = 4;
 }
 
+final class TKtx2DecodeStats extends ffi.Struct {
+  @ffi.Uint32()
+  external int texturesDecoded;
+
+  @ffi.Uint32()
+  external int texturesFailed;
+
+  @ffi.Uint64()
+  external int totalDecodeTimeInNanos;
+
+  @ffi.Uint64()
+  external int maxDecodeTimeInNanos;
+
+  @ffi.Uint64()
+  external int lastDecodeTimeInNanos;
+}
+
+final class TGltfAssetCacheStats extends ffi.Struct {
+  @ffi.Uint64()
+  external int hits;
+
+  @ffi.Uint64()
+  external int misses;
+
+  @ffi.Uint64()
+  external int evictions;
+
+  @ffi.Uint32()
+  external int entryCount;
+
+  @ffi.Uint32()
+  external int instancesInUse;
+
+  @ffi.Uint64()
+  external int sizeInBytes;
+
+  @ffi.Uint64()
+  external int budgetInBytes;
+}
+
+final class TFrameSchedulerStats extends ffi.Struct {
+  @ffi.Uint64()
+  external int framesRendered;
+
+  @ffi.Uint64()
+  external int lateFrames;
+
+  @ffi.Uint64()
+  external int droppedFrames;
+
+  @ffi.Uint64()
+  external int skippedFrames;
+
+  @ffi.Uint64()
+  external int coalescedRequests;
+
+  @ffi.Uint64()
+  external int frameIntervalInNanos;
+
+  @ffi.Uint64()
+  external int lastLatenessInNanos;
+
+  @ffi.Uint64()
+  external int maxLatenessInNanos;
+}
+
+final class TFrameTiming extends ffi.Struct {
+  @ffi.Uint64()
+  external int frameIndex;
+
+  @ffi.Uint64()
+  external int frameTimeInNanos;
+
+  @ffi.Uint64()
+  external int animationUpdateTimeInNanos;
+
+  @ffi.Uint64()
+  external int beginFrameTimeInNanos;
+
+  @ffi.Uint64()
+  external int overlayTimeInNanos;
+
+  @ffi.Uint64()
+  external int endFrameTimeInNanos;
+
+  @ffi.Uint64()
+  external int taskDrainTimeInNanos;
+
+  @ffi.Uint64()
+  external int totalTimeInNanos;
+
+  @ffi.Uint32()
+  external int tasksExecuted;
+
+  @ffi.Uint32()
+  external int numViews;
+
+  @ffi.Array.multi([8])
+  external ffi.Array<ffi.Uint64> viewRenderTimeInNanos;
+
+  @ffi.Bool()
+  external bool rendered;
+}
+
+sealed class TCommandOpcode {
+  static const COMMAND_TRANSFORM_SET_TRANSFORM = 1;
+  static const COMMAND_TRANSFORM_SET_PARENT = 2;
+  static const COMMAND_SCENE_ADD_ENTITY = 3;
+  static const COMMAND_SCENE_REMOVE_ENTITY = 4;
+  static const COMMAND_MATERIAL_INSTANCE_SET_PARAMETER_FLOAT = 5;
+  static const COMMAND_RENDERABLE_SET_PRIORITY = 6;
+}
+
+final class TCommandHeader extends ffi.Struct {
+  @ffi.Uint32()
+  external int opcode;
+
+  @ffi.Uint32()
+  external int size;
+}
+
+final class TSetTransformCommand extends ffi.Struct {
+  external TCommandHeader header;
+
+  external ffi.Pointer<TTransformManager> tTransformManager;
+
+  @EntityId()
+  external int entityId;
+
+  @ffi.Uint32()
+  external int padding;
+
+  external double4x4 transform;
+}
+
+final class TSetParentCommand extends ffi.Struct {
+  external TCommandHeader header;
+
+  external ffi.Pointer<TTransformManager> tTransformManager;
+
+  @EntityId()
+  external int child;
+
+  @EntityId()
+  external int parent;
+
+  @ffi.Uint32()
+  external int preserveScaling;
+
+  @ffi.Uint32()
+  external int padding;
+}
+
+final class TSceneEntityCommand extends ffi.Struct {
+  external TCommandHeader header;
+
+  external ffi.Pointer<TScene> tScene;
+
+  @EntityId()
+  external int entityId;
+
+  @ffi.Uint32()
+  external int padding;
+}
+
+final class TSetMaterialParameterFloatCommand extends ffi.Struct {
+  external TCommandHeader header;
+
+  external ffi.Pointer<TMaterialInstance> tMaterialInstance;
+
+  @ffi.Array.multi([4])
+  external ffi.Array<ffi.Double> value;
+
+  @ffi.Uint32()
+  external int numComponents;
+
+  @ffi.Uint32()
+  external int nameLength;
+}
+
+final class TSetPriorityCommand extends ffi.Struct {
+  external TCommandHeader header;
+
+  external ffi.Pointer<TRenderableManager> tRenderableManager;
+
+  @EntityId()
+  external int entityId;
+
+  @ffi.Uint32()
+  external int priority;
+}
+
 typedef FilamentRenderCallbackFunction = ffi.Void Function(
     ffi.Pointer<ffi.Void> owner);
 typedef DartFilamentRenderCallbackFunction = void Function(
@@ -4297,6 +5716,28 @@ typedef DartFilamentRenderCallbackFunction = void Function(
 typedef FilamentRenderCallback
     = ffi.Pointer<ffi.NativeFunction<FilamentRenderCallbackFunction>>;
 
+final class TRenderThreadStats extends ffi.Struct {
+  @ffi.Uint64()
+  external int idleTimeInNanos;
+
+  @ffi.Uint64()
+  external int busyTimeInNanos;
+
+  @ffi.Uint64()
+  external int wakeups;
+
+  @ffi.Uint64()
+  external int tasksExecuted;
+
+  @ffi.Uint64()
+  external int framesRendered;
+
+  @ffi.Float()
+  external double fps;
+}
+
+const int FRAME_TIMING_MAX_VIEWS = 8;
+
 const int __bool_true_false_are_defined = 1;
 
 const int true$ = 1;
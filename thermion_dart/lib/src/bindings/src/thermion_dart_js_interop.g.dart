@@ -1180,6 +1180,7 @@ extension type NativeLibrary(JSObject _) implements JSObject {
   );
   external void _OverlayManager_addComponent(
     Pointer<TOverlayManager> tOverlayManager,
+    Pointer<TSceneAsset> tSceneAsset,
     EntityId entityId,
     Pointer<TMaterialInstance> tMaterialInstance,
   );
@@ -3965,11 +3966,12 @@ self.Pointer<TOverlayManager> OverlayManager_create(
 
 void OverlayManager_addComponent(
   self.Pointer<TOverlayManager> tOverlayManager,
+  self.Pointer<TSceneAsset> tSceneAsset,
   DartEntityId entityId,
   self.Pointer<TMaterialInstance> tMaterialInstance,
 ) {
-  final result = _lib._OverlayManager_addComponent(
-      tOverlayManager.cast(), entityId, tMaterialInstance.cast());
+  final result = _lib._OverlayManager_addComponent(tOverlayManager.cast(),
+      tSceneAsset.cast(), entityId, tMaterialInstance.cast());
   return result;
 }
 
@@ -172,6 +172,68 @@ class FFIAsset extends ThermionAsset {
     return FFIAsset(created, app, animationManager, instanceOwner: this, keepData: keepData);
   }
 
+  ///
+  /// Creates [instanceCount] hardware instances of this (geometry) asset,
+  /// which are drawn with instance buffers rather than one renderable per
+  /// instance. If [materialInstances] is null, this asset's material
+  /// instances are used.
+  ///
+  /// All instances are positioned relative to the entity of the returned
+  /// asset (use [setInstanceTransforms] to place them). The returned asset
+  /// is not automatically added to the scene.
+  ///
+  Future<FFIAsset> createInstanced(int instanceCount,
+      {List<MaterialInstance>? materialInstances = null}) async {
+    var ptrList = IntPtrList(materialInstances?.length ?? 0);
+    if (materialInstances != null && materialInstances.isNotEmpty) {
+      ptrList.setRange(
+          0,
+          materialInstances.length,
+          materialInstances
+              .cast<FFIMaterialInstance>()
+              .map((mi) => mi.pointer.address)
+              .toList());
+    }
+
+    var created = await withPointerCallback<TSceneAsset>((cb) {
+      SceneAsset_createInstancedRenderThread(asset, instanceCount,
+          ptrList.address.cast(), materialInstances?.length ?? 0, cb);
+    });
+
+    if (FILAMENT_WASM) {
+      ptrList.free();
+    }
+
+    if (created == nullptr) {
+      throw Exception(
+          "Failed to create hardware instances (only geometry assets can be instanced)");
+    }
+    return FFIAsset(created, app, animationManager, instanceOwner: this);
+  }
+
+  ///
+  /// Sets the transforms (relative to this asset's entity) of the hardware
+  /// instances starting at [offset]. This asset must have been created with
+  /// [createInstanced].
+  ///
+  Future setInstanceTransforms(List<Matrix4> transforms,
+      {int offset = 0}) async {
+    final ptr = allocate<Float>(transforms.length * 16);
+    for (int i = 0; i < transforms.length; i++) {
+      for (int j = 0; j < 16; j++) {
+        ptr[(i * 16) + j] = transforms[i].storage[j];
+      }
+    }
+    var result = await withBoolCallback((cb) {
+      SceneAsset_setInstanceTransformsRenderThread(
+          asset, ptr, transforms.length, offset, cb);
+    });
+    free(ptr);
+    if (!result) {
+      throw Exception("Failed to set instance transforms");
+    }
+  }
+
   ///
   ///
   ///
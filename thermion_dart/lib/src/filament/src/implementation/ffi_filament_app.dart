@@ -39,6 +39,7 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
   final Pointer<TNameComponentManager> nameComponentManager;
 
   late final Future<Uint8List> Function(String uri) _loadResource;
+  late final bool _hasCustomResourceLoader;
 
   static final _logger = Logger("FFIFilamentApp");
 
@@ -54,6 +55,7 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
       this.nameComponentManager,
       Future<Uint8List> Function(String uri)? loadResource) {
     this._loadResource = loadResource ?? defaultResourceLoader;
+    this._hasCustomResourceLoader = loadResource != null;
   }
 
   Future<Uint8List> loadResource(String uri) {
@@ -111,6 +113,79 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
     _logger.info("Initialization complete");
   }
 
+  static const _kGltfImportPollInterval = Duration(milliseconds: 16);
+
+  Pointer<TGltfImporter>? _gltfImporter;
+
+  ///
+  /// The importer that uploads the resources of glTF assets loaded with
+  /// [loadGltfFromBuffer] (when loadResourcesAsync is true), created on first
+  /// use and attached to the render ticker.
+  ///
+  Pointer<TGltfImporter> get gltfImporter {
+    if (_gltfImporter == null) {
+      _gltfImporter = GltfImporter_create(4000000);
+      RenderTicker_setGltfImporter(renderTicker, _gltfImporter!);
+    }
+    return _gltfImporter!;
+  }
+
+  ///
+  /// Sets the time after which no further glTF imports are uploaded before
+  /// each frame. This is checked between imports, so a frame may exceed it by
+  /// the upload of one import's decoded resources.
+  ///
+  void setGltfImportBudget(Duration budget) {
+    GltfImporter_setBudget(gltfImporter, budget.inMicroseconds * 1000);
+  }
+
+  Pointer<TGltfAssetCache>? _gltfAssetCache;
+
+  ///
+  /// The cache of glTF assets enabled by [enableGltfAssetCache] (or null if
+  /// it hasn't been enabled).
+  ///
+  Pointer<TGltfAssetCache>? get gltfAssetCache => _gltfAssetCache;
+
+  ///
+  /// Caches assets loaded with [loadGltfFromBuffer]/[loadGltfFromFile],
+  /// keyed by a hash of their content (and resourceUri). Loading the same
+  /// glTF again then returns a new instance of the cached asset, rather
+  /// than parsing it and loading its resources again.
+  ///
+  /// Assets returned from a cache-enabled load are instances; once
+  /// destroyed (with [destroyAsset]), cached assets with no remaining
+  /// instances are evicted (least recently used first) while the total
+  /// size of all cached assets (approximately the size of the glTF/GLB
+  /// data) is over [budgetInBytes].
+  ///
+  /// Calling this again changes the budget.
+  ///
+  Future enableGltfAssetCache({int budgetInBytes = 256 * 1024 * 1024}) async {
+    if (_gltfAssetCache == null) {
+      _gltfAssetCache = GltfAssetCache_create(budgetInBytes);
+    } else {
+      await withVoidCallback((requestId, cb) =>
+          GltfAssetCache_setBudgetRenderThread(
+              _gltfAssetCache!, budgetInBytes, requestId, cb));
+    }
+  }
+
+  ///
+  /// Destroys the cache enabled by [enableGltfAssetCache], along with every
+  /// asset it owns (so any assets loaded while it was enabled must be
+  /// destroyed first).
+  ///
+  Future disableGltfAssetCache() async {
+    if (_gltfAssetCache == null) {
+      return;
+    }
+    final cache = _gltfAssetCache!;
+    _gltfAssetCache = null;
+    await withVoidCallback((requestId, cb) =>
+        GltfAssetCache_destroyRenderThread(cache, requestId, cb));
+  }
+
   final _swapChains = <FFISwapChain, List<FFIView>>{};
   late Pointer<PointerClass<TView>> viewsPtr =
       allocate<PointerClass>(255).cast();
@@ -239,6 +314,13 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
     for (final swapChain in _swapChains.keys.toList()) {
       await destroySwapChain(swapChain);
     }
+    if (_gltfImporter != null) {
+      RenderTicker_setGltfImporter(renderTicker, nullptr);
+      await withVoidCallback((requestId, cb) =>
+          GltfImporter_destroyRenderThread(_gltfImporter!, requestId, cb));
+      _gltfImporter = null;
+    }
+    await disableGltfAssetCache();
     await withVoidCallback((requestId, cb) async {
       Engine_destroyRenderThread(engine, requestId, cb);
     });
@@ -263,6 +345,15 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
   ///
   Future destroyAsset(covariant FFIAsset asset) async {
     await asset.removeAnimationComponent();
+    if (asset.isInstance && _gltfAssetCache != null) {
+      final released = await withBoolCallback((cb) =>
+          GltfAssetCache_releaseRenderThread(
+              _gltfAssetCache!, asset.asset, cb));
+      if (released) {
+        await asset.dispose();
+        return;
+      }
+    }
     if (!asset.isInstance) {
       for (final instance in (await asset.getInstances()).cast<FFIAsset>()) {
         await instance.removeAnimationComponent();
@@ -403,6 +494,28 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
     return FFILinearImage(ptr);
   }
 
+  ///
+  /// The image is decoded on a worker thread (on native platforms) to 8-bit
+  /// RGBA, then uploaded to an SRGB8_A8 (or RGBA8) texture on the render
+  /// thread.
+  ///
+  Future<Texture> decodeImageToTexture(Uint8List data,
+      {bool sRGB = true, bool generateMipmaps = false}) async {
+    try {
+      final texture = await withPointerCallback<TTexture>((cb) =>
+          Image_decodeToTextureRenderThread(engine, data.address, data.length,
+              sRGB, generateMipmaps, cb));
+      if (texture == nullptr) {
+        throw Exception("Failed to decode image");
+      }
+      return FFITexture(engine, texture);
+    } finally {
+      if (FILAMENT_WASM) {
+        data.free();
+      }
+    }
+  }
+
   ///
   /// Creates an (empty) imge with the given dimensions.
   ///
@@ -892,26 +1005,163 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
       int priority = 4,
       int layer = 0,
       bool loadResourcesAsync = false,
-      String? resourceUri}) async {
+      String? resourceUri,
+      void Function(double progress)? onProgress}) async {
+    try {
+      late Pointer stackPtr;
+      if (FILAMENT_WASM) {
+        //stackPtr = stackSave();
+      }
+      load() => _loadGltf(
+          (cb) => GltfAssetLoader_loadRenderThread(engine, gltfAssetLoader,
+              data.address, data.length, initialInstances, cb),
+          animationManager,
+          keepData: keepData,
+          loadResourcesAsync: loadResourcesAsync,
+          resourceUri: resourceUri,
+          onProgress: onProgress);
+      if (_gltfAssetCache == null) {
+        return await load();
+      }
+      final resourceUriPtr =
+          resourceUri?.toNativeUtf8(allocator: calloc).cast<Char>() ?? nullptr;
+      final key = GltfAssetCache_computeKey(
+          data.address, data.length, resourceUriPtr);
+      if (resourceUriPtr != nullptr) {
+        free(resourceUriPtr);
+      }
+      return await _loadCachedGltf(
+          key, data.length, animationManager, load, onProgress);
+    } finally {
+      if (FILAMENT_WASM) {
+        //stackRestore(stackPtr);
+        data.free();
+      }
+    }
+  }
+
+  ///
+  /// Loads the glTF/GLB file at [path] (a local path or file:// URI).
+  ///
+  /// The file is memory-mapped by the native asset loader, rather than first
+  /// being read into a Dart buffer, so opening a large model doesn't require
+  /// an additional copy of the file in memory. Resource URIs are resolved
+  /// relative to [resourceUri] (or otherwise, the directory containing
+  /// [path]).
+  ///
+  /// This isn't supported on web; use [loadGltfFromBuffer] instead.
+  ///
+  Future<ThermionAsset> loadGltfFromFile(String path, Pointer animationManager,
+      {int initialInstances = 1,
+      bool keepData = false,
+      int priority = 4,
+      int layer = 0,
+      bool loadResourcesAsync = false,
+      String? resourceUri,
+      void Function(double progress)? onProgress}) async {
+    if (FILAMENT_WASM) {
+      throw UnsupportedError("loadGltfFromFile is not supported on web");
+    }
+    resourceUri ??= path.substring(0, path.lastIndexOf(RegExp(r'[/\\]')) + 1);
+    final pathPtr = path.toNativeUtf8(allocator: calloc);
+    try {
+      load() => _loadGltf(
+          (cb) => GltfAssetLoader_loadFileRenderThread(engine,
+              gltfAssetLoader, pathPtr.cast<Char>(), initialInstances, cb),
+          animationManager,
+          keepData: keepData,
+          loadResourcesAsync: loadResourcesAsync,
+          resourceUri: resourceUri,
+          onProgress: onProgress);
+      if (_gltfAssetCache == null) {
+        return await load();
+      }
+      // unchanged files are only hashed the first time they are loaded
+      final resourceUriPtr = resourceUri.toNativeUtf8(allocator: calloc);
+      final lengthPtr = calloc<Uint64>();
+      try {
+        // hashing maps and reads the whole file, so this is done on the
+        // render thread rather than blocking this isolate
+        final key = await withUInt64Callback((cb) =>
+            GltfAssetCache_computeFileKeyRenderThread(
+                _gltfAssetCache!,
+                pathPtr.cast<Char>(),
+                resourceUriPtr.cast<Char>(),
+                lengthPtr,
+                cb));
+        if (key == 0) {
+          return await load();
+        }
+        return await _loadCachedGltf(
+            key, lengthPtr.value, animationManager, load, onProgress);
+      } finally {
+        free(resourceUriPtr);
+        free(lengthPtr);
+      }
+    } finally {
+      free(pathPtr);
+    }
+  }
+
+  ///
+  /// Returns an instance of the asset cached under [key], calling [load]
+  /// (and caching the result) if there is none.
+  ///
+  Future<ThermionAsset> _loadCachedGltf(
+      int key,
+      int sizeInBytes,
+      Pointer animationManager,
+      Future<ThermionAsset> Function() load,
+      void Function(double progress)? onProgress) async {
+    final cache = _gltfAssetCache!;
+    var instance = await withPointerCallback<TSceneAsset>(
+        (cb) => GltfAssetCache_acquireRenderThread(cache, key, nullptr, 0, cb));
+    if (instance == nullptr) {
+      final asset = await load() as FFIAsset;
+      instance = await withPointerCallback<TSceneAsset>((cb) =>
+          GltfAssetCache_insertRenderThread(
+              cache, key, asset.asset, sizeInBytes, cb));
+      if (instance == nullptr) {
+        // e.g. the same asset was loaded (and cached) concurrently
+        return asset;
+      }
+    } else {
+      onProgress?.call(1.0);
+    }
+    // the cache owns the asset, so its source data is kept for new instances
+    final owner = FFIAsset(SceneAsset_getInstanceOwner(instance), this,
+        animationManager.cast<TAnimationManager>(),
+        keepData: true);
+    return FFIAsset(
+        instance, this, animationManager.cast<TAnimationManager>(),
+        instanceOwner: owner, keepData: true);
+  }
+
+  Future<ThermionAsset> _loadGltf(
+      Function(Pointer<NativeFunction<Void Function(Pointer<TFilamentAsset>)>>)
+          createFilamentAsset,
+      Pointer animationManager,
+      {required bool keepData,
+      required bool loadResourcesAsync,
+      String? resourceUri,
+      void Function(double progress)? onProgress}) async {
     final resources = <FinalizableUint8List>[];
 
     if (resourceUri != null && !resourceUri.endsWith("/")) {
       resourceUri = "${resourceUri}/";
     }
     try {
-      late Pointer stackPtr;
-      if (FILAMENT_WASM) {
-        //stackPtr = stackSave();
+      // the synchronous path blocks the (main) thread until all textures are
+      // decoded, which isn't possible on single-threaded builds
+      if (FILAMENT_SINGLE_THREADED) {
+        loadResourcesAsync = true;
       }
 
-      loadResourcesAsync = FILAMENT_SINGLE_THREADED;
-
       var gltfResourceLoader = await withPointerCallback<TGltfResourceLoader>(
           (cb) => GltfResourceLoader_createRenderThread(engine, cb));
 
-      var filamentAsset = await withPointerCallback<TFilamentAsset>((cb) =>
-          GltfAssetLoader_loadRenderThread(engine, gltfAssetLoader,
-              data.address, data.length, initialInstances, cb));
+      var filamentAsset =
+          await withPointerCallback<TFilamentAsset>(createFilamentAsset);
 
       if (filamentAsset == nullptr) {
         throw Exception("An error occurred loading the asset");
@@ -920,25 +1170,17 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
       var resourceUris = FilamentAsset_getResourceUris(filamentAsset);
       var resourceUriCount = FilamentAsset_getResourceUriCount(filamentAsset);
 
-      for (int i = 0; i < resourceUriCount; i++) {
-        final resourceUriDart = resourceUris[i].cast<Utf8>().toDartString();
-
-        final resourceData =
-            await loadResource("${resourceUri ?? ""}${resourceUriDart}");
-
-        resources.add(FinalizableUint8List(resourceUris[i], resourceData));
-
-        await withVoidCallback((requestId, cb) =>
-            GltfResourceLoader_addResourceDataRenderThread(
-                gltfResourceLoader,
-                resourceUris[i],
-                resourceData.address,
-                resourceData.lengthInBytes,
-                requestId,
-                cb));
-      }
-
-      if (loadResourcesAsync) {
+      // all resources are fetched concurrently
+      await Future.wait([
+        for (int i = 0; i < resourceUriCount; i++)
+          _addGltfResource(
+              gltfResourceLoader,
+              resourceUris[i],
+              "${resourceUri ?? ""}${resourceUris[i].cast<Utf8>().toDartString()}",
+              resources)
+      ]);
+
+      if (loadResourcesAsync && FILAMENT_SINGLE_THREADED) {
         final result = await withBoolCallback((cb) =>
             GltfResourceLoader_asyncBeginLoadRenderThread(
                 gltfResourceLoader, filamentAsset, cb));
@@ -952,11 +1194,30 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
             GltfResourceLoader_asyncGetLoadProgressRenderThread(
                 gltfResourceLoader, cb));
         while (progress < 1.0) {
+          onProgress?.call(progress);
           GltfResourceLoader_asyncUpdateLoadRenderThread(gltfResourceLoader);
           progress = await withFloatCallback((cb) =>
               GltfResourceLoader_asyncGetLoadProgressRenderThread(
                   gltfResourceLoader, cb));
         }
+      } else if (loadResourcesAsync) {
+        // textures are decoded on worker threads and uploaded by the
+        // render ticker before each frame as they become available, so
+        // frames continue to be rendered while the import is in progress
+        final result = await withBoolCallback((cb) =>
+            GltfImporter_beginRenderThread(
+                gltfImporter, gltfResourceLoader, filamentAsset, cb));
+        if (!result) {
+          throw Exception("Failed to begin async loading");
+        }
+
+        var progress = GltfImporter_getProgress(gltfImporter, filamentAsset);
+        while (progress < 1.0) {
+          onProgress?.call(progress);
+          RenderThread_requestFrameAsync();
+          await Future.delayed(_kGltfImportPollInterval);
+          progress = GltfImporter_getProgress(gltfImporter, filamentAsset);
+        }
       } else {
         final result = await withBoolCallback((cb) =>
             GltfResourceLoader_loadResourcesRenderThread(
@@ -975,6 +1236,18 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
             "Unknown error loading glTF asset. See logs for details.");
       }
 
+      onProgress?.call(1.0);
+
+      if (!FILAMENT_WASM) {
+        final stats = calloc<TKtx2DecodeStats>();
+        GltfResourceLoader_getKtx2DecodeStats(gltfResourceLoader, stats);
+        if (stats.ref.texturesDecoded > 0) {
+          _logger.fine(
+              "Transcoded ${stats.ref.texturesDecoded} KTX2 textures in ${stats.ref.totalDecodeTimeInNanos / 1e6} ms (slowest ${stats.ref.maxDecodeTimeInNanos / 1e6} ms)");
+        }
+        calloc.free(stats);
+      }
+
       await withVoidCallback((requestId, cb) =>
           GltfResourceLoader_destroyRenderThread(
               engine, gltfResourceLoader, requestId, cb));
@@ -983,8 +1256,6 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
           keepData: keepData);
     } finally {
       if (FILAMENT_WASM) {
-        //stackRestore(stackPtr);
-        data.free();
         for (final resource in resources) {
           resource.data.free();
         }
@@ -992,6 +1263,59 @@ class FFIFilamentApp extends FilamentApp<Pointer> {
     }
   }
 
+  ///
+  /// Adds the data at [path] as the glTF resource [uri]. Local files are
+  /// memory-mapped by the native resource loader (unless a custom resource
+  /// loader was provided), so they are never copied into Dart memory;
+  /// anything else is fetched with [loadResource].
+  ///
+  Future _addGltfResource(
+      Pointer<TGltfResourceLoader> gltfResourceLoader,
+      Pointer<Char> uri,
+      String path,
+      List<FinalizableUint8List> resources) async {
+    if (canMapFile(path)) {
+      final pathPtr = path.toNativeUtf8(allocator: calloc);
+      try {
+        final mapped = await withBoolCallback((cb) =>
+            GltfResourceLoader_addResourceFileRenderThread(
+                gltfResourceLoader, uri, pathPtr.cast<Char>(), cb));
+        if (mapped) {
+          return;
+        }
+      } finally {
+        free(pathPtr);
+      }
+    }
+
+    final resourceData = await loadResource(path);
+
+    resources.add(FinalizableUint8List(uri, resourceData));
+
+    await withVoidCallback((requestId, cb) =>
+        GltfResourceLoader_addResourceDataRenderThread(
+            gltfResourceLoader,
+            uri,
+            resourceData.address,
+            resourceData.lengthInBytes,
+            requestId,
+            cb));
+  }
+
+  ///
+  /// Whether [path] is a local file that will be memory-mapped natively
+  /// (see [loadGltfFromFile]), rather than loaded with [loadResource].
+  ///
+  bool canMapFile(String path) {
+    return !FILAMENT_WASM && !_hasCustomResourceLoader && _isLocalPath(path);
+  }
+
+  static bool _isLocalPath(String path) {
+    return path.startsWith("file://") ||
+        path.startsWith("/") ||
+        RegExp(r'^[a-zA-Z]:[\\/]').hasMatch(path);
+  }
+
   Future destroyView(covariant FFIView view) async {
     View_setColorGrading(view.view, nullptr);
     for (final cg in view.colorGrading.entries) {
@@ -1,5 +1,6 @@
 import 'dart:async';
 import 'package:logging/logging.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_asset.dart';
 import 'package:thermion_dart/src/filament/src/implementation/ffi_material.dart';
 import 'package:thermion_dart/src/filament/src/implementation/ffi_texture.dart';
 import 'package:thermion_dart/src/filament/src/interface/scene.dart';
@@ -308,33 +309,31 @@ class FFIView extends View<Pointer<TView>> {
           FFIMaterial(highlightMaterialPtr, app);
     }
 
-    MaterialInstance? highlightMaterialInstance;
+    final target = entity ?? asset.entity;
 
-    entity ??= asset.entity;
-    final entities = [entity, ...await asset.getChildEntities()];
-
-    for (final entity in entities) {
-      if (!await FilamentApp.instance!.isRenderable(entity)) {
-        continue;
-      }
-      if (_highlighted.containsKey(entity)) {
-        _highlighted[entity]!.setParameterFloat4("color", r, g, b, 1.0);
-      } else {
-        if (highlightMaterialInstance == null) {
-          highlightMaterialInstance = await highlightMaterial!.createInstance();
-          await highlightMaterialInstance!.setParameterFloat("scale", scale);
-          await highlightMaterialInstance!
-              .setParameterFloat4("color", r, g, b, 1.0);
-
-          await highlightMaterialInstance!.setDepthCullingEnabled(true);
-          await highlightMaterialInstance!.setDepthWriteEnabled(true);
-        }
-        OverlayManager_addComponent(overlayManager!, entity,
-            highlightMaterialInstance.getNativeHandle());
-        _highlighted[entity] = highlightMaterialInstance!;
-      }
+    final existing = _highlighted[target];
+    if (existing != null) {
+      await existing.setParameterFloat4("color", r, g, b, 1.0);
+      return;
     }
 
+    final highlightMaterialInstance = await highlightMaterial!.createInstance();
+    await highlightMaterialInstance.setParameterFloat("scale", scale);
+    await highlightMaterialInstance.setParameterFloat4("color", r, g, b, 1.0);
+    await highlightMaterialInstance.setDepthCullingEnabled(true);
+    await highlightMaterialInstance.setDepthWriteEnabled(true);
+
+    await withVoidCallback((requestId, cb) {
+      OverlayManager_addComponentRenderThread(
+          overlayManager!,
+          (asset as FFIAsset).asset,
+          target,
+          highlightMaterialInstance.getNativeHandle(),
+          requestId,
+          cb);
+    });
+    _highlighted[target] = highlightMaterialInstance;
+
     _logger.info("Added stencil highlight for asset (entity ${asset.entity})");
   }
 
@@ -349,22 +348,15 @@ class FFIView extends View<Pointer<TView>> {
     final entities = [asset.entity, ...await asset.getChildEntities()];
 
     for (final entity in entities) {
-      OverlayManager_removeComponent(overlayManager!, entity);
-    }
-
-    final destroyed = <MaterialInstance>{};
-    for (final entity in entities) {
-      final materialInstance = _highlighted[entity];
-      if (!await FilamentApp.instance!.isRenderable(entity) ||
-          materialInstance == null) {
+      final materialInstance = _highlighted.remove(entity);
+      if (materialInstance == null) {
         continue;
       }
-
-      _highlighted.remove(entity);
-      if (!destroyed.contains(materialInstance)) {
-        await materialInstance.destroy();
-        destroyed.add(materialInstance);
-      }
+      await withVoidCallback((requestId, cb) {
+        OverlayManager_removeComponentRenderThread(
+            overlayManager!, entity, requestId, cb);
+      });
+      await materialInstance.destroy();
     }
   }
 
@@ -128,6 +128,18 @@ abstract class FilamentApp<T> {
   Future<LinearImage> decodeImage(Uint8List data,
       {String name = "image", bool requireAlpha = false});
 
+  ///
+  /// Decodes the specified image data (PNG, JPEG, etc) directly to a 2D
+  /// texture, without first converting it to a floating-point [LinearImage].
+  ///
+  /// Color images should use [sRGB] (the texture is then converted to
+  /// linear by the GPU when sampled); linear data such as normal maps should
+  /// not. If [generateMipmaps] is true, the full mip chain is generated on
+  /// the GPU.
+  ///
+  Future<Texture> decodeImageToTexture(Uint8List data,
+      {bool sRGB = true, bool generateMipmaps = false});
+
   ///
   /// Creates an (empty) imge with the given dimensions.
   ///
@@ -292,7 +304,8 @@ abstract class FilamentApp<T> {
       int priority = 4,
       int layer = 0,
       bool loadResourcesAsync = false,
-      String? resourceUri});
+      String? resourceUri,
+      void Function(double progress)? onProgress});
 
   ///
   ///
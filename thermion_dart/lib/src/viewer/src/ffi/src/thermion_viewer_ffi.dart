@@ -166,6 +166,8 @@ class ThermionViewerFFI extends ThermionViewer {
   @override
   Future setFrameRate(int framerate) async {
     _msPerFrame = 1000.0 / framerate;
+    RenderTicker_setTargetFrameInterval(
+        app.renderTicker, (1e9 / framerate).round());
   }
 
   final _onDispose = <Future Function()>[];
@@ -475,6 +477,19 @@ class ThermionViewerFFI extends ThermionViewer {
     String? resourceUri,
     bool loadAsync = false,
   }) async {
+    if (app.canMapFile(path)) {
+      final asset = await app.loadGltfFromFile(path, animationManager,
+          initialInstances: initialInstances,
+          keepData: keepData,
+          resourceUri: resourceUri,
+          loadResourcesAsync: loadAsync) as FFIAsset;
+      _assets.add(asset);
+      if (addToScene) {
+        await scene.add(asset);
+      }
+      return asset;
+    }
+
     final data = await FilamentApp.instance!.loadResource(path);
     if (resourceUri == null) {
       var split = path.split("/");
@@ -508,6 +523,7 @@ class ThermionViewerFFI extends ThermionViewer {
     int layer = 0,
     bool loadResourcesAsync = false,
     String? resourceUri,
+    void Function(double progress)? onProgress,
   }) async {
     var asset = await FilamentApp.instance!.loadGltfFromBuffer(
       data,
@@ -518,6 +534,7 @@ class ThermionViewerFFI extends ThermionViewer {
       layer: layer,
       loadResourcesAsync: loadResourcesAsync,
       resourceUri: resourceUri,
+      onProgress: onProgress,
     ) as FFIAsset;
 
     _assets.add(asset);
@@ -170,7 +170,9 @@ abstract class ThermionViewer {
   /// Instances can be retrieved with [getInstances].
   ///
   /// If [loadResourcesAsync] is true, resources (textures, materials, etc) will
-  /// be loaded asynchronously. Some material/texture pop-in is expected.
+  /// be loaded asynchronously. Textures are decoded on worker threads and
+  /// uploaded over several frames, so the viewer continues to render while
+  /// a large asset is loading. Some material/texture pop-in is expected.
   ///
   Future<ThermionAsset> loadGltf(String uri,
       {bool addToScene = true,
@@ -193,7 +195,8 @@ abstract class ThermionViewer {
       int priority = 4,
       int layer = 0,
       bool loadResourcesAsync = false,
-      bool addToScene = true});
+      bool addToScene = true,
+      void Function(double progress)? onProgress});
 
   ///
   /// Destroys [asset] and all underlying resources
@@ -0,0 +1,122 @@
+// Measures AnimationManager::update for N instances of a skinned glTF
+// (see SkinnedGltf.hpp) with the engine's JobSystem configured for 1-32
+// threads, compared against a serial update.
+//
+// Requires the Filament libraries (see FILAMENT_LIB_DIR in CMakeLists.txt).
+//
+//   ./animation_benchmark [numInstances=300] [numJoints=32] [numFrames=200]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/Scene.h>
+#include <gltfio/AssetLoader.h>
+#include <gltfio/FilamentAsset.h>
+#include <gltfio/MaterialProvider.h>
+#include <gltfio/ResourceLoader.h>
+#include <gltfio/materials/uberarchive.h>
+#include <utils/EntityManager.h>
+#include <utils/NameComponentManager.h>
+
+#include "SkinnedGltf.hpp"
+#include "scene/AnimationManager.hpp"
+#include "scene/GltfSceneAssetInstance.hpp"
+
+using namespace filament;
+using namespace thermion;
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double meanMs;
+    double p50Ms;
+    double p99Ms;
+};
+
+static Result run(const std::vector<uint8_t> &glb, int numInstances, int numFrames, int numThreads, bool parallel)
+{
+    Engine::Config config;
+    config.jobSystemThreadCount = numThreads;
+    auto *engine = Engine::create(Engine::Backend::NOOP, nullptr, nullptr, &config);
+    auto *scene = engine->createScene();
+
+    auto *materialProvider = gltfio::createUbershaderProvider(engine, UBERARCHIVE_DEFAULT_DATA, UBERARCHIVE_DEFAULT_SIZE);
+    utils::NameComponentManager ncm(utils::EntityManager::get());
+    auto *assetLoader = gltfio::AssetLoader::create({engine, materialProvider, &ncm});
+    std::vector<gltfio::FilamentInstance *> instances(numInstances);
+    auto *asset = assetLoader->createInstancedAsset(glb.data(), glb.size(), instances.data(), numInstances);
+    if (!asset)
+    {
+        std::fprintf(stderr, "Failed to load generated glTF\n");
+        std::exit(1);
+    }
+    gltfio::ResourceLoader resourceLoader({engine, nullptr, false});
+    resourceLoader.loadResources(asset);
+    scene->addEntities(asset->getEntities(), asset->getEntityCount());
+
+    auto animationManager = std::make_unique<AnimationManager>(engine, scene);
+    animationManager->setParallelUpdate(parallel);
+    animationManager->setFixedTimeStep(16666667);
+    std::vector<std::unique_ptr<GltfSceneAssetInstance>> sceneAssetInstances;
+    for (auto *instance : instances)
+    {
+        auto sceneAssetInstance = std::make_unique<GltfSceneAssetInstance>(nullptr, instance, engine, &ncm);
+        animationManager->addGltfAnimationComponent(sceneAssetInstance.get());
+        animationManager->playGltfAnimation(sceneAssetInstance.get(), 0, true, false, true, 0.0f);
+        sceneAssetInstances.push_back(std::move(sceneAssetInstance));
+    }
+
+    std::vector<double> samples;
+    for (int frame = 0; frame < numFrames; frame++)
+    {
+        auto start = Clock::now();
+        animationManager->update(0);
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        // stop the NOOP driver's command stream from filling up
+        engine->flush();
+    }
+
+    animationManager.reset();
+    sceneAssetInstances.clear();
+    scene->removeEntities(asset->getEntities(), asset->getEntityCount());
+    assetLoader->destroyAsset(asset);
+    gltfio::AssetLoader::destroy(&assetLoader);
+    materialProvider->destroyMaterials();
+    delete materialProvider;
+    engine->destroy(scene);
+    Engine::destroy(&engine);
+
+    std::sort(samples.begin(), samples.end());
+    double total = 0;
+    for (auto sample : samples)
+    {
+        total += sample;
+    }
+    return {total / samples.size(), samples[samples.size() / 2], samples[size_t(samples.size() * 0.99)]};
+}
+
+int main(int argc, char **argv)
+{
+    int numInstances = argc > 1 ? std::atoi(argv[1]) : 300;
+    int numJoints = argc > 2 ? std::atoi(argv[2]) : 32;
+    int numFrames = argc > 3 ? std::atoi(argv[3]) : 200;
+
+    auto glb = benchmark::createSkinnedGlb(numJoints);
+
+    std::printf("%d instances x %d joints, %d frames\n\n", numInstances, numJoints, numFrames);
+    std::printf("%-10s %8s %10s %10s %10s\n", "update", "threads", "mean (ms)", "p50 (ms)", "p99 (ms)");
+
+    auto serial = run(glb, numInstances, numFrames, 1, false);
+    std::printf("%-10s %8s %10.3f %10.3f %10.3f\n", "serial", "-", serial.meanMs, serial.p50Ms, serial.p99Ms);
+
+    for (int numThreads : {1, 2, 4, 8, 16, 32})
+    {
+        auto result = run(glb, numInstances, numFrames, numThreads, true);
+        std::printf("%-10s %8d %10.3f %10.3f %10.3f\n", "parallel", numThreads, result.meanMs, result.p50Ms, result.p99Ms);
+    }
+    return 0;
+}
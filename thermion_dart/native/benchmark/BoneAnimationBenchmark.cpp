@@ -0,0 +1,167 @@
+// Measures the per-bone cost of sampling a bone animation, comparing the
+// previous implementation (per-frame copy of the animation, decomposing both
+// keyframe matrices and the current joint transform, then slerp) against
+// BoneAnimationKeys (keys decomposed once, stored as separate T/R/S arrays and
+// sampled with lerp/nlerp).
+//
+//   ./bone_animation_benchmark [numBones=2000] [numFrames=60] [iterations=200]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+#include <gltfio/math.h>
+
+#include "components/BoneAnimationKeys.hpp"
+
+using namespace filament;
+using namespace filament::math;
+using namespace thermion;
+using Clock = std::chrono::steady_clock;
+
+// the layout of BoneAnimation before keys were precomputed
+struct MatrixBoneAnimation
+{
+    int lengthInFrames;
+    float frameLengthInMs;
+    std::vector<mat4f> frameData;
+};
+
+struct KeyedBoneAnimation
+{
+    int lengthInFrames;
+    float frameLengthInMs;
+    BoneAnimationKeys keys;
+};
+
+static volatile float sSink;
+
+static mat4f makeFrame(int bone, int frame)
+{
+    float angle = 0.5f * std::sin(0.1f * frame + 0.7f * bone);
+    auto rotation = quatf::fromAxisAngle(normalize(float3{0.3f, 1.0f, 0.2f}), angle);
+    return gltfio::composeMatrix(float3{0.0f, 0.01f * frame, 1.0f}, rotation, float3{1.0f});
+}
+
+static void frameIndices(float elapsedInMillis, float frameLengthInMs, int lengthInFrames, int *curr, int *next, float *delta)
+{
+    float elapsedInFrames = std::fmod(elapsedInMillis / frameLengthInMs, float(lengthInFrames - 1));
+    *curr = int(std::floor(elapsedInFrames));
+    *next = std::min(*curr + 1, lengthInFrames - 1);
+    *delta = elapsedInFrames - *curr;
+}
+
+static double runMatrix(std::vector<MatrixBoneAnimation> &animations, std::vector<mat4f> &transforms, int iterations)
+{
+    auto start = Clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        for (size_t i = 0; i < animations.size(); i++)
+        {
+            // previously each animation was copied (including its frame data) every update
+            auto animation = animations[i];
+            int currFrame, nextFrame;
+            float frameDelta;
+            frameIndices(iteration * 16.6f, animation.frameLengthInMs, animation.lengthInFrames, &currFrame, &nextFrame, &frameDelta);
+
+            float3 currTranslation, newTranslation, currScale, newScale;
+            quatf currRotation, newRotation;
+            gltfio::decomposeMatrix(animation.frameData[currFrame], &currTranslation, &currRotation, &currScale);
+            gltfio::decomposeMatrix(animation.frameData[nextFrame], &newTranslation, &newRotation, &newScale);
+            newScale = mix(currScale, newScale, frameDelta);
+            newRotation = slerp(currRotation, newRotation, frameDelta);
+            newTranslation = mix(currTranslation, newTranslation, frameDelta);
+
+            // ...and the current joint transform was always decomposed for the fade
+            float3 fadeTranslation, fadeScale;
+            quatf fadeRotation;
+            gltfio::decomposeMatrix(transforms[i], &fadeTranslation, &fadeRotation, &fadeScale);
+            newScale = mix(fadeScale, newScale, 1.0f);
+            newRotation = slerp(fadeRotation, newRotation, 1.0f);
+            newTranslation = mix(fadeTranslation, newTranslation, 1.0f);
+
+            transforms[i] = gltfio::composeMatrix(newTranslation, newRotation, newScale);
+        }
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static double runKeyed(std::vector<KeyedBoneAnimation> &animations, std::vector<mat4f> &transforms, int iterations)
+{
+    auto start = Clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        for (size_t i = 0; i < animations.size(); i++)
+        {
+            auto &animation = animations[i];
+            int currFrame, nextFrame;
+            float frameDelta;
+            frameIndices(iteration * 16.6f, animation.frameLengthInMs, animation.lengthInFrames, &currFrame, &nextFrame, &frameDelta);
+
+            float3 translation, scale;
+            quatf rotation;
+            animation.keys.sample(currFrame, nextFrame, frameDelta, &translation, &rotation, &scale);
+            transforms[i] = gltfio::composeMatrix(translation, rotation, scale);
+        }
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    int numBones = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int numFrames = argc > 2 ? std::atoi(argv[2]) : 60;
+    int iterations = argc > 3 ? std::atoi(argv[3]) : 200;
+
+    std::vector<MatrixBoneAnimation> matrixAnimations(numBones);
+    std::vector<KeyedBoneAnimation> keyedAnimations(numBones);
+    for (int bone = 0; bone < numBones; bone++)
+    {
+        std::vector<mat4f> frames(numFrames);
+        for (int frame = 0; frame < numFrames; frame++)
+        {
+            frames[frame] = makeFrame(bone, frame);
+        }
+        matrixAnimations[bone] = {numFrames, 33.3f, frames};
+        keyedAnimations[bone].lengthInFrames = numFrames;
+        keyedAnimations[bone].frameLengthInMs = 33.3f;
+        keyedAnimations[bone].keys.set(frames.data(), frames.size());
+    }
+
+    std::vector<mat4f> matrixTransforms(numBones, mat4f());
+    std::vector<mat4f> keyedTransforms(numBones, mat4f());
+
+    // warm up
+    runMatrix(matrixAnimations, matrixTransforms, 5);
+    runKeyed(keyedAnimations, keyedTransforms, 5);
+
+    double matrixNs = runMatrix(matrixAnimations, matrixTransforms, iterations);
+    double keyedNs = runKeyed(keyedAnimations, keyedTransforms, iterations);
+
+    float maxError = 0.0f;
+    for (int bone = 0; bone < numBones; bone++)
+    {
+        for (int col = 0; col < 4; col++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                maxError = std::max(maxError, std::abs(matrixTransforms[bone][col][row] - keyedTransforms[bone][col][row]));
+            }
+        }
+    }
+    sSink = keyedTransforms[0][3][1] + matrixTransforms[0][3][1];
+
+    double samples = double(numBones) * iterations;
+    std::printf("%d bones x %d keyframes, %d updates\n\n", numBones, numFrames, iterations);
+    std::printf("%-28s %12s\n", "implementation", "ns/bone");
+    std::printf("%-28s %12.1f\n", "mat4 keys + decompose", matrixNs / samples);
+    std::printf("%-28s %12.1f\n", "precomputed TRS + nlerp", keyedNs / samples);
+    std::printf("\nspeedup: %.1fx (max abs difference %.2e)\n", matrixNs / keyedNs, maxError);
+    return 0;
+}
@@ -0,0 +1,217 @@
+// Compares a brute-force collision query (testing every collider, as
+// CollisionComponentManager::collides did previously) against the
+// DynamicAabbTree broadphase, for 1k/10k/100k boxes scattered through a
+// "warehouse" volume.
+//
+// For each box count this measures:
+//   - a single-box query (e.g. one step of dragging an object)
+//   - the per-query cost of comparing every collider's world transform against
+//     the one it was last fitted to (which CollisionComponentManager previously
+//     did before every query, even when nothing had moved)
+//   - refitting the tree after 1% of the boxes have moved (which the manager
+//     now does once per frame, for the colliders marked dirty)
+//   - finding all overlapping pairs (brute force is skipped above 10k boxes)
+//
+//   ./collision_benchmark [numQueries=1000]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <filament/Box.h>
+#include <math/mat4.h>
+
+#include "components/DynamicAabbTree.hpp"
+
+using namespace filament;
+using namespace filament::math;
+using namespace thermion;
+using Clock = std::chrono::steady_clock;
+
+static double elapsedNs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static Aabb randomBox(std::mt19937 &rng, float worldSize)
+{
+    std::uniform_real_distribution<float> position(0.0f, worldSize);
+    std::uniform_real_distribution<float> size(0.5f, 2.0f);
+    float3 min{position(rng), position(rng) * 0.1f, position(rng)};
+    return {min, min + float3{size(rng), size(rng), size(rng)}};
+}
+
+// the narrow-phase test used by CollisionComponentManager::collides
+static bool cornersIntersect(const Aabb &source, const Aabb &target)
+{
+    auto sourceCorners = source.getCorners();
+    auto targetCorners = target.getCorners();
+    for (int i = 0; i < 8; i++)
+    {
+        if (target.contains(sourceCorners.vertices[i]) <= 0 || source.contains(targetCorners.vertices[i]) <= 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    int numQueries = argc > 1 ? std::atoi(argv[1]) : 1000;
+
+    std::printf("%8s %10s | %14s %14s %8s | %14s %14s | %12s %12s %8s %8s\n",
+                "boxes", "height", "query brute", "query tree", "speedup",
+                "scan/query", "dirty refit 1%", "pairs brute", "pairs tree", "speedup", "pairs");
+    std::printf("%8s %10s | %14s %14s %8s | %14s %14s | %12s %12s %8s %8s\n",
+                "", "", "(us)", "(us)", "", "(us)", "(us)", "(ms)", "(ms)", "", "");
+
+    for (int numBoxes : {1000, 10000, 100000})
+    {
+        std::mt19937 rng(42);
+        // keep the density roughly constant as the scene grows
+        const float worldSize = 20.0f * std::cbrt(float(numBoxes));
+
+        std::vector<Aabb> boxes(numBoxes);
+        DynamicAabbTree tree;
+        std::vector<int32_t> proxies(numBoxes);
+        for (int i = 0; i < numBoxes; i++)
+        {
+            boxes[i] = randomBox(rng, worldSize);
+            proxies[i] = tree.createProxy(boxes[i], i);
+        }
+
+        std::vector<Aabb> queries(numQueries);
+        for (auto &query : queries)
+        {
+            query = randomBox(rng, worldSize);
+        }
+
+        size_t bruteHits = 0;
+        auto start = Clock::now();
+        for (const auto &query : queries)
+        {
+            for (const auto &box : boxes)
+            {
+                bruteHits += cornersIntersect(query, box);
+            }
+        }
+        double bruteQueryNs = elapsedNs(start) / numQueries;
+
+        size_t treeHits = 0;
+        start = Clock::now();
+        for (const auto &query : queries)
+        {
+            tree.query(query, [&](int32_t proxyId)
+                       {
+                           treeHits += cornersIntersect(query, boxes[tree.getUserData(proxyId)]);
+                           return true; });
+        }
+        double treeQueryNs = elapsedNs(start) / numQueries;
+
+        if (bruteHits != treeHits)
+        {
+            std::fprintf(stderr, "Mismatch: brute force found %zu hits, tree found %zu\n", bruteHits, treeHits);
+            return 1;
+        }
+
+        // the world transform of each collider, and the one it was last fitted to
+        std::vector<mat4f> worldTransforms(numBoxes);
+        std::vector<mat4f> fittedTransforms(numBoxes);
+        for (int i = 0; i < numBoxes; i++)
+        {
+            worldTransforms[i] = fittedTransforms[i] = mat4f::translation(boxes[i].center());
+        }
+
+        // what each query previously paid before touching the tree (nothing has
+        // moved, so this is purely the cost of finding that out)
+        const int numScans = std::max(1, std::min(numQueries, 100));
+        size_t numStale = 0;
+        start = Clock::now();
+        for (int scan = 0; scan < numScans; scan++)
+        {
+            for (int i = 0; i < numBoxes; i++)
+            {
+                if (worldTransforms[i] != fittedTransforms[i])
+                {
+                    fittedTransforms[i] = worldTransforms[i];
+                    numStale++;
+                }
+            }
+        }
+        double scanNs = elapsedNs(start) / numScans;
+        if (numStale != 0)
+        {
+            std::fprintf(stderr, "Found %zu stale transforms\n", numStale);
+            return 1;
+        }
+
+        // move 1% of the boxes (most by less than the tree's margin), then refit
+        // only those, as the manager does once per frame for its dirty colliders
+        std::normal_distribution<float> jitter(0.0f, 0.1f);
+        const int numMoved = numBoxes / 100;
+        std::vector<int> dirty(numMoved);
+        for (int i = 0; i < numMoved; i++)
+        {
+            auto index = (i * 97) % numBoxes;
+            float3 offset{jitter(rng), 0.0f, jitter(rng)};
+            boxes[index] = {boxes[index].min + offset, boxes[index].max + offset};
+            worldTransforms[index] = mat4f::translation(boxes[index].center());
+            dirty[i] = index;
+        }
+        start = Clock::now();
+        for (auto index : dirty)
+        {
+            if (worldTransforms[index] != fittedTransforms[index])
+            {
+                fittedTransforms[index] = worldTransforms[index];
+                tree.moveProxy(proxies[index], boxes[index]);
+            }
+        }
+        double refitNs = elapsedNs(start);
+
+        size_t treePairs = 0;
+        start = Clock::now();
+        tree.queryPairs([&](int32_t a, int32_t b)
+                        { treePairs += DynamicAabbTree::overlaps(boxes[tree.getUserData(a)], boxes[tree.getUserData(b)]); });
+        double treePairsNs = elapsedNs(start);
+
+        double brutePairsNs = -1;
+        if (numBoxes <= 10000)
+        {
+            size_t brutePairs = 0;
+            start = Clock::now();
+            for (int i = 0; i < numBoxes; i++)
+            {
+                for (int j = i + 1; j < numBoxes; j++)
+                {
+                    brutePairs += DynamicAabbTree::overlaps(boxes[i], boxes[j]);
+                }
+            }
+            brutePairsNs = elapsedNs(start);
+            if (brutePairs != treePairs)
+            {
+                std::fprintf(stderr, "Mismatch: brute force found %zu pairs, tree found %zu\n", brutePairs, treePairs);
+                return 1;
+            }
+        }
+
+        char brutePairsText[32] = "-";
+        char pairsSpeedupText[32] = "-";
+        if (brutePairsNs >= 0)
+        {
+            std::snprintf(brutePairsText, sizeof(brutePairsText), "%.2f", brutePairsNs / 1e6);
+            std::snprintf(pairsSpeedupText, sizeof(pairsSpeedupText), "%.0fx", brutePairsNs / treePairsNs);
+        }
+        std::printf("%8d %10d | %14.2f %14.2f %7.0fx | %14.2f %14.2f | %12s %12.2f %8s %8zu\n",
+                    numBoxes, tree.getHeight(),
+                    bruteQueryNs / 1e3, treeQueryNs / 1e3, bruteQueryNs / treeQueryNs,
+                    scanNs / 1e3, refitNs / 1e3,
+                    brutePairsText, treePairsNs / 1e6, pairsSpeedupText, treePairs);
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+// Measures the vertex shader invocations (with a simulated FIFO
+// post-transform cache) for generated meshes before and after
+// MeshOptimizer (deduplication, vertex cache and overdraw reordering,
+// vertex fetch reordering), as GeometrySceneAssetBuilder::optimize does.
+//
+// The meshes are:
+//   - a grid with triangles in row order (already reasonably cache-friendly)
+//   - the same grid with shuffled triangles (like scanner/CAD exports)
+//   - a UV sphere with shuffled triangles
+//   - an unindexed triangle soup (every triangle has its own three vertices)
+//
+//   ./mesh_optimizer_benchmark [gridSize=256]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <math/vec3.h>
+
+#include "scene/MeshOptimizer.hpp"
+
+using namespace filament::math;
+using namespace thermion;
+using Clock = std::chrono::steady_clock;
+
+struct Mesh
+{
+    std::string name;
+    std::vector<float3> positions;
+    std::vector<uint32_t> indices;
+};
+
+static Mesh grid(uint32_t size)
+{
+    Mesh mesh{"grid (rows)", {}, {}};
+    for (uint32_t y = 0; y <= size; y++)
+    {
+        for (uint32_t x = 0; x <= size; x++)
+        {
+            mesh.positions.push_back({float(x), float(y), 0.0f});
+        }
+    }
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            uint32_t i = (y * (size + 1)) + x;
+            mesh.indices.insert(mesh.indices.end(), {i, i + 1, i + size + 1, i + 1, i + size + 2, i + size + 1});
+        }
+    }
+    return mesh;
+}
+
+static Mesh sphere(uint32_t rings, uint32_t segments)
+{
+    Mesh mesh{"sphere (shuffled)", {}, {}};
+    for (uint32_t r = 0; r <= rings; r++)
+    {
+        float phi = float(M_PI) * r / rings;
+        for (uint32_t s = 0; s <= segments; s++)
+        {
+            float theta = 2.0f * float(M_PI) * s / segments;
+            mesh.positions.push_back({std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta)});
+        }
+    }
+    for (uint32_t r = 0; r < rings; r++)
+    {
+        for (uint32_t s = 0; s < segments; s++)
+        {
+            uint32_t i = (r * (segments + 1)) + s;
+            mesh.indices.insert(mesh.indices.end(), {i, i + segments + 1, i + 1, i + 1, i + segments + 1, i + segments + 2});
+        }
+    }
+    return mesh;
+}
+
+static void shuffleTriangles(Mesh &mesh, std::mt19937 &rng)
+{
+    std::vector<uint32_t> order(mesh.indices.size() / 3);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    std::vector<uint32_t> shuffled;
+    shuffled.reserve(mesh.indices.size());
+    for (auto t : order)
+    {
+        shuffled.insert(shuffled.end(), mesh.indices.begin() + (t * 3), mesh.indices.begin() + (t * 3) + 3);
+    }
+    mesh.indices = std::move(shuffled);
+}
+
+static Mesh unindex(const Mesh &source)
+{
+    Mesh mesh{"soup (unindexed)", {}, {}};
+    for (auto index : source.indices)
+    {
+        mesh.indices.push_back(static_cast<uint32_t>(mesh.positions.size()));
+        mesh.positions.push_back(source.positions[index]);
+    }
+    return mesh;
+}
+
+static void run(const Mesh &source)
+{
+    const size_t vertexCount = source.positions.size();
+    const size_t indexCount = source.indices.size();
+    const auto before16 = MeshOptimizer::analyzeVertexCache(source.indices.data(), indexCount, vertexCount, 16);
+    const auto before32 = MeshOptimizer::analyzeVertexCache(source.indices.data(), indexCount, vertexCount, 32);
+
+    auto start = Clock::now();
+
+    std::vector<uint32_t> remap(vertexCount);
+    MeshOptimizer::VertexStream stream{source.positions.data(), sizeof(float3), sizeof(float3)};
+    const size_t uniqueCount = MeshOptimizer::deduplicateVertices(remap.data(), &stream, 1, vertexCount);
+    std::vector<float3> positions(uniqueCount);
+    std::vector<uint32_t> indices(indexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        positions[remap[v]] = source.positions[v];
+    }
+    for (size_t i = 0; i < indexCount; i++)
+    {
+        indices[i] = remap[source.indices[i]];
+    }
+
+    std::vector<uint32_t> optimized(indexCount);
+    MeshOptimizer::optimizeVertexCache(optimized.data(), indices.data(), indexCount, uniqueCount);
+    const auto cache16 = MeshOptimizer::analyzeVertexCache(optimized.data(), indexCount, uniqueCount, 16);
+    MeshOptimizer::optimizeOverdraw(indices.data(), optimized.data(), indexCount, positions.data(), sizeof(float3), uniqueCount);
+
+    const size_t usedCount = MeshOptimizer::optimizeVertexFetch(remap.data(), indices.data(), indexCount, uniqueCount);
+    for (auto &index : indices)
+    {
+        index = remap[index];
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const auto after16 = MeshOptimizer::analyzeVertexCache(indices.data(), indexCount, usedCount, 16);
+    const auto after32 = MeshOptimizer::analyzeVertexCache(indices.data(), indexCount, usedCount, 32);
+
+    std::printf("%-18s %8zu -> %-8zu %5.3f -> %5.3f (%5.3f) %5.3f -> %5.3f %10zu -> %-10zu %5.1fx %8.1f\n",
+                source.name.c_str(), vertexCount, usedCount,
+                before16.acmr, after16.acmr, cache16.acmr,
+                before32.acmr, after32.acmr,
+                before16.vertexInvocations, after16.vertexInvocations,
+                double(before16.vertexInvocations) / double(after16.vertexInvocations), ms);
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t gridSize = argc > 1 ? std::atoi(argv[1]) : 256;
+    std::mt19937 rng(42);
+
+    std::vector<Mesh> meshes;
+    meshes.push_back(grid(gridSize));
+    meshes.push_back(grid(gridSize));
+    meshes.back().name = "grid (shuffled)";
+    shuffleTriangles(meshes.back(), rng);
+    meshes.push_back(sphere(gridSize / 2, gridSize));
+    shuffleTriangles(meshes.back(), rng);
+    meshes.push_back(unindex(grid(gridSize)));
+
+    std::printf("ACMR = vertex shader invocations per triangle, with a FIFO cache of 16 (32) entries\n");
+    std::printf("(in brackets: after vertex cache optimization, before overdraw reordering)\n\n");
+    std::printf("%-18s %20s %22s %14s %24s %6s %8s\n",
+                "mesh", "vertices", "ACMR(16)", "ACMR(32)", "invocations(16)", "cut", "time(ms)");
+    for (const auto &mesh : meshes)
+    {
+        run(mesh);
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+// Measures morph animation updates for N renderables with K morph targets
+// each, comparing one setMorphWeights call per morph target (the previous
+// implementation) against MorphAnimationComponentManager::update, which
+// gathers all weights for a renderable and uploads each contiguous run of
+// driven targets with a single call (here every target is driven, so there
+// is one call per renderable).
+//
+// Requires the Filament libraries (see FILAMENT_LIB_DIR in CMakeLists.txt).
+//
+//   ./morph_animation_benchmark [numRenderables=100] [numMorphTargets=52] [numAnimations=2] [numFrames=200]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/MorphTargetBuffer.h>
+#include <filament/RenderableManager.h>
+#include <filament/TransformManager.h>
+#include <filament/VertexBuffer.h>
+#include <utils/EntityManager.h>
+
+#include "components/MorphAnimationComponentManager.hpp"
+
+using namespace filament;
+using namespace thermion;
+using Clock = std::chrono::steady_clock;
+
+static const int kAnimationFrames = 60;
+
+struct Result {
+    double meanMs;
+    double p50Ms;
+    double p99Ms;
+};
+
+static Result summarize(std::vector<double> &samples)
+{
+    std::sort(samples.begin(), samples.end());
+    double total = 0;
+    for (auto sample : samples)
+    {
+        total += sample;
+    }
+    return {total / samples.size(), samples[samples.size() / 2], samples[size_t(samples.size() * 0.99)]};
+}
+
+// the previous update loop: one lookup + one setMorphWeights call per
+// morph target of every animation, with frames stepped rather than interpolated
+static void updatePerTarget(RenderableManager &rm, std::vector<utils::Entity> &entities, MorphAnimationComponentManager &manager, uint64_t nowInNanos)
+{
+    for (auto entity : entities)
+    {
+        auto &animations = manager.elementAt<0>(manager.getInstance(entity)).animations;
+        for (auto &animation : animations)
+        {
+            auto elapsedInSecs = animation.elapsedInSecs(nowInNanos);
+            int frameNumber = static_cast<int>(elapsedInSecs * 1000.0f / animation.frameLengthInMs) % animation.lengthInFrames;
+            auto baseOffset = frameNumber * animation.morphIndices.size();
+            for (size_t i = 0; i < animation.morphIndices.size(); i++)
+            {
+                auto renderableInstance = rm.getInstance(entity);
+                rm.setMorphWeights(renderableInstance, animation.frameData.data() + baseOffset + i, 1, animation.morphIndices[i]);
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int numRenderables = argc > 1 ? std::atoi(argv[1]) : 100;
+    int numMorphTargets = argc > 2 ? std::atoi(argv[2]) : 52;
+    int numAnimations = argc > 3 ? std::atoi(argv[3]) : 2;
+    int numFrames = argc > 4 ? std::atoi(argv[4]) : 200;
+
+    auto *engine = Engine::create(Engine::Backend::NOOP);
+    auto &rm = engine->getRenderableManager();
+
+    static const float kPositions[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    static const uint16_t kIndices[3] = {0, 1, 2};
+    auto *vertexBuffer = VertexBuffer::Builder()
+                             .vertexCount(3)
+                             .bufferCount(1)
+                             .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3)
+                             .build(*engine);
+    vertexBuffer->setBufferAt(*engine, 0, VertexBuffer::BufferDescriptor(kPositions, sizeof(kPositions)));
+    auto *indexBuffer = IndexBuffer::Builder().indexCount(3).bufferType(IndexBuffer::IndexType::USHORT).build(*engine);
+    indexBuffer->setBuffer(*engine, IndexBuffer::BufferDescriptor(kIndices, sizeof(kIndices)));
+
+    MorphAnimationComponentManager manager(engine->getTransformManager(), rm);
+    std::vector<MorphTargetBuffer *> morphTargetBuffers;
+    std::vector<utils::Entity> entities(numRenderables);
+    utils::EntityManager::get().create(numRenderables, entities.data());
+    for (auto entity : entities)
+    {
+        auto *morphTargetBuffer = MorphTargetBuffer::Builder().vertexCount(3).count(numMorphTargets).build(*engine);
+        morphTargetBuffers.push_back(morphTargetBuffer);
+        RenderableManager::Builder(1)
+            .boundingBox({{0, 0, 0}, {1, 1, 1}})
+            .geometry(0, RenderableManager::PrimitiveType::TRIANGLES, vertexBuffer, indexBuffer)
+            .morphing(morphTargetBuffer)
+            .build(*engine, entity);
+
+        manager.addAnimationComponent(entity);
+        auto &animations = manager.elementAt<0>(manager.getInstance(entity)).animations;
+        for (int a = 0; a < numAnimations; a++)
+        {
+            MorphAnimation animation;
+            animation.lengthInFrames = kAnimationFrames;
+            animation.frameLengthInMs = 1000.0f / 30.0f;
+            animation.durationInSecs = kAnimationFrames * animation.frameLengthInMs / 1000.0f;
+            animation.loop = true;
+            for (int i = 0; i < numMorphTargets; i++)
+            {
+                animation.morphIndices.push_back(i);
+            }
+            for (int frame = 0; frame < kAnimationFrames; frame++)
+            {
+                for (int i = 0; i < numMorphTargets; i++)
+                {
+                    animation.frameData.push_back(float((frame + i + a) % kAnimationFrames) / kAnimationFrames);
+                }
+            }
+            animations.push_back(std::move(animation));
+        }
+    }
+
+    std::vector<double> perTarget;
+    std::vector<double> batched;
+    for (int frame = 0; frame < numFrames; frame++)
+    {
+        const uint64_t nowInNanos = frame * 16666667ull;
+        auto start = Clock::now();
+        updatePerTarget(rm, entities, manager, nowInNanos);
+        perTarget.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        engine->flush();
+
+        start = Clock::now();
+        manager.update(nowInNanos);
+        batched.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        engine->flush();
+    }
+
+    std::printf("%d renderables x %d morph targets x %d animations, %d frames\n\n", numRenderables, numMorphTargets, numAnimations, numFrames);
+    std::printf("%-12s %12s %10s %10s %10s\n", "update", "calls/frame", "mean (ms)", "p50 (ms)", "p99 (ms)");
+    auto perTargetResult = summarize(perTarget);
+    auto batchedResult = summarize(batched);
+    std::printf("%-12s %12d %10.3f %10.3f %10.3f\n", "per-target", numRenderables * numMorphTargets * numAnimations,
+                perTargetResult.meanMs, perTargetResult.p50Ms, perTargetResult.p99Ms);
+    std::printf("%-12s %12d %10.3f %10.3f %10.3f\n", "batched", numRenderables,
+                batchedResult.meanMs, batchedResult.p50Ms, batchedResult.p99Ms);
+
+    for (auto entity : entities)
+    {
+        rm.destroy(entity);
+    }
+    utils::EntityManager::get().destroy(numRenderables, entities.data());
+    for (auto *morphTargetBuffer : morphTargetBuffers)
+    {
+        engine->destroy(morphTargetBuffer);
+    }
+    engine->destroy(vertexBuffer);
+    engine->destroy(indexBuffer);
+    Engine::destroy(&engine);
+    return 0;
+}
@@ -0,0 +1,251 @@
+// Measures the CPU frame time added by outlining N objects (with the
+// OverlayComponentManager, which draws dedicated overlay renderables that
+// share each object's vertex and index buffers) compared to rendering the
+// same scene without outlines, and compares this against the previous
+// implementation, which swapped every overlay primitive's material to a depth
+// material, re-rendered the main view, swapped in the outline materials,
+// rendered the main view again and swapped the original materials back,
+// every frame.
+//
+// The overlay is measured with a static camera (so the depth prepass is
+// cached) and an orbiting camera (so it is re-rendered every frame).
+//
+// Requires the Filament libraries (see FILAMENT_LIB_DIR in CMakeLists.txt).
+//
+//   ./overlay_benchmark [numObjects=100] [numFrames=500]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <filament/Camera.h>
+#include <filament/Engine.h>
+#include <filament/Material.h>
+#include <filament/MaterialInstance.h>
+#include <filament/RenderTarget.h>
+#include <filament/Renderer.h>
+#include <filament/RenderableManager.h>
+#include <filament/Scene.h>
+#include <filament/SwapChain.h>
+#include <filament/Texture.h>
+#include <filament/TextureSampler.h>
+#include <filament/TransformManager.h>
+#include <filament/View.h>
+#include <filament/Viewport.h>
+#include <utils/EntityManager.h>
+
+#include "components/OverlayComponentManager.hpp"
+#include "material/linear_depth.h"
+#include "material/outline.h"
+#include "scene/GeometrySceneAsset.hpp"
+#include "scene/GeometrySceneAssetBuilder.hpp"
+
+using namespace filament;
+using namespace filament::math;
+using namespace thermion;
+using Clock = std::chrono::steady_clock;
+
+static constexpr uint32_t kWidth = 1280;
+static constexpr uint32_t kHeight = 720;
+
+enum class Mode
+{
+    None,
+    Legacy,
+    Cached
+};
+
+// the previous OverlayComponentManager::update
+static void legacyUpdate(Engine *engine, Renderer *renderer, View *view, Scene *overlayScene, RenderTarget *overlayRenderTarget,
+                         MaterialInstance *depthMaterialInstance, const std::vector<std::pair<utils::Entity, MaterialInstance *>> &overlays)
+{
+    auto &rm = engine->getRenderableManager();
+    std::map<utils::Entity, std::vector<MaterialInstance *>> materials;
+    auto *scene = view->getScene();
+    auto *renderTarget = view->getRenderTarget();
+    view->setRenderTarget(overlayRenderTarget);
+    view->setScene(overlayScene);
+    for (const auto &[entity, materialInstance] : overlays)
+    {
+        auto ri = rm.getInstance(entity);
+        for (size_t i = 0; i < rm.getPrimitiveCount(ri); i++)
+        {
+            materials[entity].push_back(rm.getMaterialInstanceAt(ri, i));
+            rm.setMaterialInstanceAt(ri, i, depthMaterialInstance);
+        }
+    }
+    renderer->render(view);
+    view->setRenderTarget(renderTarget);
+    for (const auto &[entity, materialInstance] : overlays)
+    {
+        auto ri = rm.getInstance(entity);
+        for (size_t i = 0; i < rm.getPrimitiveCount(ri); i++)
+        {
+            rm.setMaterialInstanceAt(ri, i, materialInstance);
+        }
+    }
+    renderer->render(view);
+    for (const auto &[entity, materialInstance] : overlays)
+    {
+        auto ri = rm.getInstance(entity);
+        for (size_t i = 0; i < rm.getPrimitiveCount(ri); i++)
+        {
+            rm.setMaterialInstanceAt(ri, i, materials[entity][i]);
+        }
+    }
+    view->setScene(scene);
+}
+
+static double run(Mode mode, bool orbit, int numObjects, int numFrames)
+{
+    auto *engine = Engine::create(Engine::Backend::NOOP);
+    auto *swapChain = engine->createSwapChain(kWidth, kHeight, 0);
+    auto *renderer = engine->createRenderer();
+    auto *scene = engine->createScene();
+    auto *overlayScene = engine->createScene();
+    auto *view = engine->createView();
+    auto cameraEntity = utils::EntityManager::get().create();
+    auto *camera = engine->createCamera(cameraEntity);
+    camera->setProjection(45.0, double(kWidth) / kHeight, 0.1, 1000.0);
+    view->setCamera(camera);
+    view->setScene(scene);
+    view->setViewport({0, 0, kWidth, kHeight});
+
+    auto *color = Texture::Builder().width(kWidth).height(kHeight).levels(1).usage(Texture::Usage::COLOR_ATTACHMENT | Texture::Usage::SAMPLEABLE).format(Texture::InternalFormat::RGBA32F).build(*engine);
+    auto *depth = Texture::Builder().width(kWidth).height(kHeight).levels(1).usage(Texture::Usage::DEPTH_ATTACHMENT).format(Texture::InternalFormat::DEPTH32F).build(*engine);
+    auto *overlayRenderTarget = RenderTarget::Builder()
+                                    .texture(RenderTarget::AttachmentPoint::COLOR, color)
+                                    .texture(RenderTarget::AttachmentPoint::DEPTH, depth)
+                                    .build(*engine);
+
+    auto *material = Material::Builder().package(LINEAR_DEPTH_LINEAR_DEPTH_DATA, LINEAR_DEPTH_LINEAR_DEPTH_SIZE).build(*engine);
+    auto *materialInstance = material->createInstance();
+    auto *depthMaterialInstance = material->createInstance();
+    auto *outlineMaterial = Material::Builder().package(OUTLINE_OUTLINE_DATA, OUTLINE_OUTLINE_SIZE).build(*engine);
+    auto *outlineMaterialInstance = outlineMaterial->createInstance();
+    outlineMaterialInstance->setParameter("scale", 1.05f);
+    outlineMaterialInstance->setParameter("color", float3{1.0f, 0.0f, 0.0f});
+
+    const float vertices[] = {
+        -1, -1, 1, 1, -1, 1, 1, 1, 1, -1, 1, 1,
+        -1, -1, -1, 1, -1, -1, 1, 1, -1, -1, 1, -1};
+    const uint16_t indices[] = {
+        0, 1, 2, 0, 2, 3, 1, 5, 6, 1, 6, 2, 5, 4, 7, 5, 7, 6,
+        4, 0, 3, 4, 3, 7, 3, 2, 6, 3, 6, 7, 4, 5, 1, 4, 1, 0};
+
+    auto &tm = engine->getTransformManager();
+    std::vector<std::unique_ptr<GeometrySceneAsset>> assets;
+    std::vector<std::pair<utils::Entity, MaterialInstance *>> overlays;
+    auto overlayManager = std::make_unique<OverlayComponentManager>(engine, view, overlayScene, overlayRenderTarget, renderer);
+    const int gridSize = int(std::ceil(std::sqrt(float(numObjects))));
+    for (int i = 0; i < numObjects; i++)
+    {
+        auto asset = GeometrySceneAssetBuilder(engine)
+                         .vertices(vertices, 24)
+                         .indices(indices, 36)
+                         .materials(&materialInstance, 1)
+                         .build();
+        auto entity = asset->getEntity();
+        if (!tm.hasComponent(entity))
+        {
+            tm.create(entity);
+        }
+        tm.setTransform(tm.getInstance(entity), mat4f::translation(float3{(i % gridSize) * 3.0f, 0.0f, (i / gridSize) * 3.0f}));
+        scene->addEntity(entity);
+        if (mode == Mode::Cached)
+        {
+            overlayManager->addOverlayComponent(asset.get(), entity, outlineMaterialInstance);
+        }
+        else if (mode == Mode::Legacy)
+        {
+            overlayScene->addEntity(entity);
+            overlays.emplace_back(entity, outlineMaterialInstance);
+        }
+        assets.push_back(std::move(asset));
+    }
+
+    std::vector<double> samples;
+    const float3 target{gridSize * 1.5f, 0.0f, gridSize * 1.5f};
+    for (int frame = 0; frame < numFrames; frame++)
+    {
+        float angle = orbit ? frame * 0.01f : 0.0f;
+        camera->lookAt(math::double3(target + float3{std::cos(angle), 0.5f, std::sin(angle)} * (gridSize * 4.0f)), math::double3(target));
+
+        auto start = Clock::now();
+        if (renderer->beginFrame(swapChain))
+        {
+            renderer->render(view);
+            if (mode == Mode::Cached)
+            {
+                overlayManager->update();
+            }
+            else if (mode == Mode::Legacy)
+            {
+                legacyUpdate(engine, renderer, view, overlayScene, overlayRenderTarget, depthMaterialInstance, overlays);
+            }
+            renderer->endFrame();
+        }
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        // stop the NOOP driver's command stream from filling up
+        engine->flush();
+    }
+
+    overlayManager.reset();
+    for (auto &asset : assets)
+    {
+        scene->remove(asset->getEntity());
+        overlayScene->remove(asset->getEntity());
+    }
+    assets.clear();
+    engine->destroy(outlineMaterialInstance);
+    engine->destroy(outlineMaterial);
+    engine->destroy(depthMaterialInstance);
+    engine->destroy(materialInstance);
+    engine->destroy(material);
+    engine->destroy(overlayRenderTarget);
+    engine->destroy(depth);
+    engine->destroy(color);
+    engine->destroyCameraComponent(cameraEntity);
+    utils::EntityManager::get().destroy(cameraEntity);
+    engine->destroy(view);
+    engine->destroy(overlayScene);
+    engine->destroy(scene);
+    engine->destroy(renderer);
+    engine->destroy(swapChain);
+    Engine::destroy(&engine);
+
+    // ignore the first frames, which include allocating the render targets
+    samples.erase(samples.begin(), samples.begin() + std::min<size_t>(samples.size(), 10));
+    double total = 0;
+    for (auto sample : samples)
+    {
+        total += sample;
+    }
+    return total / samples.size();
+}
+
+int main(int argc, char **argv)
+{
+    int numObjects = argc > 1 ? std::atoi(argv[1]) : 100;
+    int numFrames = argc > 2 ? std::atoi(argv[2]) : 500;
+
+    std::printf("%d outlined objects, %d frames\n\n", numObjects, numFrames);
+    std::printf("%-10s %-8s %12s %14s\n", "overlay", "camera", "frame (ms)", "overlay (ms)");
+
+    for (bool orbit : {false, true})
+    {
+        const char *cameraName = orbit ? "orbit" : "static";
+        auto none = run(Mode::None, orbit, numObjects, numFrames);
+        auto legacy = run(Mode::Legacy, orbit, numObjects, numFrames);
+        auto cached = run(Mode::Cached, orbit, numObjects, numFrames);
+        std::printf("%-10s %-8s %12.3f %14s\n", "none", cameraName, none, "-");
+        std::printf("%-10s %-8s %12.3f %14.3f\n", "legacy", cameraName, legacy, legacy - none);
+        std::printf("%-10s %-8s %12.3f %14.3f\n", "cached", cameraName, cached, cached - none);
+    }
+    return 0;
+}
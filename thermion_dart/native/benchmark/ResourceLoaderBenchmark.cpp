@@ -0,0 +1,265 @@
+// Measures the time to fetch every external resource of a multi-file glTF
+// from a local directory through ResourceLoaderWrapperImpl, with:
+//   - the original loadToOut busy-wait (polling every 100 ms)
+//   - loadToOut with the current (backoff) polling
+//   - loadWithCallback, with every fetch in flight at once
+//   - memory-mapping (absolute paths/file:// URIs)
+//
+// The "platform" loaders read each file on their own thread, as a platform
+// channel would, after [latencyMs] (to model the round trip to the platform
+// or a slower filesystem). The contents of every buffer are read (checksummed) so the
+// page faults for memory-mapped files are included in their timings.
+//
+// Without a directory, a glTF with [count] external buffers of [sizeKb] KB
+// is generated in a temporary directory first (so the files are likely to
+// be in the OS page cache).
+//
+//   ./resource_loader_benchmark [directory|-] [count=30] [sizeKb=1024] [latencyMs=0]
+
+#define CGLTF_IMPLEMENTATION
+#include "cgltf.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ResourceBuffer.hpp"
+
+using namespace thermion;
+using Clock = std::chrono::steady_clock;
+
+static std::string gDirectory;
+static int gLatencyMs = 0;
+
+static void generate(const std::string &directory, int count, size_t size)
+{
+    std::filesystem::create_directories(directory);
+    std::ofstream gltf(directory + "/scene.gltf");
+    gltf << "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[";
+    std::vector<uint8_t> data(size);
+    for (int i = 0; i < count; i++)
+    {
+        const auto name = "buffer" + std::to_string(i) + ".bin";
+        for (size_t j = 0; j < size; j++)
+        {
+            data[j] = uint8_t(i + j);
+        }
+        std::ofstream(directory + "/" + name, std::ios::binary).write(reinterpret_cast<const char *>(data.data()), size);
+        gltf << (i ? "," : "") << "{\"uri\":\"" << name << "\",\"byteLength\":" << size << "}";
+    }
+    gltf << "]}";
+}
+
+static std::vector<std::string> resourceUris(const std::string &directory)
+{
+    std::string path;
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.path().extension() == ".gltf")
+        {
+            path = entry.path().string();
+            break;
+        }
+    }
+    std::vector<std::string> uris;
+    cgltf_options options = {};
+    cgltf_data *data = nullptr;
+    if (path.empty() || cgltf_parse_file(&options, path.c_str(), &data) != cgltf_result_success)
+    {
+        std::fprintf(stderr, "No .gltf found in %s\n", directory.c_str());
+        return uris;
+    }
+    for (size_t i = 0; i < data->buffers_count; i++)
+    {
+        if (data->buffers[i].uri && strncmp(data->buffers[i].uri, "data:", 5) != 0)
+        {
+            uris.push_back(data->buffers[i].uri);
+        }
+    }
+    for (size_t i = 0; i < data->images_count; i++)
+    {
+        if (data->images[i].uri && strncmp(data->images[i].uri, "data:", 5) != 0)
+        {
+            uris.push_back(data->images[i].uri);
+        }
+    }
+    cgltf_free(data);
+    return uris;
+}
+
+static ResourceBuffer readFile(const char *uri)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(gLatencyMs));
+    const auto path = gDirectory + "/" + uri;
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp)
+    {
+        return ResourceBuffer(nullptr, 0, -1);
+    }
+    fseek(fp, 0, SEEK_END);
+    const size_t size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    auto *data = malloc(size);
+    fread(data, 1, size, fp);
+    fclose(fp);
+    return ResourceBuffer(data, int32_t(size), 0);
+}
+
+// writes the result into [out] on another thread, setting the size last
+static void loadToOut(const char *uri, ResourceBuffer *out)
+{
+    std::string copy(uri);
+    std::thread([copy, out]()
+                {
+        auto rb = readFile(copy.c_str());
+        const_cast<const void *&>(out->data) = rb.data;
+        const_cast<int32_t &>(out->id) = rb.id;
+        std::atomic_thread_fence(std::memory_order_release);
+        *const_cast<volatile int32_t *>(&out->size) = rb.size; })
+        .detach();
+}
+
+static void loadWithCallback(const char *uri, OnFilamentResourceLoaded onLoaded, void *const userData, void *const)
+{
+    std::string copy(uri);
+    std::thread([copy, onLoaded, userData]()
+                { onLoaded(readFile(copy.c_str()), userData); })
+        .detach();
+}
+
+static void freeResource(ResourceBuffer rb)
+{
+    free(const_cast<void *>(rb.data));
+}
+
+// the polling loop ResourceLoaderWrapperImpl::load originally used
+static ResourceBuffer busyWait(const char *uri)
+{
+    ResourceBuffer rb(nullptr, 0, -1);
+    loadToOut(uri, &rb);
+    while (*static_cast<volatile const int32_t *>(&rb.size) == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return rb;
+}
+
+static uint64_t checksum(const ResourceBuffer &rb)
+{
+    uint64_t sum = 0;
+    auto *data = static_cast<const uint8_t *>(rb.data);
+    for (int32_t i = 0; i < rb.size; i++)
+    {
+        sum += data[i];
+    }
+    return sum;
+}
+
+template <typename Load>
+static void run(const char *name, const std::vector<std::string> &uris, Load load)
+{
+    const auto start = Clock::now();
+    auto [bytes, sum] = load();
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::printf("%-24s %10.1f %10.1f %12.1f   (checksum %llu)\n", name, ms, ms / uris.size(),
+                bytes / (1024.0 * 1024.0) / (ms / 1000.0), (unsigned long long)sum);
+}
+
+int main(int argc, char **argv)
+{
+    const int count = argc > 2 ? std::atoi(argv[2]) : 30;
+    const size_t size = (argc > 3 ? std::atoi(argv[3]) : 1024) * 1024;
+    gLatencyMs = argc > 4 ? std::atoi(argv[4]) : 0;
+    if (argc > 1 && strcmp(argv[1], "-") != 0)
+    {
+        gDirectory = argv[1];
+    }
+    else
+    {
+        gDirectory = (std::filesystem::temp_directory_path() / "thermion_resource_loader_benchmark").string();
+        generate(gDirectory, count, size);
+    }
+    gDirectory = std::filesystem::absolute(gDirectory).string();
+
+    const auto uris = resourceUris(gDirectory);
+    if (uris.empty())
+    {
+        return 1;
+    }
+    std::printf("%zu resources in %s (platform latency %d ms)\n\n", uris.size(), gDirectory.c_str(), gLatencyMs);
+    std::printf("%-24s %10s %10s %12s\n", "loader", "total(ms)", "each(ms)", "MB/s");
+
+    run("busy-wait (100 ms)", uris, [&]()
+        {
+        size_t bytes = 0;
+        uint64_t sum = 0;
+        for (const auto &uri : uris)
+        {
+            auto rb = busyWait(uri.c_str());
+            bytes += rb.size;
+            sum += checksum(rb);
+            freeResource(rb);
+        }
+        return std::make_pair(bytes, sum); });
+
+    ResourceLoaderWrapper polling = {nullptr, freeResource, nullptr, nullptr, nullptr, loadToOut, nullptr};
+    ResourceLoaderWrapperImpl pollingLoader(&polling);
+    run("loadToOut (backoff)", uris, [&]()
+        {
+        size_t bytes = 0;
+        uint64_t sum = 0;
+        for (const auto &uri : uris)
+        {
+            auto rb = pollingLoader.load(uri.c_str());
+            bytes += rb.size;
+            sum += checksum(rb);
+            pollingLoader.free(rb);
+        }
+        return std::make_pair(bytes, sum); });
+
+    ResourceLoaderWrapper callback = {nullptr, freeResource, nullptr, nullptr, nullptr, nullptr, loadWithCallback};
+    ResourceLoaderWrapperImpl callbackLoader(&callback);
+    run("loadWithCallback", uris, [&]()
+        {
+        std::vector<std::future<ResourceBuffer>> futures;
+        for (const auto &uri : uris)
+        {
+            futures.push_back(callbackLoader.loadAsync(uri.c_str()));
+        }
+        size_t bytes = 0;
+        uint64_t sum = 0;
+        for (auto &future : futures)
+        {
+            auto rb = future.get();
+            bytes += rb.size;
+            sum += checksum(rb);
+            callbackLoader.free(rb);
+        }
+        return std::make_pair(bytes, sum); });
+
+    run("mmap", uris, [&]()
+        {
+        std::vector<std::future<ResourceBuffer>> futures;
+        for (const auto &uri : uris)
+        {
+            futures.push_back(callbackLoader.loadAsync(("file://" + gDirectory + "/" + uri).c_str()));
+        }
+        size_t bytes = 0;
+        uint64_t sum = 0;
+        for (auto &future : futures)
+        {
+            auto rb = future.get();
+            bytes += rb.size;
+            sum += checksum(rb);
+            callbackLoader.free(rb);
+        }
+        return std::make_pair(bytes, sum); });
+
+    return 0;
+}
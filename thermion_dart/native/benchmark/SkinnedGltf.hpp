@@ -0,0 +1,171 @@
+#pragma once
+
+// Generates a small skinned + animated glTF (as a GLB) in memory, so the
+// animation benchmarks don't depend on any binary test assets.
+//
+// The asset is a column of [numJoints] boxes, each skinned to its own joint
+// in a parent/child chain, with a single looping animation that rotates
+// every joint.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace thermion::benchmark
+{
+
+    inline std::vector<uint8_t> createSkinnedGlb(int numJoints, int numKeyframes = 30, float durationInSecs = 1.0f)
+    {
+        std::vector<uint8_t> bin;
+        auto append = [&](const void *data, size_t size)
+        {
+            auto offset = bin.size();
+            bin.resize(offset + size);
+            std::memcpy(bin.data() + offset, data, size);
+            while (bin.size() % 4 != 0)
+            {
+                bin.push_back(0);
+            }
+            return offset;
+        };
+
+        std::vector<float> positions;
+        std::vector<uint16_t> joints;
+        std::vector<float> weights;
+        std::vector<uint16_t> indices;
+        static const int kBoxIndices[36] = {
+            0, 1, 2, 2, 1, 3, 4, 6, 5, 5, 6, 7, 0, 4, 1, 1, 4, 5,
+            2, 3, 6, 6, 3, 7, 0, 2, 4, 4, 2, 6, 1, 5, 3, 3, 5, 7};
+        for (int j = 0; j < numJoints; j++)
+        {
+            for (int v = 0; v < 8; v++)
+            {
+                positions.push_back((v & 1) ? 0.25f : -0.25f);
+                positions.push_back(float(j) + ((v & 2) ? 0.9f : 0.0f));
+                positions.push_back((v & 4) ? 0.25f : -0.25f);
+                joints.insert(joints.end(), {uint16_t(j), 0, 0, 0});
+                weights.insert(weights.end(), {1.0f, 0.0f, 0.0f, 0.0f});
+            }
+            for (int i : kBoxIndices)
+            {
+                indices.push_back(uint16_t(j * 8 + i));
+            }
+        }
+
+        // column-major inverse of a translation along +Y by j
+        std::vector<float> inverseBindMatrices;
+        for (int j = 0; j < numJoints; j++)
+        {
+            float m[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, -float(j), 0, 1};
+            inverseBindMatrices.insert(inverseBindMatrices.end(), m, m + 16);
+        }
+
+        std::vector<float> times;
+        for (int k = 0; k < numKeyframes; k++)
+        {
+            times.push_back(durationInSecs * k / (numKeyframes - 1));
+        }
+
+        std::vector<size_t> rotationOffsets;
+        std::vector<float> rotations(numKeyframes * 4);
+        auto positionOffset = append(positions.data(), positions.size() * sizeof(float));
+        auto jointsOffset = append(joints.data(), joints.size() * sizeof(uint16_t));
+        auto weightsOffset = append(weights.data(), weights.size() * sizeof(float));
+        auto indicesOffset = append(indices.data(), indices.size() * sizeof(uint16_t));
+        auto ibmOffset = append(inverseBindMatrices.data(), inverseBindMatrices.size() * sizeof(float));
+        auto timesOffset = append(times.data(), times.size() * sizeof(float));
+        for (int j = 0; j < numJoints; j++)
+        {
+            for (int k = 0; k < numKeyframes; k++)
+            {
+                // a quaternion rotating about Z (with a phase offset per joint)
+                float angle = 0.3f * std::sin(6.2831853f * (float(k) / (numKeyframes - 1) + float(j) / numJoints));
+                rotations[k * 4 + 0] = 0.0f;
+                rotations[k * 4 + 1] = 0.0f;
+                rotations[k * 4 + 2] = std::sin(angle / 2);
+                rotations[k * 4 + 3] = std::cos(angle / 2);
+            }
+            rotationOffsets.push_back(append(rotations.data(), rotations.size() * sizeof(float)));
+        }
+
+        const int numVertices = numJoints * 8;
+        std::string bufferViews;
+        std::string accessors;
+        int numBufferViews = 0;
+        auto addAccessor = [&](size_t offset, size_t length, int componentType, int count, const char *type, const std::string &extra = "")
+        {
+            bufferViews += (numBufferViews ? "," : "") + std::string("{\"buffer\":0,\"byteOffset\":") + std::to_string(offset) + ",\"byteLength\":" + std::to_string(length) + "}";
+            accessors += (numBufferViews ? "," : "") + std::string("{\"bufferView\":") + std::to_string(numBufferViews) + ",\"componentType\":" + std::to_string(componentType) + ",\"count\":" + std::to_string(count) + ",\"type\":\"" + type + "\"" + extra + "}";
+            return numBufferViews++;
+        };
+
+        std::string halfHeight = std::to_string(float(numJoints) - 0.1f);
+        auto positionAccessor = addAccessor(positionOffset, positions.size() * sizeof(float), 5126, numVertices, "VEC3",
+                                            ",\"min\":[-0.25,0,-0.25],\"max\":[0.25," + halfHeight + ",0.25]");
+        auto jointsAccessor = addAccessor(jointsOffset, joints.size() * sizeof(uint16_t), 5123, numVertices, "VEC4");
+        auto weightsAccessor = addAccessor(weightsOffset, weights.size() * sizeof(float), 5126, numVertices, "VEC4");
+        auto indicesAccessor = addAccessor(indicesOffset, indices.size() * sizeof(uint16_t), 5123, int(indices.size()), "SCALAR");
+        auto ibmAccessor = addAccessor(ibmOffset, inverseBindMatrices.size() * sizeof(float), 5126, numJoints, "MAT4");
+        auto timesAccessor = addAccessor(timesOffset, times.size() * sizeof(float), 5126, numKeyframes, "SCALAR",
+                                         ",\"min\":[0],\"max\":[" + std::to_string(durationInSecs) + "]");
+
+        std::string nodes = "{\"mesh\":0,\"skin\":0}";
+        std::string jointList;
+        std::string samplers;
+        std::string channels;
+        for (int j = 0; j < numJoints; j++)
+        {
+            int node = j + 1;
+            nodes += ",{";
+            if (j > 0)
+            {
+                nodes += "\"translation\":[0,1,0]";
+            }
+            if (j < numJoints - 1)
+            {
+                nodes += std::string(j > 0 ? "," : "") + "\"children\":[" + std::to_string(node + 1) + "]";
+            }
+            nodes += "}";
+            jointList += (j ? "," : "") + std::to_string(node);
+            auto outputAccessor = addAccessor(rotationOffsets[j], rotations.size() * sizeof(float), 5126, numKeyframes, "VEC4");
+            samplers += (j ? "," : "") + std::string("{\"input\":") + std::to_string(timesAccessor) + ",\"output\":" + std::to_string(outputAccessor) + "}";
+            channels += (j ? "," : "") + std::string("{\"sampler\":") + std::to_string(j) + ",\"target\":{\"node\":" + std::to_string(node) + ",\"path\":\"rotation\"}}";
+        }
+
+        std::string json = "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0,1]}],"
+                           "\"nodes\":[" + nodes + "],"
+                           "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":" + std::to_string(positionAccessor) +
+                           ",\"JOINTS_0\":" + std::to_string(jointsAccessor) +
+                           ",\"WEIGHTS_0\":" + std::to_string(weightsAccessor) + "},\"indices\":" + std::to_string(indicesAccessor) + "}]}],"
+                           "\"skins\":[{\"inverseBindMatrices\":" + std::to_string(ibmAccessor) + ",\"joints\":[" + jointList + "]}],"
+                           "\"animations\":[{\"samplers\":[" + samplers + "],\"channels\":[" + channels + "]}],"
+                           "\"buffers\":[{\"byteLength\":" + std::to_string(bin.size()) + "}],"
+                           "\"bufferViews\":[" + bufferViews + "],"
+                           "\"accessors\":[" + accessors + "]}";
+        while (json.size() % 4 != 0)
+        {
+            json += ' ';
+        }
+
+        std::vector<uint8_t> glb;
+        auto appendU32 = [&](uint32_t v)
+        {
+            uint8_t bytes[4];
+            std::memcpy(bytes, &v, 4);
+            glb.insert(glb.end(), bytes, bytes + 4);
+        };
+        appendU32(0x46546C67); // "glTF"
+        appendU32(2);
+        appendU32(uint32_t(12 + 8 + json.size() + 8 + bin.size()));
+        appendU32(uint32_t(json.size()));
+        appendU32(0x4E4F534A); // "JSON"
+        glb.insert(glb.end(), json.begin(), json.end());
+        appendU32(uint32_t(bin.size()));
+        appendU32(0x004E4942); // "BIN\0"
+        glb.insert(glb.end(), bin.begin(), bin.end());
+        return glb;
+    }
+
+} // namespace thermion::benchmark
@@ -0,0 +1,179 @@
+// Measures the latency of enqueueing a task onto the render thread queue
+// with 1, 4 and 16 producer threads, comparing the lock-free TaskQueue
+// against the previous mutex + std::deque<std::function> implementation.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rendering/TaskQueue.hpp"
+
+using namespace thermion;
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kTasksPerProducer = 200000;
+
+// the previous RenderThread::add_task implementation
+class MutexQueue {
+public:
+    template <class F>
+    void push(F &&fn) {
+        std::packaged_task<void()> pt(std::forward<F>(fn));
+        std::unique_lock<std::mutex> lock(mMutex);
+        mTasks.push_back([pt = std::make_shared<std::packaged_task<void()>>(std::move(pt))]
+                         { (*pt)(); });
+    }
+
+    size_t drain() {
+        std::deque<std::function<void()>> tasks;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            tasks.swap(mTasks);
+        }
+        for (auto &task : tasks) {
+            task();
+        }
+        return tasks.size();
+    }
+
+private:
+    std::mutex mMutex;
+    std::deque<std::function<void()>> mTasks;
+};
+
+class LockFreeQueue {
+public:
+    template <class F>
+    void push(F &&fn) {
+        Task task(std::forward<F>(fn));
+        while (!mQueue.push(task)) {
+            std::this_thread::yield();
+        }
+    }
+
+    size_t drain() {
+        size_t numExecuted = 0;
+        Task task;
+        while (mQueue.pop(task)) {
+            task();
+            numExecuted++;
+        }
+        return numExecuted;
+    }
+
+private:
+    TaskQueue mQueue{4096};
+};
+
+struct Result {
+    double meanNs;
+    double p50Ns;
+    double p99Ns;
+    double maxNs;
+    double throughputMops;
+};
+
+template <class Queue>
+static Result run(int numProducers) {
+    Queue queue;
+    std::atomic<uint64_t> sum = 0;
+    std::atomic<bool> producersDone = false;
+    std::atomic<int> ready = 0;
+    std::atomic<bool> go = false;
+    std::vector<std::vector<uint32_t>> latencies(numProducers);
+
+    std::thread consumer([&]() {
+        size_t executed = 0;
+        const size_t expected = size_t(numProducers) * kTasksPerProducer;
+        while (executed < expected) {
+            auto numExecuted = queue.drain();
+            executed += numExecuted;
+            if (numExecuted == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; p++) {
+        producers.emplace_back([&, p]() {
+            auto &samples = latencies[p];
+            samples.reserve(kTasksPerProducer);
+            // a capture roughly the size of a typical *RenderThread call
+            // (a handful of pointers/ints plus a callback)
+            void *a = &sum;
+            void *b = &queue;
+            uint32_t requestId = p;
+            ready++;
+            while (!go) {
+            }
+            for (int i = 0; i < kTasksPerProducer; i++) {
+                auto start = Clock::now();
+                queue.push([&sum, a, b, requestId, i]() {
+                    sum.fetch_add(uint64_t(i) + (a == b ? requestId : 0), std::memory_order_relaxed);
+                });
+                auto end = Clock::now();
+                samples.push_back(uint32_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            }
+        });
+    }
+
+    while (ready < numProducers) {
+    }
+    auto start = Clock::now();
+    go = true;
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    const uint64_t expectedSum = uint64_t(numProducers) * (uint64_t(kTasksPerProducer) * (kTasksPerProducer - 1) / 2);
+    if (sum != expectedSum) {
+        std::fprintf(stderr, "Task sum mismatch: expected %llu, got %llu\n",
+                     (unsigned long long)expectedSum, (unsigned long long)sum.load());
+        std::exit(1);
+    }
+
+    std::vector<uint32_t> all;
+    all.reserve(size_t(numProducers) * kTasksPerProducer);
+    for (auto &samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+    double total = 0;
+    for (auto v : all) {
+        total += v;
+    }
+
+    Result result;
+    result.meanNs = total / all.size();
+    result.p50Ns = all[all.size() / 2];
+    result.p99Ns = all[size_t(all.size() * 0.99)];
+    result.maxNs = all.back();
+    result.throughputMops = all.size() / elapsed / 1e6;
+    return result;
+}
+
+static void print(const char *name, int numProducers, const Result &result) {
+    std::printf("%-10s %9d %10.1f %10.1f %10.1f %12.1f %12.2f\n", name, numProducers,
+                result.meanNs, result.p50Ns, result.p99Ns, result.maxNs, result.throughputMops);
+}
+
+int main() {
+    std::printf("sizeof(Task) = %zu bytes (%zu bytes inline storage)\n\n", sizeof(Task), Task::kInlineSize);
+    std::printf("%-10s %9s %10s %10s %10s %12s %12s\n", "queue", "producers", "mean (ns)", "p50 (ns)", "p99 (ns)", "max (ns)", "Mtasks/s");
+    for (int numProducers : {1, 4, 16}) {
+        print("mutex", numProducers, run<MutexQueue>(numProducers));
+        print("lock-free", numProducers, run<LockFreeQueue>(numProducers));
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace thermion
+{
+
+    ///
+    /// A read-only view of a local file, memory-mapped where the platform
+    /// supports it (so the file's contents are paged in on first access
+    /// rather than copied), or otherwise read into a heap allocation.
+    ///
+    class MappedFile
+    {
+    public:
+        /// @brief Opens [path] (which may be prefixed with file://). Returns null
+        /// if the file does not exist or cannot be read.
+        static std::unique_ptr<MappedFile> open(const char *path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const uint8_t *data() const { return mData; }
+
+        size_t size() const { return mSize; }
+
+        /// @brief Whether the contents are memory-mapped (rather than copied).
+        bool isMapped() const { return mMapped; }
+
+        /// @brief Asks the OS to start paging in the contents in the background.
+        void prefetch() const;
+
+    private:
+        MappedFile() = default;
+
+        uint8_t *mData = nullptr;
+        size_t mSize = 0;
+        bool mMapped = false;
+#ifdef _WIN32
+        void *mFile = nullptr;
+        void *mMapping = nullptr;
+#endif
+    };
+
+} // namespace thermion
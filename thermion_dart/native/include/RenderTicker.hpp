@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <mutex>
 #include <vector>
 #include <utility> 
@@ -21,7 +23,12 @@
 #include <filament/VertexBuffer.h>
 
 #include "scene/AnimationManager.hpp"
+#include "components/CollisionComponentManager.hpp"
+#include "components/LodComponentManager.hpp"
 #include "components/OverlayComponentManager.hpp"
+#include "rendering/FrameScheduler.hpp"
+#include "rendering/FrameStats.hpp"
+#include "scene/GltfImporter.hpp"
 
 namespace thermion
 {
@@ -39,8 +46,10 @@ namespace thermion
             filament::Renderer *renderer) : mEngine(engine), mRenderer(renderer) { }
         ~RenderTicker();
         
-        /// @brief 
-        /// @param frameTimeInNanos 
+        /// @brief Updates animations/levels of detail and renders all renderable swapchains/views. 
+        /// @param frameTimeInNanos the frame time (steady_clock nanoseconds) to pass to beginFrame,
+        /// or 0 to use the time determined by the frame scheduler.
+        /// @return false if nothing was rendered (no renderable swapchains, or beginFrame skipped the frame).
         bool render(
             uint64_t frameTimeInNanos
         );
@@ -57,6 +66,19 @@ namespace thermion
         /// @param numViews 
         void removeSwapChain(filament::SwapChain *swapChain);
 
+        /// @brief Returns true if at least one swapchain is renderable. Safe to call from any thread.
+        bool hasRenderable() const {
+            return mNumRenderable > 0;
+        }
+
+        /// @brief Sets a callback invoked (on the calling thread, after the change
+        /// has been applied) whenever a swapchain is made renderable, so a frame
+        /// request that was waiting for something to render into can proceed.
+        void setOnRenderableAdded(std::function<void()> onRenderableAdded) {
+            std::lock_guard lock(mMutex);
+            mOnRenderableAdded = std::move(onRenderableAdded);
+        }
+
         /// @brief 
         /// @param animationManager 
         void addAnimationManager(AnimationManager* animationManager);
@@ -71,13 +93,50 @@ namespace thermion
             mOverlayComponentManager = overlayComponentManager;
         }
 
+        /// @brief Sets the LOD manager updated before each frame is rendered (or null to disable).
+        void setLodManager(LodComponentManager *lodComponentManager) {
+            std::lock_guard lock(mMutex);
+            mLodComponentManager = lodComponentManager;
+        }
+
+        /// @brief Sets the collision manager whose dirty colliders are refit once before each
+        /// frame is rendered (or null to disable).
+        void setCollisionManager(CollisionComponentManager *collisionComponentManager) {
+            std::lock_guard lock(mMutex);
+            mCollisionComponentManager = collisionComponentManager;
+        }
+
+        /// @brief Sets the glTF importer updated before each frame is rendered (or null to disable).
+        void setGltfImporter(GltfImporter *gltfImporter) {
+            std::lock_guard lock(mMutex);
+            mGltfImporter = gltfImporter;
+        }
+
+        /// @brief Returns the frame scheduler that determines when frames are
+        /// rendered and which frame times are passed to beginFrame.
+        FrameScheduler &getFrameScheduler() {
+            return mFrameScheduler;
+        }
+
+        /// @brief Returns the CPU timings for the most recently rendered frames.
+        FrameStats &getFrameStats() {
+            return mFrameStats;
+        }
+
     private:
+        FrameScheduler mFrameScheduler;
+        FrameStats mFrameStats;
         std::mutex mMutex;
         filament::Engine *mEngine = std::nullptr_t();
         filament::Renderer *mRenderer = std::nullptr_t();
         std::vector<AnimationManager*> mAnimationManagers;
         OverlayComponentManager *mOverlayComponentManager = std::nullptr_t();
+        LodComponentManager *mLodComponentManager = std::nullptr_t();
+        CollisionComponentManager *mCollisionComponentManager = std::nullptr_t();
+        GltfImporter *mGltfImporter = std::nullptr_t();
         std::vector<ViewAttachment> mRenderable;
+        std::atomic<size_t> mNumRenderable = 0;
+        std::function<void()> mOnRenderableAdded;
         std::chrono::high_resolution_clock::time_point mLastRender;
 
     };
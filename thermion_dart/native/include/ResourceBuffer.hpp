@@ -3,6 +3,14 @@
 
 #include "ResourceBuffer.h"
 
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "MappedFile.hpp"
+
 #ifndef __EMSCRIPTEN__
 #include <thread>
 using namespace std::chrono_literals;
@@ -11,6 +19,15 @@ using namespace std::chrono_literals;
 namespace thermion
 {
 
+  //
+  // Loads resources with the platform's callbacks.
+  //
+  // Local files (absolute paths or file:// URIs) are memory-mapped rather
+  // than read, so their contents are never copied. Other URIs are passed to
+  // loadWithCallback where the platform provides it, which allows any number
+  // of fetches to be in flight at once; each future completes as soon as the
+  // platform calls back.
+  //
   struct ResourceLoaderWrapperImpl : public ResourceLoaderWrapper
   {
 
@@ -21,6 +38,7 @@ namespace thermion
       freeResource = wrapper->freeResource;
       owner = wrapper->owner;
       loadToOut = wrapper->loadToOut;
+      loadWithCallback = wrapper->loadWithCallback;
     }
 
     ResourceLoaderWrapperImpl(LoadFilamentResource loader, FreeFilamentResource freeResource)
@@ -28,45 +46,114 @@ namespace thermion
       loadFromOwner = nullptr;
       freeFromOwner = nullptr;
       loadResource = loader;
-      freeResource = freeResource;
+      this->freeResource = freeResource;
       owner = nullptr;
+      loadToOut = nullptr;
+      loadWithCallback = nullptr;
     }
 
     ResourceLoaderWrapperImpl(LoadFilamentResourceFromOwner loader, FreeFilamentResourceFromOwner freeResource, void *owner)
     {
       loadResource = nullptr;
-      freeResource = nullptr;
+      this->freeResource = nullptr;
       loadFromOwner = loader;
       freeFromOwner = freeResource;
-      owner = owner;
+      this->owner = owner;
+      loadToOut = nullptr;
+      loadWithCallback = nullptr;
     }
 
-    ResourceBuffer load(const char *uri) const
+    static bool isLocalFile(const char *uri)
+    {
+      return strncmp(uri, "file://", 7) == 0 || uri[0] == '/' ||
+             (uri[0] != '\0' && uri[1] == ':' && (uri[2] == '\\' || uri[2] == '/'));
+    }
+
+    //
+    // Starts loading [uri]. The returned future completes once the data is
+    // available; pass the result to free() once it is no longer needed.
+    //
+    std::future<ResourceBuffer> loadAsync(const char *uri) const
     {
+      if (isLocalFile(uri))
+      {
+        auto file = MappedFile::open(uri);
+        if (file && file->size() == 0)
+        {
+          // empty files have no mapping (so no key in mMappedFiles)
+          return ready(ResourceBuffer(nullptr, 0, -1));
+        }
+        if (file)
+        {
+          ResourceBuffer rb(const_cast<uint8_t *>(file->data()), static_cast<int32_t>(file->size()), -1);
+          {
+            std::lock_guard lock(mMutex);
+            mMappedFiles[file->data()] = std::move(file);
+          }
+          return ready(rb);
+        }
+      }
+
+      if (loadWithCallback)
+      {
+        auto *promise = new std::promise<ResourceBuffer>();
+        auto future = promise->get_future();
+        loadWithCallback(uri, [](ResourceBuffer rb, void *const userData)
+                                         {
+          auto *promise = static_cast<std::promise<ResourceBuffer> *>(userData);
+          promise->set_value(rb);
+          delete promise; }, promise, owner);
+        return future;
+      }
+
       if (loadToOut)
       {
+        // loadToOut provides no completion signal, so [rb] is polled until
+        // the platform fills it in (starting with short intervals, so a
+        // fast load isn't delayed by a long sleep)
         ResourceBuffer rb(nullptr, 0, -1);
         loadToOut(uri, &rb);
-        while (rb.size == 0)
+#ifndef __EMSCRIPTEN__
+        auto interval = 50us;
+#endif
+        while (*static_cast<volatile const int32_t *>(&rb.size) == 0)
         {
-          #if! __EMSCRIPTEN__
-          std::this_thread::sleep_for(100ms);
-          #endif
+#ifndef __EMSCRIPTEN__
+          std::this_thread::sleep_for(interval);
+          interval = std::min<std::chrono::microseconds>(interval * 2, 10ms);
+#endif
         }
-
-        return rb;
+        return ready(rb);
       }
-      else if (loadFromOwner)
+
+      if (loadFromOwner)
       {
-        auto rb = loadFromOwner(uri, owner);
-        return rb;
+        return ready(loadFromOwner(uri, owner));
       }
-      auto rb = loadResource(uri);
-      return rb;
+      return ready(loadResource(uri));
+    }
+
+    ResourceBuffer load(const char *uri) const
+    {
+      return loadAsync(uri).get();
     }
 
     void free(ResourceBuffer rb) const
     {
+      if (!rb.data && rb.id == -1)
+      {
+        // an empty local file (see loadAsync)
+        return;
+      }
+      {
+        std::lock_guard lock(mMutex);
+        auto it = mMappedFiles.find(rb.data);
+        if (it != mMappedFiles.end())
+        {
+          mMappedFiles.erase(it);
+          return;
+        }
+      }
       if (freeFromOwner)
       {
         freeFromOwner(rb, owner);
@@ -76,8 +163,18 @@ namespace thermion
         freeResource(rb);
       }
     }
+
+  private:
+    static std::future<ResourceBuffer> ready(ResourceBuffer rb)
+    {
+      std::promise<ResourceBuffer> promise;
+      promise.set_value(rb);
+      return promise.get_future();
+    }
+
+    mutable std::mutex mMutex;
+    mutable std::unordered_map<const void *, std::unique_ptr<MappedFile>> mMappedFiles;
   };
 
 }
 #endif
-
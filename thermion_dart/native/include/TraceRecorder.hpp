@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace thermion
+{
+
+    /**
+     * @brief Records scoped spans into per-thread ring buffers and writes them
+     * out as Chrome trace-event JSON (viewable in chrome://tracing or Perfetto).
+     *
+     * Unlike TRACE, this is always compiled in but disabled by default. When
+     * disabled, a span costs a single relaxed atomic load; when enabled, it
+     * costs two clock reads and a write to a thread-local buffer (no locks or
+     * allocations after a thread's first span).
+     *
+     * Span names must be string literals (or otherwise outlive the recorder),
+     * since only the pointer is stored.
+     */
+    class TraceRecorder
+    {
+    public:
+        /// the number of spans retained per thread (older spans are overwritten)
+        static constexpr uint32_t kEventsPerThread = 16384;
+
+        static void setEnabled(bool enabled)
+        {
+            sEnabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        static bool isEnabled()
+        {
+            return sEnabled.load(std::memory_order_relaxed);
+        }
+
+        static uint64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        /// Sets the name shown for the calling thread in the trace viewer.
+        static void setThreadName(const char *name);
+
+        static void record(const char *name, uint64_t startInNanos, uint64_t endInNanos);
+
+        /// Discards all recorded spans.
+        static void clear();
+
+        /// Returns all recorded spans as Chrome trace-event JSON.
+        static std::string toJson();
+
+        /// Writes the output of toJson() to [path]; returns false if the file
+        /// could not be written.
+        static bool dump(const char *path);
+
+    private:
+        struct Event
+        {
+            const char *name;
+            uint64_t startInNanos;
+            uint64_t endInNanos;
+        };
+
+        // written only by the owning thread; read (without locking) by toJson
+        struct ThreadBuffer
+        {
+            uint32_t threadId = 0;
+            std::string threadName;
+            // allocated by the first span recorded on this thread, so threads
+            // that only set their name (or never trace) don't pay for the ring;
+            // only read once numEvents (stored after allocating) is non-zero
+            std::unique_ptr<Event[]> events;
+            std::atomic<uint64_t> numEvents = 0;
+            // events with an index below this are ignored (see clear())
+            std::atomic<uint64_t> firstEvent = 0;
+        };
+
+        static ThreadBuffer &getThreadBuffer();
+
+        static std::atomic<bool> sEnabled;
+        static std::mutex sMutex;
+        // buffers are never freed, so spans from threads that have
+        // since exited are still included in the output
+        static std::vector<std::shared_ptr<ThreadBuffer>> sBuffers;
+    };
+
+    /**
+     * @brief Records a span covering the lifetime of this object (if tracing is enabled).
+     */
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char *name) : mName(name)
+        {
+            if (TraceRecorder::isEnabled())
+            {
+                mStart = TraceRecorder::now();
+            }
+        }
+
+        ~TraceScope()
+        {
+            if (mStart != 0)
+            {
+                TraceRecorder::record(mName, mStart, TraceRecorder::now());
+            }
+        }
+
+        TraceScope(const TraceScope &) = delete;
+        TraceScope &operator=(const TraceScope &) = delete;
+
+    private:
+        const char *mName;
+        uint64_t mStart = 0;
+    };
+
+} // namespace thermion
+
+#define THERMION_TRACE_CONCAT_INNER(a, b) a##b
+#define THERMION_TRACE_CONCAT(a, b) THERMION_TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) thermion::TraceScope THERMION_TRACE_CONCAT(__traceScope, __LINE__)(name)
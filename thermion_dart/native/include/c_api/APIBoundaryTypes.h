@@ -48,6 +48,10 @@ extern "C"
 	typedef struct TColorGrading TColorGrading;
 	typedef struct TKtx1Bundle TKtx1Bundle;
 	typedef struct TOverlayManager TOverlayManager;
+	typedef struct TLodManager TLodManager;
+	typedef struct TGltfImporter TGltfImporter;
+	typedef struct TGltfAssetCache TGltfAssetCache;
+	typedef struct TRayPicker TRayPicker;
 	
 	typedef struct { 
 		double x;
@@ -11,6 +11,12 @@ extern "C"
 	EMSCRIPTEN_KEEPALIVE TAnimationManager *AnimationManager_create(TEngine *tEngine, TScene *tScene);
 	
 	EMSCRIPTEN_KEEPALIVE void AnimationManager_update(TAnimationManager *tAnimationManager, uint64_t frameTimeInNanos);
+	/// Enables/disables updating animation components in parallel on the engine's JobSystem (enabled by default).
+	EMSCRIPTEN_KEEPALIVE void AnimationManager_setParallelUpdate(TAnimationManager *tAnimationManager, bool parallelUpdate);
+	/// Advances the animation clock by exactly [stepInNanos] on every update (0 to return to real time).
+	EMSCRIPTEN_KEEPALIVE void AnimationManager_setFixedTimeStep(TAnimationManager *tAnimationManager, uint64_t stepInNanos);
+	/// Returns the current animation clock time (in nanoseconds).
+	EMSCRIPTEN_KEEPALIVE uint64_t AnimationManager_getTime(TAnimationManager *tAnimationManager);
 
 	EMSCRIPTEN_KEEPALIVE bool AnimationManager_addGltfAnimationComponent(TAnimationManager *tAnimationManager, TSceneAsset *tSceneAsset);
 	EMSCRIPTEN_KEEPALIVE bool AnimationManager_removeGltfAnimationComponent(TAnimationManager *tAnimationManager, TSceneAsset *tSceneAsset);
@@ -128,6 +134,12 @@ extern "C"
 		const float *const morphData,
 		int numWeights);
 
+	EMSCRIPTEN_KEEPALIVE int AnimationManager_getMorphTargetWeights(
+		TAnimationManager *tAnimationManager,
+		EntityId entityId,
+		float *out,
+		int maxWeights);
+
 	EMSCRIPTEN_KEEPALIVE bool AnimationManager_setGltfAnimationFrame(
 		TAnimationManager *tAnimationManager,
 		TSceneAsset *tSceneAsset,
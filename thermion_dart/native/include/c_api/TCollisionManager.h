@@ -0,0 +1,61 @@
+#pragma once
+
+#include "APIExport.h"
+#include "APIBoundaryTypes.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Creates a manager that detects collisions between the world-space bounding
+/// boxes of its components (see CollisionComponentManager).
+EMSCRIPTEN_KEEPALIVE TCollisionComponentManager *CollisionManager_create(
+    TTransformManager *tTransformManager
+);
+
+EMSCRIPTEN_KEEPALIVE void CollisionManager_destroy(
+    TCollisionComponentManager *tCollisionManager
+);
+
+/// Adds a collider for [entityId] with the given (local-space) bounding box.
+/// [callback] (which may be null) is invoked when another entity collides with this one.
+EMSCRIPTEN_KEEPALIVE void CollisionManager_addComponent(
+    TCollisionComponentManager *tCollisionManager,
+    EntityId entityId,
+    Aabb3 boundingBox,
+    void (*callback)(EntityId entityId1, EntityId entityId2),
+    bool affectsTransform
+);
+
+EMSCRIPTEN_KEEPALIVE void CollisionManager_removeComponent(
+    TCollisionComponentManager *tCollisionManager,
+    EntityId entityId
+);
+
+/// Marks [entityId] as moved, so the colliders of the entity and its descendants
+/// are refit by the next CollisionManager_update (which the render ticker calls
+/// once per frame, see RenderTicker_setCollisionManager).
+EMSCRIPTEN_KEEPALIVE void CollisionManager_markDirty(
+    TCollisionComponentManager *tCollisionManager,
+    EntityId entityId
+);
+
+/// Refits the colliders marked dirty since the last update.
+EMSCRIPTEN_KEEPALIVE void CollisionManager_update(
+    TCollisionComponentManager *tCollisionManager
+);
+
+/// Writes every pair of colliders whose world-space boxes overlap (as of the last
+/// update) to [outPairs]
+/// (two entities per pair, up to [maxPairs] pairs). Returns the total number of pairs,
+/// which may be greater than [maxPairs].
+EMSCRIPTEN_KEEPALIVE uint32_t CollisionManager_collideAll(
+    TCollisionComponentManager *tCollisionManager,
+    EntityId *outPairs,
+    uint32_t maxPairs
+);
+
+#ifdef __cplusplus
+}
+#endif
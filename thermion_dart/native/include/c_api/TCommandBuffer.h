@@ -0,0 +1,79 @@
+#pragma once
+
+#include "APIExport.h"
+#include "APIBoundaryTypes.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	// A command buffer is a flat, caller-owned byte stream of commands.
+	// Every command starts with a TCommandHeader; [size] is the total size
+	// of the command in bytes (including the header and any trailing data)
+	// and must be a multiple of 8 so that the next command is aligned.
+	enum TCommandOpcode {
+		COMMAND_TRANSFORM_SET_TRANSFORM = 1,
+		COMMAND_TRANSFORM_SET_PARENT = 2,
+		COMMAND_SCENE_ADD_ENTITY = 3,
+		COMMAND_SCENE_REMOVE_ENTITY = 4,
+		COMMAND_MATERIAL_INSTANCE_SET_PARAMETER_FLOAT = 5,
+		COMMAND_RENDERABLE_SET_PRIORITY = 6
+	};
+	typedef enum TCommandOpcode TCommandOpcode;
+
+	typedef struct {
+		uint32_t opcode;
+		uint32_t size;
+	} TCommandHeader;
+
+	typedef struct {
+		TCommandHeader header;
+		TTransformManager *tTransformManager;
+		EntityId entityId;
+		uint32_t padding;
+		double4x4 transform;
+	} TSetTransformCommand;
+
+	typedef struct {
+		TCommandHeader header;
+		TTransformManager *tTransformManager;
+		EntityId child;
+		EntityId parent;
+		uint32_t preserveScaling;
+		uint32_t padding;
+	} TSetParentCommand;
+
+	typedef struct {
+		TCommandHeader header;
+		TScene *tScene;
+		EntityId entityId;
+		uint32_t padding;
+	} TSceneEntityCommand;
+
+	// Sets a float, float2, float3 or float4 parameter (depending on
+	// [numComponents]). The null-terminated parameter name immediately
+	// follows this struct and is included in header.size.
+	typedef struct {
+		TCommandHeader header;
+		TMaterialInstance *tMaterialInstance;
+		double value[4];
+		uint32_t numComponents;
+		uint32_t nameLength;
+	} TSetMaterialParameterFloatCommand;
+
+	typedef struct {
+		TCommandHeader header;
+		TRenderableManager *tRenderableManager;
+		EntityId entityId;
+		uint32_t priority;
+	} TSetPriorityCommand;
+
+	/// Replays every command in [commands] on the calling thread (normally
+	/// the render thread). Returns the number of commands executed; replay
+	/// stops at the first malformed or unknown command.
+	EMSCRIPTEN_KEEPALIVE uint32_t CommandBuffer_execute(const uint8_t *const commands, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "APIExport.h"
+#include "APIBoundaryTypes.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// See GltfAssetCache::Stats.
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint32_t entryCount;
+    uint32_t instancesInUse;
+    uint64_t sizeInBytes;
+    uint64_t budgetInBytes;
+} TGltfAssetCacheStats;
+
+/// Creates a cache of glTF assets keyed by content (see GltfAssetCache).
+/// Assets that aren't in use are evicted once the total size of all cached
+/// assets exceeds [budgetInBytes].
+EMSCRIPTEN_KEEPALIVE TGltfAssetCache *GltfAssetCache_create(
+    uint64_t budgetInBytes
+);
+
+/// Destroys the cache and every asset it owns (including any instances still in use).
+EMSCRIPTEN_KEEPALIVE void GltfAssetCache_destroy(
+    TGltfAssetCache *tGltfAssetCache
+);
+
+/// The key for the glTF/GLB in [data], whose resources are loaded relative
+/// to [resourceUri] (which may be null). This can be called from any thread.
+EMSCRIPTEN_KEEPALIVE uint64_t GltfAssetCache_computeKey(
+    const uint8_t *data,
+    size_t length,
+    const char *resourceUri
+);
+
+/// The key for the glTF/GLB file at [path] (see GltfAssetCache_computeKey),
+/// or 0 if the file can't be read. Unchanged files are only hashed once.
+/// If [outLength] is not null, it is set to the size of the file.
+/// This can be called from any thread.
+EMSCRIPTEN_KEEPALIVE uint64_t GltfAssetCache_computeFileKey(
+    TGltfAssetCache *tGltfAssetCache,
+    const char *path,
+    const char *resourceUri,
+    uint64_t *outLength
+);
+
+/// Returns an instance of the asset cached under [key], or null if there is none.
+/// Pass the instance to GltfAssetCache_release (rather than SceneAsset_destroy) once it is no longer needed.
+EMSCRIPTEN_KEEPALIVE TSceneAsset *GltfAssetCache_acquire(
+    TGltfAssetCache *tGltfAssetCache,
+    uint64_t key,
+    TMaterialInstance **tMaterialInstances,
+    int materialInstanceCount
+);
+
+/// Transfers ownership of [tSceneAsset] (a glTF asset, which must not be an instance) to the cache,
+/// returning its first instance (or null if the asset could not be cached, in which case
+/// ownership is not transferred).
+EMSCRIPTEN_KEEPALIVE TSceneAsset *GltfAssetCache_insert(
+    TGltfAssetCache *tGltfAssetCache,
+    uint64_t key,
+    TSceneAsset *tSceneAsset,
+    uint64_t sizeInBytes
+);
+
+/// Returns an instance handed out by GltfAssetCache_acquire/GltfAssetCache_insert.
+/// Returns false if [tSceneAsset] is not owned by the cache.
+EMSCRIPTEN_KEEPALIVE bool GltfAssetCache_release(
+    TGltfAssetCache *tGltfAssetCache,
+    TSceneAsset *tSceneAsset
+);
+
+EMSCRIPTEN_KEEPALIVE void GltfAssetCache_setBudget(
+    TGltfAssetCache *tGltfAssetCache,
+    uint64_t budgetInBytes
+);
+
+/// This can be called from any thread.
+EMSCRIPTEN_KEEPALIVE void GltfAssetCache_getStats(
+    TGltfAssetCache *tGltfAssetCache,
+    TGltfAssetCacheStats *out
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -17,6 +17,15 @@ EMSCRIPTEN_KEEPALIVE TFilamentAsset *GltfAssetLoader_load(
     size_t length,
     uint8_t numInstances
 );
+/// Memory-maps the GLB/glTF file at [path] (rather than requiring its contents to be read
+/// into memory by the caller) and creates an asset from the mapping. The mapping is released
+/// before returning. Resource URIs are relative to the directory containing [path].
+EMSCRIPTEN_KEEPALIVE TFilamentAsset *GltfAssetLoader_loadFile(
+    TEngine *tEngine,
+    TGltfAssetLoader *tAssetLoader,
+    const char *path,
+    uint8_t numInstances
+);
 EMSCRIPTEN_KEEPALIVE TMaterialInstance *GltfAssetLoader_getMaterialInstance(TRenderableManager *tRenderableManager, TFilamentAsset *tAsset);
 EMSCRIPTEN_KEEPALIVE TMaterialProvider *GltfAssetLoader_getMaterialProvider(TGltfAssetLoader *tAssetLoader);
 
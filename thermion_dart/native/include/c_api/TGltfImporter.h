@@ -0,0 +1,54 @@
+#pragma once
+
+#include "APIExport.h"
+#include "APIBoundaryTypes.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Creates an importer that uploads the resources of glTF assets over several
+/// frames. Once [budgetInNanos] has been spent in a frame, the remaining imports
+/// wait for the next frame; a single import's upload isn't split, so this bounds
+/// how many imports are serviced per frame rather than the frame time itself
+/// (see GltfImporter). Attach it to a render ticker with RenderTicker_setGltfImporter.
+EMSCRIPTEN_KEEPALIVE TGltfImporter *GltfImporter_create(
+    uint64_t budgetInNanos
+);
+
+/// Cancels any imports in progress, so this must be called on the render thread
+/// (see GltfImporter_destroyRenderThread), after detaching it from the render ticker.
+EMSCRIPTEN_KEEPALIVE void GltfImporter_destroy(
+    TGltfImporter *tGltfImporter
+);
+
+EMSCRIPTEN_KEEPALIVE void GltfImporter_setBudget(
+    TGltfImporter *tGltfImporter,
+    uint64_t budgetInNanos
+);
+
+/// Starts loading the resources of [tFilamentAsset] with [tGltfResourceLoader]
+/// (which must not be used for anything else until the import has completed).
+/// Returns false if the import could not be started.
+EMSCRIPTEN_KEEPALIVE bool GltfImporter_begin(
+    TGltfImporter *tGltfImporter,
+    TGltfResourceLoader *tGltfResourceLoader,
+    TFilamentAsset *tFilamentAsset
+);
+
+/// The progress of the import of [tFilamentAsset] in [0, 1]; 1 once all resources have been uploaded.
+/// This can be called from any thread.
+EMSCRIPTEN_KEEPALIVE float GltfImporter_getProgress(
+    TGltfImporter *tGltfImporter,
+    TFilamentAsset *tFilamentAsset
+);
+
+EMSCRIPTEN_KEEPALIVE void GltfImporter_cancel(
+    TGltfImporter *tGltfImporter,
+    TFilamentAsset *tFilamentAsset
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,12 +8,29 @@ extern "C"
 {
 #endif
 
+/// See Ktx2TextureProvider::Stats.
+typedef struct {
+    uint32_t texturesDecoded;
+    uint32_t texturesFailed;
+    uint64_t totalDecodeTimeInNanos;
+    uint64_t maxDecodeTimeInNanos;
+    uint64_t lastDecodeTimeInNanos;
+} TKtx2DecodeStats;
+
+/// Creates a resource loader whose KTX2 textures are transcoded in parallel on the engine's
+/// JobSystem (see Ktx2TextureProvider).
 EMSCRIPTEN_KEEPALIVE TGltfResourceLoader *GltfResourceLoader_create(TEngine *tEngine);
 EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_destroy(TEngine *tEngine, TGltfResourceLoader *tGltfResourceLoader);
+/// The time spent transcoding the KTX2 textures loaded so far by [tGltfResourceLoader].
+/// This can be called from any thread.
+EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_getKtx2DecodeStats(TGltfResourceLoader *tGltfResourceLoader, TKtx2DecodeStats *out);
 EMSCRIPTEN_KEEPALIVE bool GltfResourceLoader_asyncBeginLoad(TGltfResourceLoader *tGltfResourceLoader, TFilamentAsset *tFilamentAsset);
 EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_asyncUpdateLoad(TGltfResourceLoader *tGltfResourceLoader);
 EMSCRIPTEN_KEEPALIVE float GltfResourceLoader_asyncGetLoadProgress(TGltfResourceLoader *tGltfResourceLoader);
 EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_addResourceData(TGltfResourceLoader *tGltfResourceLoader, const char *uri, uint8_t *data, size_t length);
+/// Memory-maps the local file at [path] and adds it as the data for [uri], without copying its contents.
+/// The file is unmapped when the resource loader is destroyed. Returns false if the file could not be opened.
+EMSCRIPTEN_KEEPALIVE bool GltfResourceLoader_addResourceFile(TGltfResourceLoader *tGltfResourceLoader, const char *uri, const char *path);
 EMSCRIPTEN_KEEPALIVE bool GltfResourceLoader_loadResources(TGltfResourceLoader *tGltfResourceLoader, TFilamentAsset *tFilamentAsset);
 
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "APIExport.h"
+#include "APIBoundaryTypes.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Creates a manager that selects the level of detail of each component's
+/// renderable from its projected size in [tView] (see LodComponentManager).
+/// Attach it to a render ticker with RenderTicker_setLodManager.
+/// Creating and destroying the manager and adding or removing components touch the
+/// engine, so (like other engine calls) they must run on the render thread; use the
+/// *RenderThread variants in ThermionDartRenderThreadApi.h.
+EMSCRIPTEN_KEEPALIVE TLodManager *LodManager_create(
+    TEngine *tEngine,
+    TView *tView
+);
+
+EMSCRIPTEN_KEEPALIVE void LodManager_destroy(
+    TLodManager *tLodManager
+);
+
+/// Switches the renderable of [tSceneAsset] (created with SceneAsset_generateLods) between
+/// its levels of detail. Returns false if the asset has no levels of detail.
+EMSCRIPTEN_KEEPALIVE bool LodManager_addComponent(
+    TLodManager *tLodManager,
+    TSceneAsset *tSceneAsset
+);
+
+/// Restores the original triangles for [entityId]. Call before destroying the asset.
+EMSCRIPTEN_KEEPALIVE void LodManager_removeComponent(
+    TLodManager *tLodManager,
+    EntityId entityId
+);
+
+/// Positive values select coarser levels (each +1 doubles the permitted error), negative values finer levels.
+EMSCRIPTEN_KEEPALIVE void LodManager_setBias(
+    TLodManager *tLodManager,
+    float bias
+);
+
+EMSCRIPTEN_KEEPALIVE float LodManager_getBias(
+    TLodManager *tLodManager
+);
+
+/// The level currently rendered for [entityId] (or -1 if it has no LOD component).
+EMSCRIPTEN_KEEPALIVE int32_t LodManager_getCurrentLevel(
+    TLodManager *tLodManager,
+    EntityId entityId
+);
+
+#ifdef __cplusplus
+}
+#endif
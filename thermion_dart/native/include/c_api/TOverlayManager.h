@@ -17,12 +17,17 @@ EMSCRIPTEN_KEEPALIVE TOverlayManager *OverlayManager_create(
     TRenderTarget *tRenderTarget
 );
 
+/// Outlines [entityId] (the entity of [tSceneAsset] for the whole asset, or
+/// one of its renderable child entities) with [tMaterialInstance].
+/// Must be called on the render thread.
 EMSCRIPTEN_KEEPALIVE void OverlayManager_addComponent(
     TOverlayManager *tOverlayManager,
+    TSceneAsset *tSceneAsset,
     EntityId entityId,
     TMaterialInstance *tMaterialInstance
 );
 
+/// Must be called on the render thread.
 EMSCRIPTEN_KEEPALIVE void OverlayManager_removeComponent(
     TOverlayManager *tOverlayManager,
     EntityId entityId
@@ -33,6 +38,11 @@ EMSCRIPTEN_KEEPALIVE void OverlayManager_setRenderTarget(
     TRenderTarget *tRenderTarget
 );
 
+/// Forces the (cached) overlay depth prepass to be re-rendered on the next frame.
+EMSCRIPTEN_KEEPALIVE void OverlayManager_invalidate(
+    TOverlayManager *tOverlayManager
+);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
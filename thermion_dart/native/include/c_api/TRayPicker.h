@@ -0,0 +1,45 @@
+#pragma once
+
+#include "APIExport.h"
+#include "APIBoundaryTypes.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	typedef struct {
+		double3 origin;
+		double3 direction;
+	} TRay;
+
+	// [entity] is 0 if the ray did not hit anything; [instance] is the index of
+	// the hardware instance that was hit (see SceneAsset_createInstanced), or -1
+	typedef struct {
+		EntityId entity;
+		float distance;
+		double3 position;
+		int32_t instance;
+	} TRayHit;
+
+	/// Creates a synchronous CPU picker for the renderables in a scene (see RayPicker.hpp).
+	EMSCRIPTEN_KEEPALIVE TRayPicker *RayPicker_create(TEngine *tEngine);
+	EMSCRIPTEN_KEEPALIVE void RayPicker_destroy(TRayPicker *tRayPicker);
+
+	/// Registers the triangles of every renderable in [tSceneAsset] so hits can be refined beyond bounding boxes.
+	EMSCRIPTEN_KEEPALIVE bool RayPicker_addSceneAsset(TRayPicker *tRayPicker, TSceneAsset *tSceneAsset);
+	EMSCRIPTEN_KEEPALIVE void RayPicker_removeSceneAsset(TRayPicker *tRayPicker, TSceneAsset *tSceneAsset);
+	/// Registers a triangle list (in object space) for [entityId].
+	EMSCRIPTEN_KEEPALIVE void RayPicker_setTriangles(TRayPicker *tRayPicker, EntityId entityId, const float *const positions, uint32_t numVertices, const uint32_t *const indices, uint32_t numIndices);
+	EMSCRIPTEN_KEEPALIVE void RayPicker_removeTriangles(TRayPicker *tRayPicker, EntityId entityId);
+
+	/// Casts each of [rays] (in world space) against the renderables in the scene of [tView] on its visible layers,
+	/// writing the closest hit for each ray to [hits]. Returns the number of rays that hit something.
+	EMSCRIPTEN_KEEPALIVE uint32_t RayPicker_pick(TRayPicker *tRayPicker, TView *tView, const TRay *const rays, uint32_t numRays, bool refine, TRayHit *hits);
+	/// Synchronous equivalent of View_pick; ([x], [y]) are viewport coordinates with the origin at the bottom-left.
+	/// Returns true if anything was hit.
+	EMSCRIPTEN_KEEPALIVE bool RayPicker_pickView(TRayPicker *tRayPicker, TView *tView, uint32_t x, uint32_t y, bool refine, TRayHit *hit);
+
+#ifdef __cplusplus
+}
+#endif
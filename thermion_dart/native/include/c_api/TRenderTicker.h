@@ -8,6 +8,35 @@ extern "C"
 {
 #endif
 
+	typedef struct {
+		uint64_t framesRendered;
+		uint64_t lateFrames;
+		uint64_t droppedFrames;
+		uint64_t skippedFrames;
+		uint64_t coalescedRequests;
+		uint64_t frameIntervalInNanos;
+		uint64_t lastLatenessInNanos;
+		uint64_t maxLatenessInNanos;
+	} TFrameSchedulerStats;
+
+	#define FRAME_TIMING_MAX_VIEWS 8
+
+	/// CPU timings (nanoseconds) for a single frame; see RenderTicker_getFrameStats.
+	typedef struct {
+		uint64_t frameIndex;
+		uint64_t frameTimeInNanos;
+		uint64_t animationUpdateTimeInNanos;
+		uint64_t beginFrameTimeInNanos;
+		uint64_t overlayTimeInNanos;
+		uint64_t endFrameTimeInNanos;
+		uint64_t taskDrainTimeInNanos;
+		uint64_t totalTimeInNanos;
+		uint32_t tasksExecuted;
+		uint32_t numViews;
+		uint64_t viewRenderTimeInNanos[FRAME_TIMING_MAX_VIEWS];
+		bool rendered;
+	} TFrameTiming;
+
 	EMSCRIPTEN_KEEPALIVE TRenderTicker *RenderTicker_create(TEngine *tEngine, TRenderer *tRenderer);
 	EMSCRIPTEN_KEEPALIVE void RenderTicker_destroy(TRenderTicker *tRenderTicker);
 	EMSCRIPTEN_KEEPALIVE void RenderTicker_addAnimationManager(TRenderTicker *tRenderTicker, TAnimationManager *tAnimationManager);
@@ -17,6 +46,21 @@ extern "C"
 	EMSCRIPTEN_KEEPALIVE void RenderTicker_setRenderable(TRenderTicker *tRenderTicker, TSwapChain *swapChain, TView **views, uint8_t numViews);	
 	EMSCRIPTEN_KEEPALIVE void RenderTicker_removeSwapChain(TRenderTicker *tRenderTicker, TSwapChain *swapChain);	
 	EMSCRIPTEN_KEEPALIVE void RenderTicker_setOverlayManager(TRenderTicker *tRenderTicker, TOverlayManager *tOverlayManager);
+	/// Updates [tLodManager] before each frame (null to disable).
+	EMSCRIPTEN_KEEPALIVE void RenderTicker_setLodManager(TRenderTicker *tRenderTicker, TLodManager *tLodManager);
+	/// Refits the colliders marked dirty in [tCollisionManager] once before each frame (null to disable).
+	EMSCRIPTEN_KEEPALIVE void RenderTicker_setCollisionManager(TRenderTicker *tRenderTicker, TCollisionComponentManager *tCollisionManager);
+	/// Uploads the resources of glTF imports before each frame (null to disable).
+	EMSCRIPTEN_KEEPALIVE void RenderTicker_setGltfImporter(TRenderTicker *tRenderTicker, TGltfImporter *tGltfImporter);
+
+	/// Paces frames to [intervalInNanos] (0 to render as soon as a frame is requested).
+	EMSCRIPTEN_KEEPALIVE void RenderTicker_setTargetFrameInterval(TRenderTicker *tRenderTicker, uint64_t intervalInNanos);
+	/// Aligns frames to an external vsync signal; [vsyncTimeInNanos] must be in the steady_clock time base (0 to disable).
+	EMSCRIPTEN_KEEPALIVE void RenderTicker_onVsync(TRenderTicker *tRenderTicker, uint64_t vsyncTimeInNanos);
+	EMSCRIPTEN_KEEPALIVE void RenderTicker_getFrameSchedulerStats(TRenderTicker *tRenderTicker, TFrameSchedulerStats *out);
+	/// Copies the timings for (up to) the [maxFrames] most recent frames into [out], oldest first.
+	/// Returns the number of frames copied. This does not require a tracing build.
+	EMSCRIPTEN_KEEPALIVE uint32_t RenderTicker_getFrameStats(TRenderTicker *tRenderTicker, TFrameTiming *out, uint32_t maxFrames);
 	
 #ifdef __cplusplus
 }
@@ -22,6 +22,74 @@ extern "C"
         TMaterialInstance **materialInstances,
 		int materialInstanceCount
     );
+    /// As SceneAsset_createGeometry, with 32-bit indices (for meshes with more than 65536 vertices).
+    /// SceneAsset_createGeometry always keeps a CPU-side copy of the triangles for ray picking;
+    /// here, this is only kept if [pickable] is true (without it, RayPicker_addSceneAsset and
+    /// SceneAsset_generateLods will fail).
+    EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_createGeometryUint32(
+        TEngine *tEngine, 
+        float *vertices,
+        uint32_t numVertices,
+        float *normals,
+        uint32_t numNormals,
+        float *uvs,
+        uint32_t numUvs,
+        uint32_t *indices,
+        uint32_t numIndices,
+        enum TPrimitiveType tPrimitiveType,
+        bool pickable,
+        TMaterialInstance **materialInstances,
+		int materialInstanceCount
+    );
+    enum TPositionFormat {
+        POSITION_FORMAT_FLOAT3 = 0,
+        POSITION_FORMAT_HALF4 = 1,
+        // normalized to the bounding box; the renderable will be a child of the asset's entity
+        POSITION_FORMAT_SHORT4 = 2
+    };
+    typedef enum TPositionFormat TPositionFormat;
+
+    // opt-in quantized vertex layouts (see GeometrySceneAssetBuilder::VertexFormat)
+    typedef struct {
+        enum TPositionFormat positions;
+        bool halfUVs;
+        bool shortTangents;
+        bool byteColors;
+    } TVertexFormat;
+
+    // the effect of optimizing a mesh (see GeometrySceneAssetBuilder::OptimizationReport)
+    typedef struct {
+        uint32_t vertexCountBefore;
+        uint32_t vertexCountAfter;
+        // vertex shader invocations per triangle, with a simulated 16-entry FIFO cache
+        float acmrBefore;
+        float acmrAfter;
+    } TOptimizationReport;
+
+    /// As SceneAsset_createGeometryUint32, with (optional) RGBA vertex colours and the vertex layout [format].
+    /// If [optimize] is true, duplicate vertices are merged and triangles/vertices are reordered for
+    /// the vertex cache and overdraw (see GeometrySceneAssetBuilder::optimize), and the result is
+    /// written to [outOptimizationReport] (if not null).
+    EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_createGeometryWithFormat(
+        TEngine *tEngine, 
+        float *vertices,
+        uint32_t numVertices,
+        float *normals,
+        uint32_t numNormals,
+        float *uvs,
+        uint32_t numUvs,
+        float *colors,
+        uint32_t numColors,
+        uint32_t *indices,
+        uint32_t numIndices,
+        enum TPrimitiveType tPrimitiveType,
+        bool pickable,
+        TVertexFormat format,
+        bool optimize,
+        TOptimizationReport *outOptimizationReport,
+        TMaterialInstance **materialInstances,
+		int materialInstanceCount
+    );
     EMSCRIPTEN_KEEPALIVE TSceneAsset * SceneAsset_createFromFilamentAsset(
         TEngine *tEngine,
         TGltfAssetLoader *tAssetLoader,
@@ -42,8 +110,44 @@ extern "C"
     EMSCRIPTEN_KEEPALIVE size_t SceneAsset_getLightEntityCount(TSceneAsset *tSceneAsset);
     EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_getInstance(TSceneAsset *tSceneAsset, int index);
     EMSCRIPTEN_KEEPALIVE size_t SceneAsset_getInstanceCount(TSceneAsset *tSceneAsset);
+    /// The asset that [tSceneAsset] is an instance of (or null if it is not an instance).
+    EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_getInstanceOwner(TSceneAsset *tSceneAsset);
     EMSCRIPTEN_KEEPALIVE TSceneAsset * SceneAsset_createInstance(TSceneAsset *asset, TMaterialInstance **materialInstances, int materialInstanceCount);
     EMSCRIPTEN_KEEPALIVE Aabb3 SceneAsset_getBoundingBox(TSceneAsset *asset);
+
+    /**
+     * Creates [instanceCount] hardware instances of a geometry asset (all drawn with
+     * InstanceBuffers). If [materialInstanceCount] is zero, the asset's own material
+     * instances are used. Returns nullptr if [asset] is not a (non-instance) geometry asset.
+     * Destroy with SceneAsset_destroy.
+     */
+    EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_createInstanced(TSceneAsset *asset, uint32_t instanceCount, TMaterialInstance **materialInstances, int materialInstanceCount);
+
+    /**
+     * Sets the transforms of [count] hardware instances (starting at [offset]) from
+     * column-major 4x4 matrices (16 floats per instance), relative to the asset's entity.
+     * Returns false if [asset] was not created with SceneAsset_createInstanced or the range is invalid.
+     */
+    EMSCRIPTEN_KEEPALIVE bool SceneAsset_setInstanceTransforms(TSceneAsset *asset, const float *const transforms, uint32_t count, uint32_t offset);
+
+    /**
+     * Starts generating [levelCount] levels of detail (including the original triangles) for a
+     * geometry asset on the engine's JobSystem, each with [reduction] times the triangles of the
+     * previous level. Use a TLodManager to switch between them. Returns false if the asset is not
+     * (triangle) geometry or wasn't created as pickable. Must be called on the render thread (see SceneAsset_generateLodsRenderThread).
+     */
+    EMSCRIPTEN_KEEPALIVE bool SceneAsset_generateLods(TSceneAsset *asset, uint32_t levelCount, float reduction);
+
+    /**
+     * The number of levels of detail available so far (0 if SceneAsset_generateLods hasn't been
+     * called). Levels become available once generated and uploaded by a TLodManager.
+     */
+    EMSCRIPTEN_KEEPALIVE uint32_t SceneAsset_getLodLevelCount(TSceneAsset *asset);
+
+    /**
+     * The number of triangles in level [level] (0 if the level isn't available).
+     */
+    EMSCRIPTEN_KEEPALIVE uint32_t SceneAsset_getLodTriangleCount(TSceneAsset *asset, uint32_t level);
         
 #ifdef __cplusplus
 }
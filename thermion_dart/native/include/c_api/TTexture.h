@@ -273,6 +273,12 @@ EMSCRIPTEN_KEEPALIVE TTexture *Ktx2Reader_createTexture(TEngine *tEngine, uint8_
 
 EMSCRIPTEN_KEEPALIVE TLinearImage *Image_createEmpty(uint32_t width,uint32_t height,uint32_t channel);
 EMSCRIPTEN_KEEPALIVE TLinearImage *Image_decode(uint8_t* data, size_t length, const char* name, bool alpha);
+/// Decodes [data] to 8-bit RGBA and uploads it to a new 2D texture, without converting
+/// to floating point (see DecodedImage). Color images should use [sRGB] (an SRGB8_A8
+/// texture, decoded to linear by the GPU when sampled); data such as normal maps should
+/// not (RGBA8). If [generateMipmaps] is true, the mip chain is generated on the GPU.
+/// Returns null if the data can't be decoded.
+EMSCRIPTEN_KEEPALIVE TTexture *Image_decodeToTexture(TEngine *tEngine, const uint8_t *data, size_t length, bool sRGB, bool generateMipmaps);
 EMSCRIPTEN_KEEPALIVE float *Image_getBytes(TLinearImage *tLinearImage);
 EMSCRIPTEN_KEEPALIVE void Image_destroy(TLinearImage *tLinearImage);
 EMSCRIPTEN_KEEPALIVE uint32_t Image_getWidth(TLinearImage *tLinearImage);
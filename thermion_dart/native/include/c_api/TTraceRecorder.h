@@ -0,0 +1,20 @@
+#pragma once
+
+#include "APIBoundaryTypes.h"
+#include "APIExport.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+	/// Enables/disables recording of native spans (disabled by default).
+	EMSCRIPTEN_KEEPALIVE void TraceRecorder_setEnabled(bool enabled);
+	/// Discards all spans recorded so far.
+	EMSCRIPTEN_KEEPALIVE void TraceRecorder_clear();
+	/// Writes all recorded spans to [path] as Chrome trace-event JSON
+	/// (open with chrome://tracing or https://ui.perfetto.dev).
+	EMSCRIPTEN_KEEPALIVE bool TraceRecorder_dump(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
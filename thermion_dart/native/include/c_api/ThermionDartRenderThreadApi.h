@@ -6,6 +6,11 @@
 #include "TView.h"
 #include "TTexture.h"
 #include "TMaterialProvider.h"
+#include "TCommandBuffer.h"
+#include "TCollisionManager.h"
+#include "TLodManager.h"
+#include "TOverlayManager.h"
+#include "TRayPicker.h"
 
 #ifdef __cplusplus
 namespace thermion
@@ -16,11 +21,25 @@ namespace thermion
         typedef int32_t EntityId;
         typedef void (*FilamentRenderCallback)(void *const owner);
 
+        typedef struct {
+            uint64_t idleTimeInNanos;
+            uint64_t busyTimeInNanos;
+            uint64_t wakeups;
+            uint64_t tasksExecuted;
+            uint64_t framesRendered;
+            float fps;
+        } TRenderThreadStats;
+
         EMSCRIPTEN_KEEPALIVE void RenderThread_create();
         EMSCRIPTEN_KEEPALIVE void RenderThread_destroy();
         EMSCRIPTEN_KEEPALIVE void RenderThread_requestFrameAsync();
         EMSCRIPTEN_KEEPALIVE void RenderThread_setRenderTicker(TRenderTicker *tRenderTicker);
         EMSCRIPTEN_KEEPALIVE void RenderThread_addTask(void (*task)());
+        EMSCRIPTEN_KEEPALIVE void RenderThread_getStats(TRenderThreadStats *out);
+        
+        /// Replays a command buffer (see TCommandBuffer.h) on the render thread
+        /// as a single task. [commands] must remain valid until [onComplete] is called.
+        EMSCRIPTEN_KEEPALIVE void RenderThread_submitCommands(const uint8_t *const commands, size_t length, uint32_t requestId, VoidCallback onComplete);
         
         EMSCRIPTEN_KEEPALIVE void RenderTicker_renderRenderThread(TRenderTicker *tRenderTicker, uint64_t frameTimeInNanos, uint32_t requestId, VoidCallback onComplete);
         EMSCRIPTEN_KEEPALIVE void AnimationManager_createRenderThread(TEngine *tEngine, TScene *tScene, void (*onComplete)(TAnimationManager *));
@@ -124,6 +143,43 @@ namespace thermion
             int materialInstanceCount,
             void (*callback)(TSceneAsset *)
         );
+        EMSCRIPTEN_KEEPALIVE void SceneAsset_createGeometryUint32RenderThread(
+            TEngine *tEngine, 
+            float *vertices,
+            uint32_t numVertices,
+            float *normals,
+            uint32_t numNormals,
+            float *uvs,
+            uint32_t numUvs,
+            uint32_t *indices,
+            uint32_t numIndices,
+            TPrimitiveType tPrimitiveType,
+            bool pickable,
+            TMaterialInstance **materialInstances,
+            int materialInstanceCount,
+            void (*callback)(TSceneAsset *)
+        );
+        EMSCRIPTEN_KEEPALIVE void SceneAsset_createGeometryWithFormatRenderThread(
+            TEngine *tEngine, 
+            float *vertices,
+            uint32_t numVertices,
+            float *normals,
+            uint32_t numNormals,
+            float *uvs,
+            uint32_t numUvs,
+            float *colors,
+            uint32_t numColors,
+            uint32_t *indices,
+            uint32_t numIndices,
+            TPrimitiveType tPrimitiveType,
+            bool pickable,
+            TVertexFormat format,
+            bool optimize,
+            TOptimizationReport *outOptimizationReport,
+            TMaterialInstance **materialInstances,
+            int materialInstanceCount,
+            void (*callback)(TSceneAsset *)
+        );
         EMSCRIPTEN_KEEPALIVE void MaterialProvider_createMaterialInstanceRenderThread(
             TMaterialProvider *tMaterialProvider, 
             bool doubleSided,
@@ -181,6 +237,10 @@ namespace thermion
         // Image methods
         EMSCRIPTEN_KEEPALIVE void Image_createEmptyRenderThread(uint32_t width, uint32_t height, uint32_t channel, void (*onComplete)(TLinearImage *));
         EMSCRIPTEN_KEEPALIVE void Image_decodeRenderThread(uint8_t* data, size_t length, const char* name, bool alpha, void (*onComplete)(TLinearImage *));
+        /// Decodes [data] on the engine's JobSystem, then creates the texture on the render thread (see Image_decodeToTexture).
+        /// [data] is copied (or decoded) before this returns, so it need not outlive the call.
+        /// Destroying the engine or render thread waits for outstanding decodes; any not yet started complete with nullptr.
+        EMSCRIPTEN_KEEPALIVE void Image_decodeToTextureRenderThread(TEngine *tEngine, const uint8_t *data, size_t length, bool sRGB, bool generateMipmaps, void (*onComplete)(TTexture *));
         EMSCRIPTEN_KEEPALIVE void Image_getBytesRenderThread(TLinearImage *tLinearImage, void (*onComplete)(float *));
         EMSCRIPTEN_KEEPALIVE void Image_destroyRenderThread(TLinearImage *tLinearImage, uint32_t requestId, VoidCallback onComplete);
         EMSCRIPTEN_KEEPALIVE void Image_getWidthRenderThread(TLinearImage *tLinearImage, void (*onComplete)(uint32_t));
@@ -300,9 +360,55 @@ namespace thermion
         EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_destroyRenderThread(TEngine *tEngine, TGltfResourceLoader *tResourceLoader, uint32_t requestId, VoidCallback onComplete);
         EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_loadResourcesRenderThread(TGltfResourceLoader *tGltfResourceLoader, TFilamentAsset *tFilamentAsset, void (*callback)(bool));
         EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_addResourceDataRenderThread(TGltfResourceLoader *tGltfResourceLoader, const char *uri, uint8_t *data, size_t length, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_addResourceFileRenderThread(TGltfResourceLoader *tGltfResourceLoader, const char *uri, const char *path, void (*callback)(bool));
         EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_asyncBeginLoadRenderThread(TGltfResourceLoader *tGltfResourceLoader, TFilamentAsset *tFilamentAsset, void (*callback)(bool));
         EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_asyncUpdateLoadRenderThread(TGltfResourceLoader *tGltfResourceLoader);
         EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_asyncGetLoadProgressRenderThread(TGltfResourceLoader *tGltfResourceLoader, void (*callback)(float));
+        EMSCRIPTEN_KEEPALIVE void GltfImporter_destroyRenderThread(TGltfImporter *tGltfImporter, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void GltfImporter_beginRenderThread(TGltfImporter *tGltfImporter, TGltfResourceLoader *tGltfResourceLoader, TFilamentAsset *tFilamentAsset, void (*callback)(bool));
+        EMSCRIPTEN_KEEPALIVE void GltfImporter_cancelRenderThread(TGltfImporter *tGltfImporter, TFilamentAsset *tFilamentAsset, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void GltfAssetCache_destroyRenderThread(TGltfAssetCache *tGltfAssetCache, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void GltfAssetCache_acquireRenderThread(TGltfAssetCache *tGltfAssetCache, uint64_t key, TMaterialInstance **tMaterialInstances, int materialInstanceCount, void (*callback)(TSceneAsset *));
+        EMSCRIPTEN_KEEPALIVE void GltfAssetCache_insertRenderThread(TGltfAssetCache *tGltfAssetCache, uint64_t key, TSceneAsset *tSceneAsset, uint64_t sizeInBytes, void (*callback)(TSceneAsset *));
+        EMSCRIPTEN_KEEPALIVE void GltfAssetCache_releaseRenderThread(TGltfAssetCache *tGltfAssetCache, TSceneAsset *tSceneAsset, void (*callback)(bool));
+        /// Hashes the file at [path] on the render thread (see GltfAssetCache_computeFileKey), so the
+        /// caller isn't blocked the first time a file is seen. [path], [resourceUri] and [outLength]
+        /// must remain valid until [callback] is invoked.
+        EMSCRIPTEN_KEEPALIVE void GltfAssetCache_computeFileKeyRenderThread(TGltfAssetCache *tGltfAssetCache, const char *path, const char *resourceUri, uint64_t *outLength, void (*callback)(uint64_t));
+        EMSCRIPTEN_KEEPALIVE void GltfAssetCache_setBudgetRenderThread(TGltfAssetCache *tGltfAssetCache, uint64_t budgetInBytes, uint32_t requestId, VoidCallback onComplete);
+
+        EMSCRIPTEN_KEEPALIVE void CollisionManager_createRenderThread(TTransformManager *tTransformManager, void (*onComplete)(TCollisionComponentManager *));
+        EMSCRIPTEN_KEEPALIVE void CollisionManager_destroyRenderThread(TCollisionComponentManager *tCollisionManager, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void CollisionManager_addComponentRenderThread(TCollisionComponentManager *tCollisionManager, EntityId entityId, Aabb3 boundingBox, void (*callback)(EntityId entityId1, EntityId entityId2), bool affectsTransform, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void CollisionManager_removeComponentRenderThread(TCollisionComponentManager *tCollisionManager, EntityId entityId, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void CollisionManager_markDirtyRenderThread(TCollisionComponentManager *tCollisionManager, EntityId entityId, uint32_t requestId, VoidCallback onComplete);
+        /// [outPairs] must remain valid until [onComplete] is called.
+        EMSCRIPTEN_KEEPALIVE void CollisionManager_collideAllRenderThread(TCollisionComponentManager *tCollisionManager, EntityId *outPairs, uint32_t maxPairs, void (*onComplete)(uint32_t));
+
+        /// [tMaterialInstances] must remain valid until [onComplete] is called.
+        EMSCRIPTEN_KEEPALIVE void SceneAsset_createInstancedRenderThread(TSceneAsset *tSceneAsset, uint32_t instanceCount, TMaterialInstance **tMaterialInstances, int materialInstanceCount, void (*onComplete)(TSceneAsset *));
+        /// [transforms] must remain valid until [onComplete] is called.
+        EMSCRIPTEN_KEEPALIVE void SceneAsset_setInstanceTransformsRenderThread(TSceneAsset *tSceneAsset, const float *const transforms, uint32_t count, uint32_t offset, void (*onComplete)(bool));
+        EMSCRIPTEN_KEEPALIVE void SceneAsset_generateLodsRenderThread(TSceneAsset *tSceneAsset, uint32_t levelCount, float reduction, void (*onComplete)(bool));
+        EMSCRIPTEN_KEEPALIVE void LodManager_createRenderThread(TEngine *tEngine, TView *tView, void (*onComplete)(TLodManager *));
+        EMSCRIPTEN_KEEPALIVE void LodManager_destroyRenderThread(TLodManager *tLodManager, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void LodManager_addComponentRenderThread(TLodManager *tLodManager, TSceneAsset *tSceneAsset, void (*onComplete)(bool));
+        EMSCRIPTEN_KEEPALIVE void LodManager_removeComponentRenderThread(TLodManager *tLodManager, EntityId entityId, uint32_t requestId, VoidCallback onComplete);
+
+        EMSCRIPTEN_KEEPALIVE void RayPicker_createRenderThread(TEngine *tEngine, void (*onComplete)(TRayPicker *));
+        EMSCRIPTEN_KEEPALIVE void RayPicker_destroyRenderThread(TRayPicker *tRayPicker, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void RayPicker_addSceneAssetRenderThread(TRayPicker *tRayPicker, TSceneAsset *tSceneAsset, void (*onComplete)(bool));
+        EMSCRIPTEN_KEEPALIVE void RayPicker_removeSceneAssetRenderThread(TRayPicker *tRayPicker, TSceneAsset *tSceneAsset, uint32_t requestId, VoidCallback onComplete);
+        /// [positions] and [indices] must remain valid until [onComplete] is called.
+        EMSCRIPTEN_KEEPALIVE void RayPicker_setTrianglesRenderThread(TRayPicker *tRayPicker, EntityId entityId, const float *const positions, uint32_t numVertices, const uint32_t *const indices, uint32_t numIndices, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void RayPicker_removeTrianglesRenderThread(TRayPicker *tRayPicker, EntityId entityId, uint32_t requestId, VoidCallback onComplete);
+        /// [rays] and [hits] must remain valid until [onComplete] is called.
+        EMSCRIPTEN_KEEPALIVE void RayPicker_pickRenderThread(TRayPicker *tRayPicker, TView *tView, const TRay *const rays, uint32_t numRays, bool refine, TRayHit *hits, void (*onComplete)(uint32_t));
+        /// [hit] must remain valid until [onComplete] is called.
+        EMSCRIPTEN_KEEPALIVE void RayPicker_pickViewRenderThread(TRayPicker *tRayPicker, TView *tView, uint32_t x, uint32_t y, bool refine, TRayHit *hit, void (*onComplete)(bool));
+
+        EMSCRIPTEN_KEEPALIVE void OverlayManager_addComponentRenderThread(TOverlayManager *tOverlayManager, TSceneAsset *tSceneAsset, EntityId entityId, TMaterialInstance *tMaterialInstance, uint32_t requestId, VoidCallback onComplete);
+        EMSCRIPTEN_KEEPALIVE void OverlayManager_removeComponentRenderThread(TOverlayManager *tOverlayManager, EntityId entityId, uint32_t requestId, VoidCallback onComplete);
 
         EMSCRIPTEN_KEEPALIVE void GltfAssetLoader_loadRenderThread(
             TEngine *tEngine,
@@ -312,6 +418,14 @@ namespace thermion
             uint8_t numInstances,
             void (*callback)(TFilamentAsset *)
         );
+        EMSCRIPTEN_KEEPALIVE void GltfAssetLoader_loadFileRenderThread(
+            TEngine *tEngine,
+            TGltfAssetLoader *tAssetLoader,
+            const char *path,
+            uint8_t numInstances,
+            void (*callback)(TFilamentAsset *)
+        );
+        EMSCRIPTEN_KEEPALIVE void TransformManager_setTransformRenderThread(TTransformManager *tTransformManager, EntityId entityId, double4x4 transform, uint32_t requestId, VoidCallback onComplete);
         EMSCRIPTEN_KEEPALIVE void Scene_addFilamentAssetRenderThread(TScene* tScene, TFilamentAsset *tAsset, uint32_t requestId, VoidCallback onComplete);
         EMSCRIPTEN_KEEPALIVE void Gizmo_createRenderThread(
             TEngine *tEngine,
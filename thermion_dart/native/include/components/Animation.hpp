@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 
 namespace thermion
 {
@@ -10,10 +11,17 @@ namespace thermion
 
     struct Animation
     {
-        time_point_t start = time_point_t::max();
+        // the animation clock time (see AnimationManager::update) when this animation started
+        uint64_t startInNanos = 0;
         float startOffset;
         bool loop = false;
         bool reverse = false;
         float durationInSecs = 0;
+
+        /// @brief The time (in seconds) since this animation started, at animation clock time [nowInNanos].
+        float elapsedInSecs(uint64_t nowInNanos) const
+        {
+            return nowInNanos > startInNanos ? float(double(nowInNanos - startInNanos) / 1e9) : 0.0f;
+        }
     };
-}
\ No newline at end of file
+}
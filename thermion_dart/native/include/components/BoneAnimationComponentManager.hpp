@@ -15,10 +15,12 @@
 #include <gltfio/Animator.h>
 #include <gltfio/math.h>
 
+#include <utils/JobSystem.h>
 #include <utils/SingleInstanceComponentManager.h>
 
 #include "Log.hpp"
 #include "components/Animation.hpp"
+#include "components/BoneAnimationKeys.hpp"
 
 namespace thermion
 {
@@ -30,11 +32,15 @@ namespace thermion
         int lengthInFrames;
         size_t boneIndex;
         size_t skinIndex = 0;
+        // the joint entity at [boneIndex] in skin [skinIndex]
+        utils::Entity joint;
         float frameLengthInMs = 0;
-        std::vector<math::mat4f> frameData;
+        // the local transform for each frame
+        BoneAnimationKeys keys;
         float fadeOutInSecs = 0;
         float fadeInInSecs = 0;
         float maxDelta = 1.0f;
+        bool completed = false;
     };
 
     /// @brief 
@@ -56,11 +62,22 @@ namespace thermion
             
             void addAnimationComponent(FilamentInstance *target);
             void removeAnimationComponent(FilamentInstance *target);
-            void update(); 
+
+            /// @brief Applies all active bone animations at animation clock time [nowInNanos], spreading components across
+            /// [jobSystem] (if non-null). Like GltfAnimationComponentManager::update, this
+            /// must be called with a local transform transaction open; animators that
+            /// need their bone matrices updated are appended to [dirtyAnimators].
+            void update(uint64_t nowInNanos, utils::JobSystem *jobSystem, std::vector<Animator *> &dirtyAnimators);
 
         private:
+            static constexpr uint32_t kMinComponentsPerJob = 8;
+
+            bool updateComponent(Instance componentInstance, uint64_t nowInNanos);
+
             filament::TransformManager &mTransformManager;
             filament::RenderableManager &mRenderableManager;
+            // one entry per component (see GltfAnimationComponentManager)
+            std::vector<uint8_t> mUpdated;
     };
 
    
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+#include <gltfio/math.h>
+
+namespace thermion
+{
+
+    /// @brief The keyframes for a single bone animation, stored as separate
+    /// (contiguous) translation/rotation/scale arrays.
+    ///
+    /// Frames are decomposed once when the animation is created, so sampling
+    /// a frame is just a lerp/nlerp between two adjacent keys.
+    struct BoneAnimationKeys
+    {
+        std::vector<filament::math::float3> translations;
+        std::vector<filament::math::quatf> rotations;
+        std::vector<filament::math::float3> scales;
+
+        void set(const filament::math::mat4f *frames, size_t numFrames)
+        {
+            translations.resize(numFrames);
+            rotations.resize(numFrames);
+            scales.resize(numFrames);
+            for (size_t i = 0; i < numFrames; i++)
+            {
+                filament::gltfio::decomposeMatrix(frames[i], &translations[i], &rotations[i], &scales[i]);
+                // keep consecutive keys in the same hemisphere so sampling never
+                // needs to flip signs
+                if (i > 0 && dot(rotations[i - 1], rotations[i]) < 0.0f)
+                {
+                    rotations[i] = -rotations[i];
+                }
+            }
+        }
+
+        size_t size() const
+        {
+            return translations.size();
+        }
+
+        /// @brief Interpolates between keys [curr] and [next] by [t] (0-1).
+        void sample(size_t curr, size_t next, float t,
+                    filament::math::float3 *translation,
+                    filament::math::quatf *rotation,
+                    filament::math::float3 *scale) const
+        {
+            *translation = lerp(translations[curr], translations[next], t);
+            *scale = lerp(scales[curr], scales[next], t);
+            *rotation = nlerp(rotations[curr], rotations[next], t);
+        }
+
+        static filament::math::float3 lerp(const filament::math::float3 &a, const filament::math::float3 &b, float t)
+        {
+            return a + (b - a) * t;
+        }
+
+        /// @brief Normalized lerp between two rotations. For adjacent keyframes this
+        /// is visually indistinguishable from slerp, but needs no trigonometry.
+        static filament::math::quatf nlerp(const filament::math::quatf &a, filament::math::quatf b, float t)
+        {
+            if (dot(a, b) < 0.0f)
+            {
+                b = -b;
+            }
+            auto q = a + (b - a) * t;
+            return q * (1.0f / std::sqrt(dot(q, q)));
+        }
+    };
+
+} // namespace thermion
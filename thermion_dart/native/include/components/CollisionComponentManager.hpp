@@ -1,5 +1,8 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "utils/Entity.h"
 #include "utils/EntityInstance.h"
 #include "utils/SingleInstanceComponentManager.h"
@@ -8,93 +11,63 @@
 #include "gltfio/FilamentInstance.h"
 #include "Log.hpp"
 
+#include "components/DynamicAabbTree.hpp"
+
 namespace thermion
 {
 
 typedef void(*CollisionCallback)(int32_t entityId1, int32_t entityId2) ;
-class CollisionComponentManager : public utils::SingleInstanceComponentManager<filament::Aabb, CollisionCallback, bool> {
+
+///
+/// Each component is an entity's local-space bounding box, an optional callback,
+/// whether collisions should affect the entity's transform, the entity's
+/// proxy in the broadphase tree (which stores world-space boxes) and the world
+/// transform the proxy was last fitted to.
+///
+/// The TransformManager doesn't report changes, so entities that are moved must
+/// be marked dirty (markDirty); the proxies for those entities (and any colliders
+/// parented to them) are then refit once per frame by update(), which is called
+/// by the RenderTicker (see RenderTicker::setCollisionManager). Queries use the
+/// tree as it was last refit, so they don't touch every collider.
+///
+class CollisionComponentManager : public utils::SingleInstanceComponentManager<filament::Aabb, CollisionCallback, bool, int32_t, filament::math::mat4f> {
 
     const filament::TransformManager& _transformManager;
     public:
         CollisionComponentManager(const filament::TransformManager& transformManager) : _transformManager(transformManager) {}
-    
-        std::vector<filament::math::float3> collides(utils::Entity transformingEntity, filament::Aabb sourceBox) { 
-            auto sourceCorners = sourceBox.getCorners();
-            std::vector<filament::math::float3> collisionAxes;
-            for(auto it = begin(); it < end(); it++) {
-                auto entity = getEntity(it);
-
-                if(entity == transformingEntity) {
-                    continue;
-                }
-                auto targetXformInstance = _transformManager.getInstance(entity);
-                auto targetXform = _transformManager.getWorldTransform(targetXformInstance);
-                auto targetBox = elementAt<0>(it).transform(targetXform);
-                auto targetCorners = targetBox.getCorners();
-
-                // Log("Checking collision for entity %d with aabb extent %f %f %f against source entity %d with aabb extent %f %f %f", entity, targetBox.extent().x, targetBox.extent().y, targetBox.extent().z, transformingEntityId, sourceBox.extent().x, sourceBox.extent().y, sourceBox.extent().z);
-
-                bool collided = false;
-
-                // iterate over every vertex in the source/target AABB
-                for(int i = 0; i < 8; i++) {
-                    auto intersecting = sourceCorners.vertices[i];
-                    auto min = targetBox.min;
-                    auto max = targetBox.max;
-                    
-                    // if the vertex has insersected with the target/source AABB
-                    if(targetBox.contains(sourceCorners.vertices[i]) <= 0) {
-                        collided = true;
-                        // Log("targetBox %f %f %f contains source vertex %f %f %f", targetBox.extent().x, targetBox.extent().y, targetBox.extent().z, sourceCorners.vertices[i].x, sourceCorners.vertices[i].y, sourceCorners.vertices[i].z);
-                    } else if(sourceBox.contains(targetCorners.vertices[i]) <= 0) {
-                        // Log("sourceBox %f %f %f contains target vertex %f %f %f", sourceBox.extent().x, sourceBox.extent().y, sourceBox.extent().z, targetCorners.vertices[i].x, targetCorners.vertices[i].y, targetCorners.vertices[i].z);
-                        collided = true;
-                        intersecting = targetCorners.vertices[i];
-                        min = sourceBox.min;
-                        max = sourceBox.max;
-                    } else { 
-                        continue;
-                    }
-                    auto affectsTransform = elementAt<2>(it);
-                    if(affectsTransform) {
-                        float xmin = min.x - intersecting.x;
-                        float ymin = min.y - intersecting.y;
-                        float zmin = min.z - intersecting.z;
-                        float xmax = intersecting.x - max.x;
-                        float ymax = intersecting.y - max.y;
-                        float zmax = intersecting.z - max.z;
-
-                        auto maxD = std::max(xmin,std::max(ymin,std::max(zmin,std::max(xmax,std::max(ymax,zmax)))));
-                        filament::math::float3 axis;
-                        if(maxD == xmin) {
-                            axis = {-1.0f,0.0f, 0.0f};
-                        } else if(maxD == ymin) {
-                            axis = {0.0f,-1.0f, 0.0f};
-                        } else if(maxD == zmin) {
-                            axis = {0.0f,0.0f, -1.0f};
-                        } else if(maxD == xmax) {
-                            axis = {1.0f,0.0f, 0.0f};
-                        } else if(maxD == ymax) {
-                        axis = {0.0f,1.0f, 0.0f};  
-                        } else { 
-                        axis = { 0.0f, 0.0f, 1.0f};
-                        }
-                        collisionAxes.push_back(axis);                      
-                    }
-                    break;
-                }
-                if(collided) {
-                    auto callback = elementAt<1>(it);
-                    if(callback) {
-                        callback(utils::Entity::smuggle(entity), utils::Entity::smuggle(transformingEntity));
-                    }
-                }
-            }
-            
-            return collisionAxes;
-        }
-};
 
-}
+        void addCollisionComponent(utils::Entity entity, filament::Aabb boundingBox, CollisionCallback callback, bool affectsTransform);
+        void removeCollisionComponent(utils::Entity entity);
+
+        /// @brief Marks [entity] as moved, so the colliders of [entity] and its
+        /// descendants are refit by the next update().
+        void markDirty(utils::Entity entity);
+
+        /// @brief Refits the broadphase tree to the current world transform of every
+        /// collider that has been marked dirty since the last update. Colliders that
+        /// have only moved slightly since they were last (re)inserted don't change the tree.
+        void update();
 
+        /// @brief Immediately refits the broadphase tree to the current world transform of [entity].
+        void refit(utils::Entity entity);
 
+        /// @brief Returns the collision axis for each collider that [sourceBox] (in world space)
+        /// collides with (excluding [transformingEntity] itself), invoking its callback if set.
+        std::vector<filament::math::float3> collides(utils::Entity transformingEntity, filament::Aabb sourceBox);
+
+        /// @brief Returns every pair of colliders whose world-space boxes overlap.
+        std::vector<std::pair<utils::Entity, utils::Entity>> collideAll();
+
+    private:
+        /// Uses the world transform the collider was last fitted to.
+        filament::Aabb getWorldBoundingBox(Instance instance) const;
+        /// Caches [instance]'s current world transform and moves its proxy to match.
+        void fit(Instance instance);
+
+        DynamicAabbTree _tree;
+        std::vector<utils::Entity> _dirty;
+        std::vector<filament::TransformManager::Instance> _dirtyStack;
+        std::vector<utils::Entity> _children;
+};
+
+}
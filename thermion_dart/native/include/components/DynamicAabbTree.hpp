@@ -0,0 +1,292 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <filament/Box.h>
+
+namespace thermion
+{
+
+    /// @brief A dynamic bounding volume hierarchy over axis-aligned boxes,
+    /// used as the broadphase for collision queries.
+    ///
+    /// Each proxy is stored with a "fat" box (its box expanded by [margin]),
+    /// so small movements don't change the tree at all; a proxy is only
+    /// reinserted once its box leaves its fat box. Inserts choose the sibling
+    /// with the lowest surface-area cost and the tree is kept balanced with
+    /// rotations, so queries are O(log N) for well-distributed boxes.
+    class DynamicAabbTree
+    {
+    public:
+        static constexpr int32_t kNullNode = -1;
+
+        explicit DynamicAabbTree(float margin = 0.1f) : mMargin(margin) {}
+
+        /// @brief Inserts [box] into the tree and returns its proxy ID.
+        int32_t createProxy(const filament::Aabb &box, uint32_t userData);
+
+        void destroyProxy(int32_t proxyId);
+
+        /// @brief Updates the box for [proxyId]; returns true if the proxy had to be
+        /// reinserted (i.e. [box] is no longer contained by the proxy's fat box).
+        bool moveProxy(int32_t proxyId, const filament::Aabb &box);
+
+        uint32_t getUserData(int32_t proxyId) const
+        {
+            return mNodes[proxyId].userData;
+        }
+
+        const filament::Aabb &getFatAabb(int32_t proxyId) const
+        {
+            return mNodes[proxyId].box;
+        }
+
+        size_t getProxyCount() const
+        {
+            return mProxyCount;
+        }
+
+        /// @brief The height of the tree (0 if empty).
+        int32_t getHeight() const
+        {
+            return mRoot == kNullNode ? 0 : mNodes[mRoot].height + 1;
+        }
+
+        static bool overlaps(const filament::Aabb &a, const filament::Aabb &b)
+        {
+            return a.min.x <= b.max.x && b.min.x <= a.max.x &&
+                   a.min.y <= b.max.y && b.min.y <= a.max.y &&
+                   a.min.z <= b.max.z && b.min.z <= a.max.z;
+        }
+
+        /// @brief Calls [callback](proxyId) for every proxy whose fat box overlaps [box].
+        /// The query stops early if [callback] returns false.
+        template <typename Callback>
+        void query(const filament::Aabb &box, Callback &&callback) const
+        {
+            Stack stack;
+            stack.push(mRoot);
+            while (!stack.empty())
+            {
+                int32_t nodeId = stack.pop();
+                if (nodeId == kNullNode)
+                {
+                    continue;
+                }
+                const auto &node = mNodes[nodeId];
+                if (!overlaps(node.box, box))
+                {
+                    continue;
+                }
+                if (node.isLeaf())
+                {
+                    if (!callback(nodeId))
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    stack.push(node.child1);
+                    stack.push(node.child2);
+                }
+            }
+        }
+
+        /// @brief Calls [callback](proxyA, proxyB) once for every pair of proxies
+        /// whose fat boxes overlap.
+        ///
+        /// This descends the tree against itself, so subtrees that don't overlap
+        /// are rejected together rather than querying once per proxy.
+        template <typename Callback>
+        void queryPairs(Callback &&callback) const
+        {
+            if (mRoot == kNullNode)
+            {
+                return;
+            }
+            // a pair with first == second means "all pairs within this subtree"
+            std::vector<std::pair<int32_t, int32_t>> stack;
+            stack.emplace_back(mRoot, mRoot);
+            while (!stack.empty())
+            {
+                auto [a, b] = stack.back();
+                stack.pop_back();
+                const auto &nodeA = mNodes[a];
+                if (a == b)
+                {
+                    if (!nodeA.isLeaf())
+                    {
+                        stack.emplace_back(nodeA.child1, nodeA.child1);
+                        stack.emplace_back(nodeA.child2, nodeA.child2);
+                        stack.emplace_back(nodeA.child1, nodeA.child2);
+                    }
+                    continue;
+                }
+                const auto &nodeB = mNodes[b];
+                if (!overlaps(nodeA.box, nodeB.box))
+                {
+                    continue;
+                }
+                if (nodeA.isLeaf() && nodeB.isLeaf())
+                {
+                    callback(std::min(a, b), std::max(a, b));
+                }
+                else if (nodeB.isLeaf() || (!nodeA.isLeaf() && nodeA.height >= nodeB.height))
+                {
+                    // descend into the taller subtree
+                    stack.emplace_back(nodeA.child1, b);
+                    stack.emplace_back(nodeA.child2, b);
+                }
+                else
+                {
+                    stack.emplace_back(a, nodeB.child1);
+                    stack.emplace_back(a, nodeB.child2);
+                }
+            }
+        }
+
+        /// @brief Returns true if the ray origin + t * (1 / [inverseDirection]) enters [box]
+        /// for some t in [0, maxT], writing the entry distance to [tEnter].
+        static bool intersects(const filament::Aabb &box, const filament::math::float3 &origin,
+                               const filament::math::float3 &inverseDirection, float maxT, float &tEnter)
+        {
+            float tMin = 0.0f;
+            float tMax = maxT;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                float t1 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+                float t2 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+                // NaN (a ray parallel to, and lying in, a slab plane) compares false and is ignored
+                tMin = std::max(tMin, std::min(t1, t2));
+                tMax = std::min(tMax, std::max(t1, t2));
+            }
+            tEnter = tMin;
+            return tMin <= tMax;
+        }
+
+        /// @brief Calls [callback](proxyId) for every proxy whose fat box is hit by the ray
+        /// origin + t * direction for t in [0, maxT], nearest subtrees first.
+        ///
+        /// [callback] returns the new maxT (i.e. the distance to the closest hit
+        /// found so far), so boxes further away than that are culled.
+        template <typename Callback>
+        void rayCast(const filament::math::float3 &origin, const filament::math::float3 &direction, float maxT, Callback &&callback) const
+        {
+            const filament::math::float3 inverseDirection = 1.0f / direction;
+            Stack stack;
+            stack.push(mRoot);
+            while (!stack.empty())
+            {
+                int32_t nodeId = stack.pop();
+                if (nodeId == kNullNode)
+                {
+                    continue;
+                }
+                const auto &node = mNodes[nodeId];
+                float tEnter;
+                if (!intersects(node.box, origin, inverseDirection, maxT, tEnter))
+                {
+                    continue;
+                }
+                if (node.isLeaf())
+                {
+                    maxT = callback(nodeId);
+                    continue;
+                }
+                float t1, t2;
+                bool hit1 = intersects(mNodes[node.child1].box, origin, inverseDirection, maxT, t1);
+                bool hit2 = intersects(mNodes[node.child2].box, origin, inverseDirection, maxT, t2);
+                // push the further child first so the nearer one is visited first
+                if (hit1 && hit2)
+                {
+                    stack.push(t1 <= t2 ? node.child2 : node.child1);
+                    stack.push(t1 <= t2 ? node.child1 : node.child2);
+                }
+                else if (hit1)
+                {
+                    stack.push(node.child1);
+                }
+                else if (hit2)
+                {
+                    stack.push(node.child2);
+                }
+            }
+        }
+
+    private:
+        struct Node
+        {
+            filament::Aabb box;
+            uint32_t userData = 0;
+            // the parent for nodes in the tree, or the next free node for free nodes
+            int32_t parent = kNullNode;
+            int32_t child1 = kNullNode;
+            int32_t child2 = kNullNode;
+            // 0 for leaves, -1 for free nodes
+            int32_t height = -1;
+
+            bool isLeaf() const
+            {
+                return child1 == kNullNode;
+            }
+        };
+
+        // a traversal stack that only allocates for unusually deep trees
+        class Stack
+        {
+        public:
+            void push(int32_t nodeId)
+            {
+                if (mSize < mFixed.size())
+                {
+                    mFixed[mSize] = nodeId;
+                }
+                else
+                {
+                    mOverflow.push_back(nodeId);
+                }
+                mSize++;
+            }
+
+            int32_t pop()
+            {
+                mSize--;
+                if (mSize < mFixed.size())
+                {
+                    return mFixed[mSize];
+                }
+                auto nodeId = mOverflow.back();
+                mOverflow.pop_back();
+                return nodeId;
+            }
+
+            bool empty() const
+            {
+                return mSize == 0;
+            }
+
+        private:
+            std::array<int32_t, 128> mFixed;
+            std::vector<int32_t> mOverflow;
+            size_t mSize = 0;
+        };
+
+        int32_t allocateNode();
+        void freeNode(int32_t nodeId);
+        void insertLeaf(int32_t leaf);
+        void removeLeaf(int32_t leaf);
+        int32_t balance(int32_t nodeId);
+
+        float mMargin;
+        std::vector<Node> mNodes;
+        int32_t mRoot = kNullNode;
+        int32_t mFreeList = kNullNode;
+        size_t mProxyCount = 0;
+    };
+
+} // namespace thermion
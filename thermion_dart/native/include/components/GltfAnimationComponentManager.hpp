@@ -15,6 +15,7 @@
 #include <gltfio/Animator.h>
 #include <gltfio/math.h>
 
+#include <utils/JobSystem.h>
 #include <utils/SingleInstanceComponentManager.h>
 
 #include "Log.hpp"
@@ -50,6 +51,10 @@ namespace thermion
         int fadeGltfAnimationIndex = -1;
         float fadeDuration = 0.0f;
         float fadeOutAnimationStart = 0.0f;
+        // applying a glTF animation with morph target weight channels calls
+        // RenderableManager::setMorphWeights, which isn't safe to call from
+        // multiple threads; these components are always updated serially
+        bool hasMorphTargets = false;
         std::vector<GltfAnimation> animations;
     };
 
@@ -63,12 +68,26 @@ namespace thermion
             void addAnimationComponent(FilamentInstance *target);
             void removeAnimationComponent(FilamentInstance *target);
 
-            bool addGltfAnimation(FilamentInstance *target, int index, bool loop, bool reverse, bool replaceActive, float crossfade, float startOffset);
+            /// @brief Starts the glTF animation at [index] at animation clock time [nowInNanos].
+            bool addGltfAnimation(FilamentInstance *target, int index, bool loop, bool reverse, bool replaceActive, float crossfade, float startOffset, uint64_t nowInNanos);
             // GltfAnimationComponent getAnimationComponentInstance(FilamentInstance *target);
-            void update(); 
+
+            /// @brief Applies all active glTF animations at animation clock time [nowInNanos], spreading components across
+            /// [jobSystem] (if non-null). This must be called with a local transform
+            /// transaction open, since bone matrices can only be updated once world
+            /// transforms have been recomputed; animators that need their bone matrices
+            /// updated are appended to [dirtyAnimators].
+            void update(uint64_t nowInNanos, utils::JobSystem *jobSystem, std::vector<Animator *> &dirtyAnimators);
 
         private:
+            static constexpr uint32_t kMinComponentsPerJob = 8;
+
+            bool updateComponent(Instance componentInstance, uint64_t nowInNanos);
+
             filament::TransformManager &mTransformManager;
             filament::RenderableManager &mRenderableManager;
+            // one entry per component, written by whichever job updated it
+            // (not vector<bool>, since its elements share storage)
+            std::vector<uint8_t> mUpdated;
     };
 }
\ No newline at end of file
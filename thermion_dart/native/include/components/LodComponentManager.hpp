@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include <filament/Engine.h>
+#include <filament/View.h>
+#include <utils/Entity.h>
+#include <utils/SingleInstanceComponentManager.h>
+
+#include "scene/LodChain.hpp"
+
+namespace thermion
+{
+
+    ///
+    /// Switches the index buffer of each renderable with an LOD component
+    /// between the levels of its LodChain, once per frame.
+    ///
+    /// The level is the coarsest whose simplification error, projected to
+    /// the view's viewport (from the renderable's world bounding sphere and
+    /// the camera's projection), is at most kMaxPixelError * 2^bias pixels.
+    /// A renderable only switches to a coarser level once that level's error
+    /// is below the threshold by kHysteresis, and back to a finer level once
+    /// the current level's error is above it by kHysteresis, so renderables
+    /// near a threshold don't alternate between levels every frame.
+    ///
+    /// Remove an entity's component before destroying its asset.
+    ///
+    class LodComponentManager : public utils::SingleInstanceComponentManager<
+                                    std::shared_ptr<LodChain>,
+                                    uint8_t>
+    {
+    public:
+        static constexpr float kMaxPixelError = 1.0f;
+        static constexpr float kHysteresis = 0.25f;
+
+        LodComponentManager(filament::Engine *engine, filament::View *view) : mEngine(engine), mView(view) {}
+
+        void addLodComponent(utils::Entity entity, std::shared_ptr<LodChain> lodChain);
+
+        void removeLodComponent(utils::Entity entity);
+
+        /// @brief Positive values select coarser levels (each +1 doubles the permitted error),
+        /// negative values finer levels.
+        void setBias(float bias);
+
+        float getBias() const { return mBias; }
+
+        /// @brief The level currently rendered for [entity] (or -1 if it has no LOD component).
+        int32_t getCurrentLevel(utils::Entity entity);
+
+        /// @brief Selects the level for each component. Call once per frame, before rendering.
+        void update();
+
+    private:
+        std::mutex mMutex;
+        filament::Engine *mEngine = std::nullptr_t();
+        filament::View *mView = std::nullptr_t();
+        float mBias = 0.0f;
+    };
+
+} // namespace thermion
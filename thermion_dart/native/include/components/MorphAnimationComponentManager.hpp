@@ -36,15 +36,22 @@ namespace thermion
         float frameLengthInMs = 0;
         std::vector<float> frameData;
         std::vector<int> morphIndices; 
+        bool completed = false;
     };
 
 
-    /// @brief 
+    /// @brief The morph animations for a single renderable, together with the
+    /// weights most recently written for each of its morph targets.
     ///
+    /// All animations are sampled into [weights] and each contiguous run of
+    /// driven targets is then uploaded with one setMorphWeights call per frame.
+    /// Concurrent animations that target the same morph target are blended
+    /// additively; targets not driven by any animation aren't written at all.
     ///
     struct MorphAnimationComponent
     {
         std::vector<MorphAnimation> animations;
+        std::vector<float> weights;
     };
 
     class MorphAnimationComponentManager : public utils::SingleInstanceComponentManager<MorphAnimationComponent> {
@@ -57,11 +64,20 @@ namespace thermion
             
             void addAnimationComponent(Entity entity);
             void removeAnimationComponent(Entity entity);
-            void update(); 
+            /// @brief Applies all active morph animations at animation clock time [nowInNanos].
+            void update(uint64_t nowInNanos);
+
+            /// @brief Records [weights] (starting at morph target [offset]) as the
+            /// current weights for [entity] (see AnimationManager::getMorphTargetWeights).
+            void setWeights(Entity entity, const float *const weights, size_t count, size_t offset = 0);
 
         private:
+            void sample(const MorphAnimation &animation, float elapsedInSecs, std::vector<float> &weights);
+
             filament::TransformManager &mTransformManager;
             filament::RenderableManager &mRenderableManager;
+            // scratch: which morph targets of the current component are driven
+            std::vector<bool> mDriven;
     };
 
 }
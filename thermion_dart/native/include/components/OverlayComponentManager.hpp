@@ -1,12 +1,13 @@
 #pragma once
 
-#include <map>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <math/mat4.h>
 
 #include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
 #include <filament/Material.h>
 #include <filament/MaterialInstance.h>
 #include <filament/Renderer.h>
@@ -16,17 +17,68 @@
 #include <filament/Texture.h>
 #include <filament/TextureSampler.h>
 #include <filament/TransformManager.h>
+#include <filament/VertexBuffer.h>
 #include <filament/View.h>
+#include <filament/Viewport.h>
+#include <gltfio/FilamentInstance.h>
 #include <utils/SingleInstanceComponentManager.h>
 
 #include "c_api/APIBoundaryTypes.h"
 #include "material/linear_depth.h"
 
+struct cgltf_primitive;
+
 namespace thermion
 {
 
-    /// @brief
-    class OverlayComponentManager : public utils::SingleInstanceComponentManager<filament::MaterialInstance *>
+    class GeometrySceneAsset;
+    class GltfSceneAssetInstance;
+    class SceneAsset;
+
+    /// The renderables that outline a single (source) renderable.
+    struct OverlayRenderable
+    {
+        utils::Entity source;
+        // drawn with the depth material in the depth prepass
+        utils::Entity depth;
+        // drawn with the overlay material in the outline pass
+        utils::Entity outline;
+        // the (shared) glTF geometry, released when the overlay is destroyed
+        std::vector<const cgltf_primitive *> primitives;
+        // the instance whose skin the overlay is attached to (if any)
+        filament::gltfio::FilamentInstance *skinInstance = std::nullptr_t();
+        size_t skinIndex = 0;
+        // the world transform the depth prepass was last rendered with
+        filament::math::mat4f worldTransform;
+    };
+
+    ///
+    /// Renders an outline around each scene asset with an overlay component.
+    ///
+    /// Outlines are drawn with dedicated renderables (parented to the outlined
+    /// renderables, so they follow their transforms) whose materials are set
+    /// once when the component is added: one with the depth material for the
+    /// depth prepass and one with the overlay material for the outline pass,
+    /// separated by layer. The asset's own renderables are never modified.
+    ///
+    /// A GeometrySceneAsset's overlay renderables share its vertex and index
+    /// buffers. gltfio doesn't expose the buffers of a glTF asset, so for
+    /// glTF assets the positions, indices and (for skinned nodes) joints and
+    /// weights are read from the retained source data into buffers that are
+    /// shared by every outlined instance of the same primitive. Skinned
+    /// overlays follow the instance's skin (see FilamentInstance::attachSkin);
+    /// morph targets are not applied to the outline.
+    ///
+    /// Overlays are drawn with two dedicated views (with post-processing and
+    /// shadows disabled) over the overlay scene:
+    /// 1) a depth prepass into the overlay render target, which is only
+    ///    re-rendered when the overlay set, camera, viewport or an overlay
+    ///    renderable's transform has changed (or it is skinned)
+    /// 2) the outline pass, composited over the main view's render target.
+    ///
+    class OverlayComponentManager : public utils::SingleInstanceComponentManager<
+                                        filament::MaterialInstance *,
+                                        std::vector<OverlayRenderable>>
     {
     public:
         OverlayComponentManager(
@@ -34,143 +86,45 @@ namespace thermion
             filament::View *view,
             filament::Scene *scene,
             filament::RenderTarget *renderTarget,
-            filament::Renderer *renderer) : mEngine(engine), mView(view), mScene(scene), mRenderTarget(renderTarget), mRenderer(renderer)
-        {
-            mDepthMaterial = filament::Material::Builder()
-                                 .package(LINEAR_DEPTH_LINEAR_DEPTH_DATA, LINEAR_DEPTH_LINEAR_DEPTH_SIZE)
-                                 .build(*engine);
-            mDepthMaterialInstance = mDepthMaterial->createInstance();
-        }
-
-        ~OverlayComponentManager() {
-            mEngine->destroy(mDepthMaterialInstance);
-            mEngine->destroy(mDepthMaterial);
-        }
-
-        void setRenderTarget(filament::RenderTarget *renderTarget) {
-            std::lock_guard lock(mMutex);
-            mRenderTarget = renderTarget;
-            auto *color = mRenderTarget->getTexture(filament::RenderTarget::AttachmentPoint::COLOR);
-            for (auto it = begin(); it < end(); it++)
-            {
-                const auto &entity = getEntity(it);
-                auto componentInstance = getInstance(entity);
-                auto &materialInstance = elementAt<0>(componentInstance);    
-                materialInstance->setParameter("depth", color, mDepthSampler);
-            }
-
-        }
-
-        void addOverlayComponent(utils::Entity target, filament::MaterialInstance *materialInstance)
-        {
-            std::lock_guard lock(mMutex);
-            
-            auto &rm = mEngine->getRenderableManager();
-            auto ri = rm.getInstance(target);
-
-            if(!ri.isValid()) {
-                return;
-            }
-
-            auto bb = rm.getAxisAlignedBoundingBox(ri);
-
-            auto *color = mRenderTarget->getTexture(filament::RenderTarget::AttachmentPoint::COLOR);
-            materialInstance->setParameter("depth", color, mDepthSampler);
-            materialInstance->setParameter("bbCenter", bb.center);
-            if (!hasComponent(target))
-            {
-                utils::EntityInstanceBase::Type componentInstance = addComponent(target);
-                this->elementAt<0>(componentInstance) = materialInstance;
-            }
-            mScene->addEntity(target);
-        }
-
-        void removeOverlayComponent(utils::Entity target)
-        {
-            std::lock_guard lock(mMutex);
+            filament::Renderer *renderer);
 
-            if (hasComponent(target))
-            {
-                removeComponent(target);
-            }
-            mScene->remove(target);
-        }
+        ~OverlayComponentManager();
 
-        void update()
-        {
-            if (!mView || !mScene || !mRenderTarget || getComponentCount() == 0)
-            {
-                return;
-            }
-
-            std::lock_guard lock(mMutex);
-            auto &rm = mEngine->getRenderableManager();
-            std::map<utils::Entity, std::vector<filament::MaterialInstance *>> materials;
-            auto *scene = mView->getScene();
-            auto *renderTarget = mView->getRenderTarget();
-            mView->setRenderTarget(mRenderTarget);
-            mView->setScene(mScene);
-
-            for (auto it = begin(); it < end(); it++)
-            {
-                const auto &entity = getEntity(it);
-
-                auto ri = rm.getInstance(entity);
-                if (ri.isValid())
-                {
-
-                    for (int i = 0; i < rm.getPrimitiveCount(ri); i++)
-                    {
-                        auto *existing = rm.getMaterialInstanceAt(ri, i);
-                        materials[entity].push_back(existing);
-                        rm.setMaterialInstanceAt(ri, i, mDepthMaterialInstance);
-                    }
-                }
-                else
-                {
-                    Log("WARNING: INVALID RENDERABLE");
-                }
-            }
-
-            mRenderer->render(mView);
-
-            mView->setRenderTarget(renderTarget);
-
-            for (auto it = begin(); it < end(); it++)
-            {
-                const auto &entity = getEntity(it);
-                auto componentInstance = getInstance(entity);
-                auto &materialInstance = elementAt<0>(componentInstance);
-
-                auto ri = rm.getInstance(entity);
-                if (ri.isValid())
-                {
-                    for (int i = 0; i < rm.getPrimitiveCount(ri); i++)
-                    {
-                        rm.setMaterialInstanceAt(ri, i, materialInstance);
-                    }
-                }
-                else
-                {
-                    Log("WARNING: INVALID RENDERABLE");
-                }
-            }
-
-            mRenderer->render(mView);
-
-            for (auto it = begin(); it < end(); it++)
-            {
-                const auto &entity = getEntity(it);
-                auto ri = rm.getInstance(entity);
-                for (int i = 0; i < rm.getPrimitiveCount(ri); i++)
-                {
-                    rm.setMaterialInstanceAt(ri, i, materials[entity][i]);
-                }
-            }
-            mView->setScene(scene);
-        }
+        void setRenderTarget(filament::RenderTarget *renderTarget);
+
+        /// @brief Outlines [target] (either the asset's entity, for the whole
+        /// asset, or one of its renderable child entities) with [materialInstance].
+        /// Must be called on the engine thread.
+        void addOverlayComponent(SceneAsset *asset, utils::Entity target, filament::MaterialInstance *materialInstance);
+
+        /// @brief Must be called on the engine thread.
+        void removeOverlayComponent(utils::Entity target);
+
+        /// @brief Forces the depth prepass to be re-rendered on the next update
+        /// (e.g. after changing the geometry of an overlay entity).
+        void invalidate();
+
+        /// @brief Renders the overlay. Call once per frame, after the main view has been rendered.
+        void update();
 
     private:
+        struct SharedGeometry
+        {
+            filament::VertexBuffer *vertexBuffer = std::nullptr_t();
+            filament::IndexBuffer *indexBuffer = std::nullptr_t();
+            filament::RenderableManager::PrimitiveType primitiveType;
+            bool skinned = false;
+            size_t useCount = 0;
+        };
+
+        bool isDepthPrepassValid();
+        void addGeometryOverlays(GeometrySceneAsset *asset, std::vector<OverlayRenderable> &overlays, filament::MaterialInstance *materialInstance);
+        void addGltfOverlays(GltfSceneAssetInstance *instance, utils::Entity only, std::vector<OverlayRenderable> &overlays, filament::MaterialInstance *materialInstance);
+        SharedGeometry *acquireGltfGeometry(const cgltf_primitive *primitive);
+        void releaseGltfGeometry(const cgltf_primitive *primitive);
+        OverlayRenderable createOverlay(utils::Entity source, const std::vector<SharedGeometry> &geometry, size_t jointCount, filament::MaterialInstance *materialInstance);
+        void destroyOverlay(OverlayRenderable &overlay);
+
         std::mutex mMutex;
         filament::Engine *mEngine = std::nullptr_t();
         filament::View *mView = std::nullptr_t();
@@ -180,5 +134,16 @@ namespace thermion
         filament::Material *mDepthMaterial = std::nullptr_t();
         filament::MaterialInstance *mDepthMaterialInstance = std::nullptr_t();
         filament::TextureSampler mDepthSampler;
+
+        filament::View *mDepthView = std::nullptr_t();
+        filament::View *mOutlineView = std::nullptr_t();
+
+        std::unordered_map<const cgltf_primitive *, SharedGeometry> mGltfGeometry;
+
+        // the state the depth prepass was last rendered with
+        bool mDepthPrepassValid = false;
+        filament::math::mat4 mDepthPrepassViewMatrix;
+        filament::math::mat4 mDepthPrepassProjectionMatrix;
+        filament::Viewport mDepthPrepassViewport;
     };
 }
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <filament/Engine.h>
+#include <filament/Texture.h>
+
+namespace thermion
+{
+
+    ///
+    /// An image decoded (with stb) to 8-bit RGBA.
+    ///
+    /// Unlike Image_decode, the pixels are never converted to a floating point
+    /// LinearImage; they are uploaded as-is to an SRGB8_A8 texture (so the GPU
+    /// performs the sRGB-to-linear conversion when sampling) or, for linear
+    /// data such as normal maps, an RGBA8 texture.
+    ///
+    class DecodedImage
+    {
+    public:
+        /// @brief Decodes [data] (any format supported by stb_image). This can be
+        /// called from any thread. Returns null if the data can't be decoded.
+        static std::unique_ptr<DecodedImage> decode(const uint8_t *data, size_t length);
+
+        ~DecodedImage();
+
+        DecodedImage(const DecodedImage &) = delete;
+        DecodedImage &operator=(const DecodedImage &) = delete;
+
+        uint32_t getWidth() const { return mWidth; }
+        uint32_t getHeight() const { return mHeight; }
+
+        /// @brief Creates a 2D texture and uploads the image to its first level. The
+        /// pixels are handed to the upload, so this can only be called once.
+        /// If [generateMipmaps] is true (and the format supports it), the texture is
+        /// created with a full mip chain that is generated on the GPU.
+        /// Must be called on the engine thread.
+        filament::Texture *createTexture(filament::Engine &engine, bool sRGB, bool generateMipmaps);
+
+    private:
+        DecodedImage(uint8_t *pixels, uint32_t width, uint32_t height) : mPixels(pixels), mWidth(width), mHeight(height) {}
+
+        uint8_t *mPixels = nullptr;
+        uint32_t mWidth = 0;
+        uint32_t mHeight = 0;
+    };
+
+} // namespace thermion
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace thermion {
+
+/**
+ * @brief Counters describing how well frames are being paced.
+ *
+ * A frame is "late" if it began more than half an interval after its
+ * scheduled slot (i.e. the render thread was busy); "dropped" counts the
+ * slots that passed with no frame at all; "skipped" counts frames where
+ * Renderer::beginFrame declined to render (i.e. the GPU is behind).
+ */
+struct FrameSchedulerStats {
+    uint64_t framesRendered = 0;
+    uint64_t lateFrames = 0;
+    uint64_t droppedFrames = 0;
+    uint64_t skippedFrames = 0;
+    uint64_t coalescedRequests = 0;
+    uint64_t frameIntervalInNanos = 0;
+    uint64_t lastLatenessInNanos = 0;
+    uint64_t maxLatenessInNanos = 0;
+};
+
+/**
+ * @brief Decides when the next frame should begin and what frame time to
+ * pass to Renderer::beginFrame.
+ *
+ * There are three modes:
+ * - unpaced (the default): frames are rendered as soon as they are
+ *   requested, with the current steady_clock time as the frame time.
+ * - fixed interval (setTargetFrameInterval): frames are aligned to a
+ *   fixed grid of slots [interval] nanoseconds apart.
+ * - external vsync (onVsync): frames are aligned to the most recent vsync
+ *   timestamp, and the next vsync is predicted from the measured period.
+ *
+ * All timestamps are nanoseconds in the std::chrono::steady_clock time base
+ * (which is what Filament expects for beginFrame).
+ *
+ * setTargetFrameInterval, onVsync, onFrameRequested and cancelFrameRequest
+ * may be called from any thread; everything else must be called from the
+ * render thread.
+ */
+class FrameScheduler {
+public:
+    static uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /**
+     * @brief Sets the target interval between frames (0 to disable pacing).
+     */
+    void setTargetFrameInterval(uint64_t intervalInNanos);
+
+    /**
+     * @brief Records an external (hardware/platform) vsync timestamp.
+     * Once called, frames are aligned to vsync rather than the fixed interval.
+     * Pass 0 to revert to fixed-interval/unpaced scheduling.
+     */
+    void onVsync(uint64_t vsyncTimeInNanos);
+
+    /**
+     * @brief Records a frame request; [coalesced] should be true if a
+     * frame was already pending (and this request was merged into it).
+     */
+    void onFrameRequested(bool coalesced);
+
+    /**
+     * @brief Discards the pending frame request (if any) without counting
+     * a skipped frame, e.g. because there is no swapchain to render into.
+     */
+    void cancelFrameRequest();
+
+    /**
+     * @brief Returns the time at which the next frame should begin, or
+     * 0 if it can begin immediately.
+     */
+    uint64_t getNextFrameTime();
+
+    /**
+     * @brief Called immediately before beginFrame; returns the frame
+     * time to pass to beginFrame and updates late/dropped counters.
+     */
+    uint64_t beginFrame(uint64_t now);
+
+    /**
+     * @brief Called after all swapchains have been processed. [rendered]
+     * is false if beginFrame returned false for every swapchain.
+     */
+    void endFrame(bool rendered);
+
+    FrameSchedulerStats getStats();
+
+private:
+    uint64_t getFrameInterval();
+    uint64_t getSlotTime(uint64_t time);
+
+    // after a skipped frame in unpaced mode, wait this long before retrying
+    static constexpr uint64_t kSkippedFrameRetryIntervalInNanos = 2'000'000;
+
+    std::atomic<uint64_t> mTargetInterval = 0;
+    std::atomic<uint64_t> mLastVsync = 0;
+    std::atomic<uint64_t> mVsyncPeriod = 0;
+    std::atomic<uint64_t> mCoalescedRequests = 0;
+    // time of the first frame request since the last frame was rendered
+    std::atomic<uint64_t> mPendingSince = 0;
+
+    // render thread only
+    uint64_t mLastSlot = 0;
+    uint64_t mCurrentSlot = 0;
+    uint64_t mLastFrameBegin = 0;
+    bool mLastFrameSkipped = false;
+
+    std::atomic<uint64_t> mFramesRendered = 0;
+    std::atomic<uint64_t> mLateFrames = 0;
+    std::atomic<uint64_t> mDroppedFrames = 0;
+    std::atomic<uint64_t> mSkippedFrames = 0;
+    std::atomic<uint64_t> mLastLateness = 0;
+    std::atomic<uint64_t> mMaxLateness = 0;
+};
+
+} // namespace thermion
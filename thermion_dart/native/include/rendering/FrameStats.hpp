@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+namespace thermion {
+
+/**
+ * @brief CPU timings (in nanoseconds) for a single call to RenderTicker::render.
+ *
+ * Task drain time/count covers all tasks executed by the render thread
+ * since the previous frame.
+ */
+struct FrameTiming {
+    static constexpr uint32_t kMaxViews = 8;
+
+    uint64_t frameIndex = 0;
+    uint64_t frameTimeInNanos = 0;
+    uint64_t animationUpdateTimeInNanos = 0;
+    uint64_t beginFrameTimeInNanos = 0;
+    uint64_t overlayTimeInNanos = 0;
+    uint64_t endFrameTimeInNanos = 0;
+    uint64_t taskDrainTimeInNanos = 0;
+    uint64_t totalTimeInNanos = 0;
+    uint32_t tasksExecuted = 0;
+    // views beyond kMaxViews are included in totalTimeInNanos only
+    uint32_t numViews = 0;
+    std::array<uint64_t, kMaxViews> viewRenderTimeInNanos{};
+    bool rendered = false;
+};
+
+/**
+ * @brief A fixed-size ring buffer holding the timings for the most recent frames.
+ *
+ * Records are written once per frame by the render thread and can be read
+ * from any thread. This is always enabled (unlike TRACE), so the cost of
+ * recording must stay negligible.
+ */
+class FrameStats {
+public:
+    static constexpr uint32_t kCapacity = 128;
+
+    /**
+     * @brief Accumulates render thread task execution time; this is
+     * attributed to the next frame that is recorded.
+     */
+    void addTaskTime(uint64_t durationInNanos, uint32_t numTasks);
+
+    /**
+     * @brief Appends [timing] (overwriting the oldest record if the buffer is
+     * full) and assigns its frameIndex.
+     */
+    void record(FrameTiming &timing);
+
+    /**
+     * @brief Copies up to [maxRecords] of the most recent records (oldest first)
+     * into [out].
+     *
+     * @return the number of records copied
+     */
+    uint32_t getRecords(FrameTiming *out, uint32_t maxRecords);
+
+private:
+    std::mutex mMutex;
+    std::array<FrameTiming, kCapacity> mRecords;
+    uint64_t mNumRecorded = 0;
+    uint64_t mPendingTaskTimeInNanos = 0;
+    uint32_t mPendingTasks = 0;
+};
+
+} // namespace thermion
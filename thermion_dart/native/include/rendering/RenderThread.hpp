@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
@@ -8,6 +9,7 @@
 #include <thread>
 
 #include "RenderTicker.hpp"
+#include "rendering/TaskQueue.hpp"
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten/threading.h>
@@ -17,6 +19,18 @@
 
 namespace thermion {
 
+/**
+ * @brief Cumulative counters describing how the render thread has spent its time.
+ */
+struct RenderThreadStats {
+    uint64_t idleTimeInNanos = 0;
+    uint64_t busyTimeInNanos = 0;
+    uint64_t wakeups = 0;
+    uint64_t tasksExecuted = 0;
+    uint64_t framesRendered = 0;
+    float fps = 0.0f;
+};
+
 /**
  * @brief A render loop implementation that manages rendering on a separate thread.
  * 
@@ -45,9 +59,13 @@ public:
     /**
      * @brief Sets the render ticker used.
      */
-    void setRenderTicker(RenderTicker *renderTicker) {
-        mRenderTicker = renderTicker;
-    }
+    void setRenderTicker(RenderTicker *renderTicker);
+
+    /**
+     * @brief Returns the time spent blocked waiting for work vs. executing
+     * tasks/rendering since the thread was started.
+     */
+    RenderThreadStats getStats();
 
     /**
      * @brief Adds a task to the render thread's task queue.
@@ -58,8 +76,26 @@ public:
     template <class Rt>
     auto add_task(std::packaged_task<Rt()>& pt) -> std::future<Rt>;
 
+    /**
+     * @brief Adds a callable to the render thread's task queue.
+     * 
+     * Unlike add_task, this doesn't create a future, so callables with
+     * captures up to Task::kInlineSize bytes are enqueued without any
+     * heap allocation. Safe to call from any thread (including the render
+     * thread itself).
+     */
+    template <class F>
+    void enqueue(F&& fn) {
+        Task task(std::forward<F>(fn));
+        push(task);
+    }
+
     /**
      * @brief Main iteration of the render loop.
+     *
+     * Blocks (on non-emscripten builds) until a task or a frame request is
+     * available, then executes all pending tasks as a single batch before
+     * rendering the requested frame (if any).
      */
     void iter();
 
@@ -73,29 +109,52 @@ public:
     /**
      * 
      */
-    bool mStop = false;
+    std::atomic<bool> mStop = false;
 
     /**
      * 
      */
-    bool mRestart = false;
+    std::atomic<bool> mRestart = false;
     
     #ifdef __EMSCRIPTEN__
     emscripten::ProxyingQueue queue;
     pthread_t outer;
     #endif
 
-    bool mRendered = false;
-    bool mRender = false;
+    std::atomic<bool> mRendered = false;
+    std::atomic<bool> mRender = false;
 
 private:
+    void push(Task& task);
+    uint32_t drainTasks();
+    bool hasPendingWork();
+    bool isFramePending();
+    void onRenderableAdded();
+    uint64_t getNextFrameTime();
+    void render();
+
+    static constexpr size_t kTaskQueueCapacity = 4096;
+
+    // _taskMutex no longer guards the task queue itself; it is only used to
+    // block/wake the render thread and to guard the overflow list.
     std::mutex _taskMutex;
     std::condition_variable _cv;
-    std::deque<std::function<void()>> _tasks;
+    TaskQueue _tasks{kTaskQueueCapacity};
+    // tasks that didn't fit in _tasks. While _overflowing is set, all new
+    // tasks are appended here (rather than to _tasks) to preserve ordering.
+    std::deque<Task> _overflow;
+    std::atomic<bool> _overflowing = false;
+    std::atomic<bool> _sleeping = false;
     std::chrono::high_resolution_clock::time_point _lastFrameTime;
     int _frameCount = 0;
     float _accumulatedTime = 0.0f;
-    float _fps = 0.0f;
+    std::atomic<float> _fps = 0.0f;
+
+    std::atomic<uint64_t> _idleTimeInNanos = 0;
+    std::atomic<uint64_t> _busyTimeInNanos = 0;
+    std::atomic<uint64_t> _wakeups = 0;
+    std::atomic<uint64_t> _tasksExecuted = 0;
+    std::atomic<uint64_t> _framesRendered = 0;
 
     
 #ifdef __EMSCRIPTEN__
@@ -103,25 +162,14 @@ private:
 #else
     std::thread* t = nullptr;
 #endif
-    RenderTicker* mRenderTicker = nullptr;
+    std::atomic<RenderTicker*> mRenderTicker = nullptr;
 };
 
 // Template implementation
 template <class Rt>
 auto RenderThread::add_task(std::packaged_task<Rt()>& pt) -> std::future<Rt> {
-    
-    
-    std::unique_lock<std::mutex> lock(_taskMutex);
-    
     auto ret = pt.get_future();
-    _tasks.push_back([pt = std::make_shared<std::packaged_task<Rt()>>(
-                         std::move(pt))]
-                    { (*pt)(); });
-    #ifndef __EMSCRIPTEN__
-    _cv.notify_one();
-    #endif
-    
-    
+    enqueue(std::move(pt));
     return ret;
 }
 
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace thermion {
+
+/**
+ * @brief A type-erased, move-only `void()` callable.
+ *
+ * Callables whose size/alignment fit within kInlineSize are stored inline,
+ * so wrapping a lambda with a typical capture list never allocates. Larger
+ * callables fall back to a heap allocation.
+ */
+class Task {
+public:
+    static constexpr size_t kInlineSize = 104;
+
+    Task() noexcept = default;
+
+    template <class F,
+              class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+    Task(F&& fn) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>()) {
+            new (mStorage) Fn(std::forward<F>(fn));
+            mVTable = &kInlineVTable<Fn>;
+        } else {
+            *reinterpret_cast<Fn**>(mStorage) = new Fn(std::forward<F>(fn));
+            mVTable = &kHeapVTable<Fn>;
+        }
+    }
+
+    Task(Task&& other) noexcept {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        reset();
+    }
+
+    void operator()() {
+        mVTable->invoke(mStorage);
+    }
+
+    explicit operator bool() const noexcept {
+        return mVTable != nullptr;
+    }
+
+    void reset() noexcept {
+        if (mVTable) {
+            mVTable->destroy(mStorage);
+            mVTable = nullptr;
+        }
+    }
+
+private:
+    struct VTable {
+        void (*invoke)(void* storage);
+        // move-constructs into dst and destroys src
+        void (*relocate)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <class Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(Fn) <= kInlineSize &&
+               alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <class Fn>
+    static constexpr VTable kInlineVTable = {
+        [](void* storage) { (*std::launder(reinterpret_cast<Fn*>(storage)))(); },
+        [](void* dst, void* src) noexcept {
+            auto* fn = std::launder(reinterpret_cast<Fn*>(src));
+            new (dst) Fn(std::move(*fn));
+            fn->~Fn();
+        },
+        [](void* storage) noexcept { std::launder(reinterpret_cast<Fn*>(storage))->~Fn(); },
+    };
+
+    template <class Fn>
+    static constexpr VTable kHeapVTable = {
+        [](void* storage) { (**reinterpret_cast<Fn**>(storage))(); },
+        [](void* dst, void* src) noexcept {
+            *reinterpret_cast<Fn**>(dst) = *reinterpret_cast<Fn**>(src);
+        },
+        [](void* storage) noexcept { delete *reinterpret_cast<Fn**>(storage); },
+    };
+
+    void moveFrom(Task& other) noexcept {
+        if (other.mVTable) {
+            other.mVTable->relocate(mStorage, other.mStorage);
+            mVTable = other.mVTable;
+            other.mVTable = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char mStorage[kInlineSize];
+    const VTable* mVTable = nullptr;
+};
+
+/**
+ * @brief A bounded, lock-free multi-producer/single-consumer queue of Tasks.
+ *
+ * This is a ring buffer of fixed-size slots, each tagged with a sequence
+ * number (see Dmitry Vyukov's bounded MPMC queue). Producers claim a slot
+ * with a single CAS on the enqueue position; the (single) consumer never
+ * contends with producers.
+ *
+ * push() fails (without consuming the task) when the queue is full; the
+ * caller is responsible for handling overflow.
+ */
+class TaskQueue {
+public:
+    explicit TaskQueue(size_t capacity) : mMask(capacity - 1), mSlots(new Slot[capacity]) {
+        // capacity must be a power of two
+        for (size_t i = 0; i < capacity; i++) {
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
+    size_t capacity() const {
+        return mMask + 1;
+    }
+
+    /**
+     * @brief Enqueues a task. Safe to call from any thread.
+     *
+     * @return false if the queue is full (in which case [task] is left untouched)
+     */
+    bool push(Task& task) {
+        Slot* slot;
+        size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &mSlots[pos & mMask];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->task = std::move(task);
+        // seq_cst (rather than release) so that a producer that subsequently
+        // reads the consumer's "sleeping" flag can't miss a consumer that is
+        // about to check empty() and block.
+        slot->sequence.store(pos + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    /**
+     * @brief Dequeues the oldest task. Must only be called from the consumer thread.
+     *
+     * @return false if the queue is empty
+     */
+    bool pop(Task& out) {
+        Slot& slot = mSlots[mDequeuePos & mMask];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+        if (seq != mDequeuePos + 1) {
+            return false;
+        }
+        out = std::move(slot.task);
+        slot.sequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+        mDequeuePos++;
+        return true;
+    }
+
+    /**
+     * @brief Must only be called from the consumer thread.
+     */
+    bool empty() const {
+        return mSlots[mDequeuePos & mMask].sequence.load(std::memory_order_seq_cst) != mDequeuePos + 1;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        Task task;
+    };
+
+    const size_t mMask;
+    std::unique_ptr<Slot[]> mSlots;
+    alignas(64) std::atomic<size_t> mEnqueuePos = 0;
+    alignas(64) size_t mDequeuePos = 0;
+};
+
+} // namespace thermion
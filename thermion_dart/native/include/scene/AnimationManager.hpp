@@ -35,11 +35,44 @@ namespace thermion
             Scene *scene);
         ~AnimationManager() = default;
 
-        /// @brief 
+        /// @brief Advances the animation clock and applies all active animations.
         ///
-        /// @param frameTimeInNanos 
+        /// By default, the clock advances by the time elapsed since the previous
+        /// frame. If a fixed time step has been set, it advances by exactly that
+        /// step instead (and [frameTimeInNanos] is ignored).
+        ///
+        /// Every animation is sampled at the same clock value, so all animations in
+        /// a frame are consistent with each other.
+        ///
+        /// @param frameTimeInNanos the frame time (steady_clock nanoseconds), or 0 to use the current time
         void update(uint64_t frameTimeInNanos);
 
+        /// @brief Called when the frame that update() was last called for wasn't
+        /// rendered. With a fixed time step, this rewinds the clock by that step,
+        /// so the next update() evaluates the same time again and the clock only
+        /// advances once per rendered frame. Has no effect in real time.
+        void cancelFrame();
+
+        /// @brief Sets a fixed step (in nanoseconds) to advance the animation clock
+        /// on every call to update() (that isn't followed by cancelFrame()),
+        /// regardless of wall-clock time. This makes
+        /// animation playback deterministic (e.g. for offline/headless rendering,
+        /// which can then run faster than real time). Pass 0 to return to real time.
+        ///
+        /// @param stepInNanos
+        void setFixedTimeStep(uint64_t stepInNanos);
+
+        /// @brief Returns the current value of the animation clock (in nanoseconds).
+        /// This starts at zero and only advances when update() is called.
+        uint64_t getTime();
+
+        /// @brief Whether glTF/bone animation components are updated in parallel
+        /// using the engine's JobSystem (the default). update() must be called
+        /// from a thread owned by the JobSystem (i.e. the thread that created the engine).
+        ///
+        /// @param parallelUpdate
+        void setParallelUpdate(bool parallelUpdate);
+
         /// @brief
         /// @param asset
         /// @param childEntity
@@ -142,6 +175,11 @@ namespace thermion
         /// @param count
         void setMorphTargetWeights(utils::Entity entity, const float *const weights, int count);
 
+        /// @brief Copies (up to [maxCount] of) the morph target weights most recently
+        /// written to [entity] by setMorphTargetWeights or a morph animation into [out].
+        /// @return the number of weights copied
+        int getMorphTargetWeights(utils::Entity entity, float *out, int maxCount);
+
         /// @brief
         /// @param instance
         /// @param animationIndex
@@ -194,5 +232,14 @@ namespace thermion
         std::unique_ptr<GltfAnimationComponentManager> _gltfAnimationComponentManager = std::nullptr_t();
         std::unique_ptr<MorphAnimationComponentManager> _morphAnimationComponentManager = std::nullptr_t();
         std::unique_ptr<BoneAnimationComponentManager> _boneAnimationComponentManager = std::nullptr_t();
+        bool _parallelUpdate = true;
+        // the animation clock, used for the start/elapsed time of every animation
+        uint64_t _timeInNanos = 0;
+        // the clock before the last update, restored by cancelFrame
+        uint64_t _previousTimeInNanos = 0;
+        // the frameTimeInNanos passed to the last (real time) update, or 0
+        uint64_t _lastFrameTimeInNanos = 0;
+        uint64_t _fixedTimeStepInNanos = 0;
+        std::vector<Animator *> _dirtyAnimators;
     };
 }
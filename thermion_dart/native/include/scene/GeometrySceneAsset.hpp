@@ -5,7 +5,10 @@
 #include <filament/RenderableManager.h>
 #include <filament/VertexBuffer.h>
 #include <filament/IndexBuffer.h>
+#include <math/mat4.h>
 #include <gltfio/MaterialProvider.h>
+#include "scene/InstancedGeometrySceneAsset.hpp"
+#include "scene/LodChain.hpp"
 #include "scene/SceneAsset.hpp"
 
 namespace thermion
@@ -13,6 +16,8 @@ namespace thermion
 
     using namespace filament;
 
+    struct PickingMesh;
+
     class GeometrySceneAsset : public SceneAsset
     {
     public:
@@ -23,13 +28,20 @@ namespace thermion
                            size_t materialInstanceCount,
                            RenderableManager::PrimitiveType primitiveType,
                            Box boundingBox,
-                           GeometrySceneAsset *instanceParent = std::nullptr_t());
+                           GeometrySceneAsset *instanceParent = std::nullptr_t(),
+                           const filament::math::mat4f &decodeTransform = filament::math::mat4f());
         ~GeometrySceneAsset();
 
         SceneAsset *createInstance(MaterialInstance **materialInstances = nullptr, size_t materialInstanceCount = 0) override;
 
         void destroyInstance(SceneAsset *sceneAsset) override;
 
+        /// @brief Creates [instanceCount] hardware instances of this asset, drawn
+        /// with InstanceBuffers rather than one renderable per instance.
+        /// If no material instances are provided, this asset's material instances are used.
+        /// The result is owned by this asset (destroy with destroyInstance).
+        InstancedGeometrySceneAsset *createInstancedAsset(size_t instanceCount, MaterialInstance **materialInstances = nullptr, size_t materialInstanceCount = 0);
+
         SceneAssetType getType() override
         {
             return SceneAsset::SceneAssetType::Geometry;
@@ -61,15 +73,53 @@ namespace thermion
 
         VertexBuffer *getVertexBuffer() const { return _vertexBuffer; }
         IndexBuffer *getIndexBuffer() const { return _indexBuffer; }
+        RenderableManager::PrimitiveType getPrimitiveType() const { return _primitiveType; }
+
+        /// @brief A CPU-side copy of the triangles (shared with all instances), used for
+        /// ray picking. Null unless the primitive type is TRIANGLES and the asset was
+        /// built as pickable (see GeometrySceneAssetBuilder::pickable).
+        const std::shared_ptr<const PickingMesh> &getPickingMesh() const { return _pickingMesh; }
+        void setPickingMesh(std::shared_ptr<const PickingMesh> pickingMesh) { _pickingMesh = std::move(pickingMesh); }
+
+        /// @brief Starts generating [levelCount] levels of detail (including the original
+        /// triangles) on a worker thread, each with [reduction] times the triangles of the
+        /// previous level. Only supported for TRIANGLES; the levels are shared with all instances.
+        /// The levels are simplified from [triangles], or from the picking mesh if null
+        /// (so assets that weren't built as pickable must pass the triangles explicitly).
+        bool generateLods(size_t levelCount, float reduction = 0.5f,
+                          std::shared_ptr<const PickingMesh> triangles = nullptr);
+
+        /// @brief The levels of detail (null if generateLods hasn't been called).
+        std::shared_ptr<LodChain> getLodChain() const
+        {
+            return _instanceOwner ? _instanceOwner->getLodChain() : _lodChain;
+        }
+
+        /// @brief The entity with the renderable component. This is the same as getEntity(),
+        /// unless the vertex positions are quantized (see getDecodeTransform), in which case
+        /// the renderable is a child of getEntity().
+        utils::Entity getRenderableEntity() const { return _renderable; }
+
+        /// @brief Maps the (quantized) vertex positions to the asset's space. The picking
+        /// mesh and the renderable's bounding box are in quantized space.
+        const filament::math::mat4f &getDecodeTransform() const { return _decodeTransform; }
 
         void addAllEntities(Scene *scene) override
         {
             scene->addEntity(_entity);
+            if (_renderable != _entity)
+            {
+                scene->addEntity(_renderable);
+            }
         }
 
         void removeAllEntities(Scene *scene) override
         {
             scene->remove(_entity);
+            if (_renderable != _entity)
+            {
+                scene->remove(_renderable);
+            }
         }
 
         SceneAsset *getInstanceByEntity(utils::Entity entity) override
@@ -97,12 +147,12 @@ namespace thermion
 
         size_t getChildEntityCount() override
         {
-            return 0;
+            return _renderable == _entity ? 0 : 1;
         }
 
         const Entity *getChildEntities() override
         {
-            return nullptr;
+            return _renderable == _entity ? nullptr : &_renderable;
         }
 
         Entity findEntityByName(const char *name) override
@@ -111,7 +161,7 @@ namespace thermion
         }
 
         const filament::Aabb getBoundingBox() const override {
-            return _boundingBox;
+            return _boundingBox.transform(_decodeTransform);
         }
 
         static std::unique_ptr<GeometrySceneAsset> create(
@@ -131,8 +181,13 @@ namespace thermion
         Aabb _boundingBox;
         GeometrySceneAsset *_instanceOwner = std::nullptr_t();
         utils::Entity _entity;
+        utils::Entity _renderable;
+        filament::math::mat4f _decodeTransform;
         RenderableManager::PrimitiveType _primitiveType;
         std::vector<std::unique_ptr<GeometrySceneAsset>> _instances;
+        std::vector<std::unique_ptr<InstancedGeometrySceneAsset>> _instancedAssets;
+        std::shared_ptr<const PickingMesh> _pickingMesh;
+        std::shared_ptr<LodChain> _lodChain;
     };
 
 } // namespace thermion
\ No newline at end of file
@@ -14,39 +14,186 @@
 
 namespace thermion
 {
+    ///
+    /// Builds a GeometrySceneAsset from positions, (optionally) normals, UVs and colours,
+    /// and 16 or 32-bit indices.
+    ///
+    /// Data passed to vertices/normals/uvs/indices is copied. Data passed to
+    /// vertexData/indexData is not - it is uploaded directly, and must remain
+    /// valid until [release] is called (which may be on another thread, and
+    /// may be before build() returns). [release] is always called exactly once,
+    /// even if build() fails or is never called.
+    ///
+    /// Only the attributes provided are allocated; normals are only used to
+    /// compute tangents (and are not uploaded themselves).
+    ///
+    /// By default, attributes are uploaded as floats; see VertexFormat for
+    /// (opt-in) quantized layouts.
+    ///
+    /// optimize() merges duplicate vertices and reorders triangles and vertices
+    /// (see MeshOptimizer) before upload; this copies the vertex data, so
+    /// buffers passed to vertexData/indexData are released during build().
+    ///
     class GeometrySceneAssetBuilder
     {
     public:
+        /// @brief Called when Filament no longer needs a buffer passed to vertexData/indexData.
+        using ReleaseCallback = filament::backend::BufferDescriptor::Callback;
+
+        enum class PositionFormat : uint8_t
+        {
+            FLOAT3,
+            // half-precision (about 3 significant digits, relative to the distance from the origin)
+            HALF4,
+            // normalized to the bounding box (16 bits per component), and decoded by the
+            // transform of a child renderable entity (see GeometrySceneAsset::getDecodeTransform)
+            SHORT4
+        };
+
+        /// @brief The layout of the uploaded vertex attributes (positions are 12 bytes and
+        /// tangents 16 bytes per vertex at full precision, versus 8 bytes each when quantized).
+        struct VertexFormat
+        {
+            PositionFormat positions = PositionFormat::FLOAT3;
+            // HALF2 rather than FLOAT2
+            bool halfUVs = false;
+            // normalized SHORT4 tangent quaternions rather than FLOAT4
+            bool shortTangents = false;
+            // normalized UBYTE4 rather than FLOAT4
+            bool byteColors = false;
+        };
+
+        /// @brief The effect of optimize() (with a simulated 16-entry FIFO vertex cache).
+        struct OptimizationReport
+        {
+            uint32_t vertexCountBefore = 0;
+            uint32_t vertexCountAfter = 0;
+            // vertex shader invocations per triangle
+            float acmrBefore = 0.0f;
+            float acmrAfter = 0.0f;
+        };
+
         GeometrySceneAssetBuilder(filament::Engine *engine);
+        ~GeometrySceneAssetBuilder();
+
+        // copying would either duplicate or double-release the vertex data
+        GeometrySceneAssetBuilder(const GeometrySceneAssetBuilder &) = delete;
+        GeometrySceneAssetBuilder &operator=(const GeometrySceneAssetBuilder &) = delete;
 
         GeometrySceneAssetBuilder &vertices(const float *vertices, uint32_t count);
-        
+
         GeometrySceneAssetBuilder &normals(const float *normals, uint32_t count);
-        
+
         GeometrySceneAssetBuilder &uvs(const float *uvs, uint32_t count);
-        
+
+        /// @brief RGBA vertex colours (4 floats per vertex), for materials that use vertex colours.
+        GeometrySceneAssetBuilder &colors(const float *colors, uint32_t count);
 
         GeometrySceneAssetBuilder &indices(const uint16_t *indices, uint32_t count);
-        
+
+        GeometrySceneAssetBuilder &indices(const uint32_t *indices, uint32_t count);
+
+        /// @brief Uses [data] (without copying) as interleaved vertices of [stride] bytes,
+        /// with FLOAT3 positions at [positionOffset] and (if the offset is non-negative)
+        /// FLOAT3 normals and FLOAT2 UVs. Replaces anything passed to vertices/normals/uvs.
+        GeometrySceneAssetBuilder &vertexData(const void *data, uint32_t vertexCount, uint32_t stride,
+                                              uint32_t positionOffset, int32_t normalOffset = -1, int32_t uvOffset = -1,
+                                              ReleaseCallback release = nullptr, void *user = nullptr);
+
+        /// @brief Uses [data] (without copying) as [count] indices of [type].
+        GeometrySceneAssetBuilder &indexData(const void *data, uint32_t count, filament::IndexBuffer::IndexType type,
+                                             ReleaseCallback release = nullptr, void *user = nullptr);
+
         GeometrySceneAssetBuilder &materials(filament::MaterialInstance **materials, size_t materialInstanceCount);
-        
+
         GeometrySceneAssetBuilder &primitiveType(filament::RenderableManager::PrimitiveType type);
-        
+
+        GeometrySceneAssetBuilder &vertexFormat(const VertexFormat &format);
+
+        /// @brief Deduplicates vertices and optimizes the triangle and vertex order
+        /// (for triangles only; other primitive types are left as-is).
+        GeometrySceneAssetBuilder &optimize(bool enabled = true);
+
+        /// @brief Generates [levelCount] levels of detail (see GeometrySceneAsset::generateLods)
+        /// on a worker thread once the asset is built.
+        GeometrySceneAssetBuilder &lods(size_t levelCount, float reduction = 0.5f);
+
+        /// @brief Keeps a CPU-side copy of the triangles (12 bytes per vertex plus 4 per index)
+        /// so the asset can be added to a RayPicker (see GeometrySceneAsset::getPickingMesh).
+        /// Off by default; without it, ray picking falls back to the bounding box.
+        GeometrySceneAssetBuilder &pickable(bool enabled = true);
+
+        /// @brief Valid after build() when optimize() was enabled.
+        const OptimizationReport &getOptimizationReport() const { return mOptimizationReport; }
+
         std::unique_ptr<GeometrySceneAsset> build();
-        
+
     private:
+        // a block of caller-owned (or copied) memory, released once uploaded (or no longer needed)
+        struct Stream
+        {
+            const uint8_t *data = nullptr;
+            size_t size = 0;
+            uint32_t stride = 0;
+            ReleaseCallback release = nullptr;
+            void *user = nullptr;
+        };
+
+        struct Attribute
+        {
+            int32_t stream = -1;
+            uint32_t offset = 0;
+            uint32_t count = 0;
+
+            bool isPresent() const { return stream >= 0; }
+        };
+
+        template <typename T>
+        int32_t copyStream(const T *data, size_t count, uint32_t stride);
+        int32_t addStream(const void *data, size_t size, uint32_t stride, ReleaseCallback release, void *user);
+        void setIndices(const void *data, uint32_t count, filament::IndexBuffer::IndexType type, ReleaseCallback release, void *user);
+        void releaseStream(Stream &stream);
+
+        template <typename T>
+        const T &at(const Attribute &attribute, size_t index) const
+        {
+            const auto &stream = mStreams[attribute.stream];
+            return *reinterpret_cast<const T *>(stream.data + (index * stream.stride) + attribute.offset);
+        }
+
+        uint32_t indexAt(size_t index) const;
+
         Box computeBoundingBox();
-        
+
+        // maps positions to [-1, 1] for PositionFormat::SHORT4 (the inverse of the decode transform)
+        filament::math::float3 encodePosition(const filament::math::float3 &position) const;
+
+        void optimizeMesh();
+
+        // copies [attribute] for each vertex in [order] to a new (tightly packed) vector
+        template <typename T>
+        std::vector<T> *gather(const Attribute &attribute, const std::vector<uint32_t> &order) const;
+
         std::pair<filament::VertexBuffer *, filament::IndexBuffer *> createBuffers();
-        
 
         bool validate() const;
 
         filament::Engine *mEngine = nullptr;
-        std::vector<filament::math::float3> *mVertices = new std::vector<filament::math::float3>();
-        std::vector<filament::math::float3> *mNormals = new std::vector<filament::math::float3>();
-        std::vector<filament::math::float2> *mUVs = new std::vector<filament::math::float2>();
-        std::vector<uint16_t> *mIndices = new std::vector<uint16_t>;
+        std::vector<Stream> mStreams;
+        Attribute mPositions;
+        Attribute mNormals;
+        Attribute mUVs;
+        Attribute mColors;
+        VertexFormat mVertexFormat;
+        Box mBoundingBox;
+        bool mOptimize = false;
+        bool mPickable = false;
+        size_t mLodCount = 1;
+        float mLodReduction = 0.5f;
+        OptimizationReport mOptimizationReport;
+        Stream mIndices;
+        uint32_t mIndexCount = 0;
+        filament::IndexBuffer::IndexType mIndexType = filament::IndexBuffer::IndexType::USHORT;
         filament::MaterialInstance **mMaterialInstances = nullptr;
         size_t mMaterialInstanceCount = 0;
         filament::gltfio::MaterialProvider *mMaterialProvider = nullptr;
@@ -54,4 +201,4 @@ namespace thermion
             filament::RenderableManager::PrimitiveType::TRIANGLES;
     };
 
-} // namespace thermion
\ No newline at end of file
+} // namespace thermion
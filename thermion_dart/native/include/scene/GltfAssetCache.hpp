@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <filament/Engine.h>
+#include <filament/MaterialInstance.h>
+
+#include "scene/GltfSceneAsset.hpp"
+
+namespace thermion
+{
+
+    ///
+    /// Shares glTF assets that have already been loaded, keyed by a hash of
+    /// their content.
+    ///
+    /// Each entry owns a GltfSceneAsset; callers are handed instances of it
+    /// (see GltfSceneAsset::createInstance), so a cache hit costs an
+    /// instance rather than parsing, uploading and decoding the asset again.
+    /// Entries are reference-counted by the instances handed out, and
+    /// entries with no instances in use are evicted (least recently used
+    /// first) once the total size of all entries exceeds the budget.
+    ///
+    /// With the exception of getStats/computeKey/computeFileKey, all methods
+    /// must be called on the engine thread.
+    ///
+    class GltfAssetCache
+    {
+    public:
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            uint32_t entryCount = 0;
+            uint32_t instancesInUse = 0;
+            uint64_t sizeInBytes = 0;
+            uint64_t budgetInBytes = 0;
+        };
+
+        explicit GltfAssetCache(size_t budgetInBytes) : mBudgetInBytes(budgetInBytes) {}
+
+        /// @brief Destroys every cached asset (including any instances still in use).
+        ~GltfAssetCache();
+
+        GltfAssetCache(const GltfAssetCache &) = delete;
+        GltfAssetCache &operator=(const GltfAssetCache &) = delete;
+
+        /// @brief The key for an asset with the given content, whose resources
+        /// are loaded relative to [resourceUri] (which may be null).
+        static uint64_t computeKey(const uint8_t *data, size_t length, const char *resourceUri);
+
+        /// @brief The key for the file at [path] (see computeKey). The content is only
+        /// hashed the first time a file is seen, or if its size or modification time has
+        /// changed since (or its entry has been evicted). Returns 0 if the file can't be
+        /// read. If [length] is not null, it is set to the size of the file.
+        uint64_t computeFileKey(const char *path, const char *resourceUri, uint64_t *length = nullptr);
+
+        /// @brief Returns an instance of the asset cached under [key] (or null if
+        /// there is none), with its root transform reset to identity.
+        SceneAsset *acquire(uint64_t key, MaterialInstance **materialInstances = nullptr, size_t materialInstanceCount = 0);
+
+        /// @brief Takes ownership of [asset] and caches it under [key], returning
+        /// the first of its instances. [sizeInBytes] is the (approximate) memory
+        /// used by the asset, which counts towards the budget.
+        SceneAsset *insert(uint64_t key, GltfSceneAsset *asset, size_t sizeInBytes);
+
+        /// @brief Returns an instance handed out by acquire/insert to the cache. Returns
+        /// false if [instance] isn't owned by a cached asset.
+        bool release(SceneAsset *instance);
+
+        /// @brief Whether [asset] (an instance, or an asset) is owned by the cache.
+        bool contains(SceneAsset *asset);
+
+        void setBudget(size_t budgetInBytes);
+
+        Stats getStats();
+
+    private:
+        struct Entry
+        {
+            std::unique_ptr<GltfSceneAsset> asset;
+            size_t sizeInBytes = 0;
+            uint32_t refCount = 0;
+            uint64_t lastUsed = 0;
+        };
+
+        struct FileKey
+        {
+            uint64_t size = 0;
+            int64_t modifiedTime = 0;
+            uint64_t key = 0;
+        };
+
+        Entry *findOwner(SceneAsset *asset);
+
+        // evicts unused entries (least recently used first) until within budget
+        void evict();
+
+        std::mutex mMutex;
+        std::unordered_map<uint64_t, Entry> mEntries;
+        std::unordered_map<std::string, FileKey> mFileKeys;
+        size_t mBudgetInBytes = 0;
+        size_t mSizeInBytes = 0;
+        uint64_t mClock = 0;
+        Stats mStats;
+    };
+
+} // namespace thermion
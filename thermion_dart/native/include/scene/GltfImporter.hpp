@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <gltfio/FilamentAsset.h>
+#include <gltfio/ResourceLoader.h>
+
+namespace thermion
+{
+
+    ///
+    /// Finishes loading the resources of glTF assets without blocking the
+    /// render thread.
+    ///
+    /// Each import is started with ResourceLoader::asyncBeginLoad, after which
+    /// textures are decoded (and tangents computed) on gltfio's worker
+    /// threads. update() is called by the RenderTicker before each frame and
+    /// uploads whatever has been decoded (ResourceLoader::asyncUpdateLoad),
+    /// one import after another until the frame's budget has been spent.
+    ///
+    /// The budget is only checked between imports: asyncUpdateLoad uploads
+    /// everything an import has decoded since the previous call, and gltfio
+    /// offers no way to upload part of that. A frame can therefore exceed the
+    /// budget by one import's upload. Large assets are spread over frames only
+    /// because their textures finish decoding at different times.
+    ///
+    /// Each ResourceLoader can only be used for one import at a time, and
+    /// must not be destroyed until its import has completed.
+    ///
+    class GltfImporter
+    {
+    public:
+        static constexpr uint64_t kDefaultBudgetInNanos = 4'000'000;
+
+        explicit GltfImporter(uint64_t budgetInNanos = kDefaultBudgetInNanos) : mBudgetInNanos(budgetInNanos) {}
+
+        /// @brief Cancels any imports in progress. Must be called on the engine thread.
+        ~GltfImporter();
+
+        /// @brief Starts loading the resources of [asset]. Must be called on the engine thread.
+        bool begin(filament::gltfio::ResourceLoader *resourceLoader, filament::gltfio::FilamentAsset *asset);
+
+        /// @brief The progress of the import of [asset] in [0, 1] (1 once complete, or if
+        /// [asset] isn't being imported).
+        float getProgress(filament::gltfio::FilamentAsset *asset);
+
+        /// @brief Cancels the import of [asset]. Must be called on the engine thread.
+        void cancel(filament::gltfio::FilamentAsset *asset);
+
+        /// @brief The time after which update() stops starting further uploads (see above).
+        void setBudget(uint64_t budgetInNanos);
+
+        /// @brief Uploads decoded resources, within the budget. Must be called on the engine thread.
+        void update();
+
+    private:
+        struct Import
+        {
+            filament::gltfio::ResourceLoader *resourceLoader;
+            filament::gltfio::FilamentAsset *asset;
+            float progress;
+        };
+
+        std::mutex mMutex;
+        std::vector<Import> mImports;
+        // the import that update() starts with, so every import makes progress
+        size_t mNext = 0;
+        uint64_t mBudgetInNanos;
+    };
+
+} // namespace thermion
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include <gltfio/FilamentInstance.h>
+
+struct cgltf_data;
+struct cgltf_node;
+
+namespace thermion
+{
+
+    ///
+    /// Returns the nodes of the (retained) glTF source data in the same order
+    /// as the entities of [instance] (gltfio creates one entity per node,
+    /// depth-first from the root nodes of each scene, or of the whole asset if
+    /// it has no scenes), so nodes[i] corresponds to instance->getEntities()[i].
+    ///
+    /// Returns an empty vector (and logs why) if the order can't be trusted,
+    /// i.e. the node count or a node's primitive count doesn't match the instance.
+    ///
+    std::vector<const cgltf_node *> getGltfSourceNodes(const cgltf_data *data, const filament::gltfio::FilamentInstance *instance);
+
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/InstanceBuffer.h>
+#include <filament/RenderableManager.h>
+#include <filament/VertexBuffer.h>
+#include <math/mat4.h>
+#include <utils/Entity.h>
+
+#include "components/DynamicAabbTree.hpp"
+#include "scene/SceneAsset.hpp"
+
+namespace thermion
+{
+
+    using namespace filament;
+
+    class GeometrySceneAsset;
+    struct PickingMesh;
+
+    /**
+     * @brief N hardware instances of a GeometrySceneAsset's vertex/index buffers.
+     *
+     * Instances are drawn by renderables with an InstanceBuffer, each holding up
+     * to Engine::getMaxAutomaticInstances() consecutive instances (so N instances
+     * need N / getMaxAutomaticInstances() draw calls, rather than N). The
+     * renderables are children of a single root entity (getEntity()); instance
+     * transforms are relative to the root.
+     *
+     * Each renderable's bounding box is the union of its instances' bounding
+     * boxes, so instances that are close together should have consecutive
+     * indices for the best culling.
+     *
+     * Created with GeometrySceneAsset::createInstancedAsset.
+     */
+    class InstancedGeometrySceneAsset : public SceneAsset
+    {
+    public:
+        InstancedGeometrySceneAsset(GeometrySceneAsset *instanceOwner,
+                                    Engine *engine,
+                                    VertexBuffer *vertexBuffer,
+                                    IndexBuffer *indexBuffer,
+                                    MaterialInstance **materialInstances,
+                                    size_t materialInstanceCount,
+                                    RenderableManager::PrimitiveType primitiveType,
+                                    const filament::Aabb &boundingBox,
+                                    std::shared_ptr<const PickingMesh> pickingMesh,
+                                    size_t instanceCount,
+                                    const filament::math::mat4f &decodeTransform = filament::math::mat4f());
+        ~InstancedGeometrySceneAsset();
+
+        SceneAsset *createInstance(MaterialInstance **materialInstances = nullptr, size_t materialInstanceCount = 0) override;
+
+        void destroyInstance(SceneAsset * /* sceneAsset */) override {}
+
+        SceneAssetType getType() override
+        {
+            return SceneAsset::SceneAssetType::InstancedGeometry;
+        }
+
+        bool isInstance() override
+        {
+            return true;
+        }
+
+        SceneAsset *getInstanceOwner() override;
+
+        utils::Entity getEntity() override
+        {
+            return _entity;
+        }
+
+        MaterialInstance **getMaterialInstances() override
+        {
+            return _materialInstances.data();
+        }
+
+        size_t getMaterialInstanceCount() override
+        {
+            return _materialInstances.size();
+        }
+
+        void addAllEntities(Scene *scene) override
+        {
+            scene->addEntity(_entity);
+            scene->addEntities(_renderables.data(), _renderables.size());
+        }
+
+        void removeAllEntities(Scene *scene) override
+        {
+            scene->remove(_entity);
+            scene->removeEntities(_renderables.data(), _renderables.size());
+        }
+
+        // hardware instances aren't SceneAssets
+        SceneAsset *getInstanceByEntity(utils::Entity /* entity */) override
+        {
+            return std::nullptr_t();
+        }
+
+        SceneAsset *getInstanceAt(size_t /* index */) override
+        {
+            return std::nullptr_t();
+        }
+
+        size_t getInstanceCount() override
+        {
+            return 0;
+        }
+
+        size_t getChildEntityCount() override
+        {
+            return _renderables.size();
+        }
+
+        const Entity *getChildEntities() override
+        {
+            return _renderables.data();
+        }
+
+        Entity findEntityByName(const char * /* name */) override
+        {
+            return Entity(); // not currently implemented
+        }
+
+        /// @brief The bounding box of a single instance (in its own space).
+        const filament::Aabb getBoundingBox() const override
+        {
+            return _boundingBox.transform(_decodeTransform);
+        }
+
+        /// @brief The number of hardware instances.
+        size_t getInstancedCount() const
+        {
+            return _transforms.size();
+        }
+
+        const std::shared_ptr<const PickingMesh> &getPickingMesh() const
+        {
+            return _pickingMesh;
+        }
+
+        /// @brief Sets the transforms (relative to the root entity) of [count] instances,
+        /// starting at [offset], from column-major 4x4 matrices (16 floats per instance).
+        /// Returns false if the range is out of bounds.
+        bool setInstanceTransforms(const float *transforms, size_t count, size_t offset);
+
+        const filament::math::mat4f &getInstanceTransform(size_t index) const
+        {
+            return _transforms[index];
+        }
+
+        /// @brief Intersects the world-space ray origin + t * direction with every instance,
+        /// returning the smallest t < [maxT] (or maxT if nothing was hit) and writing
+        /// the index of the instance that was hit to [instance].
+        /// If [refine] is true, triangles are tested rather than bounding boxes.
+        float intersect(const filament::math::float3 &origin, const filament::math::float3 &direction, float maxT, bool refine, int32_t &instance);
+
+    private:
+        void updateBoundingBox(size_t renderableIndex);
+        void uploadTransforms(size_t renderableIndex, size_t from, size_t to);
+
+        // the transform of an instance's vertices, including the decode transform for quantized positions
+        filament::math::mat4f getVertexTransform(size_t index) const
+        {
+            return _transforms[index] * _decodeTransform;
+        }
+
+        Engine *_engine = nullptr;
+        GeometrySceneAsset *_instanceOwner = nullptr;
+        std::vector<MaterialInstance *> _materialInstances;
+        filament::Aabb _boundingBox;
+        std::shared_ptr<const PickingMesh> _pickingMesh;
+        utils::Entity _entity;
+        size_t _instancesPerRenderable = 1;
+        std::vector<utils::Entity> _renderables;
+        std::vector<InstanceBuffer *> _instanceBuffers;
+        std::vector<filament::math::mat4f> _transforms;
+        filament::math::mat4f _decodeTransform;
+        bool _hasDecodeTransform = false;
+        // scratch space for uploading transforms with the decode transform applied
+        std::vector<filament::math::mat4f> _decodedTransforms;
+
+        // instance bounding boxes (relative to the root), for picking; only
+        // refit when transforms have changed since the last pick
+        DynamicAabbTree _tree;
+        std::vector<int32_t> _proxies;
+        bool _treeDirty = true;
+    };
+
+} // namespace thermion
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/Texture.h>
+#include <gltfio/TextureProvider.h>
+#include <ktxreader/Ktx2Reader.h>
+#include <utils/JobSystem.h>
+
+namespace thermion
+{
+
+    ///
+    /// A gltfio TextureProvider for KTX2 (including Basis-encoded) textures
+    /// that transcodes on the engine's JobSystem.
+    ///
+    /// Each pushed texture is transcoded by its own job, so the textures of
+    /// an asset are transcoded in parallel across the JobSystem's threads.
+    /// updateQueue() (called on the engine thread by the ResourceLoader)
+    /// uploads each mip level as soon as it has been transcoded, rather than
+    /// once the whole texture is complete.
+    ///
+    /// The time taken to transcode each texture (from the job starting to
+    /// the last level being transcoded) is recorded in getStats().
+    ///
+    class Ktx2TextureProvider : public filament::gltfio::TextureProvider
+    {
+    public:
+        struct Stats
+        {
+            uint32_t texturesDecoded = 0;
+            uint32_t texturesFailed = 0;
+            uint64_t totalDecodeTimeInNanos = 0;
+            uint64_t maxDecodeTimeInNanos = 0;
+            uint64_t lastDecodeTimeInNanos = 0;
+        };
+
+        explicit Ktx2TextureProvider(filament::Engine *engine);
+
+        /// @brief Cancels (or waits for) any outstanding transcoding jobs.
+        ~Ktx2TextureProvider() override;
+
+        /// @brief Requests the formats that KTX2 textures may be transcoded to,
+        /// in order of preference.
+        static void requestFormats(ktxreader::Ktx2Reader &reader);
+
+        Texture *pushTexture(const uint8_t *data, size_t byteCount,
+                             const char *mimeType, TextureFlags flags) override;
+        Texture *popTexture() override;
+        void updateQueue() override;
+        const char *getPushMessage() const override;
+        const char *getPopMessage() const override;
+        void waitForCompletion() override;
+        void cancelDecoding() override;
+        size_t getPushedCount() const override { return mPushedCount; }
+        size_t getPoppedCount() const override { return mPoppedCount; }
+        size_t getDecodedCount() const override { return mDecodedCount; }
+
+        /// @brief This can be called from any thread.
+        Stats getStats();
+
+    private:
+        struct Pending
+        {
+            Texture *texture = nullptr;
+            ktxreader::Ktx2Reader::Async *async = nullptr;
+            utils::JobSystem::Job *job = nullptr;
+            std::atomic<bool> cancelled = false;
+            std::atomic<bool> transcoded = false;
+            ktxreader::Ktx2Reader::Result result = ktxreader::Ktx2Reader::Result::SUCCESS;
+            uint64_t decodeTimeInNanos = 0;
+        };
+
+        struct Decoded
+        {
+            Texture *texture;
+            bool failed;
+        };
+
+        void record(const Pending &pending);
+
+        filament::Engine *mEngine;
+        utils::JobSystem &mJobSystem;
+        std::unique_ptr<ktxreader::Ktx2Reader> mReader;
+        std::vector<std::unique_ptr<Pending>> mPending;
+        std::vector<Decoded> mDecoded;
+        std::string mPushMessage;
+        std::string mPopMessage;
+        size_t mPushedCount = 0;
+        size_t mPoppedCount = 0;
+        size_t mDecodedCount = 0;
+        std::mutex mStatsMutex;
+        Stats mStats;
+    };
+
+} // namespace thermion
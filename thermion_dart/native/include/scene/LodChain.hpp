@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/RenderableManager.h>
+#include <filament/VertexBuffer.h>
+#include <math/mat4.h>
+#include <utils/JobSystem.h>
+
+namespace thermion
+{
+
+    struct PickingMesh;
+
+    ///
+    /// The levels of detail for a single (triangle) primitive: the original
+    /// index buffer, followed by progressively simplified index buffers that
+    /// share its vertex buffer (see MeshOptimizer::simplify).
+    ///
+    /// The simplified levels are generated by a job on the engine's JobSystem
+    /// from the primitive's picking mesh, and only become available once poll()
+    /// has been called (on the engine thread) after generation has finished.
+    /// A chain must be created and destroyed on the engine thread.
+    ///
+    class LodChain
+    {
+    public:
+        struct Level
+        {
+            filament::IndexBuffer *indexBuffer = nullptr;
+            uint32_t indexCount = 0;
+            // the (cumulative) simplification error, relative to the radius of the mesh's bounds
+            float error = 0.0f;
+        };
+
+        /// @brief Starts generating up to [levelCount] - 1 simplified levels, each with
+        /// [reduction] times the triangles of the previous level. [decodeTransform]
+        /// maps the picking mesh positions to the asset's space (see GeometrySceneAsset::getDecodeTransform).
+        LodChain(filament::Engine *engine,
+                 filament::VertexBuffer *vertexBuffer,
+                 filament::IndexBuffer *indexBuffer,
+                 filament::RenderableManager::PrimitiveType primitiveType,
+                 std::shared_ptr<const PickingMesh> mesh,
+                 const filament::math::mat4f &decodeTransform,
+                 size_t levelCount,
+                 float reduction);
+
+        /// @brief Waits for generation to finish and destroys the simplified index buffers.
+        ~LodChain();
+
+        LodChain(const LodChain &) = delete;
+        LodChain &operator=(const LodChain &) = delete;
+
+        /// @brief Uploads the generated levels, if generation has finished. Must be
+        /// called on the engine thread. Returns true once all levels are available.
+        bool poll();
+
+        /// @brief Blocks until generation has finished (the levels still need to be uploaded with poll()).
+        /// Must be called on the engine thread.
+        void wait();
+
+        size_t getLevelCount();
+
+        Level getLevel(size_t level);
+
+        /// @brief The triangle count of [level] (0 if it is not available).
+        uint32_t getTriangleCount(size_t level);
+
+        filament::VertexBuffer *getVertexBuffer() const { return mVertexBuffer; }
+
+        filament::RenderableManager::PrimitiveType getPrimitiveType() const { return mPrimitiveType; }
+
+    private:
+        struct Simplified
+        {
+            std::vector<uint32_t> indices;
+            float error = 0.0f;
+        };
+
+        static std::vector<Simplified> generate(std::shared_ptr<const PickingMesh> mesh,
+                                                filament::math::mat4f decodeTransform,
+                                                size_t levelCount, float reduction);
+
+        std::mutex mMutex;
+        filament::Engine *mEngine = nullptr;
+        filament::VertexBuffer *mVertexBuffer = nullptr;
+        filament::RenderableManager::PrimitiveType mPrimitiveType;
+        std::vector<Level> mLevels;
+        // the generation job (null once it has been released) and the levels it
+        // generated, which can only be read once mGenerated is set (or the job
+        // has been waited on) and are cleared once uploaded
+        utils::JobSystem::Job *mJob = nullptr;
+        std::atomic<bool> mGenerated = false;
+        std::vector<Simplified> mSimplified;
+    };
+
+} // namespace thermion
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <math/vec3.h>
+
+namespace thermion
+{
+
+    /// @brief Reorders indexed triangle meshes for the GPU (following Sander,
+    /// Nehab & Barczak, "Fast Triangle Reordering for Vertex Locality and
+    /// Reduced Overdraw", 2007):
+    ///
+    /// 1) deduplicateVertices merges bitwise-identical vertices
+    /// 2) optimizeVertexCache reorders triangles for post-transform cache locality ("Tipsify")
+    /// 3) optimizeOverdraw reorders clusters of triangles so outward-facing
+    ///    clusters are drawn first, without increasing the cache miss ratio by
+    ///    more than [threshold]
+    /// 4) optimizeVertexFetch reorders vertices by first use (and drops unused vertices)
+    ///
+    /// simplify reduces the triangle count by quadric-error edge collapse
+    /// (Garland & Heckbert, "Surface Simplification Using Quadric Error
+    /// Metrics", 1997) for level-of-detail index buffers.
+    ///
+    /// All functions take 32-bit triangle-list indices.
+    class MeshOptimizer
+    {
+    public:
+        /// @brief One attribute of each vertex: [size] bytes, every [stride] bytes from [data].
+        struct VertexStream
+        {
+            const void *data;
+            size_t size;
+            size_t stride;
+        };
+
+        /// @brief The result of simulating a FIFO post-transform vertex cache.
+        struct VertexCacheStatistics
+        {
+            // the number of vertex shader invocations (cache misses)
+            size_t vertexInvocations = 0;
+            // average cache miss ratio (invocations per triangle; 0.5 is optimal for large grids, 3 the worst)
+            float acmr = 0.0f;
+            // average transform to vertex ratio (invocations per vertex; 1 is optimal)
+            float atvr = 0.0f;
+        };
+
+        static constexpr uint32_t kDefaultCacheSize = 16;
+
+        /// @brief Writes the index of each vertex's first identical vertex (across all [streams])
+        /// to [remap], renumbered so unique vertices are consecutive, and returns the number of unique vertices.
+        static size_t deduplicateVertices(uint32_t *remap, const VertexStream *streams, size_t streamCount, size_t vertexCount);
+
+        /// @brief Reorders the triangles in [indices] into [destination] (which may not alias [indices]).
+        static void optimizeVertexCache(uint32_t *destination, const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                        uint32_t cacheSize = kDefaultCacheSize);
+
+        /// @brief Reorders the triangles in the vertex-cache-optimized [indices] into [destination]
+        /// (which may not alias [indices]) to reduce overdraw.
+        static void optimizeOverdraw(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                     const filament::math::float3 *positions, size_t positionStride, size_t vertexCount,
+                                     float threshold = 1.05f, uint32_t cacheSize = kDefaultCacheSize);
+
+        /// @brief Writes the new index of each vertex (in order of first use by [indices]) to [remap]
+        /// (or ~0u if unused) and returns the number of vertices used.
+        static size_t optimizeVertexFetch(uint32_t *remap, const uint32_t *indices, size_t indexCount, size_t vertexCount);
+
+        /// @brief Writes a simplified copy of [indices] with (at most) [targetIndexCount] indices to
+        /// [destination] (which may alias [indices]) and returns its index count. Vertices are
+        /// collapsed into their neighbours (so the result uses the same vertex buffer); vertices
+        /// on open or non-manifold edges (including attribute seams) are never moved. Simplification
+        /// stops before the error exceeds [targetError], relative to the radius of the mesh's bounds;
+        /// the error reached is written to [resultError] (if non-null).
+        static size_t simplify(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                               const filament::math::float3 *positions, size_t positionStride, size_t vertexCount,
+                               size_t targetIndexCount, float targetError = 1.0f, float *resultError = nullptr);
+
+        /// @brief Simulates a FIFO vertex cache of [cacheSize] entries.
+        static VertexCacheStatistics analyzeVertexCache(const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                                        uint32_t cacheSize = kDefaultCacheSize);
+    };
+
+} // namespace thermion
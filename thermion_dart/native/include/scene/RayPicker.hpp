@@ -0,0 +1,120 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/Scene.h>
+#include <filament/View.h>
+#include <gltfio/FilamentAsset.h>
+#include <gltfio/FilamentInstance.h>
+
+#include <math/mat4.h>
+#include <math/vec3.h>
+#include <utils/Entity.h>
+
+#include "components/DynamicAabbTree.hpp"
+#include "scene/SceneAsset.hpp"
+
+namespace thermion
+{
+
+    class InstancedGeometrySceneAsset;
+
+    /// @brief A world-space ray; [direction] need not be normalized.
+    struct Ray
+    {
+        filament::math::float3 origin;
+        filament::math::float3 direction;
+    };
+
+    /// @brief The closest renderable hit by a ray. [entity] is null if nothing was hit.
+    struct RayHit
+    {
+        utils::Entity entity;
+        // the distance along the (normalized) ray
+        float distance = std::numeric_limits<float>::infinity();
+        // the world-space hit position
+        filament::math::float3 position;
+        // the index of the instance that was hit, for hardware-instanced assets (otherwise -1)
+        int32_t instance = -1;
+    };
+
+    /// @brief CPU-side copy of a renderable's triangles (in object space),
+    /// used to refine picking beyond the renderable's bounding box.
+    struct PickingMesh
+    {
+        std::vector<filament::math::float3> positions;
+        // a triangle list
+        std::vector<uint32_t> indices;
+    };
+
+    /**
+     * @brief Synchronous CPU ray casting against the renderables in a Scene.
+     *
+     * Unlike View::pick (which reads back from the GPU, so the result only
+     * arrives after a later frame), results are returned immediately.
+     *
+     * Every pick first syncs a bounding volume hierarchy of the world-space
+     * bounding boxes of all renderables in the scene (only renderables that
+     * have moved out of their fat box change the tree), so a batch of rays
+     * shares a single sync. Each candidate is then tested exactly against its
+     * object-space bounding box and, if requested and a PickingMesh has been
+     * registered for that entity, against its triangles.
+     *
+     * Skinning, morphing and any vertex shader displacement are not taken into account.
+     */
+    class RayPicker
+    {
+    public:
+        explicit RayPicker(filament::Engine *engine) : mEngine(engine) {}
+
+        /// @brief Registers the triangles used to refine hits on [entity].
+        void setPickingMesh(utils::Entity entity, std::shared_ptr<const PickingMesh> mesh);
+        void removePickingMesh(utils::Entity entity);
+
+        /// @brief Registers the triangles for every renderable in [asset] (and its
+        /// instances). For glTF assets, this requires the source data not to
+        /// have been released. Returns false if no triangles could be found.
+        ///
+        /// Hardware-instanced assets must be added (and removed before they are
+        /// destroyed) for hits to be resolved to individual instances.
+        bool addSceneAsset(SceneAsset *asset);
+        void removeSceneAsset(SceneAsset *asset);
+
+        /// @brief Casts each of [rays] against the renderables in [scene] whose layer mask
+        /// intersects [layerMask], writing the closest hit for each ray to [hits].
+        /// Returns the number of rays that hit something.
+        size_t pick(filament::Scene *scene, uint8_t layerMask, const Ray *rays, size_t numRays, bool refine, RayHit *hits);
+
+        /// @brief Returns the world-space ray through viewport coordinates ([x], [y])
+        /// (origin at the bottom-left, as View::pick) for the camera of [view].
+        static Ray getViewRay(const filament::View *view, float x, float y);
+
+        /// @brief Intersects the ray origin + t * direction with [box] (in object space) and,
+        /// if non-null, the triangles in [mesh], for an object with the given [transform].
+        /// Returns the smallest t < [maxT] of any hit, otherwise maxT.
+        static float intersect(const filament::Aabb &box, const PickingMesh *mesh, const filament::math::mat4f &transform,
+                               const filament::math::float3 &origin, const filament::math::float3 &direction, float maxT);
+
+    private:
+        struct Proxy
+        {
+            int32_t proxyId;
+            uint32_t generation;
+        };
+
+        void sync(filament::Scene *scene, uint8_t layerMask);
+        bool addGltfInstance(filament::gltfio::FilamentAsset *asset, filament::gltfio::FilamentInstance *instance);
+
+        filament::Engine *mEngine;
+        DynamicAabbTree mTree{0.05f};
+        std::unordered_map<utils::Entity, Proxy, utils::Entity::Hasher> mProxies;
+        std::unordered_map<utils::Entity, std::shared_ptr<const PickingMesh>, utils::Entity::Hasher> mMeshes;
+        std::unordered_map<utils::Entity, InstancedGeometrySceneAsset *, utils::Entity::Hasher> mInstanced;
+        uint32_t mGeneration = 0;
+    };
+
+} // namespace thermion
@@ -24,7 +24,7 @@ enum SceneLayer {
 class SceneAsset {
 
     public:
-        enum SceneAssetType { Gltf, Geometry, Light, Skybox, Ibl, Image, Gizmo };
+        enum SceneAssetType { Gltf, Geometry, Light, Skybox, Ibl, Image, Gizmo, InstancedGeometry };
         
         virtual ~SceneAsset() {
             
@@ -0,0 +1,146 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Log.hpp"
+#include "MappedFile.hpp"
+
+namespace thermion
+{
+
+    static const char *stripScheme(const char *path)
+    {
+        static constexpr char kFileScheme[] = "file://";
+        if (strncmp(path, kFileScheme, sizeof(kFileScheme) - 1) == 0)
+        {
+            return path + sizeof(kFileScheme) - 1;
+        }
+        return path;
+    }
+
+    std::unique_ptr<MappedFile> MappedFile::open(const char *uri)
+    {
+        const char *path = stripScheme(uri);
+        std::unique_ptr<MappedFile> file(new MappedFile());
+
+#if defined(_WIN32)
+        HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(handle, &size))
+        {
+            CloseHandle(handle);
+            return nullptr;
+        }
+        file->mFile = handle;
+        file->mSize = static_cast<size_t>(size.QuadPart);
+        if (file->mSize > 0)
+        {
+            file->mMapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!file->mMapping)
+            {
+                return nullptr;
+            }
+            file->mData = static_cast<uint8_t *>(MapViewOfFile(file->mMapping, FILE_MAP_READ, 0, 0, 0));
+            if (!file->mData)
+            {
+                return nullptr;
+            }
+        }
+        file->mMapped = true;
+#elif !defined(__EMSCRIPTEN__)
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        {
+            ::close(fd);
+            return nullptr;
+        }
+        file->mSize = static_cast<size_t>(st.st_size);
+        if (file->mSize > 0)
+        {
+            void *data = mmap(nullptr, file->mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(fd);
+                Log("Failed to map %s", path);
+                return nullptr;
+            }
+            file->mData = static_cast<uint8_t *>(data);
+        }
+        // the mapping keeps the file open
+        ::close(fd);
+        file->mMapped = true;
+#else
+        FILE *fp = fopen(path, "rb");
+        if (!fp)
+        {
+            return nullptr;
+        }
+        fseek(fp, 0, SEEK_END);
+        file->mSize = static_cast<size_t>(ftell(fp));
+        fseek(fp, 0, SEEK_SET);
+        file->mData = static_cast<uint8_t *>(malloc(file->mSize));
+        if (file->mSize > 0 && fread(file->mData, 1, file->mSize, fp) != file->mSize)
+        {
+            fclose(fp);
+            return nullptr;
+        }
+        fclose(fp);
+#endif
+        return file;
+    }
+
+    MappedFile::~MappedFile()
+    {
+#if defined(_WIN32)
+        if (mData)
+        {
+            UnmapViewOfFile(mData);
+        }
+        if (mMapping)
+        {
+            CloseHandle(mMapping);
+        }
+        if (mFile)
+        {
+            CloseHandle(mFile);
+        }
+#elif !defined(__EMSCRIPTEN__)
+        if (mData)
+        {
+            munmap(mData, mSize);
+        }
+#else
+        free(mData);
+#endif
+    }
+
+    void MappedFile::prefetch() const
+    {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+        if (mData)
+        {
+            madvise(mData, mSize, MADV_WILLNEED);
+        }
+#endif
+    }
+
+} // namespace thermion
@@ -35,6 +35,7 @@
 
 #include "Log.hpp"
 #include "RenderTicker.hpp"
+#include "TraceRecorder.hpp"
 
 namespace thermion
 {
@@ -54,11 +55,12 @@ namespace thermion
                                  { return attachment.first == swapChain; });
     mRenderable.erase(erased,
                       mRenderable.end());
+    mNumRenderable = mRenderable.size();
   }
 
   void RenderTicker::setRenderable(SwapChain *swapChain, View **views, uint8_t numViews)
   {
-    std::lock_guard lock(mMutex);
+    std::unique_lock lock(mMutex);
 
     auto it = std::find_if(mRenderable.begin(), mRenderable.end(),
                            [swapChain](const auto &pair)
@@ -78,22 +80,74 @@ namespace thermion
     {
       mRenderable.emplace_back(swapChain, swapChainViews);
     }
+    mNumRenderable = mRenderable.size();
     TRACE("Set %d views as renderable", numViews);
+
+    auto onRenderableAdded = mOnRenderableAdded;
+    lock.unlock();
+    if (onRenderableAdded)
+    {
+      onRenderableAdded();
+    }
+  }
+
+  static uint64_t nanosSince(std::chrono::high_resolution_clock::time_point start)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
   }
 
   bool RenderTicker::render(uint64_t frameTimeInNanos)
   {
+    TRACE_SCOPE("RenderTicker::render");
     auto startTime = std::chrono::high_resolution_clock::now();
 
     std::lock_guard lock(mMutex);
 
+    // imports progress even when there's nothing to render into
+    if (mGltfImporter)
+    {
+      mGltfImporter->update();
+    }
+
+    auto scheduledFrameTime = mFrameScheduler.beginFrame(FrameScheduler::now());
+    if (frameTimeInNanos == 0)
+    {
+      frameTimeInNanos = scheduledFrameTime;
+    }
+
+    FrameTiming timing;
+    timing.frameTimeInNanos = frameTimeInNanos;
+
+    auto stageStart = std::chrono::high_resolution_clock::now();
     for (auto animationManager : mAnimationManagers)
     {
       animationManager->update(frameTimeInNanos);
     }
+    timing.animationUpdateTimeInNanos = nanosSince(stageStart);
+    TRACE("Updated animations in %.3f ms", timing.animationUpdateTimeInNanos / 1e6f);
+
+    if (mLodComponentManager)
+    {
+      mLodComponentManager->update();
+    }
 
-    auto durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - mLastRender).count() / 1e6f;
-    TRACE("Updated animations in %.3f ms", durationNs);
+    if (mCollisionComponentManager)
+    {
+      mCollisionComponentManager->update();
+    }
+
+    if (mRenderable.empty())
+    {
+      // nothing to render into, so there's nothing to retry either; the
+      // request is dropped rather than counted as a skipped frame
+      TRACE("No renderable swapchains");
+      for (auto animationManager : mAnimationManagers)
+      {
+        animationManager->cancelFrame();
+      }
+      mFrameScheduler.cancelFrameRequest();
+      return false;
+    }
 
     int swapChainIndex = 0;
     bool rendered = false;
@@ -103,30 +157,40 @@ namespace thermion
 
       int numRendered = 0;
 
+      stageStart = std::chrono::high_resolution_clock::now();
       bool beginFrame = mRenderer->beginFrame(swapChain, frameTimeInNanos);
+      timing.beginFrameTimeInNanos += nanosSince(stageStart);
       if (beginFrame)
       {
         numRendered++;
-        durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - mLastRender).count() / 1e6f;
 
-        TRACE("Beginning frame (%.3f ms since last endFrame())", durationNs);
+        TRACE("Beginning frame (%.3f ms since last endFrame())", nanosSince(mLastRender) / 1e6f);
         for (auto view : views)
         {
+          stageStart = std::chrono::high_resolution_clock::now();
           mRenderer->render(view);
+          if (timing.numViews < FrameTiming::kMaxViews)
+          {
+            timing.viewRenderTimeInNanos[timing.numViews] = nanosSince(stageStart);
+          }
+          timing.numViews++;
         }
 
         if (mOverlayComponentManager)
         {
+          stageStart = std::chrono::high_resolution_clock::now();
           mOverlayComponentManager->update();
+          timing.overlayTimeInNanos += nanosSince(stageStart);
         }
 
-        mLastRender = std::chrono::high_resolution_clock::now();
+        stageStart = std::chrono::high_resolution_clock::now();
         mRenderer->endFrame();
+        mLastRender = std::chrono::high_resolution_clock::now();
+        timing.endFrameTimeInNanos += nanosSince(stageStart);
       }
       else
       {
-        durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - mLastRender).count() / 1e6f;
-        TRACE("Skipping frame (%.3f ms since last endFrame())", durationNs);
+        TRACE("Skipping frame (%.3f ms since last endFrame())", nanosSince(mLastRender) / 1e6f);
       }
       TRACE("%d views rendered for swapchain %d", numRendered, swapChainIndex);
       swapChainIndex++;
@@ -135,14 +199,23 @@ namespace thermion
         rendered = true;
       }
     }
+    if (!rendered)
+    {
+      // a fixed-step animation clock only advances for frames that are shown
+      for (auto animationManager : mAnimationManagers)
+      {
+        animationManager->cancelFrame();
+      }
+    }
+    mFrameScheduler.endFrame(rendered);
 #ifdef __EMSCRIPTEN__
     mEngine->execute();
 #endif
-    auto endTime = std::chrono::high_resolution_clock::now();
-    durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
-    float durationMs = durationNs / 1e6f;
+    timing.rendered = rendered;
+    timing.totalTimeInNanos = nanosSince(startTime);
+    mFrameStats.record(timing);
 
-    TRACE("Total render() time: %.3f ms", durationMs);
+    TRACE("Total render() time: %.3f ms", timing.totalTimeInNanos / 1e6f);
     return rendered;
   }
 
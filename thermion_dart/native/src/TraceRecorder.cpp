@@ -0,0 +1,158 @@
+#include "TraceRecorder.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "Log.hpp"
+
+namespace thermion
+{
+
+    std::atomic<bool> TraceRecorder::sEnabled = false;
+    std::mutex TraceRecorder::sMutex;
+    std::vector<std::shared_ptr<TraceRecorder::ThreadBuffer>> TraceRecorder::sBuffers;
+
+    TraceRecorder::ThreadBuffer &TraceRecorder::getThreadBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer)
+        {
+            buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(sMutex);
+            buffer->threadId = static_cast<uint32_t>(sBuffers.size() + 1);
+            sBuffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    void TraceRecorder::setThreadName(const char *name)
+    {
+        auto &buffer = getThreadBuffer();
+        std::lock_guard<std::mutex> lock(sMutex);
+        buffer.threadName = name;
+    }
+
+    void TraceRecorder::record(const char *name, uint64_t startInNanos, uint64_t endInNanos)
+    {
+        auto &buffer = getThreadBuffer();
+        if (!buffer.events)
+        {
+            buffer.events.reset(new Event[kEventsPerThread]);
+        }
+        auto index = buffer.numEvents.load(std::memory_order_relaxed);
+        buffer.events[index % kEventsPerThread] = {name, startInNanos, endInNanos};
+        buffer.numEvents.store(index + 1, std::memory_order_release);
+    }
+
+    void TraceRecorder::clear()
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        for (auto &buffer : sBuffers)
+        {
+            buffer->firstEvent.store(buffer->numEvents.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+    }
+
+    static void appendEscaped(std::string &out, const char *str)
+    {
+        for (; *str; str++)
+        {
+            auto c = *str;
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if (static_cast<unsigned char>(c) >= 0x20)
+            {
+                out += c;
+            }
+        }
+    }
+
+    std::string TraceRecorder::toJson()
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        std::vector<std::string> threadNames;
+        {
+            std::lock_guard<std::mutex> lock(sMutex);
+            buffers = sBuffers;
+            for (auto &buffer : buffers)
+            {
+                threadNames.push_back(buffer->threadName);
+            }
+        }
+
+        std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        char scratch[160];
+
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            auto &buffer = *buffers[i];
+
+            if (!threadNames[i].empty())
+            {
+                json += first ? "" : ",";
+                first = false;
+                snprintf(scratch, sizeof(scratch), "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", buffer.threadId);
+                json += scratch;
+                appendEscaped(json, threadNames[i].c_str());
+                json += "\"}}";
+            }
+
+            // the owning thread may still be recording, so copy first and
+            // then discard anything it may have overwritten in the meantime
+            auto end = buffer.numEvents.load(std::memory_order_acquire);
+            auto begin = std::max(buffer.firstEvent.load(std::memory_order_relaxed),
+                                  end > kEventsPerThread ? end - kEventsPerThread : 0);
+            std::vector<Event> events;
+            events.reserve(end - begin);
+            for (auto index = begin; index < end; index++)
+            {
+                events.push_back(buffer.events[index % kEventsPerThread]);
+            }
+            auto endAfterCopy = buffer.numEvents.load(std::memory_order_acquire);
+            auto firstValid = endAfterCopy > kEventsPerThread ? endAfterCopy - kEventsPerThread : 0;
+
+            for (auto index = std::max(begin, firstValid); index < end; index++)
+            {
+                const auto &event = events[index - begin];
+                json += first ? "" : ",";
+                first = false;
+                json += "{\"ph\":\"X\",\"cat\":\"thermion\",\"name\":\"";
+                appendEscaped(json, event.name);
+                snprintf(scratch, sizeof(scratch), "\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         buffer.threadId,
+                         event.startInNanos / 1e3,
+                         (event.endInNanos - event.startInNanos) / 1e3);
+                json += scratch;
+            }
+        }
+        json += "]}";
+        return json;
+    }
+
+    bool TraceRecorder::dump(const char *path)
+    {
+        auto json = toJson();
+        auto *file = fopen(path, "wb");
+        if (!file)
+        {
+            Log("Failed to open %s for writing trace", path);
+            return false;
+        }
+        auto written = fwrite(json.data(), 1, json.size(), file);
+        fclose(file);
+        if (written != json.size())
+        {
+            Log("Failed to write trace to %s", path);
+            return false;
+        }
+        TRACE("Wrote %zu bytes of trace events to %s", json.size(), path);
+        return true;
+    }
+
+} // namespace thermion
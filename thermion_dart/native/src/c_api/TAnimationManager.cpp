@@ -28,6 +28,21 @@ extern "C"
         animationManager->update(frameTimeInNanos);
     }
 
+    EMSCRIPTEN_KEEPALIVE void AnimationManager_setParallelUpdate(TAnimationManager *tAnimationManager, bool parallelUpdate) {
+        auto animationManager = reinterpret_cast<AnimationManager *>(tAnimationManager);
+        animationManager->setParallelUpdate(parallelUpdate);
+    }
+
+    EMSCRIPTEN_KEEPALIVE void AnimationManager_setFixedTimeStep(TAnimationManager *tAnimationManager, uint64_t stepInNanos) {
+        auto animationManager = reinterpret_cast<AnimationManager *>(tAnimationManager);
+        animationManager->setFixedTimeStep(stepInNanos);
+    }
+
+    EMSCRIPTEN_KEEPALIVE uint64_t AnimationManager_getTime(TAnimationManager *tAnimationManager) {
+        auto animationManager = reinterpret_cast<AnimationManager *>(tAnimationManager);
+        return animationManager->getTime();
+    }
+
     EMSCRIPTEN_KEEPALIVE bool AnimationManager_addGltfAnimationComponent(TAnimationManager *tAnimationManager, TSceneAsset *tSceneAsset)
     {
         auto sceneAsset = reinterpret_cast<SceneAsset *>(tSceneAsset);
@@ -160,6 +175,17 @@ extern "C"
         return true;
     }
 
+    EMSCRIPTEN_KEEPALIVE int AnimationManager_getMorphTargetWeights(
+        TAnimationManager *tAnimationManager,
+        EntityId entityId,
+        float *out,
+        int maxWeights)
+    {
+        auto entity = utils::Entity::import(entityId);
+        auto *animationManager = reinterpret_cast<AnimationManager *>(tAnimationManager);
+        return animationManager->getMorphTargetWeights(entity, out, maxWeights);
+    }
+
     EMSCRIPTEN_KEEPALIVE bool AnimationManager_clearMorphAnimation(TAnimationManager *tAnimationManager, EntityId entityId)
     {
         auto *animationManager = reinterpret_cast<AnimationManager *>(tAnimationManager);
@@ -0,0 +1,61 @@
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif 
+
+#include "Log.hpp"
+
+#include <filament/TransformManager.h>
+#include <utils/Entity.h>
+
+#include "c_api/TCollisionManager.h"
+#include "components/CollisionComponentManager.hpp"
+
+using namespace thermion;
+
+extern "C"
+{
+
+EMSCRIPTEN_KEEPALIVE TCollisionComponentManager *CollisionManager_create(TTransformManager *tTransformManager) {
+    auto *transformManager = reinterpret_cast<filament::TransformManager *>(tTransformManager);
+    auto *collisionManager = new CollisionComponentManager(*transformManager);
+    return reinterpret_cast<TCollisionComponentManager *>(collisionManager);
+}
+
+EMSCRIPTEN_KEEPALIVE void CollisionManager_destroy(TCollisionComponentManager *tCollisionManager) {
+    auto *collisionManager = reinterpret_cast<CollisionComponentManager *>(tCollisionManager);
+    delete collisionManager;
+}
+
+EMSCRIPTEN_KEEPALIVE void CollisionManager_addComponent(TCollisionComponentManager *tCollisionManager, EntityId entityId, Aabb3 boundingBox, void (*callback)(EntityId entityId1, EntityId entityId2), bool affectsTransform) {
+    auto *collisionManager = reinterpret_cast<CollisionComponentManager *>(tCollisionManager);
+    auto center = filament::math::float3 { boundingBox.centerX, boundingBox.centerY, boundingBox.centerZ };
+    auto halfExtent = filament::math::float3 { boundingBox.halfExtentX, boundingBox.halfExtentY, boundingBox.halfExtentZ };
+    collisionManager->addCollisionComponent(utils::Entity::import(entityId), filament::Aabb { center - halfExtent, center + halfExtent }, callback, affectsTransform);
+}
+
+EMSCRIPTEN_KEEPALIVE void CollisionManager_removeComponent(TCollisionComponentManager *tCollisionManager, EntityId entityId) {
+    auto *collisionManager = reinterpret_cast<CollisionComponentManager *>(tCollisionManager);
+    collisionManager->removeCollisionComponent(utils::Entity::import(entityId));
+}
+
+EMSCRIPTEN_KEEPALIVE void CollisionManager_markDirty(TCollisionComponentManager *tCollisionManager, EntityId entityId) {
+    auto *collisionManager = reinterpret_cast<CollisionComponentManager *>(tCollisionManager);
+    collisionManager->markDirty(utils::Entity::import(entityId));
+}
+
+EMSCRIPTEN_KEEPALIVE void CollisionManager_update(TCollisionComponentManager *tCollisionManager) {
+    auto *collisionManager = reinterpret_cast<CollisionComponentManager *>(tCollisionManager);
+    collisionManager->update();
+}
+
+EMSCRIPTEN_KEEPALIVE uint32_t CollisionManager_collideAll(TCollisionComponentManager *tCollisionManager, EntityId *outPairs, uint32_t maxPairs) {
+    auto *collisionManager = reinterpret_cast<CollisionComponentManager *>(tCollisionManager);
+    auto pairs = collisionManager->collideAll();
+    for (uint32_t i = 0; i < pairs.size() && i < maxPairs; i++) {
+        outPairs[i * 2] = utils::Entity::smuggle(pairs[i].first);
+        outPairs[i * 2 + 1] = utils::Entity::smuggle(pairs[i].second);
+    }
+    return static_cast<uint32_t>(pairs.size());
+}
+
+}
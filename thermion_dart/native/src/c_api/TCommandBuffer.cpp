@@ -0,0 +1,164 @@
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include <filament/MaterialInstance.h>
+#include <filament/TransformManager.h>
+#include <utils/Entity.h>
+
+#include "c_api/TCommandBuffer.h"
+#include "c_api/TRenderableManager.h"
+#include "c_api/TScene.h"
+#include "c_api/TTransformManager.h"
+
+#include "Log.hpp"
+#include "MathUtils.hpp"
+
+using namespace thermion;
+
+extern "C"
+{
+
+    EMSCRIPTEN_KEEPALIVE uint32_t CommandBuffer_execute(const uint8_t *const commands, size_t length)
+    {
+        // world transforms are only recomputed once per TransformManager
+        // (when the transaction is committed), rather than once per command
+        std::vector<filament::TransformManager *> transformManagers;
+        auto beginTransaction = [&](TTransformManager *tTransformManager) {
+            auto *transformManager = reinterpret_cast<filament::TransformManager *>(tTransformManager);
+            if (std::find(transformManagers.begin(), transformManagers.end(), transformManager) == transformManagers.end())
+            {
+                transformManager->openLocalTransformTransaction();
+                transformManagers.push_back(transformManager);
+            }
+        };
+
+        uint32_t numExecuted = 0;
+        size_t offset = 0;
+
+        while (offset + sizeof(TCommandHeader) <= length)
+        {
+            const auto *cmd = commands + offset;
+            const auto *header = reinterpret_cast<const TCommandHeader *>(cmd);
+
+            if (header->size < sizeof(TCommandHeader) || header->size % 8 != 0 || offset + header->size > length)
+            {
+                Log("Malformed command (opcode %d, size %d) at offset %zu, aborting", header->opcode, header->size, offset);
+                break;
+            }
+
+            bool valid = true;
+
+            switch (header->opcode)
+            {
+            case COMMAND_TRANSFORM_SET_TRANSFORM:
+            {
+                valid = header->size >= sizeof(TSetTransformCommand);
+                if (valid)
+                {
+                    const auto *setTransform = reinterpret_cast<const TSetTransformCommand *>(cmd);
+                    beginTransaction(setTransform->tTransformManager);
+                    TransformManager_setTransform(setTransform->tTransformManager, setTransform->entityId, setTransform->transform);
+                }
+                break;
+            }
+            case COMMAND_TRANSFORM_SET_PARENT:
+            {
+                valid = header->size >= sizeof(TSetParentCommand);
+                if (valid)
+                {
+                    const auto *setParent = reinterpret_cast<const TSetParentCommand *>(cmd);
+                    TransformManager_setParent(setParent->tTransformManager, setParent->child, setParent->parent, setParent->preserveScaling);
+                }
+                break;
+            }
+            case COMMAND_SCENE_ADD_ENTITY:
+            case COMMAND_SCENE_REMOVE_ENTITY:
+            {
+                valid = header->size >= sizeof(TSceneEntityCommand);
+                if (valid)
+                {
+                    const auto *sceneEntity = reinterpret_cast<const TSceneEntityCommand *>(cmd);
+                    if (header->opcode == COMMAND_SCENE_ADD_ENTITY)
+                    {
+                        Scene_addEntity(sceneEntity->tScene, sceneEntity->entityId);
+                    }
+                    else
+                    {
+                        Scene_removeEntity(sceneEntity->tScene, sceneEntity->entityId);
+                    }
+                }
+                break;
+            }
+            case COMMAND_MATERIAL_INSTANCE_SET_PARAMETER_FLOAT:
+            {
+                const auto *setParameter = reinterpret_cast<const TSetMaterialParameterFloatCommand *>(cmd);
+                valid = header->size >= sizeof(TSetMaterialParameterFloatCommand) &&
+                        sizeof(TSetMaterialParameterFloatCommand) + setParameter->nameLength < header->size;
+                if (!valid)
+                {
+                    break;
+                }
+                const char *name = reinterpret_cast<const char *>(cmd + sizeof(TSetMaterialParameterFloatCommand));
+                if (name[setParameter->nameLength] != '\0')
+                {
+                    valid = false;
+                    break;
+                }
+                auto *materialInstance = reinterpret_cast<filament::MaterialInstance *>(setParameter->tMaterialInstance);
+                const auto *v = setParameter->value;
+                switch (setParameter->numComponents)
+                {
+                case 1:
+                    materialInstance->setParameter(name, static_cast<float>(v[0]));
+                    break;
+                case 2:
+                    materialInstance->setParameter(name, filament::math::float2{v[0], v[1]});
+                    break;
+                case 3:
+                    materialInstance->setParameter(name, filament::math::float3{v[0], v[1], v[2]});
+                    break;
+                case 4:
+                    materialInstance->setParameter(name, filament::math::float4{v[0], v[1], v[2], v[3]});
+                    break;
+                default:
+                    valid = false;
+                }
+                break;
+            }
+            case COMMAND_RENDERABLE_SET_PRIORITY:
+            {
+                valid = header->size >= sizeof(TSetPriorityCommand);
+                if (valid)
+                {
+                    const auto *setPriority = reinterpret_cast<const TSetPriorityCommand *>(cmd);
+                    RenderableManager_setPriority(setPriority->tRenderableManager, setPriority->entityId, static_cast<uint8_t>(setPriority->priority));
+                }
+                break;
+            }
+            default:
+                valid = false;
+            }
+
+            if (!valid)
+            {
+                Log("Invalid command (opcode %d, size %d) at offset %zu, aborting", header->opcode, header->size, offset);
+                break;
+            }
+
+            numExecuted++;
+            offset += header->size;
+        }
+
+        for (auto *transformManager : transformManagers)
+        {
+            transformManager->commitLocalTransformTransaction();
+        }
+
+        TRACE("Executed %d commands (%zu bytes)", numExecuted, offset);
+        return numExecuted;
+    }
+}
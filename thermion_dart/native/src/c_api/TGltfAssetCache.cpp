@@ -0,0 +1,78 @@
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif 
+
+#include <filament/MaterialInstance.h>
+
+#include "c_api/TGltfAssetCache.h"
+#include "scene/GltfAssetCache.hpp"
+#include "scene/GltfSceneAsset.hpp"
+
+#include "Log.hpp"
+
+using namespace thermion;
+
+extern "C"
+{
+
+EMSCRIPTEN_KEEPALIVE TGltfAssetCache *GltfAssetCache_create(uint64_t budgetInBytes) {
+    auto *cache = new GltfAssetCache(budgetInBytes);
+    return reinterpret_cast<TGltfAssetCache *>(cache);
+}
+
+EMSCRIPTEN_KEEPALIVE void GltfAssetCache_destroy(TGltfAssetCache *tGltfAssetCache) {
+    auto *cache = reinterpret_cast<GltfAssetCache *>(tGltfAssetCache);
+    delete cache;
+}
+
+EMSCRIPTEN_KEEPALIVE uint64_t GltfAssetCache_computeKey(const uint8_t *data, size_t length, const char *resourceUri) {
+    return GltfAssetCache::computeKey(data, length, resourceUri);
+}
+
+EMSCRIPTEN_KEEPALIVE uint64_t GltfAssetCache_computeFileKey(TGltfAssetCache *tGltfAssetCache, const char *path, const char *resourceUri, uint64_t *outLength) {
+    auto *cache = reinterpret_cast<GltfAssetCache *>(tGltfAssetCache);
+    return cache->computeFileKey(path, resourceUri, outLength);
+}
+
+EMSCRIPTEN_KEEPALIVE TSceneAsset *GltfAssetCache_acquire(TGltfAssetCache *tGltfAssetCache, uint64_t key, TMaterialInstance **tMaterialInstances, int materialInstanceCount) {
+    auto *cache = reinterpret_cast<GltfAssetCache *>(tGltfAssetCache);
+    auto *materialInstances = reinterpret_cast<MaterialInstance **>(tMaterialInstances);
+    auto *instance = cache->acquire(key, materialInstances, materialInstanceCount);
+    return reinterpret_cast<TSceneAsset *>(instance);
+}
+
+EMSCRIPTEN_KEEPALIVE TSceneAsset *GltfAssetCache_insert(TGltfAssetCache *tGltfAssetCache, uint64_t key, TSceneAsset *tSceneAsset, uint64_t sizeInBytes) {
+    auto *cache = reinterpret_cast<GltfAssetCache *>(tGltfAssetCache);
+    auto *sceneAsset = reinterpret_cast<SceneAsset *>(tSceneAsset);
+    if (sceneAsset->getType() != SceneAsset::SceneAssetType::Gltf || sceneAsset->isInstance()) {
+        Log("Only glTF assets (not instances) can be cached");
+        return std::nullptr_t();
+    }
+    auto *instance = cache->insert(key, static_cast<GltfSceneAsset *>(sceneAsset), sizeInBytes);
+    return reinterpret_cast<TSceneAsset *>(instance);
+}
+
+EMSCRIPTEN_KEEPALIVE bool GltfAssetCache_release(TGltfAssetCache *tGltfAssetCache, TSceneAsset *tSceneAsset) {
+    auto *cache = reinterpret_cast<GltfAssetCache *>(tGltfAssetCache);
+    auto *sceneAsset = reinterpret_cast<SceneAsset *>(tSceneAsset);
+    return cache->release(sceneAsset);
+}
+
+EMSCRIPTEN_KEEPALIVE void GltfAssetCache_setBudget(TGltfAssetCache *tGltfAssetCache, uint64_t budgetInBytes) {
+    auto *cache = reinterpret_cast<GltfAssetCache *>(tGltfAssetCache);
+    cache->setBudget(budgetInBytes);
+}
+
+EMSCRIPTEN_KEEPALIVE void GltfAssetCache_getStats(TGltfAssetCache *tGltfAssetCache, TGltfAssetCacheStats *out) {
+    auto *cache = reinterpret_cast<GltfAssetCache *>(tGltfAssetCache);
+    auto stats = cache->getStats();
+    out->hits = stats.hits;
+    out->misses = stats.misses;
+    out->evictions = stats.evictions;
+    out->entryCount = stats.entryCount;
+    out->instancesInUse = stats.instancesInUse;
+    out->sizeInBytes = stats.sizeInBytes;
+    out->budgetInBytes = stats.budgetInBytes;
+}
+
+}
@@ -27,6 +27,8 @@
 #include <utils/NameComponentManager.h>
 
 #include "Log.hpp"
+#include "MappedFile.hpp"
+#include "TraceRecorder.hpp"
 
 #ifdef __cplusplus
 namespace thermion
@@ -64,6 +66,7 @@ EMSCRIPTEN_KEEPALIVE TFilamentAsset *GltfAssetLoader_load(
     size_t length,
     uint8_t numInstances)
 {
+    TRACE_SCOPE("GltfAssetLoader_load");
     auto *engine = reinterpret_cast<filament::Engine *>(tEngine);
     auto *assetLoader = reinterpret_cast<gltfio::AssetLoader *>(tAssetLoader);
     
@@ -94,6 +97,36 @@ EMSCRIPTEN_KEEPALIVE TFilamentAsset *GltfAssetLoader_load(
     return reinterpret_cast<TFilamentAsset *>(asset);
 }
 
+EMSCRIPTEN_KEEPALIVE TFilamentAsset *GltfAssetLoader_loadFile(
+    TEngine *tEngine,
+    TGltfAssetLoader *tAssetLoader,
+    const char *path,
+    uint8_t numInstances)
+{
+    TRACE_SCOPE("GltfAssetLoader_loadFile");
+    auto file = MappedFile::open(path);
+    if (!file)
+    {
+        Log("Failed to open glTF asset %s", path);
+        return std::nullptr_t();
+    }
+    if (file->size() > UINT32_MAX)
+    {
+        Log("glTF asset %s is too large (%zu bytes)", path, file->size());
+        return std::nullptr_t();
+    }
+    TRACE("Loading glTF asset %s (%zu bytes, %s)", path, file->size(), file->isMapped() ? "mapped" : "copied");
+
+    // the mapping is read from start to end while parsing
+    file->prefetch();
+    auto *asset = GltfAssetLoader_load(tEngine, tAssetLoader, file->data(), file->size(), numInstances);
+
+    // the asset keeps its own copy of the source data (including the GLB's embedded
+    // buffers, which are uploaded from that copy by the resource loader), so the
+    // mapping is released now rather than remaining resident alongside it
+    return asset;
+}
+
 EMSCRIPTEN_KEEPALIVE TMaterialInstance *GltfAssetLoader_getMaterialInstance(TRenderableManager *tRenderableManager, TFilamentAsset *tAsset) {
     auto *renderableManager = reinterpret_cast<filament::RenderableManager *>(tRenderableManager);
     auto *asset = reinterpret_cast<gltfio::FilamentAsset *>(tAsset);
@@ -0,0 +1,50 @@
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif 
+
+#include <gltfio/FilamentAsset.h>
+#include <gltfio/ResourceLoader.h>
+
+#include "c_api/TGltfImporter.h"
+#include "scene/GltfImporter.hpp"
+
+using namespace thermion;
+
+extern "C"
+{
+
+EMSCRIPTEN_KEEPALIVE TGltfImporter *GltfImporter_create(uint64_t budgetInNanos) {
+    auto *importer = new GltfImporter(budgetInNanos);
+    return reinterpret_cast<TGltfImporter *>(importer);
+}
+
+EMSCRIPTEN_KEEPALIVE void GltfImporter_destroy(TGltfImporter *tGltfImporter) {
+    auto *importer = reinterpret_cast<GltfImporter *>(tGltfImporter);
+    delete importer;
+}
+
+EMSCRIPTEN_KEEPALIVE void GltfImporter_setBudget(TGltfImporter *tGltfImporter, uint64_t budgetInNanos) {
+    auto *importer = reinterpret_cast<GltfImporter *>(tGltfImporter);
+    importer->setBudget(budgetInNanos);
+}
+
+EMSCRIPTEN_KEEPALIVE bool GltfImporter_begin(TGltfImporter *tGltfImporter, TGltfResourceLoader *tGltfResourceLoader, TFilamentAsset *tFilamentAsset) {
+    auto *importer = reinterpret_cast<GltfImporter *>(tGltfImporter);
+    auto *resourceLoader = reinterpret_cast<filament::gltfio::ResourceLoader *>(tGltfResourceLoader);
+    auto *asset = reinterpret_cast<filament::gltfio::FilamentAsset *>(tFilamentAsset);
+    return importer->begin(resourceLoader, asset);
+}
+
+EMSCRIPTEN_KEEPALIVE float GltfImporter_getProgress(TGltfImporter *tGltfImporter, TFilamentAsset *tFilamentAsset) {
+    auto *importer = reinterpret_cast<GltfImporter *>(tGltfImporter);
+    auto *asset = reinterpret_cast<filament::gltfio::FilamentAsset *>(tFilamentAsset);
+    return importer->getProgress(asset);
+}
+
+EMSCRIPTEN_KEEPALIVE void GltfImporter_cancel(TGltfImporter *tGltfImporter, TFilamentAsset *tFilamentAsset) {
+    auto *importer = reinterpret_cast<GltfImporter *>(tGltfImporter);
+    auto *asset = reinterpret_cast<filament::gltfio::FilamentAsset *>(tFilamentAsset);
+    importer->cancel(asset);
+}
+
+}
@@ -27,6 +27,27 @@
 #include <utils/NameComponentManager.h>
 
 #include "Log.hpp"
+#include "MappedFile.hpp"
+#include "TraceRecorder.hpp"
+#include "scene/Ktx2TextureProvider.hpp"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    // ResourceLoader doesn't take ownership of its texture providers, so they
+    // are destroyed alongside it
+    struct TextureProviders
+    {
+        std::unique_ptr<filament::gltfio::TextureProvider> stb;
+        std::unique_ptr<thermion::Ktx2TextureProvider> ktx2;
+    };
+
+    std::mutex sTextureProvidersMutex;
+    std::unordered_map<filament::gltfio::ResourceLoader *, TextureProviders> sTextureProviders;
+}
 
 #ifdef __cplusplus
 namespace thermion
@@ -42,11 +63,17 @@ EMSCRIPTEN_KEEPALIVE TGltfResourceLoader *GltfResourceLoader_create(TEngine *tEn
     auto *gltfResourceLoader = new gltfio::ResourceLoader({
         .engine = engine,
     });
-    auto stbDecoder = gltfio::createStbProvider(engine);
-    auto ktxDecoder = gltfio::createKtx2Provider(engine);
-    gltfResourceLoader->addTextureProvider("image/ktx2", ktxDecoder);
-    gltfResourceLoader->addTextureProvider("image/png", stbDecoder);
-    gltfResourceLoader->addTextureProvider("image/jpeg", stbDecoder);
+    TextureProviders providers;
+    providers.stb.reset(gltfio::createStbProvider(engine));
+    providers.ktx2 = std::make_unique<thermion::Ktx2TextureProvider>(engine);
+    gltfResourceLoader->addTextureProvider("image/ktx2", providers.ktx2.get());
+    gltfResourceLoader->addTextureProvider("image/png", providers.stb.get());
+    gltfResourceLoader->addTextureProvider("image/jpeg", providers.stb.get());
+
+    {
+        std::lock_guard lock(sTextureProvidersMutex);
+        sTextureProviders[gltfResourceLoader] = std::move(providers);
+    }
     
     return reinterpret_cast<TGltfResourceLoader *>(gltfResourceLoader);
 }
@@ -54,6 +81,26 @@ EMSCRIPTEN_KEEPALIVE TGltfResourceLoader *GltfResourceLoader_create(TEngine *tEn
 EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_destroy(TEngine *tEngine, TGltfResourceLoader *tGltfResourceLoader) {
     auto *gltfResourceLoader = reinterpret_cast<gltfio::ResourceLoader *>(tGltfResourceLoader);
     delete gltfResourceLoader;
+    std::lock_guard lock(sTextureProvidersMutex);
+    sTextureProviders.erase(gltfResourceLoader);
+}
+
+EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_getKtx2DecodeStats(TGltfResourceLoader *tGltfResourceLoader, TKtx2DecodeStats *out) {
+    auto *gltfResourceLoader = reinterpret_cast<gltfio::ResourceLoader *>(tGltfResourceLoader);
+    thermion::Ktx2TextureProvider::Stats stats;
+    {
+        std::lock_guard lock(sTextureProvidersMutex);
+        auto it = sTextureProviders.find(gltfResourceLoader);
+        if (it != sTextureProviders.end())
+        {
+            stats = it->second.ktx2->getStats();
+        }
+    }
+    out->texturesDecoded = stats.texturesDecoded;
+    out->texturesFailed = stats.texturesFailed;
+    out->totalDecodeTimeInNanos = stats.totalDecodeTimeInNanos;
+    out->maxDecodeTimeInNanos = stats.maxDecodeTimeInNanos;
+    out->lastDecodeTimeInNanos = stats.lastDecodeTimeInNanos;
 }
 
 EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_addResourceData(TGltfResourceLoader *tGltfResourceLoader, const char *uri, uint8_t *data, size_t length) {
@@ -64,7 +111,30 @@ EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_addResourceData(TGltfResourceLoader
         length});
 }
 
+EMSCRIPTEN_KEEPALIVE bool GltfResourceLoader_addResourceFile(TGltfResourceLoader *tGltfResourceLoader, const char *uri, const char *path) {
+    auto file = MappedFile::open(path);
+    if (!file) {
+        Log("Failed to open %s for glTF resource URI %s", path, uri);
+        return false;
+    }
+    TRACE("Adding file %s (length %d, %s) for glTF resource URI %s", path, file->size(), file->isMapped() ? "mapped" : "copied", uri);
+    // start paging in the contents now, rather than when the loader first reads them
+    file->prefetch();
+    auto *gltfResourceLoader = reinterpret_cast<gltfio::ResourceLoader *>(tGltfResourceLoader);
+    auto *data = file->data();
+    auto size = file->size();
+    gltfResourceLoader->addResourceData(uri, {
+        data,
+        size,
+        [](void *, size_t, void *user) {
+            delete static_cast<MappedFile *>(user);
+        },
+        file.release()});
+    return true;
+}
+
 EMSCRIPTEN_KEEPALIVE bool GltfResourceLoader_loadResources(TGltfResourceLoader *tGltfResourceLoader, TFilamentAsset *tFilamentAsset) {    
+    TRACE_SCOPE("GltfResourceLoader_loadResources");
     auto *gltfResourceLoader = reinterpret_cast<gltfio::ResourceLoader *>(tGltfResourceLoader);
     auto *filamentAsset = reinterpret_cast<gltfio::FilamentAsset *>(tFilamentAsset);
     return gltfResourceLoader->loadResources(filamentAsset);
@@ -0,0 +1,69 @@
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif 
+
+#include "Log.hpp"
+
+#include <filament/Engine.h>
+#include <filament/View.h>
+#include <utils/Entity.h>
+
+#include "c_api/TLodManager.h"
+#include "components/LodComponentManager.hpp"
+#include "scene/GeometrySceneAsset.hpp"
+
+using namespace thermion;
+
+extern "C"
+{
+
+EMSCRIPTEN_KEEPALIVE TLodManager *LodManager_create(TEngine *tEngine, TView *tView) {
+    auto *engine = reinterpret_cast<filament::Engine *>(tEngine);
+    auto *view = reinterpret_cast<filament::View *>(tView);
+    auto *lodManager = new LodComponentManager(engine, view);
+    return reinterpret_cast<TLodManager *>(lodManager);
+}
+
+EMSCRIPTEN_KEEPALIVE void LodManager_destroy(TLodManager *tLodManager) {
+    auto *lodManager = reinterpret_cast<LodComponentManager *>(tLodManager);
+    delete lodManager;
+}
+
+EMSCRIPTEN_KEEPALIVE bool LodManager_addComponent(TLodManager *tLodManager, TSceneAsset *tSceneAsset) {
+    auto *lodManager = reinterpret_cast<LodComponentManager *>(tLodManager);
+    auto *sceneAsset = reinterpret_cast<SceneAsset *>(tSceneAsset);
+    if (sceneAsset->getType() != SceneAsset::SceneAssetType::Geometry) {
+        Log("Levels of detail are only supported for geometry assets");
+        return false;
+    }
+    auto *asset = static_cast<GeometrySceneAsset *>(sceneAsset);
+    auto lodChain = asset->getLodChain();
+    if (!lodChain) {
+        Log("Asset has no levels of detail (call SceneAsset_generateLods first)");
+        return false;
+    }
+    lodManager->addLodComponent(asset->getRenderableEntity(), lodChain);
+    return true;
+}
+
+EMSCRIPTEN_KEEPALIVE void LodManager_removeComponent(TLodManager *tLodManager, EntityId entityId) {
+    auto *lodManager = reinterpret_cast<LodComponentManager *>(tLodManager);
+    lodManager->removeLodComponent(utils::Entity::import(entityId));
+}
+
+EMSCRIPTEN_KEEPALIVE void LodManager_setBias(TLodManager *tLodManager, float bias) {
+    auto *lodManager = reinterpret_cast<LodComponentManager *>(tLodManager);
+    lodManager->setBias(bias);
+}
+
+EMSCRIPTEN_KEEPALIVE float LodManager_getBias(TLodManager *tLodManager) {
+    auto *lodManager = reinterpret_cast<LodComponentManager *>(tLodManager);
+    return lodManager->getBias();
+}
+
+EMSCRIPTEN_KEEPALIVE int32_t LodManager_getCurrentLevel(TLodManager *tLodManager, EntityId entityId) {
+    auto *lodManager = reinterpret_cast<LodComponentManager *>(tLodManager);
+    return lodManager->getCurrentLevel(utils::Entity::import(entityId));
+}
+
+}
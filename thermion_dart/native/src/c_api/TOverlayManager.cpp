@@ -12,6 +12,7 @@
 
 #include "c_api/TOverlayManager.h"
 #include "components/OverlayComponentManager.hpp"
+#include "scene/SceneAsset.hpp"
 
 using namespace thermion;
 
@@ -35,10 +36,11 @@ EMSCRIPTEN_KEEPALIVE void OverlayManager_setRenderTarget(TOverlayManager *tOverl
     overlayManager->setRenderTarget(renderTarget);
 }
 
-EMSCRIPTEN_KEEPALIVE void OverlayManager_addComponent(TOverlayManager *tOverlayManager, EntityId entityId, TMaterialInstance *tMaterialInstance) {
+EMSCRIPTEN_KEEPALIVE void OverlayManager_addComponent(TOverlayManager *tOverlayManager, TSceneAsset *tSceneAsset, EntityId entityId, TMaterialInstance *tMaterialInstance) {
     auto *overlayManager = reinterpret_cast<OverlayComponentManager *>(tOverlayManager);
+    auto *sceneAsset = reinterpret_cast<SceneAsset *>(tSceneAsset);
     auto *materialInstance = reinterpret_cast<filament::MaterialInstance *>(tMaterialInstance);
-    overlayManager->addOverlayComponent(utils::Entity::import(entityId), materialInstance);
+    overlayManager->addOverlayComponent(sceneAsset, utils::Entity::import(entityId), materialInstance);
 }
 
 EMSCRIPTEN_KEEPALIVE void OverlayManager_removeComponent(TOverlayManager *tOverlayManager, EntityId entityId) {
@@ -46,4 +48,9 @@ EMSCRIPTEN_KEEPALIVE void OverlayManager_removeComponent(TOverlayManager *tOverl
     overlayManager->removeOverlayComponent(utils::Entity::import(entityId));
 }
 
+EMSCRIPTEN_KEEPALIVE void OverlayManager_invalidate(TOverlayManager *tOverlayManager) {
+    auto *overlayManager = reinterpret_cast<OverlayComponentManager *>(tOverlayManager);
+    overlayManager->invalidate();
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif 
+
+#include <memory>
+#include <vector>
+
+#include <filament/View.h>
+#include <utils/Entity.h>
+
+#include "Log.hpp"
+
+#include "c_api/APIExport.h"
+#include "scene/RayPicker.hpp"
+
+using namespace thermion;
+
+#include "c_api/TRayPicker.h"
+
+static void toTRayHit(const RayHit &hit, TRayHit *tHit)
+{
+    tHit->entity = utils::Entity::smuggle(hit.entity);
+    tHit->distance = hit.distance;
+    tHit->position = {hit.position.x, hit.position.y, hit.position.z};
+    tHit->instance = hit.instance;
+}
+
+extern "C"
+{
+
+    EMSCRIPTEN_KEEPALIVE TRayPicker *RayPicker_create(TEngine *tEngine) {
+        auto *engine = reinterpret_cast<filament::Engine *>(tEngine);
+        return reinterpret_cast<TRayPicker *>(new RayPicker(engine));
+    }
+
+    EMSCRIPTEN_KEEPALIVE void RayPicker_destroy(TRayPicker *tRayPicker) {
+        delete reinterpret_cast<RayPicker *>(tRayPicker);
+    }
+
+    EMSCRIPTEN_KEEPALIVE bool RayPicker_addSceneAsset(TRayPicker *tRayPicker, TSceneAsset *tSceneAsset) {
+        auto *rayPicker = reinterpret_cast<RayPicker *>(tRayPicker);
+        auto *sceneAsset = reinterpret_cast<SceneAsset *>(tSceneAsset);
+        return rayPicker->addSceneAsset(sceneAsset);
+    }
+
+    EMSCRIPTEN_KEEPALIVE void RayPicker_removeSceneAsset(TRayPicker *tRayPicker, TSceneAsset *tSceneAsset) {
+        auto *rayPicker = reinterpret_cast<RayPicker *>(tRayPicker);
+        auto *sceneAsset = reinterpret_cast<SceneAsset *>(tSceneAsset);
+        rayPicker->removeSceneAsset(sceneAsset);
+    }
+
+    EMSCRIPTEN_KEEPALIVE void RayPicker_setTriangles(TRayPicker *tRayPicker, EntityId entityId, const float *const positions, uint32_t numVertices, const uint32_t *const indices, uint32_t numIndices) {
+        auto *rayPicker = reinterpret_cast<RayPicker *>(tRayPicker);
+        auto mesh = std::make_shared<PickingMesh>();
+        mesh->positions.resize(numVertices);
+        for (uint32_t i = 0; i < numVertices; i++) {
+            mesh->positions[i] = {positions[i * 3], positions[(i * 3) + 1], positions[(i * 3) + 2]};
+        }
+        mesh->indices.assign(indices, indices + numIndices);
+        rayPicker->setPickingMesh(utils::Entity::import(entityId), mesh);
+    }
+
+    EMSCRIPTEN_KEEPALIVE void RayPicker_removeTriangles(TRayPicker *tRayPicker, EntityId entityId) {
+        auto *rayPicker = reinterpret_cast<RayPicker *>(tRayPicker);
+        rayPicker->removePickingMesh(utils::Entity::import(entityId));
+    }
+
+    EMSCRIPTEN_KEEPALIVE uint32_t RayPicker_pick(TRayPicker *tRayPicker, TView *tView, const TRay *const rays, uint32_t numRays, bool refine, TRayHit *hits) {
+        auto *rayPicker = reinterpret_cast<RayPicker *>(tRayPicker);
+        auto *view = reinterpret_cast<filament::View *>(tView);
+        if (!view->getScene()) {
+            Log("View has no scene");
+            return 0;
+        }
+        std::vector<Ray> nativeRays(numRays);
+        for (uint32_t i = 0; i < numRays; i++) {
+            nativeRays[i].origin = {rays[i].origin.x, rays[i].origin.y, rays[i].origin.z};
+            nativeRays[i].direction = {rays[i].direction.x, rays[i].direction.y, rays[i].direction.z};
+        }
+        std::vector<RayHit> nativeHits(numRays);
+        auto numHits = rayPicker->pick(view->getScene(), view->getVisibleLayers(), nativeRays.data(), numRays, refine, nativeHits.data());
+        for (uint32_t i = 0; i < numRays; i++) {
+            toTRayHit(nativeHits[i], &hits[i]);
+        }
+        return static_cast<uint32_t>(numHits);
+    }
+
+    EMSCRIPTEN_KEEPALIVE bool RayPicker_pickView(TRayPicker *tRayPicker, TView *tView, uint32_t x, uint32_t y, bool refine, TRayHit *hit) {
+        auto *rayPicker = reinterpret_cast<RayPicker *>(tRayPicker);
+        auto *view = reinterpret_cast<filament::View *>(tView);
+        if (!view->getScene()) {
+            Log("View has no scene");
+            return false;
+        }
+        // sample the center of the pixel
+        auto ray = RayPicker::getViewRay(view, x + 0.5f, y + 0.5f);
+        RayHit nativeHit;
+        auto numHits = rayPicker->pick(view->getScene(), view->getVisibleLayers(), &ray, 1, refine, &nativeHit);
+        toTRayHit(nativeHit, hit);
+        return numHits > 0;
+    }
+}
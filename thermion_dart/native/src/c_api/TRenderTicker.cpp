@@ -6,7 +6,9 @@
 #endif
 
 #include <thread>
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include <filament/LightManager.h>
 
@@ -61,10 +63,77 @@ EMSCRIPTEN_KEEPALIVE void RenderTicker_setOverlayManager(TRenderTicker *tRenderT
     renderTicker->addOverlayManager(overlayManager);
 }
 
+EMSCRIPTEN_KEEPALIVE void RenderTicker_setLodManager(TRenderTicker *tRenderTicker, TLodManager *tLodManager) {
+    auto *renderTicker = reinterpret_cast<RenderTicker *>(tRenderTicker);
+    auto *lodManager = reinterpret_cast<LodComponentManager *>(tLodManager);
+    renderTicker->setLodManager(lodManager);
+}
+
+EMSCRIPTEN_KEEPALIVE void RenderTicker_setCollisionManager(TRenderTicker *tRenderTicker, TCollisionComponentManager *tCollisionManager) {
+    auto *renderTicker = reinterpret_cast<RenderTicker *>(tRenderTicker);
+    auto *collisionManager = reinterpret_cast<CollisionComponentManager *>(tCollisionManager);
+    renderTicker->setCollisionManager(collisionManager);
+}
+
+EMSCRIPTEN_KEEPALIVE void RenderTicker_setGltfImporter(TRenderTicker *tRenderTicker, TGltfImporter *tGltfImporter) {
+    auto *renderTicker = reinterpret_cast<RenderTicker *>(tRenderTicker);
+    auto *gltfImporter = reinterpret_cast<GltfImporter *>(tGltfImporter);
+    renderTicker->setGltfImporter(gltfImporter);
+}
+
 EMSCRIPTEN_KEEPALIVE void RenderTicker_removeSwapChain(TRenderTicker *tRenderTicker, TSwapChain *tSwapChain) {
     auto *renderTicker = reinterpret_cast<RenderTicker *>(tRenderTicker);
     auto *swapChain = reinterpret_cast<filament::SwapChain *>(tSwapChain);
     renderTicker->removeSwapChain(swapChain);
 }
 
+EMSCRIPTEN_KEEPALIVE void RenderTicker_setTargetFrameInterval(TRenderTicker *tRenderTicker, uint64_t intervalInNanos) {
+    auto *renderTicker = reinterpret_cast<RenderTicker *>(tRenderTicker);
+    renderTicker->getFrameScheduler().setTargetFrameInterval(intervalInNanos);
+}
+
+EMSCRIPTEN_KEEPALIVE void RenderTicker_onVsync(TRenderTicker *tRenderTicker, uint64_t vsyncTimeInNanos) {
+    auto *renderTicker = reinterpret_cast<RenderTicker *>(tRenderTicker);
+    renderTicker->getFrameScheduler().onVsync(vsyncTimeInNanos);
+}
+
+EMSCRIPTEN_KEEPALIVE void RenderTicker_getFrameSchedulerStats(TRenderTicker *tRenderTicker, TFrameSchedulerStats *out) {
+    auto *renderTicker = reinterpret_cast<RenderTicker *>(tRenderTicker);
+    auto stats = renderTicker->getFrameScheduler().getStats();
+    out->framesRendered = stats.framesRendered;
+    out->lateFrames = stats.lateFrames;
+    out->droppedFrames = stats.droppedFrames;
+    out->skippedFrames = stats.skippedFrames;
+    out->coalescedRequests = stats.coalescedRequests;
+    out->frameIntervalInNanos = stats.frameIntervalInNanos;
+    out->lastLatenessInNanos = stats.lastLatenessInNanos;
+    out->maxLatenessInNanos = stats.maxLatenessInNanos;
+}
+
+EMSCRIPTEN_KEEPALIVE uint32_t RenderTicker_getFrameStats(TRenderTicker *tRenderTicker, TFrameTiming *out, uint32_t maxFrames) {
+    static_assert(FRAME_TIMING_MAX_VIEWS == FrameTiming::kMaxViews, "FRAME_TIMING_MAX_VIEWS must match FrameTiming::kMaxViews");
+    auto *renderTicker = reinterpret_cast<RenderTicker *>(tRenderTicker);
+    std::vector<FrameTiming> timings(std::min(maxFrames, FrameStats::kCapacity));
+    auto numFrames = renderTicker->getFrameStats().getRecords(timings.data(), static_cast<uint32_t>(timings.size()));
+    for (uint32_t i = 0; i < numFrames; i++) {
+        const auto &timing = timings[i];
+        auto &frame = out[i];
+        frame.frameIndex = timing.frameIndex;
+        frame.frameTimeInNanos = timing.frameTimeInNanos;
+        frame.animationUpdateTimeInNanos = timing.animationUpdateTimeInNanos;
+        frame.beginFrameTimeInNanos = timing.beginFrameTimeInNanos;
+        frame.overlayTimeInNanos = timing.overlayTimeInNanos;
+        frame.endFrameTimeInNanos = timing.endFrameTimeInNanos;
+        frame.taskDrainTimeInNanos = timing.taskDrainTimeInNanos;
+        frame.totalTimeInNanos = timing.totalTimeInNanos;
+        frame.tasksExecuted = timing.tasksExecuted;
+        frame.numViews = timing.numViews;
+        for (uint32_t v = 0; v < FRAME_TIMING_MAX_VIEWS; v++) {
+            frame.viewRenderTimeInNanos[v] = timing.viewRenderTimeInNanos[v];
+        }
+        frame.rendered = timing.rendered;
+    }
+    return numFrames;
+}
+
 }
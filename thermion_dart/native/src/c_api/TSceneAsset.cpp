@@ -13,9 +13,81 @@
 #include "scene/SceneAsset.hpp"
 #include "scene/GltfSceneAsset.hpp"
 #include "scene/GeometrySceneAssetBuilder.hpp"
+#include "scene/InstancedGeometrySceneAsset.hpp"
 
 using namespace thermion;
 
+template <typename Index>
+static TSceneAsset *createGeometry(
+    TEngine *tEngine,
+    float *vertices,
+    uint32_t numVertices,
+    float *normals,
+    uint32_t numNormals,
+    float *uvs,
+    uint32_t numUvs,
+    Index *indices,
+    uint32_t numIndices,
+    TPrimitiveType tPrimitiveType,
+    TMaterialInstance **materialInstances,
+    int materialInstanceCount,
+    bool pickable,
+    float *colors = nullptr,
+    uint32_t numColors = 0,
+    const GeometrySceneAssetBuilder::VertexFormat &format = {},
+    bool optimize = false,
+    TOptimizationReport *outOptimizationReport = nullptr)
+{
+    auto *engine = reinterpret_cast<filament::Engine *>(tEngine);
+
+    GeometrySceneAssetBuilder builder(engine);
+    builder.vertices(vertices, numVertices)
+        .indices(indices, numIndices)
+        .primitiveType(static_cast<filament::RenderableManager::PrimitiveType>(tPrimitiveType));
+
+    if (normals)
+    {
+        builder.normals(normals, numNormals);
+    }
+
+    if (uvs)
+    {
+        builder.uvs(uvs, numUvs);
+    }
+
+    if (colors)
+    {
+        builder.colors(colors, numColors);
+    }
+
+    builder.vertexFormat(format);
+
+    builder.optimize(optimize);
+
+    builder.pickable(pickable);
+
+    builder.materials(reinterpret_cast<MaterialInstance**>(materialInstances), materialInstanceCount);
+
+    auto sceneAsset = builder.build();
+
+    if (!sceneAsset)
+    {
+        Log("Failed to create geometry");
+        return std::nullptr_t();
+    }
+
+    if (optimize && outOptimizationReport)
+    {
+        const auto &report = builder.getOptimizationReport();
+        outOptimizationReport->vertexCountBefore = report.vertexCountBefore;
+        outOptimizationReport->vertexCountAfter = report.vertexCountAfter;
+        outOptimizationReport->acmrBefore = report.acmrBefore;
+        outOptimizationReport->acmrAfter = report.acmrAfter;
+    }
+
+    return reinterpret_cast<TSceneAsset*>(sceneAsset.release());
+}
+
 #ifdef __cplusplus
 
 extern "C"
@@ -36,37 +108,54 @@ extern "C"
         TMaterialInstance **materialInstances,
 		int materialInstanceCount
     ) {
-        utils::Entity entity;
-
-        auto *engine = reinterpret_cast<filament::Engine *>(tEngine);
-
-        auto builder = GeometrySceneAssetBuilder(engine)
-                           .vertices(vertices, numVertices)
-                           .indices(indices, numIndices)
-                           .primitiveType(static_cast<filament::RenderableManager::PrimitiveType>(tPrimitiveType));
-
-        if (normals)
-        {
-            builder.normals(normals, numNormals);
-        }
-
-        if (uvs)
-        {
-            builder.uvs(uvs, numUvs);
-        }
-
-        builder.materials(reinterpret_cast<MaterialInstance**>(materialInstances), materialInstanceCount);
-
-        auto sceneAsset = builder.build();
+        // 16-bit meshes are small enough that keeping the triangles for picking is cheap
+        return createGeometry(tEngine, vertices, numVertices, normals, numNormals, uvs, numUvs, indices, numIndices, tPrimitiveType, materialInstances, materialInstanceCount, true);
+    }
 
-        if (!sceneAsset)
-        {
-            Log("Failed to create geometry");
-            return std::nullptr_t();
-        }
+    EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_createGeometryUint32(
+        TEngine *tEngine, 
+        float *vertices,
+        uint32_t numVertices,
+        float *normals,
+        uint32_t numNormals,
+        float *uvs,
+        uint32_t numUvs,
+        uint32_t *indices,
+        uint32_t numIndices,
+        TPrimitiveType tPrimitiveType,
+        bool pickable,
+        TMaterialInstance **materialInstances,
+		int materialInstanceCount
+    ) {
+        return createGeometry(tEngine, vertices, numVertices, normals, numNormals, uvs, numUvs, indices, numIndices, tPrimitiveType, materialInstances, materialInstanceCount, pickable);
+    }
 
-        return reinterpret_cast<TSceneAsset*>(sceneAsset.release());
-        
+    EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_createGeometryWithFormat(
+        TEngine *tEngine, 
+        float *vertices,
+        uint32_t numVertices,
+        float *normals,
+        uint32_t numNormals,
+        float *uvs,
+        uint32_t numUvs,
+        float *colors,
+        uint32_t numColors,
+        uint32_t *indices,
+        uint32_t numIndices,
+        TPrimitiveType tPrimitiveType,
+        bool pickable,
+        TVertexFormat tFormat,
+        bool optimize,
+        TOptimizationReport *outOptimizationReport,
+        TMaterialInstance **materialInstances,
+		int materialInstanceCount
+    ) {
+        GeometrySceneAssetBuilder::VertexFormat format;
+        format.positions = static_cast<GeometrySceneAssetBuilder::PositionFormat>(tFormat.positions);
+        format.halfUVs = tFormat.halfUVs;
+        format.shortTangents = tFormat.shortTangents;
+        format.byteColors = tFormat.byteColors;
+        return createGeometry(tEngine, vertices, numVertices, normals, numNormals, uvs, numUvs, indices, numIndices, tPrimitiveType, materialInstances, materialInstanceCount, pickable, colors, numColors, format, optimize, outOptimizationReport);
     }
 
     EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_createFromFilamentAsset(
@@ -217,6 +306,14 @@ extern "C"
         return asset->getInstanceCount();
     }
 
+    EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_getInstanceOwner(TSceneAsset *tSceneAsset) {
+        auto *asset = reinterpret_cast<SceneAsset*>(tSceneAsset);
+        if (!asset->isInstance()) {
+            return std::nullptr_t();
+        }
+        return reinterpret_cast<TSceneAsset*>(asset->getInstanceOwner());
+    }
+
     EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_createInstance(TSceneAsset *tSceneAsset, TMaterialInstance **tMaterialInstances, int materialInstanceCount)
     {
         auto *materialInstances = reinterpret_cast<MaterialInstance **>(tMaterialInstances);
@@ -231,6 +328,62 @@ extern "C"
         return Aabb3{box.center().x, box.center().y, box.center().z, box.extent().x, box.extent().y, box.extent().z};
     }
 
+    EMSCRIPTEN_KEEPALIVE TSceneAsset *SceneAsset_createInstanced(TSceneAsset *tSceneAsset, uint32_t instanceCount, TMaterialInstance **tMaterialInstances, int materialInstanceCount)
+    {
+        auto *sceneAsset = reinterpret_cast<SceneAsset*>(tSceneAsset);
+        if (sceneAsset->getType() != SceneAsset::SceneAssetType::Geometry)
+        {
+            Log("ERROR: only geometry assets can be instanced");
+            return nullptr;
+        }
+        auto *materialInstances = reinterpret_cast<MaterialInstance **>(tMaterialInstances);
+        auto *instanced = static_cast<GeometrySceneAsset *>(sceneAsset)->createInstancedAsset(instanceCount, materialInstances, materialInstanceCount);
+        return reinterpret_cast<TSceneAsset *>(instanced);
+    }
+
+    EMSCRIPTEN_KEEPALIVE bool SceneAsset_setInstanceTransforms(TSceneAsset *tSceneAsset, const float *const transforms, uint32_t count, uint32_t offset)
+    {
+        auto *sceneAsset = reinterpret_cast<SceneAsset*>(tSceneAsset);
+        if (sceneAsset->getType() != SceneAsset::SceneAssetType::InstancedGeometry)
+        {
+            Log("ERROR: not an instanced geometry asset");
+            return false;
+        }
+        return static_cast<InstancedGeometrySceneAsset *>(sceneAsset)->setInstanceTransforms(transforms, count, offset);
+    }
+
+    EMSCRIPTEN_KEEPALIVE bool SceneAsset_generateLods(TSceneAsset *tSceneAsset, uint32_t levelCount, float reduction)
+    {
+        auto *sceneAsset = reinterpret_cast<SceneAsset*>(tSceneAsset);
+        if (sceneAsset->getType() != SceneAsset::SceneAssetType::Geometry)
+        {
+            Log("ERROR: levels of detail are only supported for geometry assets");
+            return false;
+        }
+        return static_cast<GeometrySceneAsset *>(sceneAsset)->generateLods(levelCount, reduction);
+    }
+
+    EMSCRIPTEN_KEEPALIVE uint32_t SceneAsset_getLodLevelCount(TSceneAsset *tSceneAsset)
+    {
+        auto *sceneAsset = reinterpret_cast<SceneAsset*>(tSceneAsset);
+        if (sceneAsset->getType() != SceneAsset::SceneAssetType::Geometry)
+        {
+            return 0;
+        }
+        auto lodChain = static_cast<GeometrySceneAsset *>(sceneAsset)->getLodChain();
+        return lodChain ? static_cast<uint32_t>(lodChain->getLevelCount()) : 0;
+    }
+
+    EMSCRIPTEN_KEEPALIVE uint32_t SceneAsset_getLodTriangleCount(TSceneAsset *tSceneAsset, uint32_t level)
+    {
+        auto *sceneAsset = reinterpret_cast<SceneAsset*>(tSceneAsset);
+        if (sceneAsset->getType() != SceneAsset::SceneAssetType::Geometry)
+        {
+            return 0;
+        }
+        auto lodChain = static_cast<GeometrySceneAsset *>(sceneAsset)->getLodChain();
+        return lodChain ? lodChain->getTriangleCount(level) : 0;
+    }
 
 #ifdef __cplusplus
 }
@@ -22,8 +22,10 @@
 #include <ktxreader/Ktx2Reader.h>
 
 #include "c_api/TTexture.h"
+#include "rendering/DecodedImage.hpp"
 
 #include "Log.hpp"
+#include "TraceRecorder.hpp"
 
 #include <filament/third_party/stb/stb_image.h>
 
@@ -94,6 +96,18 @@ namespace thermion
             return reinterpret_cast<TLinearImage *>(linearImage);
         }
 
+        EMSCRIPTEN_KEEPALIVE TTexture *Image_decodeToTexture(TEngine *tEngine, const uint8_t *data, size_t length, bool sRGB, bool generateMipmaps)
+        {
+            auto *engine = reinterpret_cast<filament::Engine *>(tEngine);
+            auto image = DecodedImage::decode(data, length);
+            if (!image)
+            {
+                return std::nullptr_t();
+            }
+            auto *texture = image->createTexture(*engine, sRGB, generateMipmaps);
+            return reinterpret_cast<TTexture *>(texture);
+        }
+
         EMSCRIPTEN_KEEPALIVE TKtx1Bundle *Ktx1Bundle_create(uint8_t *ktxData, size_t length)
         {
             auto *bundle = new image::Ktx1Bundle(ktxData, static_cast<uint32_t>(length));
@@ -540,6 +554,7 @@ namespace thermion
 
         EMSCRIPTEN_KEEPALIVE bool Texture_loadImage(TEngine *tEngine, TTexture *tTexture, TLinearImage *tImage, TPixelDataFormat tBufferFormat, TPixelDataType tPixelDataType, int level)
         {
+            TRACE_SCOPE("Texture_loadImage");
             auto engine = reinterpret_cast<filament::Engine *>(tEngine);
             auto image = reinterpret_cast<::image::LinearImage *>(tImage);
             auto texture = reinterpret_cast<filament::Texture *>(tTexture);
@@ -593,6 +608,7 @@ namespace thermion
             uint32_t tBufferFormat,
             uint32_t tPixelDataType)
         {
+            TRACE_SCOPE("Texture_setImage");
             auto engine = reinterpret_cast<filament::Engine *>(tEngine);
 
             auto texture = reinterpret_cast<filament::Texture *>(tTexture);
@@ -0,0 +1,30 @@
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+#include "TraceRecorder.hpp"
+#include "c_api/TTraceRecorder.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	EMSCRIPTEN_KEEPALIVE void TraceRecorder_setEnabled(bool enabled)
+	{
+		thermion::TraceRecorder::setEnabled(enabled);
+	}
+
+	EMSCRIPTEN_KEEPALIVE void TraceRecorder_clear()
+	{
+		thermion::TraceRecorder::clear();
+	}
+
+	EMSCRIPTEN_KEEPALIVE bool TraceRecorder_dump(const char *path)
+	{
+		return thermion::TraceRecorder::dump(path);
+	}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,25 +1,36 @@
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include <stdlib.h>
 
 #include <filament/LightManager.h>
+#include <utils/JobSystem.h>
 
 #include "c_api/APIBoundaryTypes.h"
 #include "c_api/TAnimationManager.h"
+#include "c_api/TCommandBuffer.h"
 #include "c_api/TEngine.h"
 #include "c_api/TGizmo.h"
+#include "c_api/TGltfAssetCache.h"
 #include "c_api/TGltfAssetLoader.h"
+#include "c_api/TGltfImporter.h"
 #include "c_api/TGltfResourceLoader.h"
+#include "c_api/TOverlayManager.h"
+#include "c_api/TRayPicker.h"
 #include "c_api/TRenderer.h"
 #include "c_api/TRenderTicker.h"
 #include "c_api/TRenderTarget.h"
 #include "c_api/TScene.h"
 #include "c_api/TSceneAsset.h"
 #include "c_api/TTexture.h"
+#include "c_api/TTransformManager.h"
 #include "c_api/TView.h"
 #include "c_api/ThermionDartRenderThreadApi.h"
 
+#include "rendering/DecodedImage.hpp"
 #include "rendering/RenderThread.hpp"
 #include "Log.hpp"
 
@@ -63,6 +74,50 @@ extern "C"
 
   static std::unique_ptr<RenderThread> _renderThread;
 
+  //
+  // Tracks calls to Image_decodeToTextureRenderThread whose callback hasn't yet
+  // been invoked. Decoding happens off the render thread, so the engine (and the
+  // render thread itself) can only be destroyed once these have drained.
+  //
+  static struct PendingDecodes
+  {
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t count = 0;
+    std::atomic<bool> cancelled = false;
+
+    void begin()
+    {
+      std::lock_guard lock(mutex);
+      count++;
+    }
+
+    void end()
+    {
+      {
+        std::lock_guard lock(mutex);
+        count--;
+      }
+      cv.notify_all();
+    }
+
+    // Cancels any decodes that haven't yet started (their callbacks receive
+    // nullptr) and blocks until all outstanding callbacks have been invoked.
+    // The render thread must still be running.
+    void cancelAndWait()
+    {
+#ifndef __EMSCRIPTEN__
+      // (on web, decoding is synchronous, so the uploads are always queued
+      // ahead of whatever is tearing down the engine)
+      cancelled = true;
+      std::unique_lock lock(mutex);
+      cv.wait(lock, [this]
+              { return count == 0; });
+      cancelled = false;
+#endif
+    }
+  } _pendingDecodes;
+
   EMSCRIPTEN_KEEPALIVE void RenderThread_create()
   {
     TRACE("RenderThread_create");
@@ -79,18 +134,39 @@ extern "C"
     TRACE("RenderThread_destroy");
     if (_renderThread)
     {
+      _pendingDecodes.cancelAndWait();
       _renderThread = nullptr;
     }
   }
 
   EMSCRIPTEN_KEEPALIVE void RenderThread_addTask(void (*task)())
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           task();
         });
-    auto fut = _renderThread->add_task(lambda);
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RenderThread_getStats(TRenderThreadStats *out)
+  {
+    auto stats = _renderThread->getStats();
+    out->idleTimeInNanos = stats.idleTimeInNanos;
+    out->busyTimeInNanos = stats.busyTimeInNanos;
+    out->wakeups = stats.wakeups;
+    out->tasksExecuted = stats.tasksExecuted;
+    out->framesRendered = stats.framesRendered;
+    out->fps = stats.fps;
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RenderThread_submitCommands(const uint8_t *const commands, size_t length, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          CommandBuffer_execute(commands, length);
+          PROXY(onComplete(requestId));
+        });
   }
 
   EMSCRIPTEN_KEEPALIVE void RenderThread_setRenderTicker(TRenderTicker *tRenderTicker)
@@ -106,13 +182,12 @@ extern "C"
 
   EMSCRIPTEN_KEEPALIVE void RenderTicker_renderRenderThread(TRenderTicker *tRenderTicker, uint64_t frameTimeInNanos, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           RenderTicker_render(tRenderTicker, frameTimeInNanos);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_createRenderThread(
@@ -124,241 +199,220 @@ extern "C"
       void (*onComplete)(TEngine *))
   {
 
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *engine = Engine_create(backend, platform, sharedContext, stereoscopicEyeCount, disableHandleUseAfterFreeCheck);
           PROXY(onComplete(engine));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_createRendererRenderThread(TEngine *tEngine, void (*onComplete)(TRenderer *))
   {
 
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *renderer = Engine_createRenderer(tEngine);
           PROXY(onComplete(renderer));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_createSwapChainRenderThread(TEngine *tEngine, void *window, uint64_t flags, void (*onComplete)(TSwapChain *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto swapChain = Engine_createSwapChain(tEngine, window, flags);
           PROXY(onComplete(swapChain));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_createHeadlessSwapChainRenderThread(TEngine *tEngine, uint32_t width, uint32_t height, uint64_t flags, void (*onComplete)(TSwapChain *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto swapChain = Engine_createHeadlessSwapChain(tEngine, width, height, flags);
           PROXY(onComplete(swapChain));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroySwapChainRenderThread(TEngine *tEngine, TSwapChain *tSwapChain, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroySwapChain(tEngine, tSwapChain);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroyViewRenderThread(TEngine *tEngine, TView *tView, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroyView(tEngine, tView);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroySceneRenderThread(TEngine *tEngine, TScene *tScene, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroyScene(tEngine, tScene);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_createCameraRenderThread(TEngine *tEngine, void (*onComplete)(TCamera *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto camera = Engine_createCamera(tEngine);
           PROXY(onComplete(camera));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_createViewRenderThread(TEngine *tEngine, void (*onComplete)(TView *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *view = Engine_createView(tEngine);
           PROXY(onComplete(view));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroyRenderThread(TEngine *tEngine, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _pendingDecodes.cancelAndWait();
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroy(tEngine);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroyTextureRenderThread(TEngine *engine, TTexture *tTexture, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroyTexture(engine, tTexture);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroySkyboxRenderThread(TEngine *tEngine, TSkybox *tSkybox, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroySkybox(tEngine, tSkybox);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroyIndirectLightRenderThread(TEngine *tEngine, TIndirectLight *tIndirectLight, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroyIndirectLight(tEngine, tIndirectLight);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_buildMaterialRenderThread(TEngine *tEngine, const uint8_t *materialData, size_t length, void (*onComplete)(TMaterial *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto material = Engine_buildMaterial(tEngine, materialData, length);
           PROXY(onComplete(material));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroyMaterialRenderThread(TEngine *tEngine, TMaterial *tMaterial, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroyMaterial(tEngine, tMaterial);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroyMaterialInstanceRenderThread(TEngine *tEngine, TMaterialInstance *tMaterialInstance, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroyMaterialInstance(tEngine, tMaterialInstance);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_createFenceRenderThread(TEngine *tEngine, void (*onComplete)(TFence *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *fence = Engine_createFence(tEngine);
           PROXY(onComplete(fence));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Fence_waitAndDestroyRenderThread(TFence *tFence, uint32_t requestId, VoidCallback onComplete)
   {
     
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Fence_waitAndDestroy(tFence);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroyFenceRenderThread(TEngine *tEngine, TFence *tFence, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_destroyFence(tEngine, tFence);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_flushAndWaitRenderThread(TEngine *tEngine, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_flushAndWait(tEngine);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_executeRenderThread(TEngine *tEngine, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Engine_execute(tEngine);
-          std::packaged_task<void()> callback(
+          _renderThread->enqueue(
           [=]() mutable
           { 
             PROXY(onComplete(requestId));
           });
-          _renderThread->add_task(callback);
           _renderThread->restart();
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void execute_queue()
@@ -370,13 +424,12 @@ extern "C"
 
   EMSCRIPTEN_KEEPALIVE void Engine_buildSkyboxRenderThread(TEngine *tEngine, TTexture *tTexture, void (*onComplete)(TSkybox *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *skybox = Engine_buildSkybox(tEngine, tTexture);
           PROXY(onComplete(skybox));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_buildIndirectLightFromIrradianceTextureRenderThread(
@@ -385,13 +438,12 @@ extern "C"
     TTexture* tIrradianceTexture,
     float intensity,
     void (*onComplete)(TIndirectLight *)) {
-      std::packaged_task<void()> lambda(
+      _renderThread->enqueue(
           [=]() mutable
           {
             auto *indirectLight = Engine_buildIndirectLightFromIrradianceTexture(tEngine, tReflectionsTexture, tIrradianceTexture, intensity);
             PROXY(onComplete(indirectLight));
           });
-      auto fut = _renderThread->add_task(lambda);
   }
   
   EMSCRIPTEN_KEEPALIVE void Engine_buildIndirectLightFromIrradianceHarmonicsRenderThread(
@@ -400,57 +452,52 @@ extern "C"
     float *harmonics,
     float intensity,
     void (*onComplete)(TIndirectLight *)) {
-      std::packaged_task<void()> lambda(
+      _renderThread->enqueue(
           [=]() mutable
           {
             auto *indirectLight = Engine_buildIndirectLightFromIrradianceHarmonics(tEngine, tReflectionsTexture, harmonics, intensity);
             PROXY(onComplete(indirectLight));
           });
-      auto fut = _renderThread->add_task(lambda);
   }
 
 
   EMSCRIPTEN_KEEPALIVE void Renderer_beginFrameRenderThread(TRenderer *tRenderer, TSwapChain *tSwapChain, uint64_t frameTimeInNanos, void (*onComplete)(bool))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto result = Renderer_beginFrame(tRenderer, tSwapChain, frameTimeInNanos);
           PROXY(onComplete(result));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
   EMSCRIPTEN_KEEPALIVE void Renderer_endFrameRenderThread(TRenderer *tRenderer, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Renderer_endFrame(tRenderer);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Renderer_renderRenderThread(TRenderer *tRenderer, TView *tView, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Renderer_render(tRenderer, tView);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Renderer_renderStandaloneViewRenderThread(TRenderer *tRenderer, TView *tView, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Renderer_renderStandaloneView(tRenderer, tView);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Renderer_setClearOptionsRenderThread(
@@ -463,13 +510,12 @@ extern "C"
       bool clear,
       bool discard, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Renderer_setClearOptions(tRenderer, clearR, clearG, clearB, clearA, clearStencil, clear, discard);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Renderer_readPixelsRenderThread(
@@ -482,78 +528,71 @@ extern "C"
       size_t outLength,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Renderer_readPixels(tRenderer, width, height, xOffset, yOffset, tRenderTarget, tPixelBufferFormat, tPixelDataType, out, outLength);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Material_createImageMaterialRenderThread(TEngine *tEngine, void (*onComplete)(TMaterial *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *instance = Material_createImageMaterial(tEngine);
           PROXY(onComplete(instance));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Material_createGizmoMaterialRenderThread(TEngine *tEngine, void (*onComplete)(TMaterial *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *instance = Material_createGizmoMaterial(tEngine);
           PROXY(onComplete(instance));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
     EMSCRIPTEN_KEEPALIVE void Material_createOutlineMaterialRenderThread(TEngine *tEngine, void (*onComplete)(TMaterial *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *instance = Material_createOutlineMaterial(tEngine);
           PROXY(onComplete(instance));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Material_createInstanceRenderThread(TMaterial *tMaterial, void (*onComplete)(TMaterialInstance *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *instance = Material_createInstance(tMaterial);
           PROXY(onComplete(instance));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void SceneAsset_createGridRenderThread(TEngine *tEngine, TMaterial * tMaterial, void (*onComplete)(TSceneAsset *)) {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *asset = SceneAsset_createGrid(tEngine, tMaterial);
           PROXY(onComplete(asset));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
   
   EMSCRIPTEN_KEEPALIVE void SceneAsset_destroyRenderThread(TSceneAsset *tSceneAsset, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           SceneAsset_destroy(tSceneAsset);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void SceneAsset_createGeometryRenderThread(
@@ -571,13 +610,65 @@ extern "C"
       int materialInstanceCount,
       void (*callback)(TSceneAsset *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           auto sceneAsset = SceneAsset_createGeometry(tEngine, vertices, numVertices, normals, numNormals, uvs, numUvs, indices, numIndices, tPrimitiveType, materialInstances, materialInstanceCount);
           PROXY(callback(sceneAsset));
         });
-    auto fut = _renderThread->add_task(lambda);
+  }
+
+  EMSCRIPTEN_KEEPALIVE void SceneAsset_createGeometryUint32RenderThread(
+      TEngine *tEngine,
+      float *vertices,
+      uint32_t numVertices,
+      float *normals,
+      uint32_t numNormals,
+      float *uvs,
+      uint32_t numUvs,
+      uint32_t *indices,
+      uint32_t numIndices,
+      TPrimitiveType tPrimitiveType,
+      bool pickable,
+      TMaterialInstance **materialInstances,
+      int materialInstanceCount,
+      void (*callback)(TSceneAsset *))
+  {
+    _renderThread->enqueue(
+        [=]
+        {
+          auto sceneAsset = SceneAsset_createGeometryUint32(tEngine, vertices, numVertices, normals, numNormals, uvs, numUvs, indices, numIndices, tPrimitiveType, pickable, materialInstances, materialInstanceCount);
+          PROXY(callback(sceneAsset));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void SceneAsset_createGeometryWithFormatRenderThread(
+      TEngine *tEngine,
+      float *vertices,
+      uint32_t numVertices,
+      float *normals,
+      uint32_t numNormals,
+      float *uvs,
+      uint32_t numUvs,
+      float *colors,
+      uint32_t numColors,
+      uint32_t *indices,
+      uint32_t numIndices,
+      TPrimitiveType tPrimitiveType,
+      bool pickable,
+      TVertexFormat format,
+      bool optimize,
+      TOptimizationReport *outOptimizationReport,
+      TMaterialInstance **materialInstances,
+      int materialInstanceCount,
+      void (*callback)(TSceneAsset *))
+  {
+    _renderThread->enqueue(
+        [=]
+        {
+          auto sceneAsset = SceneAsset_createGeometryWithFormat(tEngine, vertices, numVertices, normals, numNormals, uvs, numUvs, colors, numColors, indices, numIndices, tPrimitiveType, pickable, format, optimize, outOptimizationReport, materialInstances, materialInstanceCount);
+          PROXY(callback(sceneAsset));
+        });
   }
 
   EMSCRIPTEN_KEEPALIVE void SceneAsset_createFromFilamentAssetRenderThread(
@@ -587,13 +678,12 @@ extern "C"
       TFilamentAsset *tFilamentAsset,
       void (*onComplete)(TSceneAsset *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           auto sceneAsset = SceneAsset_createFromFilamentAsset(tEngine, tAssetLoader, tNameComponentManager, tFilamentAsset);
           PROXY(onComplete(sceneAsset));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void SceneAsset_createInstanceRenderThread(
@@ -601,13 +691,12 @@ extern "C"
       int materialInstanceCount,
       void (*callback)(TSceneAsset *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           auto instanceAsset = SceneAsset_createInstance(asset, tMaterialInstances, materialInstanceCount);
           PROXY(callback(instanceAsset));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void MaterialProvider_createMaterialInstanceRenderThread(
@@ -652,7 +741,7 @@ extern "C"
       bool hasVolume,
       void (*callback)(TMaterialInstance *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           auto materialInstance = MaterialProvider_createMaterialInstance(
@@ -697,29 +786,26 @@ extern "C"
               hasVolume);
           PROXY(callback(materialInstance));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void ColorGrading_createRenderThread(TEngine *tEngine, TToneMapping toneMapping, void (*callback)(TColorGrading *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           auto cg = ColorGrading_create(tEngine, toneMapping);
           PROXY(callback(cg));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Engine_destroyColorGradingRenderThread(TEngine *tEngine, TColorGrading *tColorGrading, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           Engine_destroyColorGrading(tEngine, tColorGrading);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void View_pickRenderThread(TView *tView, uint32_t requestId, uint32_t x, uint32_t y, PickCallback callback)
@@ -731,56 +817,51 @@ extern "C"
 
   EMSCRIPTEN_KEEPALIVE void View_setColorGradingRenderThread(TView *tView, TColorGrading *tColorGrading, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           View_setColorGrading(tView, tColorGrading);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void View_setBloomRenderThread(TView *tView, bool enabled, double strength, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           View_setBloom(tView, enabled, strength);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void View_setCameraRenderThread(TView *tView, TCamera *tCamera, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]
         {
           View_setCamera(tView, tCamera);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void AnimationManager_resetToRestPoseRenderThread(TAnimationManager *tAnimationManager, TSceneAsset *tSceneAsset, uint32_t requestId, VoidCallback onComplete) {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           AnimationManager_resetToRestPose(tAnimationManager, tSceneAsset);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void AnimationManager_createRenderThread(TEngine *tEngine, TScene *tScene, void (*onComplete)(TAnimationManager *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *animationManager = AnimationManager_create(tEngine, tScene);
           PROXY(onComplete(animationManager));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void AnimationManager_updateBoneMatricesRenderThread(
@@ -788,13 +869,12 @@ extern "C"
       TSceneAsset *sceneAsset,
       void (*callback)(bool))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           bool result = AnimationManager_updateBoneMatrices(tAnimationManager, sceneAsset);
           PROXY(callback(result));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void AnimationManager_setMorphTargetWeightsRenderThread(
@@ -804,90 +884,129 @@ extern "C"
       int numWeights,
       void (*callback)(bool))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           bool result = AnimationManager_setMorphTargetWeights(tAnimationManager, entityId, morphData, numWeights);
           PROXY(callback(result));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Image_createEmptyRenderThread(uint32_t width, uint32_t height, uint32_t channel, void (*onComplete)(TLinearImage *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto image = Image_createEmpty(width, height, channel);
           PROXY(onComplete(image));
         });
-    auto fut = _renderThread->add_task(lambda);
+  }
+
+  EMSCRIPTEN_KEEPALIVE void Image_decodeToTextureRenderThread(TEngine *tEngine, const uint8_t *data, size_t length, bool sRGB, bool generateMipmaps, void (*onComplete)(TTexture *))
+  {
+    auto *engine = reinterpret_cast<filament::Engine *>(tEngine);
+    auto upload = [=](DecodedImage *image)
+    {
+      _renderThread->enqueue(
+          [=]() mutable
+          {
+            TTexture *texture = std::nullptr_t();
+            if (image)
+            {
+              if (!_pendingDecodes.cancelled)
+              {
+                texture = reinterpret_cast<TTexture *>(image->createTexture(*engine, sRGB, generateMipmaps));
+              }
+              delete image;
+            }
+            PROXY(onComplete(texture));
+            _pendingDecodes.end();
+          });
+    };
+    _pendingDecodes.begin();
+#ifdef __EMSCRIPTEN__
+    upload(DecodedImage::decode(data, length).release());
+#else
+    // [data] is copied first as the caller's buffer is only valid for the duration of this call
+    auto *bytes = new std::vector<uint8_t>(data, data + length);
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          // decoding doesn't touch the engine, so it runs on the engine's JobSystem
+          // (jobs can only be started from the engine thread) rather than blocking the render thread
+          auto &js = engine->getJobSystem();
+          auto *job = utils::jobs::createJob(js, nullptr, [=]()
+                                             {
+            DecodedImage *image = nullptr;
+            if (!_pendingDecodes.cancelled)
+            {
+              image = DecodedImage::decode(bytes->data(), bytes->size()).release();
+            }
+            delete bytes;
+            upload(image); });
+          js.run(job);
+        });
+#endif
   }
 
   EMSCRIPTEN_KEEPALIVE void Image_decodeRenderThread(uint8_t *data, size_t length, const char *name, bool alpha, void (*onComplete)(TLinearImage *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto image = Image_decode(data, length, name, alpha);
           PROXY(onComplete(image));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Image_getBytesRenderThread(TLinearImage *tLinearImage, void (*onComplete)(float *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto bytes = Image_getBytes(tLinearImage);
           PROXY(onComplete(bytes));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Image_destroyRenderThread(TLinearImage *tLinearImage, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Image_destroy(tLinearImage);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Image_getWidthRenderThread(TLinearImage *tLinearImage, void (*onComplete)(uint32_t))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto width = Image_getWidth(tLinearImage);
           PROXY(onComplete(width));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Image_getHeightRenderThread(TLinearImage *tLinearImage, void (*onComplete)(uint32_t))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto height = Image_getHeight(tLinearImage);
           PROXY(onComplete(height));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Image_getChannelsRenderThread(TLinearImage *tLinearImage, void (*onComplete)(uint32_t))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto channels = Image_getChannels(tLinearImage);
           PROXY(onComplete(channels));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Texture_buildRenderThread(
@@ -901,23 +1020,21 @@ extern "C"
       TTextureSamplerType sampler,
       TTextureFormat format, void (*onComplete)(TTexture *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *texture = Texture_build(tEngine, width, height, depth, levels, tUsage, import, sampler, format);
           PROXY(onComplete(texture));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Texture_generateMipMapsRenderThread(TTexture *tTexture, TEngine *tEngine, uint32_t requestId, VoidCallback onComplete) {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Texture_generateMipMaps(tTexture, tEngine);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   #ifdef EMSCRIPTEN
@@ -947,7 +1064,7 @@ extern "C"
             };
         }
       #endif
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           #ifdef EMSCRIPTEN
@@ -957,7 +1074,6 @@ extern "C"
           #endif          
           PROXY(onComplete(texture));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
 
@@ -966,13 +1082,12 @@ extern "C"
                                                           int level,
                                                           void (*onComplete)(bool))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           bool result = Texture_loadImage(tEngine, tTexture, tImage, bufferFormat, pixelDataType, level);
           PROXY(onComplete(result));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Texture_setImageRenderThread(
@@ -991,7 +1106,7 @@ extern "C"
       uint32_t pixelDataType,
       void (*onComplete)(bool))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           bool result = Texture_setImage(
@@ -1010,18 +1125,16 @@ extern "C"
               pixelDataType);
           PROXY(onComplete(result));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void RenderTarget_getColorTextureRenderThread(TRenderTarget *tRenderTarget, void (*onComplete)(TTexture *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto texture = RenderTarget_getColorTexture(tRenderTarget);
           PROXY(onComplete(texture));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void RenderTarget_createRenderThread(
@@ -1035,13 +1148,12 @@ extern "C"
     auto color = reinterpret_cast<filament::Texture *>(tColor);
     auto depth = reinterpret_cast<filament::Texture *>(tDepth);
 
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto texture = RenderTarget_create(tEngine, width, height, tColor, tDepth);
           PROXY(onComplete(texture));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void RenderTarget_destroyRenderThread(
@@ -1049,24 +1161,22 @@ extern "C"
       TRenderTarget *tRenderTarget,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           RenderTarget_destroy(tEngine, tRenderTarget);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_createRenderThread(void (*onComplete)(TTextureSampler *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto sampler = TextureSampler_create();
           PROXY(onComplete(sampler));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_createWithFilteringRenderThread(
@@ -1077,13 +1187,12 @@ extern "C"
       TSamplerWrapMode wrapR,
       void (*onComplete)(TTextureSampler *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto sampler = TextureSampler_createWithFiltering(minFilter, magFilter, wrapS, wrapT, wrapR);
           PROXY(onComplete(sampler));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_createWithComparisonRenderThread(
@@ -1091,13 +1200,12 @@ extern "C"
       TSamplerCompareFunc compareFunc,
       void (*onComplete)(TTextureSampler *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto sampler = TextureSampler_createWithComparison(compareMode, compareFunc);
           PROXY(onComplete(sampler));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_setMinFilterRenderThread(
@@ -1105,13 +1213,12 @@ extern "C"
       TSamplerMinFilter filter,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           TextureSampler_setMinFilter(sampler, filter);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_setMagFilterRenderThread(
@@ -1119,13 +1226,12 @@ extern "C"
       TSamplerMagFilter filter,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           TextureSampler_setMagFilter(sampler, filter);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_setWrapModeSRenderThread(
@@ -1133,13 +1239,12 @@ extern "C"
       TSamplerWrapMode mode,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           TextureSampler_setWrapModeS(sampler, mode);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_setWrapModeTRenderThread(
@@ -1147,13 +1252,12 @@ extern "C"
       TSamplerWrapMode mode,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           TextureSampler_setWrapModeT(sampler, mode);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_setWrapModeRRenderThread(
@@ -1161,13 +1265,12 @@ extern "C"
       TSamplerWrapMode mode,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           TextureSampler_setWrapModeR(sampler, mode);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_setAnisotropyRenderThread(
@@ -1175,13 +1278,12 @@ extern "C"
       double anisotropy,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           TextureSampler_setAnisotropy(sampler, anisotropy);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_setCompareModeRenderThread(
@@ -1190,26 +1292,24 @@ extern "C"
       TTextureSamplerCompareFunc func,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           TextureSampler_setCompareMode(sampler, mode, func);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void TextureSampler_destroyRenderThread(
       TTextureSampler *sampler,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           TextureSampler_destroy(sampler);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void GltfAssetLoader_createRenderThread(
@@ -1218,46 +1318,42 @@ extern "C"
     TNameComponentManager *tNameComponentManager,
     void (*callback)(TGltfAssetLoader *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
       [=]() mutable
       {
         auto loader = GltfAssetLoader_create(tEngine, tMaterialProvider, tNameComponentManager);
         PROXY(callback(loader));
       });
-    auto fut = _renderThread->add_task(lambda);
   }
   
   EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_createRenderThread(TEngine *tEngine, void (*callback)(TGltfResourceLoader *)) {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
       [=]() mutable
       {
         auto loader = GltfResourceLoader_create(tEngine);
         PROXY(callback(loader));
       });
-    auto fut = _renderThread->add_task(lambda);
   }
 
 
   EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_destroyRenderThread(TEngine *tEngine, TGltfResourceLoader *tResourceLoader, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           GltfResourceLoader_destroy(tEngine, tResourceLoader);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_loadResourcesRenderThread(TGltfResourceLoader *tGltfResourceLoader, TFilamentAsset *tFilamentAsset, void (*callback)(bool))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto result = GltfResourceLoader_loadResources(tGltfResourceLoader, tFilamentAsset);
           PROXY(callback(result));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_addResourceDataRenderThread(
@@ -1267,13 +1363,26 @@ extern "C"
       size_t length,
       uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           GltfResourceLoader_addResourceData(tGltfResourceLoader, uri, data, length);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_addResourceFileRenderThread(
+      TGltfResourceLoader *tGltfResourceLoader,
+      const char *uri,
+      const char *path,
+      void (*callback)(bool))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = GltfResourceLoader_addResourceFile(tGltfResourceLoader, uri, path);
+          PROXY(callback(result));
+        });
   }
 
   EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_asyncBeginLoadRenderThread(
@@ -1281,37 +1390,300 @@ extern "C"
       TFilamentAsset *tFilamentAsset,
       void (*callback)(bool))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto result = GltfResourceLoader_asyncBeginLoad(tGltfResourceLoader, tFilamentAsset);
           PROXY(callback(result));
         });
-    auto fut = _renderThread->add_task(lambda);
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfImporter_destroyRenderThread(
+      TGltfImporter *tGltfImporter,
+      uint32_t requestId,
+      VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          GltfImporter_destroy(tGltfImporter);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfImporter_beginRenderThread(
+      TGltfImporter *tGltfImporter,
+      TGltfResourceLoader *tGltfResourceLoader,
+      TFilamentAsset *tFilamentAsset,
+      void (*callback)(bool))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = GltfImporter_begin(tGltfImporter, tGltfResourceLoader, tFilamentAsset);
+          PROXY(callback(result));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfImporter_cancelRenderThread(
+      TGltfImporter *tGltfImporter,
+      TFilamentAsset *tFilamentAsset,
+      uint32_t requestId,
+      VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          GltfImporter_cancel(tGltfImporter, tFilamentAsset);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfAssetCache_destroyRenderThread(
+      TGltfAssetCache *tGltfAssetCache,
+      uint32_t requestId,
+      VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          GltfAssetCache_destroy(tGltfAssetCache);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfAssetCache_acquireRenderThread(
+      TGltfAssetCache *tGltfAssetCache,
+      uint64_t key,
+      TMaterialInstance **tMaterialInstances,
+      int materialInstanceCount,
+      void (*callback)(TSceneAsset *))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto instance = GltfAssetCache_acquire(tGltfAssetCache, key, tMaterialInstances, materialInstanceCount);
+          PROXY(callback(instance));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfAssetCache_insertRenderThread(
+      TGltfAssetCache *tGltfAssetCache,
+      uint64_t key,
+      TSceneAsset *tSceneAsset,
+      uint64_t sizeInBytes,
+      void (*callback)(TSceneAsset *))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto instance = GltfAssetCache_insert(tGltfAssetCache, key, tSceneAsset, sizeInBytes);
+          PROXY(callback(instance));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfAssetCache_releaseRenderThread(
+      TGltfAssetCache *tGltfAssetCache,
+      TSceneAsset *tSceneAsset,
+      void (*callback)(bool))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = GltfAssetCache_release(tGltfAssetCache, tSceneAsset);
+          PROXY(callback(result));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfAssetCache_computeFileKeyRenderThread(
+      TGltfAssetCache *tGltfAssetCache,
+      const char *path,
+      const char *resourceUri,
+      uint64_t *outLength,
+      void (*callback)(uint64_t))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto key = GltfAssetCache_computeFileKey(tGltfAssetCache, path, resourceUri, outLength);
+          PROXY(callback(key));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfAssetCache_setBudgetRenderThread(
+      TGltfAssetCache *tGltfAssetCache,
+      uint64_t budgetInBytes,
+      uint32_t requestId,
+      VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          GltfAssetCache_setBudget(tGltfAssetCache, budgetInBytes);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void CollisionManager_createRenderThread(TTransformManager *tTransformManager, void (*onComplete)(TCollisionComponentManager *))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto *collisionManager = CollisionManager_create(tTransformManager);
+          PROXY(onComplete(collisionManager));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void CollisionManager_destroyRenderThread(TCollisionComponentManager *tCollisionManager, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          CollisionManager_destroy(tCollisionManager);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void CollisionManager_addComponentRenderThread(TCollisionComponentManager *tCollisionManager, EntityId entityId, Aabb3 boundingBox, void (*callback)(EntityId entityId1, EntityId entityId2), bool affectsTransform, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          CollisionManager_addComponent(tCollisionManager, entityId, boundingBox, callback, affectsTransform);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void CollisionManager_removeComponentRenderThread(TCollisionComponentManager *tCollisionManager, EntityId entityId, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          CollisionManager_removeComponent(tCollisionManager, entityId);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void CollisionManager_markDirtyRenderThread(TCollisionComponentManager *tCollisionManager, EntityId entityId, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          CollisionManager_markDirty(tCollisionManager, entityId);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void CollisionManager_collideAllRenderThread(TCollisionComponentManager *tCollisionManager, EntityId *outPairs, uint32_t maxPairs, void (*onComplete)(uint32_t))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto count = CollisionManager_collideAll(tCollisionManager, outPairs, maxPairs);
+          PROXY(onComplete(count));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void SceneAsset_createInstancedRenderThread(
+      TSceneAsset *tSceneAsset,
+      uint32_t instanceCount,
+      TMaterialInstance **tMaterialInstances,
+      int materialInstanceCount,
+      void (*onComplete)(TSceneAsset *))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto *instanced = SceneAsset_createInstanced(tSceneAsset, instanceCount, tMaterialInstances, materialInstanceCount);
+          PROXY(onComplete(instanced));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void SceneAsset_setInstanceTransformsRenderThread(
+      TSceneAsset *tSceneAsset,
+      const float *const transforms,
+      uint32_t count,
+      uint32_t offset,
+      void (*onComplete)(bool))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = SceneAsset_setInstanceTransforms(tSceneAsset, transforms, count, offset);
+          PROXY(onComplete(result));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void SceneAsset_generateLodsRenderThread(TSceneAsset *tSceneAsset, uint32_t levelCount, float reduction, void (*onComplete)(bool))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = SceneAsset_generateLods(tSceneAsset, levelCount, reduction);
+          PROXY(onComplete(result));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void LodManager_createRenderThread(TEngine *tEngine, TView *tView, void (*onComplete)(TLodManager *))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto *lodManager = LodManager_create(tEngine, tView);
+          PROXY(onComplete(lodManager));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void LodManager_destroyRenderThread(TLodManager *tLodManager, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          LodManager_destroy(tLodManager);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void LodManager_addComponentRenderThread(TLodManager *tLodManager, TSceneAsset *tSceneAsset, void (*onComplete)(bool))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = LodManager_addComponent(tLodManager, tSceneAsset);
+          PROXY(onComplete(result));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void LodManager_removeComponentRenderThread(TLodManager *tLodManager, EntityId entityId, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          LodManager_removeComponent(tLodManager, entityId);
+          PROXY(onComplete(requestId));
+        });
   }
 
   EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_asyncUpdateLoadRenderThread(
       TGltfResourceLoader *tGltfResourceLoader)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           GltfResourceLoader_asyncUpdateLoad(tGltfResourceLoader);
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void GltfResourceLoader_asyncGetLoadProgressRenderThread(
       TGltfResourceLoader *tGltfResourceLoader,
       void (*callback)(float))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto result = GltfResourceLoader_asyncGetLoadProgress(tGltfResourceLoader);
           PROXY(callback(result));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void GltfAssetLoader_loadRenderThread(
@@ -1322,24 +1694,47 @@ extern "C"
       uint8_t numInstances,
       void (*callback)(TFilamentAsset *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto loader = GltfAssetLoader_load(tEngine, tAssetLoader, data, length, numInstances);
           PROXY(callback(loader));
         });
-    auto fut = _renderThread->add_task(lambda);
+  }
+
+  EMSCRIPTEN_KEEPALIVE void GltfAssetLoader_loadFileRenderThread(
+      TEngine *tEngine,
+      TGltfAssetLoader *tAssetLoader,
+      const char *path,
+      uint8_t numInstances,
+      void (*callback)(TFilamentAsset *))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto asset = GltfAssetLoader_loadFile(tEngine, tAssetLoader, path, numInstances);
+          PROXY(callback(asset));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void TransformManager_setTransformRenderThread(TTransformManager *tTransformManager, EntityId entityId, double4x4 transform, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          TransformManager_setTransform(tTransformManager, entityId, transform);
+          PROXY(onComplete(requestId));
+        });
   }
 
   EMSCRIPTEN_KEEPALIVE void Scene_addFilamentAssetRenderThread(TScene *tScene, TFilamentAsset *tAsset, uint32_t requestId, VoidCallback onComplete)
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           Scene_addFilamentAsset(tScene, tAsset);
           PROXY(onComplete(requestId));
         });
-    auto fut = _renderThread->add_task(lambda);
   }
 
   EMSCRIPTEN_KEEPALIVE void Gizmo_createRenderThread(
@@ -1352,12 +1747,143 @@ extern "C"
       TGizmoType tGizmoType,
       void (*callback)(TGizmo *))
   {
-    std::packaged_task<void()> lambda(
+    _renderThread->enqueue(
         [=]() mutable
         {
           auto *gizmo = Gizmo_create(tEngine, tAssetLoader, tGltfResourceLoader, tNameComponentManager, tView, tMaterial, tGizmoType);
           PROXY(callback(gizmo));
         });
-    auto fut = _renderThread->add_task(lambda);
+  }
+
+  EMSCRIPTEN_KEEPALIVE void OverlayManager_addComponentRenderThread(
+      TOverlayManager *tOverlayManager,
+      TSceneAsset *tSceneAsset,
+      EntityId entityId,
+      TMaterialInstance *tMaterialInstance,
+      uint32_t requestId,
+      VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          OverlayManager_addComponent(tOverlayManager, tSceneAsset, entityId, tMaterialInstance);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void OverlayManager_removeComponentRenderThread(
+      TOverlayManager *tOverlayManager,
+      EntityId entityId,
+      uint32_t requestId,
+      VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          OverlayManager_removeComponent(tOverlayManager, entityId);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RayPicker_createRenderThread(TEngine *tEngine, void (*onComplete)(TRayPicker *))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto *rayPicker = RayPicker_create(tEngine);
+          PROXY(onComplete(rayPicker));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RayPicker_destroyRenderThread(TRayPicker *tRayPicker, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          RayPicker_destroy(tRayPicker);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RayPicker_addSceneAssetRenderThread(TRayPicker *tRayPicker, TSceneAsset *tSceneAsset, void (*onComplete)(bool))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = RayPicker_addSceneAsset(tRayPicker, tSceneAsset);
+          PROXY(onComplete(result));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RayPicker_removeSceneAssetRenderThread(TRayPicker *tRayPicker, TSceneAsset *tSceneAsset, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          RayPicker_removeSceneAsset(tRayPicker, tSceneAsset);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RayPicker_setTrianglesRenderThread(
+      TRayPicker *tRayPicker,
+      EntityId entityId,
+      const float *const positions,
+      uint32_t numVertices,
+      const uint32_t *const indices,
+      uint32_t numIndices,
+      uint32_t requestId,
+      VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          RayPicker_setTriangles(tRayPicker, entityId, positions, numVertices, indices, numIndices);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RayPicker_removeTrianglesRenderThread(TRayPicker *tRayPicker, EntityId entityId, uint32_t requestId, VoidCallback onComplete)
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          RayPicker_removeTriangles(tRayPicker, entityId);
+          PROXY(onComplete(requestId));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RayPicker_pickRenderThread(
+      TRayPicker *tRayPicker,
+      TView *tView,
+      const TRay *const rays,
+      uint32_t numRays,
+      bool refine,
+      TRayHit *hits,
+      void (*onComplete)(uint32_t))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = RayPicker_pick(tRayPicker, tView, rays, numRays, refine, hits);
+          PROXY(onComplete(result));
+        });
+  }
+
+  EMSCRIPTEN_KEEPALIVE void RayPicker_pickViewRenderThread(
+      TRayPicker *tRayPicker,
+      TView *tView,
+      uint32_t x,
+      uint32_t y,
+      bool refine,
+      TRayHit *hit,
+      void (*onComplete)(bool))
+  {
+    _renderThread->enqueue(
+        [=]() mutable
+        {
+          auto result = RayPicker_pickView(tRayPicker, tView, x, y, refine, hit);
+          PROXY(onComplete(result));
+        });
   }
 }
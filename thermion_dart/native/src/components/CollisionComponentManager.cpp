@@ -0,0 +1,174 @@
+#include <algorithm>
+
+#include "components/CollisionComponentManager.hpp"
+
+#include "TraceRecorder.hpp"
+
+namespace thermion
+{
+
+    filament::Aabb CollisionComponentManager::getWorldBoundingBox(Instance instance) const {
+        return elementAt<0>(instance).transform(elementAt<4>(instance));
+    }
+
+    void CollisionComponentManager::fit(Instance instance) {
+        auto transformInstance = _transformManager.getInstance(getEntity(instance));
+        elementAt<4>(instance) = _transformManager.getWorldTransform(transformInstance);
+        _tree.moveProxy(elementAt<3>(instance), getWorldBoundingBox(instance));
+    }
+
+    void CollisionComponentManager::addCollisionComponent(utils::Entity entity, filament::Aabb boundingBox, CollisionCallback callback, bool affectsTransform) {
+        if(hasComponent(entity)) {
+            removeCollisionComponent(entity);
+        }
+        auto instance = addComponent(entity);
+        elementAt<0>(instance) = boundingBox;
+        elementAt<1>(instance) = callback;
+        elementAt<2>(instance) = affectsTransform;
+        elementAt<4>(instance) = _transformManager.getWorldTransform(_transformManager.getInstance(entity));
+        elementAt<3>(instance) = _tree.createProxy(getWorldBoundingBox(instance), utils::Entity::smuggle(entity));
+    }
+
+    void CollisionComponentManager::removeCollisionComponent(utils::Entity entity) {
+        if(!hasComponent(entity)) {
+            return;
+        }
+        _tree.destroyProxy(elementAt<3>(getInstance(entity)));
+        removeComponent(entity);
+    }
+
+    void CollisionComponentManager::markDirty(utils::Entity entity) {
+        _dirty.push_back(entity);
+    }
+
+    void CollisionComponentManager::update() {
+        TRACE_SCOPE("CollisionComponentManager::update");
+        if(_dirty.empty()) {
+            return;
+        }
+        // moving an entity moves all of its descendants, so walk each dirty subtree
+        for(auto entity : _dirty) {
+            auto transformInstance = _transformManager.getInstance(entity);
+            if(!transformInstance) {
+                continue;
+            }
+            _dirtyStack.push_back(transformInstance);
+            while(!_dirtyStack.empty()) {
+                auto current = _dirtyStack.back();
+                _dirtyStack.pop_back();
+                auto instance = getInstance(_transformManager.getEntity(current));
+                // the same collider may be reached from more than one dirty entity
+                if(instance && _transformManager.getWorldTransform(current) != elementAt<4>(instance)) {
+                    fit(instance);
+                }
+                auto childCount = _transformManager.getChildCount(current);
+                if(childCount == 0) {
+                    continue;
+                }
+                _children.resize(childCount);
+                _transformManager.getChildren(current, _children.data(), childCount);
+                for(auto child : _children) {
+                    _dirtyStack.push_back(_transformManager.getInstance(child));
+                }
+            }
+        }
+        _dirty.clear();
+    }
+
+    void CollisionComponentManager::refit(utils::Entity entity) {
+        auto instance = getInstance(entity);
+        if(instance) {
+            fit(instance);
+        }
+    }
+
+    std::vector<filament::math::float3> CollisionComponentManager::collides(utils::Entity transformingEntity, filament::Aabb sourceBox) {
+        TRACE_SCOPE("CollisionComponentManager::collides");
+        auto sourceCorners = sourceBox.getCorners();
+        std::vector<filament::math::float3> collisionAxes;
+
+        // the broadphase only returns colliders whose (fat) boxes overlap the
+        // source box, which are then tested exactly as before
+        _tree.query(sourceBox, [&](int32_t proxyId) {
+            auto entity = utils::Entity::import(_tree.getUserData(proxyId));
+
+            if(entity == transformingEntity) {
+                return true;
+            }
+            auto it = getInstance(entity);
+            auto targetBox = getWorldBoundingBox(it);
+            auto targetCorners = targetBox.getCorners();
+
+            bool collided = false;
+
+            // iterate over every vertex in the source/target AABB
+            for(int i = 0; i < 8; i++) {
+                auto intersecting = sourceCorners.vertices[i];
+                auto min = targetBox.min;
+                auto max = targetBox.max;
+
+                // if the vertex has insersected with the target/source AABB
+                if(targetBox.contains(sourceCorners.vertices[i]) <= 0) {
+                    collided = true;
+                } else if(sourceBox.contains(targetCorners.vertices[i]) <= 0) {
+                    collided = true;
+                    intersecting = targetCorners.vertices[i];
+                    min = sourceBox.min;
+                    max = sourceBox.max;
+                } else {
+                    continue;
+                }
+                auto affectsTransform = elementAt<2>(it);
+                if(affectsTransform) {
+                    float xmin = min.x - intersecting.x;
+                    float ymin = min.y - intersecting.y;
+                    float zmin = min.z - intersecting.z;
+                    float xmax = intersecting.x - max.x;
+                    float ymax = intersecting.y - max.y;
+                    float zmax = intersecting.z - max.z;
+
+                    auto maxD = std::max(xmin,std::max(ymin,std::max(zmin,std::max(xmax,std::max(ymax,zmax)))));
+                    filament::math::float3 axis;
+                    if(maxD == xmin) {
+                        axis = {-1.0f,0.0f, 0.0f};
+                    } else if(maxD == ymin) {
+                        axis = {0.0f,-1.0f, 0.0f};
+                    } else if(maxD == zmin) {
+                        axis = {0.0f,0.0f, -1.0f};
+                    } else if(maxD == xmax) {
+                        axis = {1.0f,0.0f, 0.0f};
+                    } else if(maxD == ymax) {
+                        axis = {0.0f,1.0f, 0.0f};
+                    } else {
+                        axis = { 0.0f, 0.0f, 1.0f};
+                    }
+                    collisionAxes.push_back(axis);
+                }
+                break;
+            }
+            if(collided) {
+                auto callback = elementAt<1>(it);
+                if(callback) {
+                    callback(utils::Entity::smuggle(entity), utils::Entity::smuggle(transformingEntity));
+                }
+            }
+            return true;
+        });
+
+        return collisionAxes;
+    }
+
+    std::vector<std::pair<utils::Entity, utils::Entity>> CollisionComponentManager::collideAll() {
+        TRACE_SCOPE("CollisionComponentManager::collideAll");
+        std::vector<std::pair<utils::Entity, utils::Entity>> pairs;
+        _tree.queryPairs([&](int32_t proxyA, int32_t proxyB) {
+            auto entityA = utils::Entity::import(_tree.getUserData(proxyA));
+            auto entityB = utils::Entity::import(_tree.getUserData(proxyB));
+            if(DynamicAabbTree::overlaps(getWorldBoundingBox(getInstance(entityA)), getWorldBoundingBox(getInstance(entityB)))) {
+                pairs.emplace_back(entityA, entityB);
+            }
+        });
+        return pairs;
+    }
+
+}
@@ -0,0 +1,274 @@
+#include <algorithm>
+
+#include "components/DynamicAabbTree.hpp"
+
+namespace thermion
+{
+
+    using filament::Aabb;
+    using filament::math::float3;
+
+    static Aabb combine(const Aabb &a, const Aabb &b)
+    {
+        return {min(a.min, b.min), max(a.max, b.max)};
+    }
+
+    static float surfaceArea(const Aabb &box)
+    {
+        auto extent = box.max - box.min;
+        return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+
+    static bool contains(const Aabb &outer, const Aabb &inner)
+    {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+               inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+    }
+
+    int32_t DynamicAabbTree::allocateNode()
+    {
+        if (mFreeList == kNullNode)
+        {
+            mNodes.emplace_back();
+            return static_cast<int32_t>(mNodes.size() - 1);
+        }
+        auto nodeId = mFreeList;
+        mFreeList = mNodes[nodeId].parent;
+        mNodes[nodeId] = Node();
+        return nodeId;
+    }
+
+    void DynamicAabbTree::freeNode(int32_t nodeId)
+    {
+        auto &node = mNodes[nodeId];
+        node.parent = mFreeList;
+        node.child1 = kNullNode;
+        node.child2 = kNullNode;
+        node.height = -1;
+        mFreeList = nodeId;
+    }
+
+    int32_t DynamicAabbTree::createProxy(const Aabb &box, uint32_t userData)
+    {
+        auto proxyId = allocateNode();
+        auto &node = mNodes[proxyId];
+        const float3 margin(mMargin);
+        node.box = {box.min - margin, box.max + margin};
+        node.userData = userData;
+        node.height = 0;
+        insertLeaf(proxyId);
+        mProxyCount++;
+        return proxyId;
+    }
+
+    void DynamicAabbTree::destroyProxy(int32_t proxyId)
+    {
+        removeLeaf(proxyId);
+        freeNode(proxyId);
+        mProxyCount--;
+    }
+
+    bool DynamicAabbTree::moveProxy(int32_t proxyId, const Aabb &box)
+    {
+        if (contains(mNodes[proxyId].box, box))
+        {
+            return false;
+        }
+        removeLeaf(proxyId);
+        const float3 margin(mMargin);
+        mNodes[proxyId].box = {box.min - margin, box.max + margin};
+        insertLeaf(proxyId);
+        return true;
+    }
+
+    void DynamicAabbTree::insertLeaf(int32_t leaf)
+    {
+        if (mRoot == kNullNode)
+        {
+            mRoot = leaf;
+            mNodes[leaf].parent = kNullNode;
+            return;
+        }
+
+        // descend to the sibling that minimizes the total surface area
+        const auto leafBox = mNodes[leaf].box;
+        auto index = mRoot;
+        while (!mNodes[index].isLeaf())
+        {
+            const auto &node = mNodes[index];
+            const float area = surfaceArea(node.box);
+            const float combinedArea = surfaceArea(combine(node.box, leafBox));
+
+            // the cost of making a new parent for this node and the leaf
+            const float cost = 2.0f * combinedArea;
+            // the minimum cost of pushing the leaf further down the tree
+            const float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto childCost = [&](int32_t childId)
+            {
+                const auto &child = mNodes[childId];
+                const float newArea = surfaceArea(combine(leafBox, child.box));
+                return child.isLeaf() ? newArea + inheritanceCost
+                                      : (newArea - surfaceArea(child.box)) + inheritanceCost;
+            };
+            const float cost1 = childCost(node.child1);
+            const float cost2 = childCost(node.child2);
+
+            if (cost < cost1 && cost < cost2)
+            {
+                break;
+            }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const auto sibling = index;
+        const auto oldParent = mNodes[sibling].parent;
+        const auto newParent = allocateNode();
+        mNodes[newParent].parent = oldParent;
+        mNodes[newParent].box = combine(leafBox, mNodes[sibling].box);
+        mNodes[newParent].height = mNodes[sibling].height + 1;
+        mNodes[newParent].child1 = sibling;
+        mNodes[newParent].child2 = leaf;
+        mNodes[sibling].parent = newParent;
+        mNodes[leaf].parent = newParent;
+
+        if (oldParent == kNullNode)
+        {
+            mRoot = newParent;
+        }
+        else if (mNodes[oldParent].child1 == sibling)
+        {
+            mNodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            mNodes[oldParent].child2 = newParent;
+        }
+
+        // walk back up the tree, fixing heights and boxes
+        index = mNodes[leaf].parent;
+        while (index != kNullNode)
+        {
+            index = balance(index);
+            auto &node = mNodes[index];
+            node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+            node.box = combine(mNodes[node.child1].box, mNodes[node.child2].box);
+            index = node.parent;
+        }
+    }
+
+    void DynamicAabbTree::removeLeaf(int32_t leaf)
+    {
+        if (leaf == mRoot)
+        {
+            mRoot = kNullNode;
+            return;
+        }
+
+        const auto parent = mNodes[leaf].parent;
+        const auto grandParent = mNodes[parent].parent;
+        const auto sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+        if (grandParent == kNullNode)
+        {
+            mRoot = sibling;
+            mNodes[sibling].parent = kNullNode;
+            freeNode(parent);
+            return;
+        }
+
+        // replace the parent with the sibling
+        if (mNodes[grandParent].child1 == parent)
+        {
+            mNodes[grandParent].child1 = sibling;
+        }
+        else
+        {
+            mNodes[grandParent].child2 = sibling;
+        }
+        mNodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        auto index = grandParent;
+        while (index != kNullNode)
+        {
+            index = balance(index);
+            auto &node = mNodes[index];
+            node.box = combine(mNodes[node.child1].box, mNodes[node.child2].box);
+            node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+            index = node.parent;
+        }
+    }
+
+    // Performs a left or right rotation if [a] is imbalanced; returns the
+    // index of the node now at [a]'s position.
+    int32_t DynamicAabbTree::balance(int32_t a)
+    {
+        auto &A = mNodes[a];
+        if (A.isLeaf() || A.height < 2)
+        {
+            return a;
+        }
+
+        const auto b = A.child1;
+        const auto c = A.child2;
+        const int32_t heightDifference = mNodes[c].height - mNodes[b].height;
+
+        // rotates [child] (one of A's children) up to replace A
+        auto rotate = [&](int32_t child, int32_t other)
+        {
+            auto &C = mNodes[child];
+            const auto f = C.child1;
+            const auto g = C.child2;
+
+            C.child1 = a;
+            C.parent = A.parent;
+            A.parent = child;
+
+            if (C.parent == kNullNode)
+            {
+                mRoot = child;
+            }
+            else if (mNodes[C.parent].child1 == a)
+            {
+                mNodes[C.parent].child1 = child;
+            }
+            else
+            {
+                mNodes[C.parent].child2 = child;
+            }
+
+            // keep the taller of C's children under C, and give the other to A
+            const bool keepF = mNodes[f].height > mNodes[g].height;
+            const auto kept = keepF ? f : g;
+            const auto moved = keepF ? g : f;
+            C.child2 = kept;
+            if (A.child1 == child)
+            {
+                A.child1 = moved;
+            }
+            else
+            {
+                A.child2 = moved;
+            }
+            mNodes[moved].parent = a;
+
+            A.box = combine(mNodes[other].box, mNodes[moved].box);
+            C.box = combine(A.box, mNodes[kept].box);
+            A.height = 1 + std::max(mNodes[other].height, mNodes[moved].height);
+            C.height = 1 + std::max(A.height, mNodes[kept].height);
+            return child;
+        };
+
+        if (heightDifference > 1)
+        {
+            return rotate(c, b);
+        }
+        if (heightDifference < -1)
+        {
+            return rotate(b, c);
+        }
+        return a;
+    }
+
+} // namespace thermion
@@ -0,0 +1,152 @@
+#include <cmath>
+
+#include <filament/Box.h>
+#include <filament/Camera.h>
+#include <filament/RenderableManager.h>
+#include <filament/TransformManager.h>
+#include <filament/Viewport.h>
+
+#include "components/LodComponentManager.hpp"
+
+#include "Log.hpp"
+#include "TraceRecorder.hpp"
+
+namespace thermion
+{
+
+    void LodComponentManager::addLodComponent(utils::Entity entity, std::shared_ptr<LodChain> lodChain)
+    {
+        std::lock_guard lock(mMutex);
+        auto &rm = mEngine->getRenderableManager();
+        if (!rm.getInstance(entity).isValid())
+        {
+            Log("Entity %d is not renderable, not adding LOD component", utils::Entity::smuggle(entity));
+            return;
+        }
+        auto instance = hasComponent(entity) ? getInstance(entity) : addComponent(entity);
+        elementAt<0>(instance) = std::move(lodChain);
+        elementAt<1>(instance) = 0;
+    }
+
+    void LodComponentManager::removeLodComponent(utils::Entity entity)
+    {
+        std::lock_guard lock(mMutex);
+        if (!hasComponent(entity))
+        {
+            return;
+        }
+
+        // restore the original triangles
+        auto &rm = mEngine->getRenderableManager();
+        auto ri = rm.getInstance(entity);
+        auto &lodChain = elementAt<0>(getInstance(entity));
+        if (ri.isValid() && elementAt<1>(getInstance(entity)) != 0)
+        {
+            auto level = lodChain->getLevel(0);
+            rm.setGeometryAt(ri, 0, lodChain->getPrimitiveType(), lodChain->getVertexBuffer(), level.indexBuffer, 0, level.indexCount);
+        }
+        removeComponent(entity);
+    }
+
+    void LodComponentManager::setBias(float bias)
+    {
+        std::lock_guard lock(mMutex);
+        mBias = bias;
+    }
+
+    int32_t LodComponentManager::getCurrentLevel(utils::Entity entity)
+    {
+        std::lock_guard lock(mMutex);
+        if (!hasComponent(entity))
+        {
+            return -1;
+        }
+        return elementAt<1>(getInstance(entity));
+    }
+
+    void LodComponentManager::update()
+    {
+        TRACE_SCOPE("LodComponentManager::update");
+        std::lock_guard lock(mMutex);
+
+        auto &rm = mEngine->getRenderableManager();
+        auto &tm = mEngine->getTransformManager();
+        const auto &camera = mView->getCamera();
+        const auto projection = camera.getProjectionMatrix();
+        const bool perspective = projection[3][3] == 0.0;
+        const auto cameraPosition = filament::math::float3(camera.getPosition());
+        // world units to pixels (at unit distance, for perspective projections)
+        const float pixelsPerUnit = float(projection[1][1]) * float(mView->getViewport().height) * 0.5f;
+        const float threshold = kMaxPixelError * std::exp2(mBias);
+
+        for (auto it = begin(); it < end(); it++)
+        {
+            auto &lodChain = elementAt<0>(it);
+            auto &current = elementAt<1>(it);
+            lodChain->poll();
+            const size_t levelCount = lodChain->getLevelCount();
+            if (levelCount < 2)
+            {
+                continue;
+            }
+
+            auto entity = getEntity(it);
+            auto ri = rm.getInstance(entity);
+            if (!ri.isValid())
+            {
+                continue;
+            }
+
+            auto box = rm.getAxisAlignedBoundingBox(ri);
+            auto ti = tm.getInstance(entity);
+            if (ti.isValid())
+            {
+                const auto &world = tm.getWorldTransform(ti);
+                box = filament::Box::transform(world.upperLeft(), world[3].xyz, box);
+            }
+            const float radius = length(box.halfExtent);
+
+            // the size in pixels of the bounding sphere's radius, at the point closest to the camera
+            float radiusInPixels = radius * pixelsPerUnit;
+            if (perspective)
+            {
+                const float distance = length(box.center - cameraPosition) - radius;
+                radiusInPixels = distance > 0.0f ? radiusInPixels / distance : INFINITY;
+            }
+
+            // errors only increase with the level
+            auto coarsest = [&](float maxError)
+            {
+                uint8_t level = 0;
+                for (size_t i = 1; i < levelCount; i++)
+                {
+                    if (lodChain->getLevel(i).error * radiusInPixels > maxError)
+                    {
+                        break;
+                    }
+                    level = static_cast<uint8_t>(i);
+                }
+                return level;
+            };
+
+            uint8_t level = std::min<uint8_t>(current, levelCount - 1);
+            if (lodChain->getLevel(level).error * radiusInPixels > threshold * (1.0f + kHysteresis))
+            {
+                level = coarsest(threshold);
+            }
+            else
+            {
+                level = std::max(level, coarsest(threshold * (1.0f - kHysteresis)));
+            }
+
+            if (level != current)
+            {
+                auto lod = lodChain->getLevel(level);
+                rm.setGeometryAt(ri, 0, lodChain->getPrimitiveType(), lodChain->getVertexBuffer(), lod.indexBuffer, 0, lod.indexCount);
+                TRACE("Entity %d switched from LOD %d to %d", utils::Entity::smuggle(entity), current, level);
+                current = level;
+            }
+        }
+    }
+
+} // namespace thermion
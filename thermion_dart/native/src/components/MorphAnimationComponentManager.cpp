@@ -1,9 +1,12 @@
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <variant>
 
 #include "components/MorphAnimationComponentManager.hpp"
 
 #include "Log.hpp"
+#include "TraceRecorder.hpp"
 
 namespace thermion
 {
@@ -21,56 +24,147 @@ namespace thermion
         }
     }
 
-    void MorphAnimationComponentManager::update() {
+    void MorphAnimationComponentManager::setWeights(utils::Entity entity, const float *const weights, size_t count, size_t offset) {
+        if(!hasComponent(entity)) {
+            return;
+        }
+        auto &animationComponent = elementAt<0>(getInstance(entity));
+        if(animationComponent.weights.size() < offset + count) {
+            animationComponent.weights.resize(offset + count, 0.0f);
+        }
+        std::copy(weights, weights + count, animationComponent.weights.begin() + offset);
+    }
+
+    void MorphAnimationComponentManager::sample(const MorphAnimation &animation, float elapsedInSecs, std::vector<float> &weights) {
+        const int lengthInFrames = animation.lengthInFrames;
+        float elapsedInFrames = elapsedInSecs * 1000.0f / animation.frameLengthInMs;
+
+        int currFrame;
+        int nextFrame;
+        if (animation.loop)
+        {
+            elapsedInFrames = std::fmod(elapsedInFrames, float(lengthInFrames));
+            currFrame = std::min(static_cast<int>(elapsedInFrames), lengthInFrames - 1);
+            nextFrame = (currFrame + 1) % lengthInFrames;
+        }
+        else
+        {
+            elapsedInFrames = std::clamp(elapsedInFrames, 0.0f, float(lengthInFrames - 1));
+            currFrame = static_cast<int>(elapsedInFrames);
+            nextFrame = std::min(currFrame + 1, lengthInFrames - 1);
+        }
+        const float frameDelta = elapsedInFrames - currFrame;
+
+        // offset from the end if reverse
+        if (animation.reverse)
+        {
+            currFrame = lengthInFrames - 1 - currFrame;
+            nextFrame = lengthInFrames - 1 - nextFrame;
+        }
+
+        const auto numMorphTargets = animation.morphIndices.size();
+        const float *curr = animation.frameData.data() + currFrame * numMorphTargets;
+        const float *next = animation.frameData.data() + nextFrame * numMorphTargets;
+        for (size_t i = 0; i < numMorphTargets; i++)
+        {
+            const auto morphIndex = static_cast<size_t>(animation.morphIndices[i]);
+            if (morphIndex < weights.size())
+            {
+                weights[morphIndex] += curr[i] + (next[i] - curr[i]) * frameDelta;
+            }
+        }
+    }
+
+    void MorphAnimationComponentManager::update(uint64_t nowInNanos) {
+        TRACE_SCOPE("MorphAnimationComponentManager::update");
         TRACE("Updating %d morph animation components", getComponentCount());
-         for (auto it = begin(); it < end(); it++)
+
+        for (auto it = begin(); it < end(); it++)
         {
             const auto &entity = getEntity(it);
-            
-            auto componentInstance = getInstance(entity);
-            
-            auto &animationComponent = elementAt<0>(componentInstance);
+            auto &animationComponent = elementAt<0>(getInstance(entity));
             auto &animations = animationComponent.animations;
 
-            TRACE("Component has %d animations", animations.size());           
-
-            for (int i = (int)animations.size() - 1; i >= 0; i--)
-                {
+            if (animations.empty())
+            {
+                continue;
+            }
 
-                    auto now = high_resolution_clock::now();
+            TRACE("Component has %d animations", animations.size());
 
-                    auto &animation = animationComponent.animations[i];
+            auto renderableInstance = mRenderableManager.getInstance(entity);
+            if (!renderableInstance.isValid())
+            {
+                continue;
+            }
 
-                    auto elapsedInSecs = float(std::chrono::duration_cast<std::chrono::milliseconds>(now - animation.start).count()) / 1000.0f;
+            auto &weights = animationComponent.weights;
+            const auto morphTargetCount = mRenderableManager.getMorphTargetCount(renderableInstance);
+            if (weights.size() != morphTargetCount)
+            {
+                weights.resize(morphTargetCount, 0.0f);
+            }
 
-                    if (!animation.loop && elapsedInSecs >= animation.durationInSecs)
+            // reset every driven target (so concurrent animations can be
+            // accumulated) and record which targets need to be uploaded
+            mDriven.assign(weights.size(), false);
+            for (const auto &animation : animations)
+            {
+                for (auto morphIndex : animation.morphIndices)
+                {
+                    if (static_cast<size_t>(morphIndex) < weights.size())
                     {
-                        animations.erase(animations.begin() + i);
-                        TRACE("Animation %d completed", i);
-                        continue;
+                        weights[morphIndex] = 0.0f;
+                        mDriven[morphIndex] = true;
                     }
+                }
+            }
 
-                    int frameNumber = static_cast<int>(elapsedInSecs * 1000.0f / animation.frameLengthInMs) % animation.lengthInFrames;
-                    // offset from the end if reverse
-                    if (animation.reverse)
-                    {
-                        frameNumber = animation.lengthInFrames - frameNumber;
-                    }
-                    
-                    auto baseOffset = frameNumber * animation.morphIndices.size();
-                    for (int i = 0; i < animation.morphIndices.size(); i++)
-                    {
-                        auto morphIndex = animation.morphIndices[i];
-                        auto renderableInstance = mRenderableManager.getInstance(entity);
-                        
-                        mRenderableManager.setMorphWeights(
-                            renderableInstance,
-                            animation.frameData.data() + baseOffset + i,
-                            1,
-                            morphIndex);
-                            
-                    }
+            bool anyCompleted = false;
+            for (auto &animation : animations)
+            {
+                auto elapsedInSecs = animation.elapsedInSecs(nowInNanos);
+
+                // a completed animation is still applied (at its last frame) before it's removed
+                if (!animation.loop && elapsedInSecs >= animation.durationInSecs)
+                {
+                    animation.completed = true;
+                    anyCompleted = true;
+                    TRACE("Morph animation completed");
+                }
+                sample(animation, elapsedInSecs, weights);
+            }
+
+            if (anyCompleted)
+            {
+                animations.erase(
+                    std::remove_if(animations.begin(), animations.end(),
+                                   [](const MorphAnimation &animation) { return animation.completed; }),
+                    animations.end());
+            }
+
+            // upload each contiguous run of driven targets, so targets in between
+            // (which may have been set elsewhere, e.g. by a glTF animation) are untouched
+            size_t runStart = 0;
+            while (runStart < weights.size())
+            {
+                if (!mDriven[runStart])
+                {
+                    runStart++;
+                    continue;
+                }
+                size_t runEnd = runStart + 1;
+                while (runEnd < weights.size() && mDriven[runEnd])
+                {
+                    runEnd++;
                 }
+                mRenderableManager.setMorphWeights(
+                    renderableInstance,
+                    weights.data() + runStart,
+                    runEnd - runStart,
+                    runStart);
+                runStart = runEnd;
+            }
         }
     }
 }
@@ -0,0 +1,519 @@
+#include <cstring>
+
+#include <filament/Camera.h>
+#include <filament/MaterialEnums.h>
+#include <gltfio/Animator.h>
+#include <math/vec4.h>
+#include <utils/EntityManager.h>
+
+#include "cgltf.h"
+
+#include "components/OverlayComponentManager.hpp"
+#include "scene/GeometrySceneAsset.hpp"
+#include "scene/GltfSceneAsset.hpp"
+#include "scene/GltfSceneAssetInstance.hpp"
+#include "scene/GltfSourceNodes.hpp"
+
+#include "Log.hpp"
+#include "TraceRecorder.hpp"
+
+namespace thermion
+{
+
+    namespace
+    {
+        // the depth prepass and the outline pass draw separate renderables
+        // from the same scene, so each view only sees its own layer
+        constexpr uint8_t kDepthLayer = 0x1;
+        constexpr uint8_t kOutlineLayer = 0x2;
+
+        // exact (bitwise) comparison, so any change at all invalidates the depth prepass
+        template <typename T>
+        bool unchanged(const T &a, const T &b)
+        {
+            return std::memcmp(&a, &b, sizeof(T)) == 0;
+        }
+
+        template <typename T>
+        void deleteVector(void *, size_t, void *user)
+        {
+            delete static_cast<std::vector<T> *>(user);
+        }
+
+        filament::View *createOverlayView(filament::Engine *engine, filament::Scene *scene, uint8_t layer)
+        {
+            auto *view = engine->createView();
+            view->setScene(scene);
+            view->setPostProcessingEnabled(false);
+            view->setShadowingEnabled(false);
+            view->setVisibleLayers(0xFF, layer);
+            return view;
+        }
+
+        bool toPrimitiveType(cgltf_primitive_type in, filament::RenderableManager::PrimitiveType &out)
+        {
+            using PrimitiveType = filament::RenderableManager::PrimitiveType;
+            switch (in)
+            {
+            case cgltf_primitive_type_points:
+                out = PrimitiveType::POINTS;
+                return true;
+            case cgltf_primitive_type_lines:
+                out = PrimitiveType::LINES;
+                return true;
+            case cgltf_primitive_type_line_strip:
+                out = PrimitiveType::LINE_STRIP;
+                return true;
+            case cgltf_primitive_type_triangles:
+                out = PrimitiveType::TRIANGLES;
+                return true;
+            case cgltf_primitive_type_triangle_strip:
+                out = PrimitiveType::TRIANGLE_STRIP;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        const cgltf_accessor *findAttribute(const cgltf_primitive &primitive, cgltf_attribute_type type)
+        {
+            for (cgltf_size i = 0; i < primitive.attributes_count; i++)
+            {
+                const auto &attribute = primitive.attributes[i];
+                if (attribute.type == type && attribute.index == 0)
+                {
+                    return attribute.data;
+                }
+            }
+            return std::nullptr_t();
+        }
+
+        bool isReadable(const cgltf_accessor *accessor, cgltf_type type, cgltf_size count)
+        {
+            return accessor && accessor->type == type && accessor->count == count &&
+                   accessor->buffer_view && accessor->buffer_view->buffer->data;
+        }
+    }
+
+    OverlayComponentManager::OverlayComponentManager(
+        filament::Engine *engine,
+        filament::View *view,
+        filament::Scene *scene,
+        filament::RenderTarget *renderTarget,
+        filament::Renderer *renderer) : mEngine(engine), mView(view), mScene(scene), mRenderTarget(renderTarget), mRenderer(renderer)
+    {
+        mDepthMaterial = filament::Material::Builder()
+                             .package(LINEAR_DEPTH_LINEAR_DEPTH_DATA, LINEAR_DEPTH_LINEAR_DEPTH_SIZE)
+                             .build(*engine);
+        mDepthMaterialInstance = mDepthMaterial->createInstance();
+
+        mDepthView = createOverlayView(engine, scene, kDepthLayer);
+        mDepthView->setRenderTarget(mRenderTarget);
+
+        mOutlineView = createOverlayView(engine, scene, kOutlineLayer);
+        // composite over whatever the main view has already rendered
+        mOutlineView->setBlendMode(filament::View::BlendMode::TRANSLUCENT);
+    }
+
+    OverlayComponentManager::~OverlayComponentManager()
+    {
+        for (auto it = begin(); it < end(); it++)
+        {
+            for (auto &overlay : elementAt<1>(it))
+            {
+                destroyOverlay(overlay);
+            }
+        }
+        mEngine->destroy(mOutlineView);
+        mEngine->destroy(mDepthView);
+        mEngine->destroy(mDepthMaterialInstance);
+        mEngine->destroy(mDepthMaterial);
+    }
+
+    void OverlayComponentManager::setRenderTarget(filament::RenderTarget *renderTarget)
+    {
+        std::lock_guard lock(mMutex);
+        mRenderTarget = renderTarget;
+        mDepthView->setRenderTarget(mRenderTarget);
+        mDepthPrepassValid = false;
+        auto *color = mRenderTarget->getTexture(filament::RenderTarget::AttachmentPoint::COLOR);
+        for (auto it = begin(); it < end(); it++)
+        {
+            auto &materialInstance = elementAt<0>(it);
+            materialInstance->setParameter("depth", color, mDepthSampler);
+        }
+    }
+
+    void OverlayComponentManager::addOverlayComponent(SceneAsset *asset, utils::Entity target, filament::MaterialInstance *materialInstance)
+    {
+        std::lock_guard lock(mMutex);
+
+        if (hasComponent(target))
+        {
+            return;
+        }
+
+        // the whole asset is outlined if the target is its entity
+        auto only = target == asset->getEntity() ? utils::Entity() : target;
+
+        std::vector<OverlayRenderable> overlays;
+        switch (asset->getType())
+        {
+        case SceneAsset::SceneAssetType::Geometry:
+            addGeometryOverlays(static_cast<GeometrySceneAsset *>(asset), overlays, materialInstance);
+            break;
+        case SceneAsset::SceneAssetType::Gltf:
+            if (asset->isInstance())
+            {
+                addGltfOverlays(static_cast<GltfSceneAssetInstance *>(asset), only, overlays, materialInstance);
+            }
+            else
+            {
+                for (size_t i = 0; i < asset->getInstanceCount(); i++)
+                {
+                    addGltfOverlays(static_cast<GltfSceneAssetInstance *>(asset->getInstanceAt(i)), only, overlays, materialInstance);
+                }
+            }
+            break;
+        default:
+            Log("Overlays are not supported for this asset type (%d)", asset->getType());
+            break;
+        }
+
+        if (overlays.empty())
+        {
+            Log("No overlay renderables created for entity %d", utils::Entity::smuggle(target));
+            return;
+        }
+
+        auto *color = mRenderTarget->getTexture(filament::RenderTarget::AttachmentPoint::COLOR);
+        materialInstance->setParameter("depth", color, mDepthSampler);
+        materialInstance->setParameter("bbCenter", asset->getBoundingBox().center());
+
+        utils::EntityInstanceBase::Type componentInstance = addComponent(target);
+        elementAt<0>(componentInstance) = materialInstance;
+        elementAt<1>(componentInstance) = std::move(overlays);
+        mDepthPrepassValid = false;
+    }
+
+    void OverlayComponentManager::addGeometryOverlays(GeometrySceneAsset *asset, std::vector<OverlayRenderable> &overlays, filament::MaterialInstance *materialInstance)
+    {
+        SharedGeometry geometry;
+        geometry.vertexBuffer = asset->getVertexBuffer();
+        geometry.indexBuffer = asset->getIndexBuffer();
+        geometry.primitiveType = asset->getPrimitiveType();
+        overlays.push_back(createOverlay(asset->getRenderableEntity(), {geometry}, 0, materialInstance));
+    }
+
+    void OverlayComponentManager::addGltfOverlays(GltfSceneAssetInstance *instance, utils::Entity only, std::vector<OverlayRenderable> &overlays, filament::MaterialInstance *materialInstance)
+    {
+        auto *owner = static_cast<GltfSceneAsset *>(instance->getInstanceOwner());
+        auto *data = static_cast<const cgltf_data *>(owner->getAsset()->getSourceAsset());
+        if (!data)
+        {
+            Log("glTF source data has been released, cannot create overlay");
+            return;
+        }
+
+        auto *filamentInstance = instance->getInstance();
+        auto nodes = getGltfSourceNodes(data, filamentInstance);
+        const auto *entities = filamentInstance->getEntities();
+        bool skinned = false;
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            auto *mesh = nodes[i]->mesh;
+            if (!mesh || (!only.isNull() && entities[i] != only))
+            {
+                continue;
+            }
+
+            std::vector<SharedGeometry> geometry;
+            std::vector<const cgltf_primitive *> primitives;
+            bool hasBones = true;
+            for (cgltf_size j = 0; j < mesh->primitives_count; j++)
+            {
+                auto *shared = acquireGltfGeometry(&mesh->primitives[j]);
+                if (shared)
+                {
+                    geometry.push_back(*shared);
+                    primitives.push_back(&mesh->primitives[j]);
+                    hasBones &= shared->skinned;
+                }
+            }
+            if (geometry.empty())
+            {
+                continue;
+            }
+
+            auto *skin = hasBones ? nodes[i]->skin : std::nullptr_t();
+            auto overlay = createOverlay(entities[i], geometry, skin ? skin->joints_count : 0, materialInstance);
+            overlay.primitives = std::move(primitives);
+            if (skin)
+            {
+                overlay.skinInstance = filamentInstance;
+                overlay.skinIndex = static_cast<size_t>(skin - data->skins);
+                filamentInstance->attachSkin(overlay.skinIndex, overlay.depth);
+                filamentInstance->attachSkin(overlay.skinIndex, overlay.outline);
+                skinned = true;
+            }
+            overlays.push_back(std::move(overlay));
+        }
+
+        // the overlay's bones are otherwise only set the next time the instance is animated
+        if (skinned)
+        {
+            filamentInstance->getAnimator()->updateBoneMatrices();
+        }
+    }
+
+    OverlayComponentManager::SharedGeometry *OverlayComponentManager::acquireGltfGeometry(const cgltf_primitive *primitive)
+    {
+        auto it = mGltfGeometry.find(primitive);
+        if (it != mGltfGeometry.end())
+        {
+            it->second.useCount++;
+            return &it->second;
+        }
+
+        SharedGeometry geometry;
+        if (!toPrimitiveType(primitive->type, geometry.primitiveType) || primitive->has_draco_mesh_compression)
+        {
+            Log("Unsupported glTF primitive, not outlined");
+            return std::nullptr_t();
+        }
+
+        const auto *positions = findAttribute(*primitive, cgltf_attribute_type_position);
+        if (!positions || !isReadable(positions, cgltf_type_vec3, positions->count))
+        {
+            Log("glTF primitive positions are not readable, not outlined");
+            return std::nullptr_t();
+        }
+        const auto vertexCount = positions->count;
+        const auto *joints = findAttribute(*primitive, cgltf_attribute_type_joints);
+        const auto *weights = findAttribute(*primitive, cgltf_attribute_type_weights);
+        geometry.skinned = isReadable(joints, cgltf_type_vec4, vertexCount) && isReadable(weights, cgltf_type_vec4, vertexCount);
+
+        auto vertexBufferBuilder = filament::VertexBuffer::Builder()
+                                       .vertexCount(static_cast<uint32_t>(vertexCount))
+                                       .bufferCount(geometry.skinned ? 3 : 1)
+                                       .attribute(filament::VertexAttribute::POSITION, 0, filament::VertexBuffer::AttributeType::FLOAT3);
+        if (geometry.skinned)
+        {
+            vertexBufferBuilder.attribute(filament::VertexAttribute::BONE_INDICES, 1, filament::VertexBuffer::AttributeType::USHORT4);
+            vertexBufferBuilder.attribute(filament::VertexAttribute::BONE_WEIGHTS, 2, filament::VertexBuffer::AttributeType::FLOAT4);
+        }
+        geometry.vertexBuffer = vertexBufferBuilder.build(*mEngine);
+
+        auto *positionData = new std::vector<filament::math::float3>(vertexCount);
+        cgltf_accessor_unpack_floats(positions, &positionData->data()->x, vertexCount * 3);
+        geometry.vertexBuffer->setBufferAt(*mEngine, 0,
+                                           filament::VertexBuffer::BufferDescriptor(
+                                               positionData->data(), positionData->size() * sizeof(filament::math::float3),
+                                               deleteVector<filament::math::float3>, positionData));
+        if (geometry.skinned)
+        {
+            auto *jointData = new std::vector<filament::math::ushort4>(vertexCount);
+            cgltf_uint joint[4];
+            for (cgltf_size i = 0; i < vertexCount; i++)
+            {
+                cgltf_accessor_read_uint(joints, i, joint, 4);
+                (*jointData)[i] = filament::math::ushort4(joint[0], joint[1], joint[2], joint[3]);
+            }
+            auto *weightData = new std::vector<filament::math::float4>(vertexCount);
+            cgltf_accessor_unpack_floats(weights, &weightData->data()->x, vertexCount * 4);
+            geometry.vertexBuffer->setBufferAt(*mEngine, 1,
+                                               filament::VertexBuffer::BufferDescriptor(
+                                                   jointData->data(), jointData->size() * sizeof(filament::math::ushort4),
+                                                   deleteVector<filament::math::ushort4>, jointData));
+            geometry.vertexBuffer->setBufferAt(*mEngine, 2,
+                                               filament::VertexBuffer::BufferDescriptor(
+                                                   weightData->data(), weightData->size() * sizeof(filament::math::float4),
+                                                   deleteVector<filament::math::float4>, weightData));
+        }
+
+        // non-indexed primitives are drawn with sequential indices
+        auto *indexData = new std::vector<uint32_t>(primitive->indices ? primitive->indices->count : vertexCount);
+        for (size_t i = 0; i < indexData->size(); i++)
+        {
+            (*indexData)[i] = primitive->indices ? static_cast<uint32_t>(cgltf_accessor_read_index(primitive->indices, i)) : static_cast<uint32_t>(i);
+        }
+        geometry.indexBuffer = filament::IndexBuffer::Builder()
+                                   .indexCount(static_cast<uint32_t>(indexData->size()))
+                                   .bufferType(filament::IndexBuffer::IndexType::UINT)
+                                   .build(*mEngine);
+        geometry.indexBuffer->setBuffer(*mEngine,
+                                        filament::IndexBuffer::BufferDescriptor(
+                                            indexData->data(), indexData->size() * sizeof(uint32_t),
+                                            deleteVector<uint32_t>, indexData));
+
+        geometry.useCount = 1;
+        return &mGltfGeometry.emplace(primitive, geometry).first->second;
+    }
+
+    void OverlayComponentManager::releaseGltfGeometry(const cgltf_primitive *primitive)
+    {
+        auto it = mGltfGeometry.find(primitive);
+        if (it == mGltfGeometry.end() || --it->second.useCount > 0)
+        {
+            return;
+        }
+        mEngine->destroy(it->second.vertexBuffer);
+        mEngine->destroy(it->second.indexBuffer);
+        mGltfGeometry.erase(it);
+    }
+
+    OverlayRenderable OverlayComponentManager::createOverlay(utils::Entity source, const std::vector<SharedGeometry> &geometry, size_t jointCount, filament::MaterialInstance *materialInstance)
+    {
+        auto &rm = mEngine->getRenderableManager();
+        auto &tm = mEngine->getTransformManager();
+        auto &em = utils::EntityManager::get();
+
+        auto ri = rm.getInstance(source);
+        auto boundingBox = ri.isValid() ? rm.getAxisAlignedBoundingBox(ri) : filament::Box();
+
+        auto build = [&](utils::Entity entity, filament::MaterialInstance *mi, uint8_t layer)
+        {
+            filament::RenderableManager::Builder builder(geometry.size());
+            builder.boundingBox(boundingBox)
+                .layerMask(0xFF, layer)
+                .castShadows(false)
+                .receiveShadows(false);
+            for (size_t i = 0; i < geometry.size(); i++)
+            {
+                builder.geometry(i, geometry[i].primitiveType, geometry[i].vertexBuffer, geometry[i].indexBuffer);
+                builder.material(i, mi);
+            }
+            if (jointCount > 0)
+            {
+                builder.skinning(jointCount);
+            }
+            // the outline material scales the geometry, so it may fall outside the bounding box
+            builder.culling(layer != kOutlineLayer);
+            builder.build(*mEngine, entity);
+
+            // follows the source renderable (with an identity local transform)
+            tm.create(entity, tm.getInstance(source));
+            mScene->addEntity(entity);
+        };
+
+        OverlayRenderable overlay;
+        overlay.source = source;
+        overlay.depth = em.create();
+        build(overlay.depth, mDepthMaterialInstance, kDepthLayer);
+        overlay.outline = em.create();
+        build(overlay.outline, materialInstance, kOutlineLayer);
+        return overlay;
+    }
+
+    void OverlayComponentManager::destroyOverlay(OverlayRenderable &overlay)
+    {
+        for (auto entity : {overlay.depth, overlay.outline})
+        {
+            if (overlay.skinInstance)
+            {
+                overlay.skinInstance->detachSkin(overlay.skinIndex, entity);
+            }
+            mScene->remove(entity);
+            mEngine->destroy(entity);
+            utils::EntityManager::get().destroy(entity);
+        }
+        for (auto *primitive : overlay.primitives)
+        {
+            releaseGltfGeometry(primitive);
+        }
+        overlay.primitives.clear();
+    }
+
+    void OverlayComponentManager::removeOverlayComponent(utils::Entity target)
+    {
+        std::lock_guard lock(mMutex);
+
+        if (!hasComponent(target))
+        {
+            return;
+        }
+        for (auto &overlay : elementAt<1>(getInstance(target)))
+        {
+            destroyOverlay(overlay);
+        }
+        removeComponent(target);
+        mDepthPrepassValid = false;
+    }
+
+    void OverlayComponentManager::invalidate()
+    {
+        std::lock_guard lock(mMutex);
+        mDepthPrepassValid = false;
+    }
+
+    bool OverlayComponentManager::isDepthPrepassValid()
+    {
+        bool valid = mDepthPrepassValid;
+
+        const auto &camera = mView->getCamera();
+        auto viewMatrix = camera.getViewMatrix();
+        auto projectionMatrix = camera.getProjectionMatrix();
+        const auto &viewport = mView->getViewport();
+        if (!unchanged(viewMatrix, mDepthPrepassViewMatrix) ||
+            !unchanged(projectionMatrix, mDepthPrepassProjectionMatrix) ||
+            viewport != mDepthPrepassViewport)
+        {
+            mDepthPrepassViewMatrix = viewMatrix;
+            mDepthPrepassProjectionMatrix = projectionMatrix;
+            mDepthPrepassViewport = viewport;
+            valid = false;
+        }
+
+        // every transform is checked (rather than stopping at the first
+        // change) so they're all up to date for the next frame
+        auto &tm = mEngine->getTransformManager();
+        for (auto it = begin(); it < end(); it++)
+        {
+            for (auto &overlay : elementAt<1>(it))
+            {
+                const auto &worldTransform = tm.getWorldTransform(tm.getInstance(overlay.depth));
+                if (!unchanged(worldTransform, overlay.worldTransform))
+                {
+                    overlay.worldTransform = worldTransform;
+                    valid = false;
+                }
+                // skinned renderables can change shape without their transform changing
+                if (overlay.skinInstance)
+                {
+                    valid = false;
+                }
+            }
+        }
+        return valid;
+    }
+
+    void OverlayComponentManager::update()
+    {
+        TRACE_SCOPE("OverlayComponentManager::update");
+        std::lock_guard lock(mMutex);
+
+        if (!mView || !mScene || !mRenderTarget || getComponentCount() == 0)
+        {
+            return;
+        }
+
+        // the overlay views follow the main view
+        auto &camera = mView->getCamera();
+        const auto &viewport = mView->getViewport();
+        mDepthView->setCamera(&camera);
+        mDepthView->setViewport(viewport);
+        mOutlineView->setCamera(&camera);
+        mOutlineView->setViewport(viewport);
+        mOutlineView->setRenderTarget(mView->getRenderTarget());
+
+        if (!isDepthPrepassValid())
+        {
+            TRACE_SCOPE("OverlayComponentManager::depthPrepass");
+            mRenderer->render(mDepthView);
+            mDepthPrepassValid = true;
+        }
+
+        mRenderer->render(mOutlineView);
+    }
+
+}
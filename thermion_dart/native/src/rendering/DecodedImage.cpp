@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cmath>
+
+#include <filament/Texture.h>
+#include <filament/backend/PixelBufferDescriptor.h>
+
+#include <filament/third_party/stb/stb_image.h>
+
+#include "rendering/DecodedImage.hpp"
+
+#include "Log.hpp"
+#include "TraceRecorder.hpp"
+
+namespace thermion
+{
+
+    using namespace filament;
+
+    std::unique_ptr<DecodedImage> DecodedImage::decode(const uint8_t *data, size_t length)
+    {
+        TRACE_SCOPE("DecodedImage::decode");
+        int width, height, channels;
+        // always expanded to RGBA, since there are no 8-bit sRGB formats without alpha
+        auto *pixels = stbi_load_from_memory(data, static_cast<int>(length), &width, &height, &channels, 4);
+        if (!pixels)
+        {
+            Log("Failed to decode image: %s", stbi_failure_reason());
+            return std::nullptr_t();
+        }
+        TRACE("Decoded %dx%d image (%d channels)", width, height, channels);
+        return std::unique_ptr<DecodedImage>(new DecodedImage(pixels, width, height));
+    }
+
+    DecodedImage::~DecodedImage()
+    {
+        if (mPixels)
+        {
+            stbi_image_free(mPixels);
+        }
+    }
+
+    Texture *DecodedImage::createTexture(Engine &engine, bool sRGB, bool generateMipmaps)
+    {
+        TRACE_SCOPE("DecodedImage::createTexture");
+        if (!mPixels)
+        {
+            Log("Image has already been uploaded");
+            return std::nullptr_t();
+        }
+
+        const auto format = sRGB ? Texture::InternalFormat::SRGB8_A8 : Texture::InternalFormat::RGBA8;
+        if (generateMipmaps && !Texture::isTextureFormatMipmappable(engine, format))
+        {
+            Log("Texture format %d is not mipmappable, mipmaps will not be generated", static_cast<int>(format));
+            generateMipmaps = false;
+        }
+
+        uint8_t levels = 1;
+        auto usage = Texture::Usage::DEFAULT;
+        if (generateMipmaps)
+        {
+            levels = static_cast<uint8_t>(std::ilogb(std::max(mWidth, mHeight)) + 1);
+            usage |= Texture::Usage::BLIT_SRC | Texture::Usage::BLIT_DST;
+        }
+
+        auto *texture = Texture::Builder()
+                            .width(mWidth)
+                            .height(mHeight)
+                            .levels(levels)
+                            .sampler(Texture::Sampler::SAMPLER_2D)
+                            .format(format)
+                            .usage(usage)
+                            .build(engine);
+        if (!texture)
+        {
+            Log("Failed to create %dx%d texture", mWidth, mHeight);
+            return std::nullptr_t();
+        }
+
+        const size_t size = size_t(mWidth) * mHeight * 4;
+        Texture::PixelBufferDescriptor buffer(
+            mPixels,
+            size,
+            Texture::Format::RGBA,
+            Texture::Type::UBYTE,
+            [](void *pixels, size_t, void *)
+            { stbi_image_free(pixels); });
+        mPixels = nullptr;
+
+        texture->setImage(engine, 0, std::move(buffer));
+        if (generateMipmaps)
+        {
+            texture->generateMipmaps(engine);
+        }
+        return texture;
+    }
+
+} // namespace thermion
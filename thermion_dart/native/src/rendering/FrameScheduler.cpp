@@ -0,0 +1,177 @@
+#include "rendering/FrameScheduler.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Log.hpp"
+
+namespace thermion {
+
+void FrameScheduler::setTargetFrameInterval(uint64_t intervalInNanos)
+{
+    mTargetInterval = intervalInNanos;
+    TRACE("Set target frame interval to %.3f ms", intervalInNanos / 1e6f);
+}
+
+void FrameScheduler::onVsync(uint64_t vsyncTimeInNanos)
+{
+    if (vsyncTimeInNanos == 0)
+    {
+        mLastVsync = 0;
+        mVsyncPeriod = 0;
+        return;
+    }
+    auto lastVsync = mLastVsync.exchange(vsyncTimeInNanos);
+    if (lastVsync != 0 && vsyncTimeInNanos > lastVsync)
+    {
+        // vsync callbacks can themselves be skipped, so only use deltas
+        // that are plausibly a single period to refine the estimate
+        auto delta = vsyncTimeInNanos - lastVsync;
+        auto period = mVsyncPeriod.load();
+        if (period == 0 || delta < period * 3 / 2)
+        {
+            mVsyncPeriod = period == 0 ? delta : (period * 7 + delta) / 8;
+        }
+    }
+}
+
+void FrameScheduler::onFrameRequested(bool coalesced)
+{
+    if (coalesced)
+    {
+        mCoalescedRequests++;
+    }
+    uint64_t expected = 0;
+    mPendingSince.compare_exchange_strong(expected, now());
+}
+
+void FrameScheduler::cancelFrameRequest()
+{
+    mPendingSince = 0;
+}
+
+uint64_t FrameScheduler::getFrameInterval()
+{
+    auto target = mTargetInterval.load();
+    if (mLastVsync == 0)
+    {
+        return target;
+    }
+    auto period = mVsyncPeriod.load();
+    if (period == 0)
+    {
+        return target;
+    }
+    // render every Nth vsync where N is the smallest value that satisfies the target interval
+    auto numPeriods = std::max<uint64_t>(1, (target + period / 2) / period);
+    return numPeriods * period;
+}
+
+uint64_t FrameScheduler::getSlotTime(uint64_t time)
+{
+    auto interval = getFrameInterval();
+    if (interval == 0)
+    {
+        return time;
+    }
+    auto anchor = mLastVsync.load();
+    if (anchor == 0 || time < anchor)
+    {
+        return time - (time % interval);
+    }
+    return anchor + ((time - anchor) / interval) * interval;
+}
+
+uint64_t FrameScheduler::getNextFrameTime()
+{
+    auto interval = getFrameInterval();
+    if (interval == 0)
+    {
+        return mLastFrameSkipped ? mLastFrameBegin + kSkippedFrameRetryIntervalInNanos : 0;
+    }
+    if (getSlotTime(now()) > mLastSlot)
+    {
+        // the current slot hasn't been used yet
+        return 0;
+    }
+    return getSlotTime(mLastSlot) + interval;
+}
+
+uint64_t FrameScheduler::beginFrame(uint64_t now)
+{
+    mLastFrameBegin = now;
+
+    auto interval = getFrameInterval();
+    auto pendingSince = mPendingSince.load();
+    if (pendingSince == 0 || pendingSince > now)
+    {
+        // render() was called directly rather than via a frame request
+        pendingSince = now;
+    }
+
+    if (interval == 0)
+    {
+        mCurrentSlot = now;
+        mLastLateness = now - pendingSince;
+        return now;
+    }
+
+    mCurrentSlot = getSlotTime(now);
+
+    // slots that passed without a frame between the first slot this
+    // request could have been rendered in, and now
+    auto firstEligibleSlot = getSlotTime(pendingSince);
+    if (firstEligibleSlot <= mLastSlot)
+    {
+        firstEligibleSlot = getSlotTime(mLastSlot) + interval;
+    }
+    if (mCurrentSlot > firstEligibleSlot)
+    {
+        mDroppedFrames += (mCurrentSlot - firstEligibleSlot) / interval;
+    }
+
+    // how long after the slot (or the request, if it arrived mid-slot) we actually started
+    auto lateness = now - std::max(mCurrentSlot, pendingSince);
+    mLastLateness = lateness;
+    if (lateness > mMaxLateness)
+    {
+        mMaxLateness = lateness;
+    }
+    if (lateness > interval / 2)
+    {
+        mLateFrames++;
+    }
+
+    return mCurrentSlot;
+}
+
+void FrameScheduler::endFrame(bool rendered)
+{
+    mLastSlot = mCurrentSlot;
+    mLastFrameSkipped = !rendered;
+    if (rendered)
+    {
+        mFramesRendered++;
+        mPendingSince = 0;
+    }
+    else
+    {
+        mSkippedFrames++;
+    }
+}
+
+FrameSchedulerStats FrameScheduler::getStats()
+{
+    FrameSchedulerStats stats;
+    stats.framesRendered = mFramesRendered;
+    stats.lateFrames = mLateFrames;
+    stats.droppedFrames = mDroppedFrames;
+    stats.skippedFrames = mSkippedFrames;
+    stats.coalescedRequests = mCoalescedRequests;
+    stats.frameIntervalInNanos = getFrameInterval();
+    stats.lastLatenessInNanos = mLastLateness;
+    stats.maxLatenessInNanos = mMaxLateness;
+    return stats;
+}
+
+} // namespace thermion
@@ -0,0 +1,39 @@
+#include "rendering/FrameStats.hpp"
+
+#include <algorithm>
+
+namespace thermion
+{
+
+void FrameStats::addTaskTime(uint64_t durationInNanos, uint32_t numTasks)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingTaskTimeInNanos += durationInNanos;
+    mPendingTasks += numTasks;
+}
+
+void FrameStats::record(FrameTiming &timing)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    timing.frameIndex = mNumRecorded;
+    timing.taskDrainTimeInNanos = mPendingTaskTimeInNanos;
+    timing.tasksExecuted = mPendingTasks;
+    mPendingTaskTimeInNanos = 0;
+    mPendingTasks = 0;
+    mRecords[mNumRecorded % kCapacity] = timing;
+    mNumRecorded++;
+}
+
+uint32_t FrameStats::getRecords(FrameTiming *out, uint32_t maxRecords)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto numRecords = static_cast<uint32_t>(std::min<uint64_t>({mNumRecorded, kCapacity, maxRecords}));
+    auto first = mNumRecorded - numRecords;
+    for (uint32_t i = 0; i < numRecords; i++)
+    {
+        out[i] = mRecords[(first + i) % kCapacity];
+    }
+    return numRecords;
+}
+
+} // namespace thermion
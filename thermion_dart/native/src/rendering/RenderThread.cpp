@@ -6,6 +6,7 @@
 #include <chrono>
 
 #include "Log.hpp"
+#include "TraceRecorder.hpp"
 
 namespace thermion {
 
@@ -48,6 +49,7 @@ static void mainLoop(void* arg) {
 }
 
 static void *startHelper(void * parm) {
+    TraceRecorder::setThreadName("RenderThread");
     loopStart = std::chrono::high_resolution_clock::now();
     emscripten_set_main_loop_arg(&mainLoop, parm, 0, true);
     return nullptr;
@@ -72,6 +74,7 @@ RenderThread::RenderThread()
     pthread_create(&t, &attr, startHelper, this);
     #else
     t = new std::thread([this]() { 
+        TraceRecorder::setThreadName("RenderThread");
         while (!mStop) {
             iter();
             mRendered = false;
@@ -84,17 +87,18 @@ RenderThread::RenderThread()
 
 RenderThread::~RenderThread()
 {
-    Log("Destroying RenderThread (%d tasks remaining)", _tasks.size());
-    mStop = true;
+    Log("Destroying RenderThread");
+    if (auto *renderTicker = mRenderTicker.load())
+    {
+        renderTicker->setOnRenderableAdded(nullptr);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_taskMutex);
+        mStop = true;
+    }
     _cv.notify_one();
     TRACE("Joining RenderThread thread..");    
     
-    while (!_tasks.empty())
-    {
-        auto task = std::move(_tasks.front());
-        _tasks.pop_front();
-        task();
-    }
     #ifdef __EMSCRIPTEN__
     pthread_join(t, NULL);
     #else
@@ -102,63 +106,264 @@ RenderThread::~RenderThread()
     delete t;
     #endif
 
+    // the render thread has exited, so it's safe to consume from this thread
+    while (drainTasks() > 0)
+    {
+    }
+
     TRACE("RenderThread destructor complete");    
 }
 
+void RenderThread::setRenderTicker(RenderTicker *renderTicker)
+{
+    {
+        std::lock_guard<std::mutex> lock(_taskMutex);
+        auto *previous = mRenderTicker.exchange(renderTicker);
+        if (previous && previous != renderTicker)
+        {
+            previous->setOnRenderableAdded(nullptr);
+        }
+        if (renderTicker)
+        {
+            renderTicker->setOnRenderableAdded([this]()
+                                               { onRenderableAdded(); });
+        }
+    }
+    #ifndef __EMSCRIPTEN__
+    _cv.notify_one();
+    #endif
+}
+
+void RenderThread::onRenderableAdded()
+{
+    bool pending;
+    {
+        std::lock_guard<std::mutex> lock(_taskMutex);
+        pending = mRender;
+    }
+    if (pending)
+    {
+        // the request was waiting for something to render into, so it
+        // becomes due now rather than when it was originally made
+        auto &frameScheduler = mRenderTicker.load()->getFrameScheduler();
+        frameScheduler.cancelFrameRequest();
+        frameScheduler.onFrameRequested(false);
+    }
+    #ifndef __EMSCRIPTEN__
+    _cv.notify_one();
+    #endif
+}
+
 void RenderThread::requestFrame()
 {
     if(mRendered) {
         return;
     }
-    if(mRender) {
-        TRACE("Warning - frame requested before previous frame has completed rendering");
+    bool coalesced;
+    {
+        std::lock_guard<std::mutex> lock(_taskMutex);
+        coalesced = mRender;
+        if(coalesced) {
+            TRACE("Warning - frame requested before previous frame has completed rendering");
+        }
+        mRender = true;
+    }
+    if(mRenderTicker) {
+        mRenderTicker.load()->getFrameScheduler().onFrameRequested(coalesced);
     }
-    mRender = true;
     #ifndef __EMSCRIPTEN__
     _cv.notify_one();
     #endif
 }
 
-void RenderThread::iter()
+RenderThreadStats RenderThread::getStats()
+{
+    RenderThreadStats stats;
+    stats.idleTimeInNanos = _idleTimeInNanos;
+    stats.busyTimeInNanos = _busyTimeInNanos;
+    stats.wakeups = _wakeups;
+    stats.tasksExecuted = _tasksExecuted;
+    stats.framesRendered = _framesRendered;
+    stats.fps = _fps;
+    return stats;
+}
+
+void RenderThread::push(Task &task)
+{
+    if (_overflowing || !_tasks.push(task))
+    {
+        std::lock_guard<std::mutex> lock(_taskMutex);
+        if (_overflowing || !_tasks.push(task))
+        {
+            _overflowing = true;
+            _overflow.push_back(std::move(task));
+        }
+    }
+
+    #ifndef __EMSCRIPTEN__
+    // _sleeping is only set (under _taskMutex) immediately before the render
+    // thread checks hasPendingWork() and blocks. Acquiring the mutex here
+    // guarantees we either notify after it has started waiting, or it sees
+    // this task when checking the predicate.
+    if (_sleeping)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_taskMutex);
+        }
+        _cv.notify_one();
+    }
+    #endif
+}
+
+// must be called on the render thread
+uint32_t RenderThread::drainTasks()
 {
-    if (mRender && !mRendered)
+    uint32_t numExecuted = 0;
+    Task task;
+
+    // cap the batch so producers can't starve rendering
+    while (numExecuted < kTaskQueueCapacity && _tasks.pop(task))
     {
-        if(mRenderTicker->render(0)) {
-            mRender = false;
-            mRendered = true;
-        
-            // Calculate and print FPS
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - _lastFrameTime).count();
-            _lastFrameTime = currentTime;
-
-            _frameCount++;
-            _accumulatedTime += deltaTime;
-
-            if (_accumulatedTime >= 1.0f) // Update FPS every second
+        task();
+        task.reset();
+        numExecuted++;
+    }
+
+    if (_overflowing)
+    {
+        std::deque<Task> pending;
+        {
+            std::lock_guard<std::mutex> lock(_taskMutex);
+            // anything still in the ring buffer was enqueued before the overflow
+            while (_tasks.pop(task))
+            {
+                pending.push_back(std::move(task));
+            }
+            for (auto &overflowed : _overflow)
             {
-                _fps = _frameCount / _accumulatedTime;
-                _frameCount = 0;
-                _accumulatedTime = 0.0f;
+                pending.push_back(std::move(overflowed));
             }
+            _overflow.clear();
+            _overflowing = false;
+        }
+        for (auto &pendingTask : pending)
+        {
+            pendingTask();
+            numExecuted++;
         }
     }
-    
-    std::unique_lock<std::mutex> taskLock(_taskMutex);
 
-    if (!_tasks.empty())
+    _tasksExecuted += numExecuted;
+    return numExecuted;
+}
+
+// a request made while there is no renderable swapchain isn't pending
+// until one is added (see onRenderableAdded), so it isn't retried
+bool RenderThread::isFramePending()
+{
+    auto *renderTicker = mRenderTicker.load();
+    return mRender && !mRendered && renderTicker && renderTicker->hasRenderable();
+}
+
+// returns the (steady_clock) time at which the pending frame should be
+// rendered, or 0 if it should be rendered immediately
+uint64_t RenderThread::getNextFrameTime()
+{
+    auto nextFrameTime = mRenderTicker.load()->getFrameScheduler().getNextFrameTime();
+    if (nextFrameTime <= FrameScheduler::now())
     {
-        auto task = std::move(_tasks.front());
-        _tasks.pop_front();
-        taskLock.unlock();
-        task();
-        taskLock.lock();
+        return 0;
+    }
+    return nextFrameTime;
+}
+
+// must be called on the render thread with _taskMutex held
+bool RenderThread::hasPendingWork()
+{
+    return !_tasks.empty() || _overflowing || mStop || (isFramePending() && getNextFrameTime() == 0);
+}
+
+void RenderThread::render()
+{
+    if (!isFramePending() || getNextFrameTime() != 0)
+    {
+        return;
     }
+
+    // cleared before rendering so that any request made while this frame
+    // is rendering will trigger another frame
+    mRender = false;
+
+    if(mRenderTicker.load()->render(0)) {
+        mRendered = true;
+        _framesRendered++;
+
+        // Calculate FPS
+        auto currentTime = std::chrono::high_resolution_clock::now();
+        float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - _lastFrameTime).count();
+        _lastFrameTime = currentTime;
+
+        _frameCount++;
+        _accumulatedTime += deltaTime;
+
+        if (_accumulatedTime >= 1.0f) // Update FPS every second
+        {
+            _fps = _frameCount / _accumulatedTime;
+            _frameCount = 0;
+            _accumulatedTime = 0.0f;
+        }
+    } else {
+        // either beginFrame skipped the frame (and the frame scheduler
+        // determines when this will be retried), or the last swapchain was
+        // removed (and this waits until one is added)
+        mRender = true;
+    }
+}
+
+void RenderThread::iter()
+{
     #ifndef __EMSCRIPTEN__
-    _cv.wait_for(taskLock, std::chrono::microseconds(2000), [this]
-                { return !_tasks.empty() || mStop; });
+    {
+        std::unique_lock<std::mutex> taskLock(_taskMutex);
+
+        if (!hasPendingWork())
+        {
+            auto idleStart = std::chrono::high_resolution_clock::now();
+            _sleeping = true;
+            if (isFramePending())
+            {
+                // a frame is outstanding but isn't due yet, so only sleep until
+                // then (or until a task/new request wakes us up)
+                auto nextFrameTime = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(getNextFrameTime()));
+                _cv.wait_until(taskLock, nextFrameTime, [this]
+                            { return hasPendingWork(); });
+            }
+            else
+            {
+                _cv.wait(taskLock, [this]
+                        { return hasPendingWork(); });
+            }
+            _sleeping = false;
+            _idleTimeInNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - idleStart).count();
+            _wakeups++;
+        }
+    }
     #endif
 
+    TRACE_SCOPE("RenderThread::iter");
+    auto busyStart = std::chrono::high_resolution_clock::now();
+
+    auto numTasks = drainTasks();
+    auto *renderTicker = mRenderTicker.load();
+    if (numTasks > 0 && renderTicker)
+    {
+        auto drainTimeInNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - busyStart).count();
+        renderTicker->getFrameStats().addTaskTime(drainTimeInNanos, numTasks);
+    }
+
+    render();
+
+    _busyTimeInNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - busyStart).count();
 }
 
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <stack>
 #include <unordered_set>
@@ -65,12 +66,10 @@ namespace thermion
         }
         morphAnimation.durationInSecs = (frameLengthInMs * numFrames) / 1000.0f;
 
-        morphAnimation.start = high_resolution_clock::now();
+        morphAnimation.startInNanos = _timeInNanos;
         morphAnimation.lengthInFrames = numFrames;
 
-        morphAnimations.emplace_back(morphAnimation);
-
-        auto& foo = morphAnimations[morphAnimations.size() - 1];
+        morphAnimations.emplace_back(std::move(morphAnimation));
 
         return true;
     }
@@ -270,55 +269,38 @@ namespace thermion
     {
         std::lock_guard lock(_mutex);
 
-        BoneAnimation animation;
-        animation.boneIndex = boneIndex;
-        animation.frameData.clear();
+        if (!_boneAnimationComponentManager->hasComponent(instance->getInstance()->getRoot()))
+        {
+            Log("ERROR: specified entity is not animatable (has no animation component attached).");
+            return false;
+        }
 
-        const auto &inverseBindMatrix = instance->getInstance()->getInverseBindMatricesAt(skinIndex)[boneIndex];
-        for (int i = 0; i < numFrames; i++)
+        if (skinIndex >= instance->getInstance()->getSkinCount() || boneIndex >= instance->getInstance()->getJointCountAt(skinIndex))
         {
-            math::mat4f frame(
-                frameData[i * 16],
-                frameData[(i * 16) + 1],
-                frameData[(i * 16) + 2],
-                frameData[(i * 16) + 3],
-                frameData[(i * 16) + 4],
-                frameData[(i * 16) + 5],
-                frameData[(i * 16) + 6],
-                frameData[(i * 16) + 7],
-                frameData[(i * 16) + 8],
-                frameData[(i * 16) + 9],
-                frameData[(i * 16) + 10],
-                frameData[(i * 16) + 11],
-                frameData[(i * 16) + 12],
-                frameData[(i * 16) + 13],
-                frameData[(i * 16) + 14],
-                frameData[(i * 16) + 15]);
-
-            animation.frameData.push_back(frame);
+            Log("ERROR: bone index %d is out of range for skin %d", boneIndex, skinIndex);
+            return false;
         }
 
+        BoneAnimation animation;
+        animation.boneIndex = boneIndex;
+        animation.joint = instance->getInstance()->getJointsAt(skinIndex)[boneIndex];
+        // frames are decomposed into translation/rotation/scale once here,
+        // rather than every time the animation is sampled
+        animation.keys.set(reinterpret_cast<const math::mat4f *>(frameData), numFrames);
+
         animation.frameLengthInMs = frameLengthInMs;
-        animation.start = std::chrono::high_resolution_clock::now();
+        animation.startInNanos = _timeInNanos;
         animation.reverse = false;
         animation.durationInSecs = (frameLengthInMs * numFrames) / 1000.0f;
         animation.lengthInFrames = numFrames;
-        animation.frameLengthInMs = frameLengthInMs;
         animation.fadeOutInSecs = fadeOutInSecs;
         animation.fadeInInSecs = fadeInInSecs;
         animation.maxDelta = maxDelta;
         animation.skinIndex = skinIndex;
-        if (!_boneAnimationComponentManager->hasComponent(instance->getInstance()->getRoot()))
-        {
-            Log("ERROR: specified entity is not animatable (has no animation component attached).");
-            return false;
-        }
-        auto animationComponentInstance = _boneAnimationComponentManager->getInstance(instance->getInstance()->getRoot());
 
+        auto animationComponentInstance = _boneAnimationComponentManager->getInstance(instance->getInstance()->getRoot());
         auto &animationComponent = _boneAnimationComponentManager->elementAt<0>(animationComponentInstance);
-        // auto &boneAnimations = animationComponent.boneAnimations;
-
-        // boneAnimations.emplace_back(animation);
+        animationComponent.animations.emplace_back(std::move(animation));
 
         return true;
     }
@@ -333,7 +315,7 @@ namespace thermion
             return;
         }
 
-        _gltfAnimationComponentManager->addGltfAnimation(instance->getInstance(), index, loop, reverse, replaceActive, crossfade, startOffset);
+        _gltfAnimationComponentManager->addGltfAnimation(instance->getInstance(), index, loop, reverse, replaceActive, crossfade, startOffset, _timeInNanos);
     }
 
     void AnimationManager::stopGltfAnimation(GltfSceneAssetInstance *instance, int index)
@@ -361,6 +343,22 @@ namespace thermion
             renderableInstance,
             weights,
             count);
+        _morphAnimationComponentManager->setWeights(entity, weights, count);
+    }
+
+    int AnimationManager::getMorphTargetWeights(utils::Entity entity, float *out, int maxCount)
+    {
+        std::lock_guard lock(_mutex);
+        if (!_morphAnimationComponentManager->hasComponent(entity) || maxCount <= 0)
+        {
+            return 0;
+        }
+        const auto &weights = _morphAnimationComponentManager->elementAt<0>(
+                                                                 _morphAnimationComponentManager->getInstance(entity))
+                                  .weights;
+        auto count = std::min(weights.size(), static_cast<size_t>(maxCount));
+        std::copy(weights.begin(), weights.begin() + count, out);
+        return static_cast<int>(count);
     }
 
     void AnimationManager::setGltfAnimationFrame(GltfSceneAssetInstance *instance, int animationIndex, int animationFrame)
@@ -418,9 +416,81 @@ namespace thermion
     void AnimationManager::update(uint64_t frameTimeInNanos)
     {
         std::lock_guard lock(_mutex);
-        _gltfAnimationComponentManager->update();
-        _morphAnimationComponentManager->update();
-        _boneAnimationComponentManager->update();
+
+        _previousTimeInNanos = _timeInNanos;
+        if (_fixedTimeStepInNanos > 0)
+        {
+            _timeInNanos += _fixedTimeStepInNanos;
+        }
+        else
+        {
+            if (frameTimeInNanos == 0)
+            {
+                frameTimeInNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now().time_since_epoch())
+                                       .count();
+            }
+            // only the delta is used, so the clock never runs backwards (and
+            // doesn't jump when switching back from a fixed time step)
+            if (_lastFrameTimeInNanos != 0 && frameTimeInNanos > _lastFrameTimeInNanos)
+            {
+                _timeInNanos += frameTimeInNanos - _lastFrameTimeInNanos;
+            }
+            _lastFrameTimeInNanos = frameTimeInNanos;
+        }
+
+        if (!_gltfAnimationComponentManager->empty() || !_boneAnimationComponentManager->empty())
+        {
+            // glTF/bone animations only write the local transforms of each instance's
+            // own nodes, so components can be updated in parallel while a transaction
+            // is open. World transforms are then recomputed once on commit.
+            auto &transformManager = _engine->getTransformManager();
+            auto *jobSystem = _parallelUpdate ? &_engine->getJobSystem() : nullptr;
+
+            _dirtyAnimators.clear();
+            transformManager.openLocalTransformTransaction();
+            _gltfAnimationComponentManager->update(_timeInNanos, jobSystem, _dirtyAnimators);
+            _boneAnimationComponentManager->update(_timeInNanos, jobSystem, _dirtyAnimators);
+            transformManager.commitLocalTransformTransaction();
+
+            // setBones issues driver commands, so this must stay on the calling thread
+            std::sort(_dirtyAnimators.begin(), _dirtyAnimators.end());
+            _dirtyAnimators.erase(std::unique(_dirtyAnimators.begin(), _dirtyAnimators.end()), _dirtyAnimators.end());
+            for (auto *animator : _dirtyAnimators)
+            {
+                animator->updateBoneMatrices();
+            }
+        }
+
+        _morphAnimationComponentManager->update(_timeInNanos);
+    }
+
+    void AnimationManager::cancelFrame()
+    {
+        std::lock_guard lock(_mutex);
+        if (_fixedTimeStepInNanos > 0)
+        {
+            _timeInNanos = _previousTimeInNanos;
+        }
+    }
+
+    void AnimationManager::setFixedTimeStep(uint64_t stepInNanos)
+    {
+        std::lock_guard lock(_mutex);
+        _fixedTimeStepInNanos = stepInNanos;
+        _lastFrameTimeInNanos = 0;
+    }
+
+    uint64_t AnimationManager::getTime()
+    {
+        std::lock_guard lock(_mutex);
+        return _timeInNanos;
+    }
+
+    void AnimationManager::setParallelUpdate(bool parallelUpdate)
+    {
+        std::lock_guard lock(_mutex);
+        _parallelUpdate = parallelUpdate;
     }
 
     math::mat4f AnimationManager::getInverseBindMatrix(GltfSceneAssetInstance *instance, int skinIndex, int boneIndex)
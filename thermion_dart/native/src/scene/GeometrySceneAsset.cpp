@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 #include <gltfio/MaterialProvider.h>
@@ -12,6 +14,7 @@
 #include "Log.hpp"
 #include "scene/GeometrySceneAsset.hpp"
 #include "scene/GeometrySceneAssetBuilder.hpp"
+#include "scene/RayPicker.hpp"
 
 namespace thermion
 {
@@ -26,16 +29,30 @@ namespace thermion
         size_t materialInstanceCount,
         RenderableManager::PrimitiveType primitiveType,
         Box boundingBox,
-        GeometrySceneAsset *instanceOwner)
+        GeometrySceneAsset *instanceOwner,
+        const filament::math::mat4f &decodeTransform)
         : _engine(engine), 
         _vertexBuffer(vertexBuffer),
         _indexBuffer(indexBuffer),
         _primitiveType(primitiveType),
-        _instanceOwner(instanceOwner)
+        _instanceOwner(instanceOwner),
+        _decodeTransform(decodeTransform)
     {
         _materialInstances.insert(_materialInstances.begin(), materialInstances, materialInstances + materialInstanceCount);
 
         _entity = utils::EntityManager::get().create();
+        _renderable = _entity;
+
+        // quantized positions are decoded by the transform of a child renderable,
+        // so the asset's own transform is left to the caller
+        const math::mat4f identity;
+        if (std::memcmp(&decodeTransform, &identity, sizeof(identity)) != 0)
+        {
+            _renderable = utils::EntityManager::get().create();
+            auto &tm = _engine->getTransformManager();
+            tm.create(_entity);
+            tm.create(_renderable, tm.getInstance(_entity), decodeTransform);
+        }
 
         RenderableManager::Builder builder(1);
         builder.boundingBox(boundingBox)
@@ -51,13 +68,21 @@ namespace thermion
         {
             builder.material(i, materialInstances[i]);
         }
-        builder.build(*_engine, _entity);
+        builder.build(*_engine, _renderable);
     }
 
     GeometrySceneAsset::~GeometrySceneAsset()
     {
+        // these reference the vertex/index buffers, so must be destroyed first
+        _instancedAssets.clear();
         if (_engine)
         {
+            if (_renderable != _entity)
+            {
+                _engine->getRenderableManager().destroy(_renderable);
+                _engine->getTransformManager().destroy(_renderable);
+                utils::EntityManager::get().destroy(_renderable);
+            }
             if (_vertexBuffer && !isInstance())
                 _engine->destroy(_vertexBuffer);
             if (_indexBuffer && !isInstance())
@@ -87,7 +112,9 @@ namespace thermion
             materialInstanceCount,
             _primitiveType,
             filament::Box().set(_boundingBox.min, _boundingBox.max),
-            this);
+            this,
+            _decodeTransform);
+        instance->setPickingMesh(_pickingMesh);
         auto *raw = instance.get();
         _instances.push_back(std::move(instance));
         return raw;
@@ -98,6 +125,78 @@ namespace thermion
         auto it = std::remove_if(_instances.begin(), _instances.end(), [=](auto &sceneAsset)
                                  { return sceneAsset.get() == asset; });
         _instances.erase(it, _instances.end());
+        auto instancedIt = std::remove_if(_instancedAssets.begin(), _instancedAssets.end(), [=](auto &sceneAsset)
+                                          { return sceneAsset.get() == asset; });
+        _instancedAssets.erase(instancedIt, _instancedAssets.end());
+    }
+
+    bool GeometrySceneAsset::generateLods(size_t levelCount, float reduction, std::shared_ptr<const PickingMesh> triangles)
+    {
+        if (isInstance())
+        {
+            Log("Cannot generate levels of detail for an instance. Ensure you are calling generateLods with the original asset.");
+            return false;
+        }
+        if (_primitiveType != RenderableManager::PrimitiveType::TRIANGLES)
+        {
+            Log("Levels of detail are only supported for triangles");
+            return false;
+        }
+        if (!triangles)
+        {
+            triangles = _pickingMesh;
+        }
+        if (!triangles)
+        {
+            Log("Levels of detail require the triangles on the CPU. Ensure the asset is created as pickable.");
+            return false;
+        }
+        if (reduction <= 0.0f || reduction >= 1.0f)
+        {
+            Log("Invalid LOD reduction %f (must be between 0 and 1)", reduction);
+            return false;
+        }
+        _lodChain = std::make_shared<LodChain>(_engine, _vertexBuffer, _indexBuffer, _primitiveType, std::move(triangles),
+                                               _decodeTransform, levelCount, reduction);
+        return true;
+    }
+
+    InstancedGeometrySceneAsset *GeometrySceneAsset::createInstancedAsset(size_t instanceCount, MaterialInstance **materialInstances, size_t materialInstanceCount)
+    {
+        if (isInstance())
+        {
+            Log("Cannot create an instanced asset from an instance. Ensure you are calling createInstancedAsset with the original asset.");
+            return nullptr;
+        }
+
+        if (instanceCount == 0)
+        {
+            Log("ERROR: instanceCount must be greater than zero");
+            return nullptr;
+        }
+
+        if (materialInstanceCount == 0 && _materialInstances.size() > 0)
+        {
+            materialInstanceCount = _materialInstances.size();
+            materialInstances = _materialInstances.data();
+            TRACE("No material instances provided, re-using %d existing material instances", materialInstanceCount);
+        }
+
+        auto instanced = std::make_unique<InstancedGeometrySceneAsset>(
+            this,
+            _engine,
+            _vertexBuffer,
+            _indexBuffer,
+            materialInstances,
+            materialInstanceCount,
+            _primitiveType,
+            _boundingBox,
+            _pickingMesh,
+            instanceCount,
+            _decodeTransform);
+        auto *raw = instanced.get();
+        _instancedAssets.push_back(std::move(instanced));
+        return raw;
     }
 
 } // namespace thermion
\ No newline at end of file
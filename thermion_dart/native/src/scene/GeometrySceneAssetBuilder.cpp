@@ -1,3 +1,5 @@
+#include <cfloat>
+#include <type_traits>
 #include <memory>
 #include <vector>
 #include <filament/Engine.h>
@@ -7,26 +9,69 @@
 #include <filament/geometry/SurfaceOrientation.h>
 #include <filament/Box.h>
 #include <gltfio/MaterialProvider.h>
+#include <math/half.h>
+#include <math/norm.h>
 
 #include "scene/GeometrySceneAssetBuilder.hpp"
 #include "scene/GeometrySceneAsset.hpp"
+#include "scene/MeshOptimizer.hpp"
+#include "scene/RayPicker.hpp"
 #include "Log.hpp"
 
 namespace thermion
 {
+    namespace
+    {
+        // keeps the decode transform invertible for flat meshes
+        constexpr float kMinHalfExtent = 1e-6f;
+
+        template <typename T>
+        void deleteVector(void *, size_t, void *user)
+        {
+            delete static_cast<std::vector<T> *>(user);
+        }
+    }
+
     GeometrySceneAssetBuilder::GeometrySceneAssetBuilder(filament::Engine *engine) : mEngine(engine)
     {
     }
 
+    GeometrySceneAssetBuilder::~GeometrySceneAssetBuilder()
+    {
+        for (auto &stream : mStreams)
+        {
+            releaseStream(stream);
+        }
+        releaseStream(mIndices);
+    }
+
+    void GeometrySceneAssetBuilder::releaseStream(Stream &stream)
+    {
+        if (stream.release)
+        {
+            stream.release(const_cast<uint8_t *>(stream.data), stream.size, stream.user);
+        }
+        stream = Stream();
+    }
+
+    int32_t GeometrySceneAssetBuilder::addStream(const void *data, size_t size, uint32_t stride, ReleaseCallback release, void *user)
+    {
+        mStreams.push_back(Stream{static_cast<const uint8_t *>(data), size, stride, release, user});
+        return static_cast<int32_t>(mStreams.size() - 1);
+    }
+
+    template <typename T>
+    int32_t GeometrySceneAssetBuilder::copyStream(const T *data, size_t count, uint32_t stride)
+    {
+        auto *copy = new std::vector<T>(data, data + count);
+        return addStream(copy->data(), copy->size() * sizeof(T), stride, deleteVector<T>, copy);
+    }
+
     GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::vertices(const float *vertices, uint32_t count)
     {
         if (count > 0)
         {
-            mVertices->resize(count / 3);
-            for (int i = 0; i < mVertices->size(); i++)
-            {
-                mVertices->at(i) = filament::math::float3{vertices[(i * 3)], vertices[(i * 3) + 1], vertices[(i * 3) + 2]};
-            }
+            mPositions = {copyStream(vertices, count, sizeof(filament::math::float3)), 0, count / 3};
         }
         return *this;
     }
@@ -35,11 +80,7 @@ namespace thermion
     {
         if (count > 0)
         {
-            mNormals->resize(count / 3);
-            for (int i = 0; i < mNormals->size(); i++)
-            {
-                mNormals->at(i) = filament::math::float3{normals[i * 3], normals[(i * 3) + 1], normals[(i * 3) + 2]};
-            }
+            mNormals = {copyStream(normals, count, sizeof(filament::math::float3)), 0, count / 3};
         }
         return *this;
     }
@@ -48,28 +89,76 @@ namespace thermion
     {
         if (count > 0)
         {
-            mUVs->resize(count / 2);
-            for (int i = 0; i < mUVs->size(); i++)
-            {
-                mUVs->at(i) = filament::math::float2{uvs[i * 2], uvs[(i * 2) + 1]};
-            }
+            mUVs = {copyStream(uvs, count, sizeof(filament::math::float2)), 0, count / 2};
+        }
+        return *this;
+    }
+
+    GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::colors(const float *colors, uint32_t count)
+    {
+        if (count > 0)
+        {
+            mColors = {copyStream(colors, count, sizeof(filament::math::float4)), 0, count / 4};
         }
         return *this;
     }
 
+    GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::vertexData(const void *data, uint32_t vertexCount, uint32_t stride,
+                                                                     uint32_t positionOffset, int32_t normalOffset, int32_t uvOffset,
+                                                                     ReleaseCallback release, void *user)
+    {
+        auto stream = addStream(data, size_t(vertexCount) * stride, stride, release, user);
+        mPositions = {stream, positionOffset, vertexCount};
+        mNormals = normalOffset >= 0 ? Attribute{stream, uint32_t(normalOffset), vertexCount} : Attribute();
+        mUVs = uvOffset >= 0 ? Attribute{stream, uint32_t(uvOffset), vertexCount} : Attribute();
+        return *this;
+    }
+
+    void GeometrySceneAssetBuilder::setIndices(const void *data, uint32_t count, filament::IndexBuffer::IndexType type, ReleaseCallback release, void *user)
+    {
+        releaseStream(mIndices);
+        const uint32_t stride = type == filament::IndexBuffer::IndexType::UINT ? sizeof(uint32_t) : sizeof(uint16_t);
+        mIndices = Stream{static_cast<const uint8_t *>(data), size_t(count) * stride, stride, release, user};
+        mIndexCount = count;
+        mIndexType = type;
+    }
+
     GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::indices(const uint16_t *indices, uint32_t count)
     {
         if (count > 0)
         {
-            mIndices->resize(count);
-            for (int i = 0; i < mIndices->size(); i++)
-            {
-                mIndices->at(i) = indices[i];
-            }
+            auto *copy = new std::vector<uint16_t>(indices, indices + count);
+            setIndices(copy->data(), count, filament::IndexBuffer::IndexType::USHORT, deleteVector<uint16_t>, copy);
         }
         return *this;
     }
 
+    GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::indices(const uint32_t *indices, uint32_t count)
+    {
+        if (count > 0)
+        {
+            auto *copy = new std::vector<uint32_t>(indices, indices + count);
+            setIndices(copy->data(), count, filament::IndexBuffer::IndexType::UINT, deleteVector<uint32_t>, copy);
+        }
+        return *this;
+    }
+
+    GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::indexData(const void *data, uint32_t count, filament::IndexBuffer::IndexType type,
+                                                                    ReleaseCallback release, void *user)
+    {
+        setIndices(data, count, type, release, user);
+        return *this;
+    }
+
+    uint32_t GeometrySceneAssetBuilder::indexAt(size_t index) const
+    {
+        if (mIndexType == filament::IndexBuffer::IndexType::UINT)
+        {
+            return reinterpret_cast<const uint32_t *>(mIndices.data)[index];
+        }
+        return reinterpret_cast<const uint16_t *>(mIndices.data)[index];
+    }
+
     GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::materials(filament::MaterialInstance **materials, size_t materialInstanceCount)
     {
         mMaterialInstances = materials;
@@ -83,6 +172,31 @@ namespace thermion
         return *this;
     }
 
+    GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::vertexFormat(const VertexFormat &format)
+    {
+        mVertexFormat = format;
+        return *this;
+    }
+
+    GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::optimize(bool enabled)
+    {
+        mOptimize = enabled;
+        return *this;
+    }
+
+    GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::lods(size_t levelCount, float reduction)
+    {
+        mLodCount = levelCount;
+        mLodReduction = reduction;
+        return *this;
+    }
+
+    GeometrySceneAssetBuilder &GeometrySceneAssetBuilder::pickable(bool enabled)
+    {
+        mPickable = enabled;
+        return *this;
+    }
+
     std::unique_ptr<GeometrySceneAsset> GeometrySceneAssetBuilder::build()
     {
         Log("Starting build. Validating inputs...");
@@ -92,6 +206,56 @@ namespace thermion
             return nullptr;
         }
 
+        if (mOptimize)
+        {
+            if (mPrimitiveType == RenderableManager::PrimitiveType::TRIANGLES)
+            {
+                optimizeMesh();
+            }
+            else
+            {
+                Log("Mesh optimization is only supported for triangles, skipping");
+            }
+        }
+
+        // everything that reads the vertex/index data must happen before it's
+        // uploaded, since the buffers may be released at any time afterwards
+        mBoundingBox = computeBoundingBox();
+        TRACE("Computed bounding box: min={%f,%f,%f}, max={%f,%f,%f}",
+            mBoundingBox.getMin().x, mBoundingBox.getMin().y, mBoundingBox.getMin().z,
+            mBoundingBox.getMax().x, mBoundingBox.getMax().y, mBoundingBox.getMax().z);
+
+        // quantized positions are decoded by the renderable's transform, so its
+        // bounding box and picking mesh are in quantized space
+        const bool quantizedPositions = mVertexFormat.positions == PositionFormat::SHORT4;
+        filament::math::mat4f decodeTransform;
+        Box boundingBox = mBoundingBox;
+        if (quantizedPositions)
+        {
+            decodeTransform = filament::math::mat4f::translation(mBoundingBox.center) *
+                              filament::math::mat4f::scaling(max(mBoundingBox.halfExtent, filament::math::float3(kMinHalfExtent)));
+            boundingBox.set(encodePosition(mBoundingBox.getMin()), encodePosition(mBoundingBox.getMax()));
+        }
+
+        // levels of detail are simplified from the same triangles, so these are kept
+        // until the levels have been generated even if the asset isn't pickable
+        std::shared_ptr<PickingMesh> pickingMesh;
+        if (mPrimitiveType == RenderableManager::PrimitiveType::TRIANGLES && (mPickable || mLodCount > 1))
+        {
+            pickingMesh = std::make_shared<PickingMesh>();
+            pickingMesh->positions.resize(mPositions.count);
+            for (size_t i = 0; i < mPositions.count; i++)
+            {
+                const auto &position = at<filament::math::float3>(mPositions, i);
+                pickingMesh->positions[i] = quantizedPositions ? encodePosition(position) : position;
+            }
+            pickingMesh->indices.resize(mIndexCount);
+            for (size_t i = 0; i < mIndexCount; i++)
+            {
+                pickingMesh->indices[i] = indexAt(i);
+            }
+        }
+
         TRACE("Creating buffers...");
         auto [vertexBuffer, indexBuffer] = createBuffers();
         if (!vertexBuffer || !indexBuffer)
@@ -101,11 +265,6 @@ namespace thermion
         }
         TRACE("Buffers created successfully: VB=%p, IB=%p", vertexBuffer, indexBuffer);
 
-        Box boundingBox = computeBoundingBox();
-        TRACE("Computed bounding box: min={%f,%f,%f}, max={%f,%f,%f}",
-            boundingBox.getMin().x, boundingBox.getMin().y, boundingBox.getMin().z,
-            boundingBox.getMax().x, boundingBox.getMax().y, boundingBox.getMax().z);
-
         auto asset = std::make_unique<GeometrySceneAsset>(
             mEngine,
             vertexBuffer,
@@ -113,131 +272,330 @@ namespace thermion
             mMaterialInstances,
             mMaterialInstanceCount,
             mPrimitiveType,
-            boundingBox);
+            boundingBox,
+            std::nullptr_t(),
+            decodeTransform);
+        if (mPickable)
+        {
+            asset->setPickingMesh(pickingMesh);
+        }
+        if (mLodCount > 1)
+        {
+            asset->generateLods(mLodCount, mLodReduction, pickingMesh);
+        }
 
         TRACE("Asset created: %p", asset.get());
         return asset;
     }
 
-    Box GeometrySceneAssetBuilder::computeBoundingBox()
+    template <typename T>
+    std::vector<T> *GeometrySceneAssetBuilder::gather(const Attribute &attribute, const std::vector<uint32_t> &order) const
     {
-        float minX = FLT_MAX, minY = FLT_MAX, minZ = FLT_MAX;
-        float maxX = -FLT_MAX, maxY = -FLT_MAX, maxZ = -FLT_MAX;
-        Box box;
-        for (auto &vertex : *mVertices)
-        {
-            minX = std::min(vertex.x, minX);
-            minY = std::min(vertex.y, minY);
-            minZ = std::min(vertex.z, minZ);
-            maxX = std::max(vertex.x, maxX);
-            maxY = std::max(vertex.y, maxY);
-            maxZ = std::max(vertex.z, maxZ);
-        }
-        const filament::math::float3 min{minX, minY, minZ};
-        const filament::math::float3 max{maxX, maxY, maxZ};
-        box.set(min, max);
-        return box;
+        if (!attribute.isPresent())
+        {
+            return nullptr;
+        }
+        auto *gathered = new std::vector<T>(order.size());
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            (*gathered)[i] = at<T>(attribute, order[i]);
+        }
+        return gathered;
     }
 
-    std::pair<filament::VertexBuffer *, filament::IndexBuffer *> GeometrySceneAssetBuilder::createBuffers()
+    void GeometrySceneAssetBuilder::optimizeMesh()
     {
-        auto indexBuffer = IndexBuffer::Builder()
-                               .indexCount(mIndices->size())
-                               .bufferType(IndexBuffer::IndexType::USHORT)
-                               .build(*mEngine);
+        using namespace filament::math;
 
-        indexBuffer->setBuffer(*mEngine,
-                               IndexBuffer::BufferDescriptor(
-                                   mIndices->data(),
-                                   mIndices->size() * sizeof(uint16_t),
-                                   [](void *, size_t, void *data)
-                                   {
-                                       delete static_cast<std::vector<uint16_t> *>(data);
-                                   },
-                                   mIndices));
+        const size_t vertexCount = mPositions.count;
+        std::vector<uint32_t> indices(mIndexCount);
+        for (size_t i = 0; i < mIndexCount; i++)
+        {
+            indices[i] = indexAt(i);
+        }
+        mOptimizationReport.vertexCountBefore = mPositions.count;
+        mOptimizationReport.acmrBefore = MeshOptimizer::analyzeVertexCache(indices.data(), mIndexCount, vertexCount).acmr;
 
-        if (mUVs->empty())
+        // vertices are only merged if every attribute matches
+        std::vector<MeshOptimizer::VertexStream> streams;
+        auto addVertexStream = [&](const Attribute &attribute, size_t size)
+        {
+            if (attribute.isPresent())
+            {
+                const auto &stream = mStreams[attribute.stream];
+                streams.push_back({stream.data + attribute.offset, size, stream.stride});
+            }
+        };
+        addVertexStream(mPositions, sizeof(float3));
+        addVertexStream(mNormals, sizeof(float3));
+        addVertexStream(mUVs, sizeof(float2));
+        addVertexStream(mColors, sizeof(float4));
+
+        std::vector<uint32_t> remap(vertexCount);
+        const size_t uniqueCount = MeshOptimizer::deduplicateVertices(remap.data(), streams.data(), streams.size(), vertexCount);
+        std::vector<uint32_t> uniqueToOriginal(uniqueCount);
+        std::vector<float3> positions(uniqueCount);
+        for (uint32_t v = 0; v < vertexCount; v++)
         {
-            mUVs->resize(mVertices->size());
-            std::fill(mUVs->begin(), mUVs->end(), filament::math::float2{0.0f, 0.0f});
+            uniqueToOriginal[remap[v]] = v;
+            positions[remap[v]] = at<float3>(mPositions, v);
+        }
+        for (auto &index : indices)
+        {
+            index = remap[index];
         }
 
-        auto vertexBufferBuilder =
-            VertexBuffer::Builder()
-                .vertexCount(mVertices->size())
-                .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3)
-                .attribute(VertexAttribute::UV0, 1, VertexBuffer::AttributeType::FLOAT2)
-                .attribute(VertexAttribute::COLOR, 2, VertexBuffer::AttributeType::FLOAT4);
+        std::vector<uint32_t> optimized(mIndexCount);
+        MeshOptimizer::optimizeVertexCache(optimized.data(), indices.data(), mIndexCount, uniqueCount);
+        MeshOptimizer::optimizeOverdraw(indices.data(), optimized.data(), mIndexCount, positions.data(), sizeof(float3), uniqueCount);
 
-        if (mNormals->empty())
+        const size_t usedCount = MeshOptimizer::optimizeVertexFetch(remap.data(), indices.data(), mIndexCount, uniqueCount);
+        std::vector<uint32_t> order(usedCount);
+        for (uint32_t u = 0; u < uniqueCount; u++)
         {
-            vertexBufferBuilder = vertexBufferBuilder.bufferCount(3);
+            if (remap[u] != ~0u)
+            {
+                order[remap[u]] = uniqueToOriginal[u];
+            }
+        }
+        for (auto &index : indices)
+        {
+            index = remap[index];
+        }
+
+        // gather everything before releasing the original streams
+        auto *newPositions = gather<float3>(mPositions, order);
+        auto *newNormals = gather<float3>(mNormals, order);
+        auto *newUVs = gather<float2>(mUVs, order);
+        auto *newColors = gather<float4>(mColors, order);
+        for (auto &stream : mStreams)
+        {
+            releaseStream(stream);
+        }
+        mStreams.clear();
+
+        const uint32_t count = static_cast<uint32_t>(usedCount);
+        auto replace = [&](Attribute &attribute, auto *data)
+        {
+            using T = typename std::remove_pointer_t<decltype(data)>::value_type;
+            attribute = data ? Attribute{addStream(data->data(), data->size() * sizeof(T), sizeof(T), deleteVector<T>, data), 0, count} : Attribute();
+        };
+        replace(mPositions, newPositions);
+        replace(mNormals, newNormals);
+        replace(mUVs, newUVs);
+        replace(mColors, newColors);
+
+        mOptimizationReport.vertexCountAfter = count;
+        mOptimizationReport.acmrAfter = MeshOptimizer::analyzeVertexCache(indices.data(), mIndexCount, usedCount).acmr;
+
+        if (mIndexType == filament::IndexBuffer::IndexType::USHORT)
+        {
+            auto *copy = new std::vector<uint16_t>(indices.begin(), indices.end());
+            setIndices(copy->data(), mIndexCount, filament::IndexBuffer::IndexType::USHORT, deleteVector<uint16_t>, copy);
         }
         else
         {
-            vertexBufferBuilder.bufferCount(4)
-                .attribute(VertexAttribute::TANGENTS, 3, VertexBuffer::AttributeType::FLOAT4);
+            auto *copy = new std::vector<uint32_t>(std::move(indices));
+            setIndices(copy->data(), mIndexCount, filament::IndexBuffer::IndexType::UINT, deleteVector<uint32_t>, copy);
         }
 
-        auto vertexBuffer = vertexBufferBuilder.build(*mEngine);
+        Log("Optimized mesh: %d -> %d vertices, ACMR %f -> %f", mOptimizationReport.vertexCountBefore,
+            mOptimizationReport.vertexCountAfter, mOptimizationReport.acmrBefore, mOptimizationReport.acmrAfter);
+    }
 
-        vertexBuffer->setBufferAt(*mEngine, 0,
-                                  VertexBuffer::BufferDescriptor(
-                                      mVertices->data(), mVertices->size() * sizeof(filament::math::float3),
-                                      [](void *, size_t, void *) {
+    Box GeometrySceneAssetBuilder::computeBoundingBox()
+    {
+        filament::math::float3 boxMin{FLT_MAX};
+        filament::math::float3 boxMax{-FLT_MAX};
+        for (size_t i = 0; i < mPositions.count; i++)
+        {
+            const auto &vertex = at<filament::math::float3>(mPositions, i);
+            boxMin = min(boxMin, vertex);
+            boxMax = max(boxMax, vertex);
+        }
+        Box box;
+        box.set(boxMin, boxMax);
+        return box;
+    }
 
-                                      }));
+    filament::math::float3 GeometrySceneAssetBuilder::encodePosition(const filament::math::float3 &position) const
+    {
+        return (position - mBoundingBox.center) / max(mBoundingBox.halfExtent, filament::math::float3(kMinHalfExtent));
+    }
 
-        vertexBuffer->setBufferAt(*mEngine, 1,
-                                  VertexBuffer::BufferDescriptor(
-                                      mUVs->data(), mUVs->size() * sizeof(filament::math::float2),
-                                      [](void *, size_t, void *data) {
+    std::pair<filament::VertexBuffer *, filament::IndexBuffer *> GeometrySceneAssetBuilder::createBuffers()
+    {
+        using namespace filament::math;
 
-                                      },
-                                      mUVs));
+        const size_t vertexCount = mPositions.count;
 
-        auto dummyColors = new std::vector<filament::math::float4>(
-            mVertices->size(), filament::math::float4{1.0f, 1.0f, 1.0f, 1.0f});
-        vertexBuffer->setBufferAt(*mEngine, 2,
-                                  VertexBuffer::BufferDescriptor(
-                                      dummyColors->data(), dummyColors->size() * sizeof(math::float4),
-                                      [](void *, size_t, void *data)
-                                      {
-                                          delete static_cast<std::vector<math::float4> *>(data);
-                                      },
-                                      dummyColors));
-        if (mNormals->size() > 0)
+        // tangents are computed from the normals, so the normals themselves aren't uploaded
+        std::unique_ptr<geometry::SurfaceOrientation> orientation;
+        if (mNormals.isPresent())
         {
+            const auto &positions = mStreams[mPositions.stream];
+            const auto &normals = mStreams[mNormals.stream];
+            geometry::SurfaceOrientation::Builder builder;
+            builder.vertexCount(vertexCount);
+            builder.normals(reinterpret_cast<const float3 *>(normals.data + mNormals.offset), normals.stride);
+            builder.positions(reinterpret_cast<const float3 *>(positions.data + mPositions.offset), positions.stride);
+            builder.triangleCount(mIndexCount / 3);
+            if (mIndexType == IndexBuffer::IndexType::UINT)
+            {
+                builder.triangles(reinterpret_cast<const uint3 *>(mIndices.data));
+            }
+            else
+            {
+                builder.triangles(reinterpret_cast<const ushort3 *>(mIndices.data));
+            }
+            orientation.reset(builder.build());
+        }
 
-            std::vector<filament::math::ushort3> triangles;
+        // each buffer is either one of the streams (uploaded as-is, so interleaved
+        // attributes share a single buffer) or an attribute converted to a new
+        // (owned) buffer
+        std::vector<VertexBuffer::BufferDescriptor> buffers;
+        std::vector<int32_t> streamBuffers(mStreams.size(), -1);
+        auto vertexBufferBuilder = VertexBuffer::Builder();
+        vertexBufferBuilder.vertexCount(vertexCount);
 
-            for (uint32_t i = 0; i < mIndices->size(); i += 3)
+        auto addAttribute = [&](VertexAttribute attribute, const Attribute &source, VertexBuffer::AttributeType type)
+        {
+            auto &bufferIndex = streamBuffers[source.stream];
+            const auto &stream = mStreams[source.stream];
+            if (bufferIndex < 0)
             {
-                triangles.push_back({mIndices->at(i),
-                                     mIndices->at(i + 1),
-                                     mIndices->at(i + 2)});
+                bufferIndex = static_cast<int32_t>(buffers.size());
+                buffers.emplace_back(stream.data, vertexCount * stream.stride, stream.release, stream.user);
             }
+            vertexBufferBuilder.attribute(attribute, bufferIndex, type, source.offset, stream.stride);
+        };
 
-            geometry::SurfaceOrientation::Builder builder;
-            builder.vertexCount(mVertices->size());
-            builder.normals(mNormals->data());
-            builder.positions(mVertices->data());
-            builder.triangleCount(triangles.size());
-            builder.triangles(triangles.data());
-
-            auto orientation = builder.build();
-            auto quats = new std::vector<filament::math::quatf>(mVertices->size());
-            orientation->getQuats(quats->data(), mVertices->size());
-
-            vertexBuffer->setBufferAt(*mEngine, 3,
-                                      VertexBuffer::BufferDescriptor(
-                                          quats->data(), quats->size() * sizeof(math::quatf),
-                                          [](void *, size_t, void *data)
-                                          {
-                                              delete static_cast<std::vector<math::quatf> *>(data);
-                                          },
-                                          quats));
+        auto addConverted = [&](VertexAttribute attribute, VertexBuffer::AttributeType type, auto *converted, bool normalized)
+        {
+            using T = typename std::remove_pointer_t<decltype(converted)>::value_type;
+            vertexBufferBuilder.attribute(attribute, buffers.size(), type);
+            if (normalized)
+            {
+                vertexBufferBuilder.normalized(attribute);
+            }
+            buffers.emplace_back(converted->data(), converted->size() * sizeof(T), deleteVector<T>, converted);
+        };
+
+        switch (mVertexFormat.positions)
+        {
+        case PositionFormat::FLOAT3:
+            addAttribute(VertexAttribute::POSITION, mPositions, VertexBuffer::AttributeType::FLOAT3);
+            break;
+        case PositionFormat::HALF4:
+        {
+            auto *positions = new std::vector<half>(vertexCount * 4);
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                const auto &position = at<float3>(mPositions, i);
+                for (size_t j = 0; j < 3; j++)
+                {
+                    (*positions)[(i * 4) + j] = half(position[j]);
+                }
+                (*positions)[(i * 4) + 3] = half(1.0f);
+            }
+            addConverted(VertexAttribute::POSITION, VertexBuffer::AttributeType::HALF4, positions, false);
+            break;
         }
+        case PositionFormat::SHORT4:
+        {
+            auto *positions = new std::vector<short4>(vertexCount);
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                (*positions)[i] = packSnorm16(float4(encodePosition(at<float3>(mPositions, i)), 1.0f));
+            }
+            addConverted(VertexAttribute::POSITION, VertexBuffer::AttributeType::SHORT4, positions, true);
+            break;
+        }
+        }
+
+        if (mUVs.isPresent())
+        {
+            if (mVertexFormat.halfUVs)
+            {
+                auto *uvs = new std::vector<half>(vertexCount * 2);
+                for (size_t i = 0; i < vertexCount; i++)
+                {
+                    const auto &uv = at<float2>(mUVs, i);
+                    (*uvs)[i * 2] = half(uv.x);
+                    (*uvs)[(i * 2) + 1] = half(uv.y);
+                }
+                addConverted(VertexAttribute::UV0, VertexBuffer::AttributeType::HALF2, uvs, false);
+            }
+            else
+            {
+                addAttribute(VertexAttribute::UV0, mUVs, VertexBuffer::AttributeType::FLOAT2);
+            }
+        }
+
+        if (mColors.isPresent())
+        {
+            if (mVertexFormat.byteColors)
+            {
+                auto *colors = new std::vector<ubyte4>(vertexCount);
+                for (size_t i = 0; i < vertexCount; i++)
+                {
+                    (*colors)[i] = packUnorm8(at<float4>(mColors, i));
+                }
+                addConverted(VertexAttribute::COLOR, VertexBuffer::AttributeType::UBYTE4, colors, true);
+            }
+            else
+            {
+                addAttribute(VertexAttribute::COLOR, mColors, VertexBuffer::AttributeType::FLOAT4);
+            }
+        }
+
+        if (orientation)
+        {
+            if (mVertexFormat.shortTangents)
+            {
+                auto *quats = new std::vector<short4>(vertexCount);
+                orientation->getQuats(quats->data(), vertexCount);
+                addConverted(VertexAttribute::TANGENTS, VertexBuffer::AttributeType::SHORT4, quats, true);
+            }
+            else
+            {
+                auto *quats = new std::vector<quatf>(vertexCount);
+                orientation->getQuats(quats->data(), vertexCount);
+                addConverted(VertexAttribute::TANGENTS, VertexBuffer::AttributeType::FLOAT4, quats, false);
+            }
+        }
+
+        vertexBufferBuilder.bufferCount(buffers.size());
+        auto vertexBuffer = vertexBufferBuilder.build(*mEngine);
+
+        auto indexBuffer = IndexBuffer::Builder()
+                               .indexCount(mIndexCount)
+                               .bufferType(mIndexType)
+                               .build(*mEngine);
+
+        // the buffers are handed over to Filament, which releases them once uploaded;
+        // streams that were converted (or only used for tangents) are released now
+        for (size_t i = 0; i < mStreams.size(); i++)
+        {
+            if (streamBuffers[i] >= 0)
+            {
+                mStreams[i] = Stream();
+            }
+            else
+            {
+                releaseStream(mStreams[i]);
+            }
+        }
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            vertexBuffer->setBufferAt(*mEngine, i, std::move(buffers[i]));
+        }
+
+        indexBuffer->setBuffer(*mEngine,
+                               IndexBuffer::BufferDescriptor(
+                                   mIndices.data, mIndices.size, mIndices.release, mIndices.user));
+        mIndices = Stream();
 
         return {vertexBuffer, indexBuffer};
     }
@@ -249,37 +607,57 @@ namespace thermion
             Log("Validation failed: No engine");
             return false;
         }
-        if (mVertices->empty())
+        if (!mPositions.isPresent() || mPositions.count == 0)
         {
-            Log("Validation failed: No vertices (empty=%d, count=%d)", mVertices->empty(), mVertices->size());
+            Log("Validation failed: No vertices");
             return false;
         }
 
-        if (!mNormals->empty())
+        if (mNormals.isPresent() && mPrimitiveType != RenderableManager::PrimitiveType::TRIANGLES)
         {
-            assert(mPrimitiveType == RenderableManager::PrimitiveType::TRIANGLES);
+            Log("Validation failed: Normals are only supported for triangles");
+            return false;
         }
-        if (!mNormals->empty() && mNormals->size() != mVertices->size())
+        if (mNormals.isPresent() && mNormals.count != mPositions.count)
         {
-            Log("Validation failed: Normal count mismatch (normals=%d, vertices=%d)", mNormals->size(), mVertices->size());
+            Log("Validation failed: Normal count mismatch (normals=%d, vertices=%d)", mNormals.count, mPositions.count);
             return false;
         }
-        if (!mUVs->empty() && mUVs->size() != mVertices->size())
+        if (mUVs.isPresent() && mUVs.count != mPositions.count)
         {
-            Log("Validation failed: UV count mismatch (uvs=%d, vertices=%d)", mUVs->size(), mVertices->size());
+            Log("Validation failed: UV count mismatch (uvs=%d, vertices=%d)", mUVs.count, mPositions.count);
             return false;
         }
-        if (mIndices->empty())
+        if (mColors.isPresent() && mColors.count != mPositions.count)
         {
-            Log("Validation failed: No indices (empty=%d, count=%d)", mIndices->empty(), mIndices->size());
+            Log("Validation failed: Color count mismatch (colors=%d, vertices=%d)", mColors.count, mPositions.count);
             return false;
         }
+        if (!mIndices.data || mIndexCount == 0)
+        {
+            Log("Validation failed: No indices");
+            return false;
+        }
+        if (mIndexType == IndexBuffer::IndexType::USHORT && mPositions.count > 65536)
+        {
+            Log("Validation failed: %d vertices can't be addressed with 16-bit indices", mPositions.count);
+            return false;
+        }
+        for (size_t i = 0; i < mIndexCount; i++)
+        {
+            if (indexAt(i) >= mPositions.count)
+            {
+                Log("Validation failed: Index %d (%d) is out of range (vertices=%d)", i, indexAt(i), mPositions.count);
+                return false;
+            }
+        }
 
-        TRACE("Validation passed: vertices=%d, normals=%s, uvs=%d, indices=%d",
-            mVertices->size(),
-            (!mNormals->empty() ? "yes" : "no"),
-            mUVs->size(),
-            mIndices->size());
+        TRACE("Validation passed: vertices=%d, normals=%s, uvs=%d, indices=%d (%d-bit)",
+            mPositions.count,
+            (mNormals.isPresent() ? "yes" : "no"),
+            mUVs.count,
+            mIndexCount,
+            mIndexType == IndexBuffer::IndexType::UINT ? 32 : 16);
         return true;
     }
 
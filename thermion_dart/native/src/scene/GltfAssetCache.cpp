@@ -0,0 +1,325 @@
+#include <cstring>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <filament/TransformManager.h>
+
+#include "Log.hpp"
+#include "MappedFile.hpp"
+#include "TraceRecorder.hpp"
+#include "scene/GltfAssetCache.hpp"
+
+namespace thermion
+{
+
+    namespace
+    {
+        constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+        constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+        inline uint64_t rotl(uint64_t x, int r)
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        inline uint64_t read64(const uint8_t *p)
+        {
+            uint64_t v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint64_t round(uint64_t acc, uint64_t input)
+        {
+            acc += input * kPrime2;
+            return rotl(acc, 31) * kPrime1;
+        }
+
+        inline uint64_t merge(uint64_t acc, uint64_t val)
+        {
+            acc ^= round(0, val);
+            return acc * kPrime1 + kPrime4;
+        }
+
+        // XXH64; four independent lanes, so hashing runs at close to memory bandwidth
+        uint64_t hash(const uint8_t *data, size_t length, uint64_t seed)
+        {
+            const uint8_t *p = data;
+            const uint8_t *const end = data + length;
+            uint64_t h;
+            if (length >= 32)
+            {
+                uint64_t v1 = seed + kPrime1 + kPrime2;
+                uint64_t v2 = seed + kPrime2;
+                uint64_t v3 = seed;
+                uint64_t v4 = seed - kPrime1;
+                const uint8_t *const limit = end - 32;
+                do
+                {
+                    v1 = round(v1, read64(p));
+                    v2 = round(v2, read64(p + 8));
+                    v3 = round(v3, read64(p + 16));
+                    v4 = round(v4, read64(p + 24));
+                    p += 32;
+                } while (p <= limit);
+                h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+                h = merge(h, v1);
+                h = merge(h, v2);
+                h = merge(h, v3);
+                h = merge(h, v4);
+            }
+            else
+            {
+                h = seed + kPrime5;
+            }
+            h += length;
+            for (; p + 8 <= end; p += 8)
+            {
+                h ^= round(0, read64(p));
+                h = rotl(h, 27) * kPrime1 + kPrime4;
+            }
+            for (; p < end; p++)
+            {
+                h ^= (*p) * kPrime5;
+                h = rotl(h, 11) * kPrime1;
+            }
+            h ^= h >> 33;
+            h *= kPrime2;
+            h ^= h >> 29;
+            h *= kPrime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        const char *stripScheme(const char *path)
+        {
+            return strncmp(path, "file://", 7) == 0 ? path + 7 : path;
+        }
+    }
+
+    GltfAssetCache::~GltfAssetCache()
+    {
+        std::lock_guard lock(mMutex);
+        for (auto &[key, entry] : mEntries)
+        {
+            if (entry.refCount > 0)
+            {
+                Log("Warning: destroying cached glTF asset with %d instances in use", entry.refCount);
+            }
+        }
+        mEntries.clear();
+    }
+
+    uint64_t GltfAssetCache::computeKey(const uint8_t *data, size_t length, const char *resourceUri)
+    {
+        uint64_t key = hash(data, length, 0);
+        if (resourceUri)
+        {
+            key = hash(reinterpret_cast<const uint8_t *>(resourceUri), strlen(resourceUri), key);
+        }
+        // 0 is reserved for "no key"
+        return key == 0 ? 1 : key;
+    }
+
+    uint64_t GltfAssetCache::computeFileKey(const char *path, const char *resourceUri, uint64_t *length)
+    {
+        struct stat st;
+        if (stat(stripScheme(path), &st) != 0)
+        {
+            return 0;
+        }
+        if (length)
+        {
+            *length = uint64_t(st.st_size);
+        }
+
+        std::string id(path);
+        if (resourceUri)
+        {
+            id.append("\n").append(resourceUri);
+        }
+
+        {
+            std::lock_guard lock(mMutex);
+            auto it = mFileKeys.find(id);
+            if (it != mFileKeys.end() && it->second.size == uint64_t(st.st_size) && it->second.modifiedTime == int64_t(st.st_mtime))
+            {
+                return it->second.key;
+            }
+        }
+
+        TRACE_SCOPE("GltfAssetCache::computeFileKey");
+        auto file = MappedFile::open(path);
+        if (!file)
+        {
+            return 0;
+        }
+        auto key = computeKey(file->data(), file->size(), resourceUri);
+
+        std::lock_guard lock(mMutex);
+        mFileKeys[id] = FileKey{uint64_t(st.st_size), int64_t(st.st_mtime), key};
+        return key;
+    }
+
+    SceneAsset *GltfAssetCache::acquire(uint64_t key, MaterialInstance **materialInstances, size_t materialInstanceCount)
+    {
+        std::lock_guard lock(mMutex);
+        auto it = mEntries.find(key);
+        if (it == mEntries.end())
+        {
+            mStats.misses++;
+            return std::nullptr_t();
+        }
+
+        auto &entry = it->second;
+        auto *instance = entry.asset->createInstance(materialInstances, materialInstanceCount);
+        if (!instance)
+        {
+            mStats.misses++;
+            return std::nullptr_t();
+        }
+
+        // recycled instances keep the transform they were last given
+        auto &tm = entry.asset->getAsset()->getEngine()->getTransformManager();
+        auto ti = tm.getInstance(instance->getEntity());
+        if (ti.isValid())
+        {
+            tm.setTransform(ti, math::mat4f());
+        }
+
+        entry.refCount++;
+        entry.lastUsed = ++mClock;
+        mStats.hits++;
+        TRACE("glTF asset cache hit (%d instances in use)", entry.refCount);
+        return instance;
+    }
+
+    SceneAsset *GltfAssetCache::insert(uint64_t key, GltfSceneAsset *asset, size_t sizeInBytes)
+    {
+        std::lock_guard lock(mMutex);
+        if (mEntries.find(key) != mEntries.end())
+        {
+            Log("An asset has already been cached under this key");
+            return std::nullptr_t();
+        }
+        if (asset->getInstanceCount() == 0)
+        {
+            Log("Cached glTF assets must have at least one instance");
+            return std::nullptr_t();
+        }
+
+        auto &entry = mEntries[key];
+        entry.asset.reset(asset);
+        entry.sizeInBytes = sizeInBytes;
+        entry.refCount = 1;
+        entry.lastUsed = ++mClock;
+        mSizeInBytes += sizeInBytes;
+
+        // the remaining reserved instances are available to future hits
+        for (size_t i = 1; i < asset->getInstanceCount(); i++)
+        {
+            asset->destroyInstance(asset->getInstanceAt(i));
+        }
+
+        evict();
+        return asset->getInstanceAt(0);
+    }
+
+    GltfAssetCache::Entry *GltfAssetCache::findOwner(SceneAsset *asset)
+    {
+        auto *owner = asset->isInstance() ? asset->getInstanceOwner() : asset;
+        for (auto &[key, entry] : mEntries)
+        {
+            if (entry.asset.get() == owner)
+            {
+                return &entry;
+            }
+        }
+        return std::nullptr_t();
+    }
+
+    bool GltfAssetCache::release(SceneAsset *instance)
+    {
+        std::lock_guard lock(mMutex);
+        if (!instance->isInstance())
+        {
+            return false;
+        }
+        auto *entry = findOwner(instance);
+        if (!entry)
+        {
+            return false;
+        }
+        entry->asset->destroyInstance(instance);
+        if (entry->refCount > 0)
+        {
+            entry->refCount--;
+        }
+        evict();
+        return true;
+    }
+
+    bool GltfAssetCache::contains(SceneAsset *asset)
+    {
+        std::lock_guard lock(mMutex);
+        return findOwner(asset) != nullptr;
+    }
+
+    void GltfAssetCache::setBudget(size_t budgetInBytes)
+    {
+        std::lock_guard lock(mMutex);
+        mBudgetInBytes = budgetInBytes;
+        evict();
+    }
+
+    GltfAssetCache::Stats GltfAssetCache::getStats()
+    {
+        std::lock_guard lock(mMutex);
+        Stats stats = mStats;
+        stats.entryCount = static_cast<uint32_t>(mEntries.size());
+        stats.sizeInBytes = mSizeInBytes;
+        stats.budgetInBytes = mBudgetInBytes;
+        for (const auto &[key, entry] : mEntries)
+        {
+            stats.instancesInUse += entry.refCount;
+        }
+        return stats;
+    }
+
+    void GltfAssetCache::evict()
+    {
+        while (mSizeInBytes > mBudgetInBytes)
+        {
+            auto lru = mEntries.end();
+            for (auto it = mEntries.begin(); it != mEntries.end(); it++)
+            {
+                if (it->second.refCount == 0 && (lru == mEntries.end() || it->second.lastUsed < lru->second.lastUsed))
+                {
+                    lru = it;
+                }
+            }
+            if (lru == mEntries.end())
+            {
+                // everything remaining is in use
+                return;
+            }
+            TRACE("Evicting cached glTF asset (%zu bytes)", lru->second.sizeInBytes);
+            const auto key = lru->first;
+            mSizeInBytes -= lru->second.sizeInBytes;
+            mEntries.erase(lru);
+            mStats.evictions++;
+
+            // forget the files with this content (rehashed if they're loaded again)
+            for (auto it = mFileKeys.begin(); it != mFileKeys.end();)
+            {
+                it = it->second.key == key ? mFileKeys.erase(it) : std::next(it);
+            }
+        }
+    }
+
+} // namespace thermion
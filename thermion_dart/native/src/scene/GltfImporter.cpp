@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+
+#include "Log.hpp"
+#include "TraceRecorder.hpp"
+#include "scene/GltfImporter.hpp"
+
+namespace thermion
+{
+
+    GltfImporter::~GltfImporter()
+    {
+        for (auto &import : mImports)
+        {
+            import.resourceLoader->asyncCancelLoad();
+        }
+    }
+
+    bool GltfImporter::begin(filament::gltfio::ResourceLoader *resourceLoader, filament::gltfio::FilamentAsset *asset)
+    {
+        TRACE_SCOPE("GltfImporter::begin");
+        if (!resourceLoader->asyncBeginLoad(asset))
+        {
+            Log("Failed to begin loading glTF resources");
+            return false;
+        }
+        std::lock_guard lock(mMutex);
+        mImports.push_back(Import{resourceLoader, asset, resourceLoader->asyncGetLoadProgress()});
+        TRACE("Began glTF import (%d in progress)", mImports.size());
+        return true;
+    }
+
+    float GltfImporter::getProgress(filament::gltfio::FilamentAsset *asset)
+    {
+        std::lock_guard lock(mMutex);
+        for (const auto &import : mImports)
+        {
+            if (import.asset == asset)
+            {
+                return import.progress;
+            }
+        }
+        return 1.0f;
+    }
+
+    void GltfImporter::cancel(filament::gltfio::FilamentAsset *asset)
+    {
+        std::lock_guard lock(mMutex);
+        auto it = std::find_if(mImports.begin(), mImports.end(), [=](const Import &import)
+                               { return import.asset == asset; });
+        if (it != mImports.end())
+        {
+            it->resourceLoader->asyncCancelLoad();
+            mImports.erase(it);
+            mNext = 0;
+        }
+    }
+
+    void GltfImporter::setBudget(uint64_t budgetInNanos)
+    {
+        std::lock_guard lock(mMutex);
+        mBudgetInNanos = budgetInNanos;
+    }
+
+    void GltfImporter::update()
+    {
+        std::lock_guard lock(mMutex);
+        if (mImports.empty())
+        {
+            return;
+        }
+        TRACE_SCOPE("GltfImporter::update");
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        const size_t count = mImports.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            auto &import = mImports[(mNext + i) % count];
+            import.resourceLoader->asyncUpdateLoad();
+            import.progress = import.resourceLoader->asyncGetLoadProgress();
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+            if (uint64_t(elapsed) >= mBudgetInNanos)
+            {
+                TRACE("glTF import budget spent after %d of %d imports (%.3f ms)", i + 1, count, elapsed / 1e6f);
+                mNext = (mNext + i + 1) % count;
+                break;
+            }
+        }
+
+        auto completed = std::remove_if(mImports.begin(), mImports.end(), [](const Import &import)
+                                        { return import.progress >= 1.0f; });
+        if (completed != mImports.end())
+        {
+            mImports.erase(completed, mImports.end());
+            mNext = 0;
+        }
+    }
+
+} // namespace thermion
@@ -0,0 +1,80 @@
+#include <filament/Engine.h>
+#include <filament/RenderableManager.h>
+#include <gltfio/FilamentAsset.h>
+
+#include "cgltf.h"
+
+#include "Log.hpp"
+#include "scene/GltfSourceNodes.hpp"
+
+namespace thermion
+{
+
+    std::vector<const cgltf_node *> getGltfSourceNodes(const cgltf_data *data, const filament::gltfio::FilamentInstance *instance)
+    {
+        std::vector<const cgltf_node *> nodes;
+        std::vector<bool> visited(data->nodes_count, false);
+        std::vector<const cgltf_node *> stack;
+        auto visit = [&](const cgltf_node *root)
+        {
+            stack.push_back(root);
+            while (!stack.empty())
+            {
+                auto *node = stack.back();
+                stack.pop_back();
+                auto index = static_cast<size_t>(node - data->nodes);
+                if (visited[index])
+                {
+                    continue;
+                }
+                visited[index] = true;
+                nodes.push_back(node);
+                for (auto i = node->children_count; i > 0; i--)
+                {
+                    stack.push_back(node->children[i - 1]);
+                }
+            }
+        };
+        if (data->scenes_count == 0)
+        {
+            for (cgltf_size i = 0; i < data->nodes_count; i++)
+            {
+                if (!data->nodes[i].parent)
+                {
+                    visit(&data->nodes[i]);
+                }
+            }
+        }
+        for (cgltf_size i = 0; i < data->scenes_count; i++)
+        {
+            for (cgltf_size j = 0; j < data->scenes[i].nodes_count; j++)
+            {
+                visit(data->scenes[i].nodes[j]);
+            }
+        }
+
+        // check the mapping before trusting it
+        if (nodes.size() != instance->getEntityCount())
+        {
+            Log("Found %d glTF nodes but instance has %d entities", nodes.size(), instance->getEntityCount());
+            return {};
+        }
+        auto &rm = instance->getAsset()->getEngine()->getRenderableManager();
+        const auto *entities = instance->getEntities();
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            if (!nodes[i]->mesh)
+            {
+                continue;
+            }
+            auto ri = rm.getInstance(entities[i]);
+            if (!ri.isValid() || rm.getPrimitiveCount(ri) != nodes[i]->mesh->primitives_count)
+            {
+                Log("glTF node %d does not match entity %d", i, utils::Entity::smuggle(entities[i]));
+                return {};
+            }
+        }
+        return nodes;
+    }
+
+}
@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cstring>
+
+#include <filament/Box.h>
+#include <filament/TransformManager.h>
+#include <utils/EntityManager.h>
+
+#include "Log.hpp"
+#include "TraceRecorder.hpp"
+#include "scene/GeometrySceneAsset.hpp"
+#include "scene/InstancedGeometrySceneAsset.hpp"
+#include "scene/RayPicker.hpp"
+
+namespace thermion
+{
+
+    using namespace filament;
+    using namespace filament::math;
+
+    InstancedGeometrySceneAsset::InstancedGeometrySceneAsset(
+        GeometrySceneAsset *instanceOwner,
+        Engine *engine,
+        VertexBuffer *vertexBuffer,
+        IndexBuffer *indexBuffer,
+        MaterialInstance **materialInstances,
+        size_t materialInstanceCount,
+        RenderableManager::PrimitiveType primitiveType,
+        const filament::Aabb &boundingBox,
+        std::shared_ptr<const PickingMesh> pickingMesh,
+        size_t instanceCount,
+        const mat4f &decodeTransform)
+        : _engine(engine),
+          _instanceOwner(instanceOwner),
+          _boundingBox(boundingBox),
+          _pickingMesh(std::move(pickingMesh)),
+          _transforms(instanceCount),
+          _decodeTransform(decodeTransform)
+    {
+        const mat4f identity;
+        _hasDecodeTransform = std::memcmp(&decodeTransform, &identity, sizeof(identity)) != 0;
+
+        _materialInstances.insert(_materialInstances.begin(), materialInstances, materialInstances + materialInstanceCount);
+
+        auto &em = utils::EntityManager::get();
+        auto &tm = _engine->getTransformManager();
+        _entity = em.create();
+        tm.create(_entity);
+        auto parent = tm.getInstance(_entity);
+
+        // InstanceBuffers are limited to getMaxAutomaticInstances() transforms each
+        _instancesPerRenderable = std::max<size_t>(1, _engine->getMaxAutomaticInstances());
+        const size_t renderableCount = (instanceCount + _instancesPerRenderable - 1) / _instancesPerRenderable;
+        _renderables.resize(renderableCount);
+        _instanceBuffers.resize(renderableCount);
+        em.create(renderableCount, _renderables.data());
+
+        // every instance starts with an identity transform
+        const auto decodedBoundingBox = boundingBox.transform(decodeTransform);
+        const Box box = Box().set(decodedBoundingBox.min, decodedBoundingBox.max);
+        for (size_t i = 0; i < renderableCount; i++)
+        {
+            const size_t count = std::min(_instancesPerRenderable, instanceCount - (i * _instancesPerRenderable));
+            _instanceBuffers[i] = InstanceBuffer::Builder(count).build(*_engine);
+            uploadTransforms(i, i * _instancesPerRenderable, (i * _instancesPerRenderable) + count);
+
+            RenderableManager::Builder builder(1);
+            builder.boundingBox(box)
+                .geometry(0, primitiveType, vertexBuffer, indexBuffer)
+                .instances(count, _instanceBuffers[i])
+                .culling(true)
+                .receiveShadows(true)
+                .castShadows(true);
+            for (size_t j = 0; j < materialInstanceCount; j++)
+            {
+                builder.material(j, materialInstances[j]);
+            }
+            builder.build(*_engine, _renderables[i]);
+            tm.create(_renderables[i], parent);
+        }
+        _proxies.resize(instanceCount);
+        for (size_t i = 0; i < instanceCount; i++)
+        {
+            _proxies[i] = _tree.createProxy(_boundingBox.transform(getVertexTransform(i)), static_cast<uint32_t>(i));
+        }
+        _treeDirty = false;
+    }
+
+    InstancedGeometrySceneAsset::~InstancedGeometrySceneAsset()
+    {
+        auto &em = utils::EntityManager::get();
+        auto &tm = _engine->getTransformManager();
+        for (size_t i = 0; i < _renderables.size(); i++)
+        {
+            _engine->getRenderableManager().destroy(_renderables[i]);
+            tm.destroy(_renderables[i]);
+            // the renderable must be destroyed before its InstanceBuffer
+            _engine->destroy(_instanceBuffers[i]);
+        }
+        em.destroy(_renderables.size(), _renderables.data());
+        tm.destroy(_entity);
+        em.destroy(_entity);
+    }
+
+    SceneAsset *InstancedGeometrySceneAsset::createInstance(MaterialInstance ** /* materialInstances */, size_t /* materialInstanceCount */)
+    {
+        Log("Cannot create an instance from a hardware-instanced asset. Ensure you are calling createInstance with the original asset.");
+        return nullptr;
+    }
+
+    SceneAsset *InstancedGeometrySceneAsset::getInstanceOwner()
+    {
+        return _instanceOwner;
+    }
+
+    bool InstancedGeometrySceneAsset::setInstanceTransforms(const float *transforms, size_t count, size_t offset)
+    {
+        TRACE_SCOPE("InstancedGeometrySceneAsset::setInstanceTransforms");
+        if (offset + count > _transforms.size())
+        {
+            Log("ERROR: instances %d to %d are out of range (%d instances)", offset, offset + count, _transforms.size());
+            return false;
+        }
+        if (count == 0)
+        {
+            return true;
+        }
+        static_assert(sizeof(mat4f) == sizeof(float) * 16);
+        const auto *source = reinterpret_cast<const mat4f *>(transforms);
+        std::copy(source, source + count, _transforms.begin() + offset);
+
+        const size_t first = offset / _instancesPerRenderable;
+        const size_t last = (offset + count - 1) / _instancesPerRenderable;
+        for (size_t i = first; i <= last; i++)
+        {
+            const size_t start = i * _instancesPerRenderable;
+            const size_t from = std::max(offset, start);
+            const size_t to = std::min(offset + count, start + _instanceBuffers[i]->getInstanceCount());
+            uploadTransforms(i, from, to);
+            updateBoundingBox(i);
+        }
+        _treeDirty = true;
+        return true;
+    }
+
+    void InstancedGeometrySceneAsset::uploadTransforms(size_t renderableIndex, size_t from, size_t to)
+    {
+        const size_t start = renderableIndex * _instancesPerRenderable;
+        if (!_hasDecodeTransform)
+        {
+            _instanceBuffers[renderableIndex]->setLocalTransforms(_transforms.data() + from, to - from, from - start);
+            return;
+        }
+        // setLocalTransforms copies the transforms, so the buffer can be reused
+        _decodedTransforms.resize(to - from);
+        for (size_t i = from; i < to; i++)
+        {
+            _decodedTransforms[i - from] = getVertexTransform(i);
+        }
+        _instanceBuffers[renderableIndex]->setLocalTransforms(_decodedTransforms.data(), _decodedTransforms.size(), from - start);
+    }
+
+    void InstancedGeometrySceneAsset::updateBoundingBox(size_t renderableIndex)
+    {
+        // all instances are culled with the renderable's bounding box, so it must contain every instance
+        const size_t start = renderableIndex * _instancesPerRenderable;
+        const size_t end = start + _instanceBuffers[renderableIndex]->getInstanceCount();
+        filament::Aabb box = _boundingBox.transform(getVertexTransform(start));
+        for (size_t i = start + 1; i < end; i++)
+        {
+            auto instanceBox = _boundingBox.transform(getVertexTransform(i));
+            box.min = min(box.min, instanceBox.min);
+            box.max = max(box.max, instanceBox.max);
+        }
+        auto &rm = _engine->getRenderableManager();
+        rm.setAxisAlignedBoundingBox(rm.getInstance(_renderables[renderableIndex]), Box().set(box.min, box.max));
+    }
+
+    float InstancedGeometrySceneAsset::intersect(const float3 &origin, const float3 &direction, float maxT, bool refine, int32_t &instance)
+    {
+        TRACE_SCOPE("InstancedGeometrySceneAsset::intersect");
+        if (_treeDirty)
+        {
+            for (size_t i = 0; i < _proxies.size(); i++)
+            {
+                _tree.moveProxy(_proxies[i], _boundingBox.transform(getVertexTransform(i)));
+            }
+            _treeDirty = false;
+        }
+
+        // transform the ray to the root's space (t is unchanged)
+        auto &tm = _engine->getTransformManager();
+        auto inverseTransform = inverse(tm.getWorldTransform(tm.getInstance(_entity)));
+        const float3 rootOrigin = (inverseTransform * float4(origin, 1.0f)).xyz;
+        const float3 rootDirection = (inverseTransform * float4(direction, 0.0f)).xyz;
+
+        const PickingMesh *mesh = refine ? _pickingMesh.get() : nullptr;
+        instance = -1;
+        _tree.rayCast(rootOrigin, rootDirection, maxT, [&](int32_t proxyId)
+                      {
+            auto index = _tree.getUserData(proxyId);
+            float t = RayPicker::intersect(_boundingBox, mesh, getVertexTransform(index), rootOrigin, rootDirection, maxT);
+            if (t < maxT)
+            {
+                maxT = t;
+                instance = static_cast<int32_t>(index);
+            }
+            return maxT; });
+        return maxT;
+    }
+
+} // namespace thermion
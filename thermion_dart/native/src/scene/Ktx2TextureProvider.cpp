@@ -0,0 +1,206 @@
+#include <chrono>
+#include <cstring>
+
+#include "scene/Ktx2TextureProvider.hpp"
+
+#include "Log.hpp"
+#include "TraceRecorder.hpp"
+
+namespace thermion
+{
+
+    using namespace filament;
+    using Ktx2Reader = ktxreader::Ktx2Reader;
+
+    Ktx2TextureProvider::Ktx2TextureProvider(Engine *engine)
+        : mEngine(engine),
+          mJobSystem(engine->getJobSystem()),
+          mReader(std::make_unique<Ktx2Reader>(*engine, true))
+    {
+        requestFormats(*mReader);
+    }
+
+    Ktx2TextureProvider::~Ktx2TextureProvider()
+    {
+        cancelDecoding();
+        for (auto &pending : mPending)
+        {
+            mReader->asyncDestroy(&pending->async);
+        }
+    }
+
+    void Ktx2TextureProvider::requestFormats(Ktx2Reader &reader)
+    {
+        // the reader skips any that the device doesn't support
+        static constexpr Texture::InternalFormat kFormats[] = {
+            Texture::InternalFormat::RGBA_ASTC_4x4,
+            Texture::InternalFormat::EAC_R11,
+            Texture::InternalFormat::EAC_R11_SIGNED,
+            Texture::InternalFormat::EAC_RG11,
+            Texture::InternalFormat::EAC_RG11_SIGNED,
+            Texture::InternalFormat::ETC2_RGB8,
+            Texture::InternalFormat::ETC2_SRGB8,
+            Texture::InternalFormat::ETC2_RGB8_A1,
+            Texture::InternalFormat::ETC2_SRGB8_A1,
+            Texture::InternalFormat::ETC2_EAC_RGBA8,
+            Texture::InternalFormat::ETC2_EAC_SRGBA8,
+            Texture::InternalFormat::RGBA8,
+        };
+        for (auto format : kFormats)
+        {
+            auto result = reader.requestFormat(format);
+            if (result != Ktx2Reader::Result::SUCCESS)
+            {
+                TRACE("KTX2 format %d not available (%d)", static_cast<int>(format), static_cast<int>(result));
+            }
+        }
+    }
+
+    Texture *Ktx2TextureProvider::pushTexture(const uint8_t *data, size_t byteCount,
+                                              const char *mimeType, TextureFlags flags)
+    {
+        if (strcmp(mimeType, "image/ktx2") != 0)
+        {
+            mPushMessage = std::string("Unsupported mime type: ") + mimeType;
+            return std::nullptr_t();
+        }
+
+        const auto transfer = any(flags & TextureFlags::sRGB) ? Ktx2Reader::TransferFunction::sRGB : Ktx2Reader::TransferFunction::LINEAR;
+
+        // the texture is created now (with its source data copied), and its levels transcoded by the job
+        auto *async = mReader->asyncCreate(data, byteCount, transfer);
+        if (!async)
+        {
+            mPushMessage = "Unable to create KTX2 texture (unsupported format, or transfer function mismatch)";
+            return std::nullptr_t();
+        }
+
+        auto pending = std::make_unique<Pending>();
+        pending->texture = async->getTexture();
+        pending->async = async;
+
+        auto *p = pending.get();
+        pending->job = utils::jobs::createJob(mJobSystem, nullptr, [p]()
+                                              {
+            if (p->cancelled) {
+                p->result = Ktx2Reader::Result::COMPRESSED_TRANSCODE_FAILURE;
+                p->transcoded = true;
+                return;
+            }
+            auto start = std::chrono::high_resolution_clock::now();
+            p->result = p->async->doTranscoding();
+            p->decodeTimeInNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - start).count();
+            p->transcoded = true; });
+        pending->job = mJobSystem.runAndRetain(pending->job);
+
+        mPending.push_back(std::move(pending));
+        mPushMessage.clear();
+        mPushedCount++;
+        return p->texture;
+    }
+
+    Texture *Ktx2TextureProvider::popTexture()
+    {
+        if (mDecoded.empty())
+        {
+            mPopMessage.clear();
+            return std::nullptr_t();
+        }
+        auto decoded = mDecoded.back();
+        mDecoded.pop_back();
+        if (decoded.failed)
+        {
+            mPopMessage = "Failed to transcode KTX2 texture";
+        }
+        else
+        {
+            mPopMessage.clear();
+        }
+        mPoppedCount++;
+        return decoded.texture;
+    }
+
+    void Ktx2TextureProvider::updateQueue()
+    {
+        TRACE_SCOPE("Ktx2TextureProvider::updateQueue");
+        for (auto it = mPending.begin(); it != mPending.end();)
+        {
+            auto &pending = *it;
+
+            // upload whichever levels have been transcoded so far
+            const bool transcoded = pending->transcoded;
+            pending->async->uploadImages();
+            if (!transcoded)
+            {
+                it++;
+                continue;
+            }
+
+            if (pending->job)
+            {
+                mJobSystem.release(pending->job);
+                pending->job = nullptr;
+            }
+            const bool failed = pending->result != Ktx2Reader::Result::SUCCESS;
+            record(*pending);
+            mReader->asyncDestroy(&pending->async);
+            mDecoded.push_back({pending->texture, failed});
+            mDecodedCount++;
+            it = mPending.erase(it);
+        }
+    }
+
+    void Ktx2TextureProvider::record(const Pending &pending)
+    {
+        std::lock_guard lock(mStatsMutex);
+        if (pending.result != Ktx2Reader::Result::SUCCESS)
+        {
+            mStats.texturesFailed++;
+            return;
+        }
+        TRACE("Transcoded KTX2 texture (%dx%d, %d levels) in %.3f ms", pending.texture->getWidth(), pending.texture->getHeight(), pending.texture->getLevels(), pending.decodeTimeInNanos / 1e6f);
+        mStats.texturesDecoded++;
+        mStats.totalDecodeTimeInNanos += pending.decodeTimeInNanos;
+        mStats.lastDecodeTimeInNanos = pending.decodeTimeInNanos;
+        mStats.maxDecodeTimeInNanos = std::max(mStats.maxDecodeTimeInNanos, pending.decodeTimeInNanos);
+    }
+
+    const char *Ktx2TextureProvider::getPushMessage() const
+    {
+        return mPushMessage.empty() ? nullptr : mPushMessage.c_str();
+    }
+
+    const char *Ktx2TextureProvider::getPopMessage() const
+    {
+        return mPopMessage.empty() ? nullptr : mPopMessage.c_str();
+    }
+
+    void Ktx2TextureProvider::waitForCompletion()
+    {
+        for (auto &pending : mPending)
+        {
+            if (pending->job)
+            {
+                mJobSystem.waitAndRelease(pending->job);
+                pending->job = nullptr;
+            }
+        }
+    }
+
+    void Ktx2TextureProvider::cancelDecoding()
+    {
+        for (auto &pending : mPending)
+        {
+            pending->cancelled = true;
+        }
+        waitForCompletion();
+    }
+
+    Ktx2TextureProvider::Stats Ktx2TextureProvider::getStats()
+    {
+        std::lock_guard lock(mStatsMutex);
+        return mStats;
+    }
+
+} // namespace thermion
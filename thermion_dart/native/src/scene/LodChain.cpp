@@ -0,0 +1,143 @@
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+
+#include "Log.hpp"
+#include "scene/LodChain.hpp"
+#include "scene/MeshOptimizer.hpp"
+#include "scene/RayPicker.hpp"
+
+namespace thermion
+{
+
+    using namespace filament;
+
+    LodChain::LodChain(Engine *engine,
+                       VertexBuffer *vertexBuffer,
+                       IndexBuffer *indexBuffer,
+                       RenderableManager::PrimitiveType primitiveType,
+                       std::shared_ptr<const PickingMesh> mesh,
+                       const math::mat4f &decodeTransform,
+                       size_t levelCount,
+                       float reduction) : mEngine(engine),
+                                          mVertexBuffer(vertexBuffer),
+                                          mPrimitiveType(primitiveType)
+    {
+        mLevels.push_back(Level{indexBuffer, static_cast<uint32_t>(indexBuffer->getIndexCount()), 0.0f});
+        if (levelCount > 1 && mesh && primitiveType == RenderableManager::PrimitiveType::TRIANGLES)
+        {
+            auto &js = engine->getJobSystem();
+            mJob = utils::jobs::createJob(js, nullptr, [this, mesh = std::move(mesh), decodeTransform, levelCount, reduction]()
+                                          {
+                mSimplified = generate(mesh, decodeTransform, levelCount, reduction);
+                mGenerated = true; });
+            mJob = js.runAndRetain(mJob);
+        }
+    }
+
+    LodChain::~LodChain()
+    {
+        wait();
+        // level 0 is owned by the asset
+        for (size_t i = 1; i < mLevels.size(); i++)
+        {
+            mEngine->destroy(mLevels[i].indexBuffer);
+        }
+    }
+
+    std::vector<LodChain::Simplified> LodChain::generate(std::shared_ptr<const PickingMesh> mesh,
+                                                         math::mat4f decodeTransform,
+                                                         size_t levelCount, float reduction)
+    {
+        std::vector<math::float3> positions(mesh->positions.size());
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            positions[i] = (decodeTransform * math::float4(mesh->positions[i], 1.0f)).xyz;
+        }
+
+        // each level is simplified from the previous one, so the errors accumulate
+        std::vector<Simplified> levels;
+        std::vector<uint32_t> indices = mesh->indices;
+        float error = 0.0f;
+        for (size_t level = 1; level < levelCount; level++)
+        {
+            const size_t target = static_cast<size_t>(indices.size() * reduction) / 3 * 3;
+            float levelError = 0.0f;
+            const size_t indexCount = MeshOptimizer::simplify(indices.data(), indices.data(), indices.size(),
+                                                              positions.data(), sizeof(math::float3), positions.size(),
+                                                              target, 1.0f, &levelError);
+            if (indexCount == 0 || indexCount == indices.size())
+            {
+                TRACE("Simplification stopped after %d levels", level);
+                break;
+            }
+            indices.resize(indexCount);
+            error += levelError;
+            levels.push_back(Simplified{indices, error});
+        }
+        return levels;
+    }
+
+    bool LodChain::poll()
+    {
+        std::lock_guard lock(mMutex);
+        if (mJob)
+        {
+            if (!mGenerated)
+            {
+                return false;
+            }
+            mEngine->getJobSystem().release(mJob);
+        }
+        if (mSimplified.empty())
+        {
+            return true;
+        }
+        for (auto &simplified : mSimplified)
+        {
+            auto *indices = new std::vector<uint32_t>(std::move(simplified.indices));
+            auto *indexBuffer = IndexBuffer::Builder()
+                                    .indexCount(indices->size())
+                                    .bufferType(IndexBuffer::IndexType::UINT)
+                                    .build(*mEngine);
+            indexBuffer->setBuffer(*mEngine, IndexBuffer::BufferDescriptor(
+                                                 indices->data(), indices->size() * sizeof(uint32_t),
+                                                 [](void *, size_t, void *user)
+                                                 { delete static_cast<std::vector<uint32_t> *>(user); },
+                                                 indices));
+            mLevels.push_back(Level{indexBuffer, static_cast<uint32_t>(indexBuffer->getIndexCount()), simplified.error});
+        }
+        mSimplified.clear();
+        TRACE("Uploaded %d levels of detail", mLevels.size());
+        return true;
+    }
+
+    void LodChain::wait()
+    {
+        std::lock_guard lock(mMutex);
+        if (mJob)
+        {
+            // (this thread runs other jobs while it waits)
+            mEngine->getJobSystem().waitAndRelease(mJob);
+        }
+    }
+
+    size_t LodChain::getLevelCount()
+    {
+        std::lock_guard lock(mMutex);
+        return mLevels.size();
+    }
+
+    LodChain::Level LodChain::getLevel(size_t level)
+    {
+        std::lock_guard lock(mMutex);
+        return level < mLevels.size() ? mLevels[level] : Level();
+    }
+
+    uint32_t LodChain::getTriangleCount(size_t level)
+    {
+        return getLevel(level).indexCount / 3;
+    }
+
+} // namespace thermion
@@ -0,0 +1,619 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+#include "scene/MeshOptimizer.hpp"
+
+namespace thermion
+{
+
+    using filament::math::float3;
+
+    namespace
+    {
+        // FIFO cache simulation: a vertex is cached if it was inserted fewer
+        // than cacheSize misses ago (the timestamp only advances on a miss)
+        class FifoCache
+        {
+        public:
+            FifoCache(size_t vertexCount, uint32_t cacheSize) : mInsertedAt(vertexCount, 0), mTime(cacheSize + 1), mCacheSize(cacheSize) {}
+
+            // returns the number of misses (0-3) for the triangle
+            uint32_t triangle(const uint32_t *indices)
+            {
+                uint32_t misses = 0;
+                for (int i = 0; i < 3; i++)
+                {
+                    misses += vertex(indices[i]);
+                }
+                return misses;
+            }
+
+            uint32_t vertex(uint32_t index)
+            {
+                if (mTime - mInsertedAt[index] > mCacheSize)
+                {
+                    mInsertedAt[index] = mTime++;
+                    return 1;
+                }
+                return 0;
+            }
+
+            // evicts everything
+            void flush()
+            {
+                mTime += mCacheSize + 1;
+            }
+
+        private:
+            std::vector<size_t> mInsertedAt;
+            size_t mTime;
+            uint32_t mCacheSize;
+        };
+
+        // the triangles adjacent to each vertex (compressed sparse rows)
+        struct Adjacency
+        {
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> triangles;
+
+            Adjacency(const uint32_t *indices, size_t indexCount, size_t vertexCount) : offsets(vertexCount + 1, 0), triangles(indexCount)
+            {
+                for (size_t i = 0; i < indexCount; i++)
+                {
+                    offsets[indices[i] + 1]++;
+                }
+                std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+                std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indexCount; i++)
+                {
+                    triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+            uint32_t count(uint32_t vertex) const
+            {
+                return offsets[vertex + 1] - offsets[vertex];
+            }
+        };
+
+        // the (area-weighted) sum of squared distances to a set of planes
+        struct Quadric
+        {
+            double a2 = 0, b2 = 0, c2 = 0, d2 = 0;
+            double ab = 0, ac = 0, ad = 0, bc = 0, bd = 0, cd = 0;
+            double weight = 0;
+
+            static Quadric fromPlane(const float3 &normal, double d, double weight)
+            {
+                const double a = normal.x, b = normal.y, c = normal.z;
+                Quadric q;
+                q.a2 = a * a * weight;
+                q.b2 = b * b * weight;
+                q.c2 = c * c * weight;
+                q.d2 = d * d * weight;
+                q.ab = a * b * weight;
+                q.ac = a * c * weight;
+                q.ad = a * d * weight;
+                q.bc = b * c * weight;
+                q.bd = b * d * weight;
+                q.cd = c * d * weight;
+                q.weight = weight;
+                return q;
+            }
+
+            Quadric &operator+=(const Quadric &q)
+            {
+                a2 += q.a2;
+                b2 += q.b2;
+                c2 += q.c2;
+                d2 += q.d2;
+                ab += q.ab;
+                ac += q.ac;
+                ad += q.ad;
+                bc += q.bc;
+                bd += q.bd;
+                cd += q.cd;
+                weight += q.weight;
+                return *this;
+            }
+
+            // the mean squared distance of [p] to the planes
+            double error(const float3 &p) const
+            {
+                const double x = p.x, y = p.y, z = p.z;
+                const double e = (a2 * x * x) + (b2 * y * y) + (c2 * z * z) + d2 +
+                                 2 * ((ab * x * y) + (ac * x * z) + (bc * y * z) + (ad * x) + (bd * y) + (cd * z));
+                return weight > 0 ? std::abs(e) / weight : 0;
+            }
+        };
+
+        struct Collapse
+        {
+            uint32_t from;
+            uint32_t to;
+            double error;
+        };
+    }
+
+    size_t MeshOptimizer::deduplicateVertices(uint32_t *remap, const VertexStream *streams, size_t streamCount, size_t vertexCount)
+    {
+        auto hash = [=](uint32_t vertex)
+        {
+            // FNV-1a over every attribute of the vertex
+            uint64_t h = 14695981039346656037ull;
+            for (size_t s = 0; s < streamCount; s++)
+            {
+                auto *bytes = static_cast<const uint8_t *>(streams[s].data) + (vertex * streams[s].stride);
+                for (size_t i = 0; i < streams[s].size; i++)
+                {
+                    h = (h ^ bytes[i]) * 1099511628211ull;
+                }
+            }
+            return static_cast<size_t>(h);
+        };
+        auto equal = [=](uint32_t a, uint32_t b)
+        {
+            for (size_t s = 0; s < streamCount; s++)
+            {
+                auto *bytes = static_cast<const uint8_t *>(streams[s].data);
+                if (std::memcmp(bytes + (a * streams[s].stride), bytes + (b * streams[s].stride), streams[s].size) != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)> unique(vertexCount, hash, equal);
+        size_t uniqueCount = 0;
+        for (uint32_t v = 0; v < vertexCount; v++)
+        {
+            auto [it, inserted] = unique.emplace(v, static_cast<uint32_t>(uniqueCount));
+            if (inserted)
+            {
+                uniqueCount++;
+            }
+            remap[v] = it->second;
+        }
+        return uniqueCount;
+    }
+
+    void MeshOptimizer::optimizeVertexCache(uint32_t *destination, const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                            uint32_t cacheSize)
+    {
+        const size_t triangleCount = indexCount / 3;
+        Adjacency adjacency(indices, indexCount, vertexCount);
+
+        std::vector<uint32_t> live(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; v++)
+        {
+            live[v] = adjacency.count(v);
+        }
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<size_t> timestamps(vertexCount, 0);
+        size_t time = cacheSize + 1;
+
+        std::vector<uint32_t> deadEnds;
+        std::vector<uint32_t> candidates;
+        uint32_t cursor = 0;
+        size_t output = 0;
+
+        // when the candidates are exhausted, continue from the most recently
+        // used vertex that still has triangles (or the next one in input order)
+        auto skipDeadEnd = [&]() -> int64_t
+        {
+            while (!deadEnds.empty())
+            {
+                auto vertex = deadEnds.back();
+                deadEnds.pop_back();
+                if (live[vertex] > 0)
+                {
+                    return vertex;
+                }
+            }
+            while (cursor < vertexCount)
+            {
+                if (live[cursor] > 0)
+                {
+                    return cursor;
+                }
+                cursor++;
+            }
+            return -1;
+        };
+
+        int64_t fan = skipDeadEnd();
+        while (fan >= 0)
+        {
+            candidates.clear();
+            for (uint32_t i = adjacency.offsets[fan]; i < adjacency.offsets[fan + 1]; i++)
+            {
+                auto triangle = adjacency.triangles[i];
+                if (emitted[triangle])
+                {
+                    continue;
+                }
+                for (int j = 0; j < 3; j++)
+                {
+                    auto vertex = indices[(triangle * 3) + j];
+                    destination[output++] = vertex;
+                    deadEnds.push_back(vertex);
+                    candidates.push_back(vertex);
+                    live[vertex]--;
+                    if (time - timestamps[vertex] > cacheSize)
+                    {
+                        timestamps[vertex] = time++;
+                    }
+                }
+                emitted[triangle] = true;
+            }
+
+            // prefer the candidate that will stay in the cache the longest once
+            // its remaining triangles are emitted
+            int64_t next = -1;
+            int64_t bestPriority = -1;
+            for (auto vertex : candidates)
+            {
+                if (live[vertex] == 0)
+                {
+                    continue;
+                }
+                int64_t priority = 0;
+                const int64_t age = static_cast<int64_t>(time - timestamps[vertex]);
+                if (age + (2 * live[vertex]) <= cacheSize)
+                {
+                    priority = age;
+                }
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    next = vertex;
+                }
+            }
+            fan = next >= 0 ? next : skipDeadEnd();
+        }
+    }
+
+    void MeshOptimizer::optimizeOverdraw(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                         const float3 *positions, size_t positionStride, size_t vertexCount,
+                                         float threshold, uint32_t cacheSize)
+    {
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+        {
+            return;
+        }
+        if (positionStride == 0)
+        {
+            positionStride = sizeof(float3);
+        }
+        auto position = [=](uint32_t vertex) -> const float3 &
+        {
+            return *reinterpret_cast<const float3 *>(reinterpret_cast<const uint8_t *>(positions) + (vertex * positionStride));
+        };
+
+        // hard boundaries: wherever a triangle misses on all three vertices
+        // (so reordering there can't make locality any worse)
+        std::vector<uint32_t> hardClusters;
+        FifoCache cache(vertexCount, cacheSize);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            if (cache.triangle(indices + (t * 3)) == 3)
+            {
+                hardClusters.push_back(static_cast<uint32_t>(t));
+            }
+        }
+        hardClusters.push_back(static_cast<uint32_t>(triangleCount));
+
+        // soft boundaries: split each hard cluster wherever the running miss
+        // ratio (starting with an empty cache) is within [threshold] of the
+        // cluster's own, so the split costs at most [threshold] in locality
+        std::vector<uint32_t> clusters;
+        for (size_t c = 0; c + 1 < hardClusters.size(); c++)
+        {
+            const uint32_t start = hardClusters[c];
+            const uint32_t end = hardClusters[c + 1];
+
+            cache.flush();
+            uint32_t clusterMisses = 0;
+            for (uint32_t t = start; t < end; t++)
+            {
+                clusterMisses += cache.triangle(indices + (t * 3));
+            }
+            const float clusterThreshold = threshold * (float(clusterMisses) / float(end - start));
+
+            const size_t first = clusters.size();
+            clusters.push_back(start);
+            cache.flush();
+            uint32_t misses = 0;
+            uint32_t triangles = 0;
+            for (uint32_t t = start; t < end; t++)
+            {
+                misses += cache.triangle(indices + (t * 3));
+                triangles++;
+                if (t + 1 < end && float(misses) / float(triangles) <= clusterThreshold)
+                {
+                    clusters.push_back(t + 1);
+                    cache.flush();
+                    misses = 0;
+                    triangles = 0;
+                }
+            }
+            // the remainder may not have reached the target ratio, so merge it with the previous split
+            if (clusters.size() - first > 1 && float(misses) / float(triangles) > clusterThreshold)
+            {
+                clusters.pop_back();
+            }
+        }
+        clusters.push_back(static_cast<uint32_t>(triangleCount));
+
+        float3 meshCentroid{0.0f};
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            meshCentroid += position(indices[i]);
+        }
+        meshCentroid /= float(indexCount);
+
+        // draw the clusters facing most directly away from the centre (i.e.
+        // most likely to occlude the others) first
+        const size_t clusterCount = clusters.size() - 1;
+        std::vector<float> sortKeys(clusterCount);
+        for (size_t cluster = 0; cluster < clusterCount; cluster++)
+        {
+            float3 centroid{0.0f};
+            float3 normal{0.0f};
+            float area = 0.0f;
+            for (uint32_t t = clusters[cluster]; t < clusters[cluster + 1]; t++)
+            {
+                const auto &a = position(indices[t * 3]);
+                const auto &b = position(indices[(t * 3) + 1]);
+                const auto &c = position(indices[(t * 3) + 2]);
+                const float3 faceNormal = cross(b - a, c - a);
+                const float faceArea = length(faceNormal);
+                centroid += (a + b + c) * (faceArea / 3.0f);
+                normal += faceNormal;
+                area += faceArea;
+            }
+            const float normalLength = length(normal);
+            if (area == 0.0f || normalLength == 0.0f)
+            {
+                sortKeys[cluster] = 0.0f;
+                continue;
+            }
+            sortKeys[cluster] = dot((centroid / area) - meshCentroid, normal / normalLength);
+        }
+
+        std::vector<uint32_t> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+                         { return sortKeys[a] > sortKeys[b]; });
+
+        size_t output = 0;
+        for (auto c : order)
+        {
+            const size_t count = (clusters[c + 1] - clusters[c]) * 3;
+            std::memcpy(destination + output, indices + (clusters[c] * 3), count * sizeof(uint32_t));
+            output += count;
+        }
+    }
+
+    size_t MeshOptimizer::optimizeVertexFetch(uint32_t *remap, const uint32_t *indices, size_t indexCount, size_t vertexCount)
+    {
+        std::fill(remap, remap + vertexCount, ~0u);
+        uint32_t next = 0;
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            if (remap[indices[i]] == ~0u)
+            {
+                remap[indices[i]] = next++;
+            }
+        }
+        return next;
+    }
+
+    size_t MeshOptimizer::simplify(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                   const float3 *positions, size_t positionStride, size_t vertexCount,
+                                   size_t targetIndexCount, float targetError, float *resultError)
+    {
+        if (destination != indices)
+        {
+            std::memmove(destination, indices, indexCount * sizeof(uint32_t));
+        }
+        if (positionStride == 0)
+        {
+            positionStride = sizeof(float3);
+        }
+
+        // work in a normalized space, so errors are relative to the size of the mesh
+        float3 boxMin{FLT_MAX};
+        float3 boxMax{-FLT_MAX};
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            const auto &p = *reinterpret_cast<const float3 *>(reinterpret_cast<const uint8_t *>(positions) + (v * positionStride));
+            boxMin = min(boxMin, p);
+            boxMax = max(boxMax, p);
+        }
+        const float3 center = (boxMin + boxMax) * 0.5f;
+        const float radius = std::max(length(boxMax - boxMin) * 0.5f, FLT_MIN);
+        std::vector<float3> normalized(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            const auto &p = *reinterpret_cast<const float3 *>(reinterpret_cast<const uint8_t *>(positions) + (v * positionStride));
+            normalized[v] = (p - center) / radius;
+        }
+
+        // vertices on edges without exactly two triangles are locked, which
+        // keeps holes, borders and attribute seams intact
+        std::vector<bool> locked(vertexCount, false);
+        {
+            std::unordered_map<uint64_t, uint32_t> edges;
+            for (size_t i = 0; i < indexCount; i++)
+            {
+                const uint32_t a = destination[i];
+                const uint32_t b = destination[(i % 3) == 2 ? i - 2 : i + 1];
+                edges[(uint64_t(std::min(a, b)) << 32) | std::max(a, b)]++;
+            }
+            for (const auto &[edge, count] : edges)
+            {
+                if (count != 2)
+                {
+                    locked[edge >> 32] = true;
+                    locked[edge & 0xffffffff] = true;
+                }
+            }
+        }
+
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t i = 0; i < indexCount; i += 3)
+        {
+            const auto &a = normalized[destination[i]];
+            const auto &b = normalized[destination[i + 1]];
+            const auto &c = normalized[destination[i + 2]];
+            float3 normal = cross(b - a, c - a);
+            const float area = length(normal);
+            if (area == 0.0f)
+            {
+                continue;
+            }
+            normal /= area;
+            const auto quadric = Quadric::fromPlane(normal, -dot(normal, a), area);
+            for (int j = 0; j < 3; j++)
+            {
+                quadrics[destination[i + j]] += quadric;
+            }
+        }
+
+        const double maxError = double(targetError) * double(targetError);
+        double error = 0;
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<bool> touched(vertexCount);
+
+        while (indexCount > targetIndexCount)
+        {
+            Adjacency adjacency(destination, indexCount, vertexCount);
+
+            // one candidate per edge (interior edges appear in two triangles, with opposite winding)
+            collapses.clear();
+            for (size_t i = 0; i < indexCount; i++)
+            {
+                const uint32_t a = destination[i];
+                const uint32_t b = destination[(i % 3) == 2 ? i - 2 : i + 1];
+                if (a > b || (locked[a] && locked[b]))
+                {
+                    continue;
+                }
+                Quadric q = quadrics[a];
+                q += quadrics[b];
+                const double toB = locked[a] ? DBL_MAX : q.error(normalized[b]);
+                const double toA = locked[b] ? DBL_MAX : q.error(normalized[a]);
+                collapses.push_back(toB <= toA ? Collapse{a, b, toB} : Collapse{b, a, toA});
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b)
+                      { return a.error < b.error; });
+
+            std::iota(remap.begin(), remap.end(), 0);
+            std::fill(touched.begin(), touched.end(), false);
+            size_t remaining = indexCount;
+            size_t collapsed = 0;
+            for (const auto &collapse : collapses)
+            {
+                if (collapse.error > maxError || remaining <= targetIndexCount)
+                {
+                    break;
+                }
+                if (touched[collapse.from] || touched[collapse.to])
+                {
+                    continue;
+                }
+
+                // reject collapses that would flip a triangle
+                bool flips = false;
+                size_t removed = 0;
+                for (uint32_t i = adjacency.offsets[collapse.from]; i < adjacency.offsets[collapse.from + 1] && !flips; i++)
+                {
+                    const uint32_t *triangle = destination + (adjacency.triangles[i] * 3);
+                    if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                    {
+                        removed += 3;
+                        continue;
+                    }
+                    float3 before[3];
+                    float3 after[3];
+                    for (int j = 0; j < 3; j++)
+                    {
+                        before[j] = normalized[triangle[j]];
+                        after[j] = normalized[triangle[j] == collapse.from ? collapse.to : triangle[j]];
+                    }
+                    flips = dot(cross(before[1] - before[0], before[2] - before[0]),
+                                cross(after[1] - after[0], after[2] - after[0])) <= 0.0f;
+                }
+                if (flips)
+                {
+                    continue;
+                }
+
+                // the triangles around [from] change, so no other collapse in this pass may touch them
+                for (uint32_t i = adjacency.offsets[collapse.from]; i < adjacency.offsets[collapse.from + 1]; i++)
+                {
+                    const uint32_t *triangle = destination + (adjacency.triangles[i] * 3);
+                    touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = true;
+                }
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to] += quadrics[collapse.from];
+                error = std::max(error, collapse.error);
+                remaining -= removed;
+                collapsed++;
+            }
+            if (collapsed == 0)
+            {
+                break;
+            }
+
+            // remove the triangles that have become degenerate
+            size_t output = 0;
+            for (size_t i = 0; i < indexCount; i += 3)
+            {
+                const uint32_t a = remap[destination[i]];
+                const uint32_t b = remap[destination[i + 1]];
+                const uint32_t c = remap[destination[i + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    destination[output++] = a;
+                    destination[output++] = b;
+                    destination[output++] = c;
+                }
+            }
+            indexCount = output;
+        }
+
+        if (resultError)
+        {
+            *resultError = static_cast<float>(std::sqrt(error));
+        }
+        return indexCount;
+    }
+
+    MeshOptimizer::VertexCacheStatistics MeshOptimizer::analyzeVertexCache(const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                                                           uint32_t cacheSize)
+    {
+        VertexCacheStatistics statistics;
+        if (indexCount == 0 || vertexCount == 0)
+        {
+            return statistics;
+        }
+        FifoCache cache(vertexCount, cacheSize);
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            statistics.vertexInvocations += cache.vertex(indices[i]);
+        }
+        statistics.acmr = float(statistics.vertexInvocations) / float(indexCount / 3);
+        statistics.atvr = float(statistics.vertexInvocations) / float(vertexCount);
+        return statistics;
+    }
+
+} // namespace thermion
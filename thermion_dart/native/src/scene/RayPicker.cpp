@@ -0,0 +1,431 @@
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#include <filament/Camera.h>
+#include <filament/RenderableManager.h>
+#include <filament/TransformManager.h>
+#include <filament/Viewport.h>
+#include <gltfio/FilamentAsset.h>
+#include <math/mat4.h>
+#include <math/vec4.h>
+
+#include "cgltf.h"
+
+#include "Log.hpp"
+#include "TraceRecorder.hpp"
+#include "scene/GeometrySceneAsset.hpp"
+#include "scene/GltfSceneAsset.hpp"
+#include "scene/GltfSceneAssetInstance.hpp"
+#include "scene/GltfSourceNodes.hpp"
+#include "scene/InstancedGeometrySceneAsset.hpp"
+#include "scene/RayPicker.hpp"
+
+namespace thermion
+{
+
+    using namespace filament;
+    using namespace filament::math;
+
+    namespace
+    {
+        // Returns the smallest t in [0, maxT) where the ray intersects a triangle in [mesh]
+        // (from either side), or maxT if there is none.
+        float intersectTriangles(const PickingMesh &mesh, const float3 &origin, const float3 &direction, float maxT)
+        {
+            const auto &positions = mesh.positions;
+            const auto &indices = mesh.indices;
+            for (size_t i = 0; i + 2 < indices.size(); i += 3)
+            {
+                // Möller–Trumbore
+                const float3 &v0 = positions[indices[i]];
+                const float3 e1 = positions[indices[i + 1]] - v0;
+                const float3 e2 = positions[indices[i + 2]] - v0;
+                const float3 p = cross(direction, e2);
+                const float det = dot(e1, p);
+                if (std::abs(det) < 1e-12f)
+                {
+                    continue;
+                }
+                const float invDet = 1.0f / det;
+                const float3 s = origin - v0;
+                const float u = dot(s, p) * invDet;
+                if (u < 0.0f || u > 1.0f)
+                {
+                    continue;
+                }
+                const float3 q = cross(s, e1);
+                const float v = dot(direction, q) * invDet;
+                if (v < 0.0f || u + v > 1.0f)
+                {
+                    continue;
+                }
+                const float t = dot(e2, q) * invDet;
+                if (t >= 0.0f && t < maxT)
+                {
+                    maxT = t;
+                }
+            }
+            return maxT;
+        }
+
+        // Appends the triangles of [primitive] to [mesh], returning false if they can't be read.
+        bool appendPrimitive(const cgltf_primitive &primitive, PickingMesh &mesh)
+        {
+            if (primitive.type != cgltf_primitive_type_triangles || primitive.has_draco_mesh_compression)
+            {
+                return false;
+            }
+            const cgltf_accessor *positions = nullptr;
+            for (cgltf_size i = 0; i < primitive.attributes_count; i++)
+            {
+                if (primitive.attributes[i].type == cgltf_attribute_type_position)
+                {
+                    positions = primitive.attributes[i].data;
+                }
+            }
+            if (!positions || positions->type != cgltf_type_vec3 || !positions->buffer_view || !positions->buffer_view->buffer->data)
+            {
+                return false;
+            }
+
+            const auto baseVertex = static_cast<uint32_t>(mesh.positions.size());
+            mesh.positions.resize(baseVertex + positions->count);
+            cgltf_accessor_unpack_floats(positions, &mesh.positions[baseVertex].x, positions->count * 3);
+
+            if (primitive.indices)
+            {
+                if (!primitive.indices->buffer_view || !primitive.indices->buffer_view->buffer->data)
+                {
+                    return false;
+                }
+                for (cgltf_size i = 0; i < primitive.indices->count; i++)
+                {
+                    auto index = cgltf_accessor_read_index(primitive.indices, i);
+                    if (index >= positions->count)
+                    {
+                        return false;
+                    }
+                    mesh.indices.push_back(baseVertex + static_cast<uint32_t>(index));
+                }
+            }
+            else
+            {
+                for (uint32_t i = 0; i < positions->count; i++)
+                {
+                    mesh.indices.push_back(baseVertex + i);
+                }
+            }
+            return true;
+        }
+    }
+
+    float RayPicker::intersect(const Aabb &box, const PickingMesh *mesh, const mat4f &transform,
+                               const float3 &origin, const float3 &direction, float maxT)
+    {
+        // intersect in object space; since the transform is affine, t is unchanged
+        auto inverseTransform = inverse(transform);
+        const float3 localOrigin = (inverseTransform * float4(origin, 1.0f)).xyz;
+        const float3 localDirection = (inverseTransform * float4(direction, 0.0f)).xyz;
+
+        float t;
+        if (!DynamicAabbTree::intersects(box, localOrigin, 1.0f / localDirection, maxT, t))
+        {
+            return maxT;
+        }
+        if (mesh)
+        {
+            return intersectTriangles(*mesh, localOrigin, localDirection, maxT);
+        }
+        return t;
+    }
+
+    void RayPicker::setPickingMesh(utils::Entity entity, std::shared_ptr<const PickingMesh> mesh)
+    {
+        if (!mesh)
+        {
+            removePickingMesh(entity);
+            return;
+        }
+        for (auto index : mesh->indices)
+        {
+            if (index >= mesh->positions.size())
+            {
+                Log("Index %d out of range (%d positions), not using triangles for entity %d", index, mesh->positions.size(), utils::Entity::smuggle(entity));
+                return;
+            }
+        }
+        mMeshes[entity] = std::move(mesh);
+    }
+
+    void RayPicker::removePickingMesh(utils::Entity entity)
+    {
+        mMeshes.erase(entity);
+    }
+
+    bool RayPicker::addSceneAsset(SceneAsset *asset)
+    {
+        switch (asset->getType())
+        {
+        case SceneAsset::SceneAssetType::Geometry:
+        {
+            auto *geometry = static_cast<GeometrySceneAsset *>(asset);
+            if (!geometry->getPickingMesh())
+            {
+                return false;
+            }
+            // the picking mesh is in the renderable's (possibly quantized) space
+            setPickingMesh(geometry->getRenderableEntity(), geometry->getPickingMesh());
+            for (size_t i = 0; i < geometry->getInstanceCount(); i++)
+            {
+                auto *instance = static_cast<GeometrySceneAsset *>(geometry->getInstanceAt(i));
+                setPickingMesh(instance->getRenderableEntity(), geometry->getPickingMesh());
+            }
+            return true;
+        }
+        case SceneAsset::SceneAssetType::Gltf:
+        {
+            if (asset->isInstance())
+            {
+                auto *instance = static_cast<GltfSceneAssetInstance *>(asset);
+                auto *owner = static_cast<GltfSceneAsset *>(instance->getInstanceOwner());
+                return addGltfInstance(owner->getAsset(), instance->getInstance());
+            }
+            auto *filamentAsset = static_cast<GltfSceneAsset *>(asset)->getAsset();
+            bool added = false;
+            for (size_t i = 0; i < filamentAsset->getAssetInstanceCount(); i++)
+            {
+                added |= addGltfInstance(filamentAsset, filamentAsset->getAssetInstances()[i]);
+            }
+            return added;
+        }
+        case SceneAsset::SceneAssetType::InstancedGeometry:
+        {
+            auto *instanced = static_cast<InstancedGeometrySceneAsset *>(asset);
+            for (size_t i = 0; i < instanced->getChildEntityCount(); i++)
+            {
+                mInstanced[instanced->getChildEntities()[i]] = instanced;
+            }
+            return instanced->getPickingMesh() != nullptr;
+        }
+        default:
+            return false;
+        }
+    }
+
+    void RayPicker::removeSceneAsset(SceneAsset *asset)
+    {
+        for (auto it = mInstanced.begin(); it != mInstanced.end();)
+        {
+            if (it->second == asset)
+            {
+                it = mInstanced.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        removePickingMesh(asset->getEntity());
+        for (size_t i = 0; i < asset->getChildEntityCount(); i++)
+        {
+            removePickingMesh(asset->getChildEntities()[i]);
+        }
+        for (size_t i = 0; i < asset->getInstanceCount(); i++)
+        {
+            auto *instance = asset->getInstanceAt(i);
+            removePickingMesh(instance->getEntity());
+            for (size_t j = 0; j < instance->getChildEntityCount(); j++)
+            {
+                removePickingMesh(instance->getChildEntities()[j]);
+            }
+        }
+    }
+
+    bool RayPicker::addGltfInstance(gltfio::FilamentAsset *asset, gltfio::FilamentInstance *instance)
+    {
+        auto *data = static_cast<const cgltf_data *>(asset->getSourceAsset());
+        if (!data)
+        {
+            Log("glTF source data has been released, cannot add triangles for picking");
+            return false;
+        }
+
+        // picking falls back to bounding boxes if the nodes can't be matched to the entities
+        auto nodes = getGltfSourceNodes(data, instance);
+        if (nodes.empty())
+        {
+            Log("Not using triangles for picking");
+            return false;
+        }
+        const auto *entities = instance->getEntities();
+
+        // nodes that share a mesh share its triangles
+        std::unordered_map<const cgltf_mesh *, std::shared_ptr<const PickingMesh>> meshes;
+        bool added = false;
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            auto *gltfMesh = nodes[i]->mesh;
+            if (!gltfMesh)
+            {
+                continue;
+            }
+            auto it = meshes.find(gltfMesh);
+            if (it == meshes.end())
+            {
+                auto mesh = std::make_shared<PickingMesh>();
+                for (cgltf_size j = 0; j < gltfMesh->primitives_count; j++)
+                {
+                    // if any primitive can't be read, only the bounding box is used
+                    if (!appendPrimitive(gltfMesh->primitives[j], *mesh))
+                    {
+                        mesh.reset();
+                        break;
+                    }
+                }
+                it = meshes.emplace(gltfMesh, mesh).first;
+            }
+            if (it->second)
+            {
+                setPickingMesh(entities[i], it->second);
+                added = true;
+            }
+        }
+        return added;
+    }
+
+    void RayPicker::sync(Scene *scene, uint8_t layerMask)
+    {
+        TRACE_SCOPE("RayPicker::sync");
+        auto &rm = mEngine->getRenderableManager();
+        auto &tm = mEngine->getTransformManager();
+        mGeneration++;
+
+        scene->forEach([&](utils::Entity entity)
+                       {
+            auto ri = rm.getInstance(entity);
+            if (!ri.isValid() || !(rm.getLayerMask(ri) & layerMask))
+            {
+                return;
+            }
+            const auto &box = rm.getAxisAlignedBoundingBox(ri);
+            Aabb worldBox{box.getMin(), box.getMax()};
+            auto ti = tm.getInstance(entity);
+            if (ti.isValid())
+            {
+                worldBox = worldBox.transform(tm.getWorldTransform(ti));
+            }
+            auto it = mProxies.find(entity);
+            if (it == mProxies.end())
+            {
+                mProxies.emplace(entity, Proxy{mTree.createProxy(worldBox, utils::Entity::smuggle(entity)), mGeneration});
+            }
+            else
+            {
+                mTree.moveProxy(it->second.proxyId, worldBox);
+                it->second.generation = mGeneration;
+            } });
+
+        // drop renderables that have been removed from the scene (or filtered out by the layer mask)
+        for (auto it = mProxies.begin(); it != mProxies.end();)
+        {
+            if (it->second.generation != mGeneration)
+            {
+                mTree.destroyProxy(it->second.proxyId);
+                it = mProxies.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    size_t RayPicker::pick(Scene *scene, uint8_t layerMask, const Ray *rays, size_t numRays, bool refine, RayHit *hits)
+    {
+        TRACE_SCOPE("RayPicker::pick");
+        sync(scene, layerMask);
+
+        auto &rm = mEngine->getRenderableManager();
+        auto &tm = mEngine->getTransformManager();
+        size_t numHits = 0;
+
+        for (size_t r = 0; r < numRays; r++)
+        {
+            auto &hit = hits[r];
+            hit = RayHit();
+            const float3 origin = rays[r].origin;
+            const float directionLength = length(rays[r].direction);
+            if (directionLength == 0.0f)
+            {
+                continue;
+            }
+            // with a unit direction, t is the distance along the ray
+            const float3 direction = rays[r].direction / directionLength;
+
+            mTree.rayCast(origin, direction, std::numeric_limits<float>::infinity(), [&](int32_t proxyId)
+                          {
+                auto entity = utils::Entity::import(mTree.getUserData(proxyId));
+
+                auto instanced = mInstanced.find(entity);
+                if (instanced != mInstanced.end())
+                {
+                    int32_t instance;
+                    float t = instanced->second->intersect(origin, direction, hit.distance, refine, instance);
+                    if (t < hit.distance)
+                    {
+                        hit.entity = entity;
+                        hit.distance = t;
+                        hit.instance = instance;
+                    }
+                    return hit.distance;
+                }
+
+                auto ri = rm.getInstance(entity);
+                const auto &box = rm.getAxisAlignedBoundingBox(ri);
+                auto ti = tm.getInstance(entity);
+                const PickingMesh *mesh = nullptr;
+                if (refine)
+                {
+                    auto it = mMeshes.find(entity);
+                    mesh = it == mMeshes.end() ? nullptr : it->second.get();
+                }
+                float t = intersect({box.getMin(), box.getMax()}, mesh,
+                                    ti.isValid() ? tm.getWorldTransform(ti) : mat4f(),
+                                    origin, direction, hit.distance);
+                if (t < hit.distance)
+                {
+                    hit.entity = entity;
+                    hit.distance = t;
+                    hit.instance = -1;
+                }
+                return hit.distance; });
+
+            if (!hit.entity.isNull())
+            {
+                hit.position = origin + direction * hit.distance;
+                numHits++;
+            }
+        }
+        return numHits;
+    }
+
+    Ray RayPicker::getViewRay(const View *view, float x, float y)
+    {
+        const auto &viewport = view->getViewport();
+        const auto &camera = view->getCamera();
+        // NDC, with the same bottom-left origin as View::pick
+        double ndcX = 2.0 * (x - viewport.left) / viewport.width - 1.0;
+        double ndcY = 2.0 * (y - viewport.bottom) / viewport.height - 1.0;
+
+        // the culling projection has a finite far plane (unlike the projection used for rendering)
+        auto inverseViewProjection = inverse(camera.getCullingProjectionMatrix() * camera.getViewMatrix());
+        auto nearPoint = inverseViewProjection * double4(ndcX, ndcY, -1.0, 1.0);
+        auto farPoint = inverseViewProjection * double4(ndcX, ndcY, 1.0, 1.0);
+        auto origin = nearPoint.xyz / nearPoint.w;
+        auto direction = farPoint.xyz / farPoint.w - origin;
+        return {float3(origin), float3(normalize(direction))};
+    }
+
+} // namespace thermion
@@ -3,6 +3,7 @@ import 'dart:typed_data';
 import 'package:animation_tools_dart/animation_tools_dart.dart';
 import 'package:test/test.dart';
 import 'package:thermion_dart/src/bindings/bindings.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_filament_app.dart';
 import 'package:thermion_dart/thermion_dart.dart';
 import 'helpers.dart';
 
@@ -103,4 +104,78 @@ void main() async {
       await testHelper.capture(viewer.view, "gltf_asset_destroyed");
     }, bg: kRed);
   });
+
+  test('fixed time step advances the animation clock deterministically',
+      () async {
+    await testHelper.withViewer((viewer) async {
+      final app = FilamentApp.instance as FFIFilamentApp;
+      final animationManager = (viewer as ThermionViewerFFI).animationManager;
+      await viewer.setRendering(false);
+
+      final stepInNanos = (1e9 / 60).round();
+      AnimationManager_setFixedTimeStep(animationManager, stepInNanos);
+
+      final schedulerStats = calloc<TFrameSchedulerStats>();
+      final weights = calloc<Float>(1);
+
+      // plays a glTF node animation and a morph animation for [numFrames]
+      // rendered frames, then returns every animated node transform and the
+      // morph target weight
+      Future<List<double>> run(int numFrames) async {
+        final drone = await viewer
+            .loadGltf("${testHelper.testDir}/assets/BusterDrone/scene.gltf");
+        final cube = await viewer.loadGltf(
+            "${testHelper.testDir}/assets/cube_with_morph_targets.glb");
+        await viewer.addToScene(drone);
+        await viewer.addToScene(cube);
+
+        await drone.playGltfAnimation(0, loop: true);
+        await cube.setMorphAnimationData(MorphAnimationData(
+            Float32List.fromList(List.generate(30, (i) => i / 29)), ["Key 1"],
+            frameLengthInMs: 1000.0 / 24.0));
+
+        final start = AnimationManager_getTime(animationManager);
+        RenderTicker_getFrameSchedulerStats(app.renderTicker, schedulerStats);
+        final framesRendered = schedulerStats.ref.framesRendered;
+
+        // frames that beginFrame skips don't advance the clock, so keep
+        // going until exactly [numFrames] have been rendered
+        var rendered = 0;
+        while (rendered < numFrames) {
+          await viewer.render();
+          RenderTicker_getFrameSchedulerStats(app.renderTicker, schedulerStats);
+          rendered = schedulerStats.ref.framesRendered - framesRendered;
+          expect(AnimationManager_getTime(animationManager) - start,
+              rendered * stepInNanos);
+        }
+
+        final output = <double>[];
+        for (final entity in await drone.getChildEntities()) {
+          output.addAll((await drone.getLocalTransform(entity: entity)).storage);
+        }
+        final morphEntity = (await cube.getChildEntities()).first;
+        expect(
+            AnimationManager_getMorphTargetWeights(
+                animationManager, morphEntity, weights, 1),
+            1);
+        expect(weights[0], greaterThan(0.0));
+        output.add(weights[0]);
+
+        await viewer.destroyAsset(drone);
+        await viewer.destroyAsset(cube);
+        return output;
+      }
+
+      final first = await run(30);
+      final second = await run(30);
+
+      // the clock only ever advances in whole steps, so both runs sample
+      // the animations at exactly the same times
+      expect(second, orderedEquals(first));
+
+      calloc.free(schedulerStats);
+      calloc.free(weights);
+      AnimationManager_setFixedTimeStep(animationManager, 0);
+    }, bg: kRed);
+  });
 }
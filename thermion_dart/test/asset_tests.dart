@@ -2,6 +2,10 @@
 import 'dart:io';
 
 import 'package:test/test.dart';
+import 'package:thermion_dart/src/bindings/bindings.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_asset.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_filament_app.dart';
+import 'package:thermion_dart/thermion_dart.dart';
 import 'package:vector_math/vector_math_64.dart';
 import 'helpers.dart';
 
@@ -66,6 +70,90 @@ void main() async {
     }, cameraPosition: Vector3(0, 0, 5));
   });
 
+  test('async load gltf from buffer reports progress', () async {
+    await testHelper.withViewer((viewer) async {
+      var assetData =
+          File("${testHelper.testDir}/assets/cube.gltf").readAsBytesSync();
+      final progress = <double>[];
+      var asset = await viewer.loadGltfFromBuffer(assetData,
+          resourceUri: "${testHelper.testDir}/assets",
+          loadResourcesAsync: true,
+          onProgress: progress.add);
+      expect(progress, isNotEmpty);
+      expect(progress.last, 1.0);
+      for (int i = 1; i < progress.length; i++) {
+        expect(progress[i], greaterThanOrEqualTo(progress[i - 1]));
+      }
+      await viewer
+          .loadIbl("file://${testHelper.testDir}/assets/default_env_ibl.ktx");
+      await testHelper.capture(viewer.view, "gltf_async_load_from_buffer");
+      await viewer.destroyAsset(asset);
+    }, cameraPosition: Vector3(0, 0, 5));
+  });
+
+  test('load gltf from file matches load from buffer', () async {
+    await testHelper.withViewer((viewer) async {
+      final app = FilamentApp.instance as FFIFilamentApp;
+      final path = "${testHelper.testDir}/assets/cube.gltf";
+      // the test helper provides its own resource loader, so viewer.loadGltf
+      // reads files into Dart buffers; load the file directly instead
+      var mapped = await app.loadGltfFromFile(
+          path, viewer.animationManager);
+      await viewer.addToScene(mapped);
+      var buffered = await viewer.loadGltfFromBuffer(
+          File(path).readAsBytesSync(),
+          resourceUri: "${testHelper.testDir}/assets");
+      var mappedBounds = await mapped.getBoundingBox();
+      var bufferedBounds = await buffered.getBoundingBox();
+      expect(mappedBounds.min, bufferedBounds.min);
+      expect(mappedBounds.max, bufferedBounds.max);
+      await viewer.destroyAsset(mapped);
+      await viewer.destroyAssets();
+
+      await expectLater(
+          app.loadGltfFromFile(
+              "${testHelper.testDir}/assets/missing.glb", nullptr),
+          throwsException);
+    }, cameraPosition: Vector3(0, 0, 5));
+  });
+
+  test('glTF asset cache returns instances of previously loaded assets',
+      () async {
+    await testHelper.withViewer((viewer) async {
+      final app = FilamentApp.instance as FFIFilamentApp;
+      await app.enableGltfAssetCache(budgetInBytes: 0);
+      final path = "${testHelper.testDir}/assets/cube.glb";
+      final stats = calloc<TGltfAssetCacheStats>();
+
+      var first = await app.loadGltfFromFile(path, viewer.animationManager)
+          as FFIAsset;
+      var second = await app.loadGltfFromFile(path, viewer.animationManager)
+          as FFIAsset;
+      expect(first.isInstance, isTrue);
+      expect(second.isInstance, isTrue);
+      expect(first.entity, isNot(second.entity));
+
+      GltfAssetCache_getStats(app.gltfAssetCache!, stats);
+      expect(stats.ref.misses, 1);
+      expect(stats.ref.hits, 1);
+      expect(stats.ref.entryCount, 1);
+      expect(stats.ref.instancesInUse, 2);
+
+      // the entry is over budget, but is only evicted once unused
+      await app.destroyAsset(first);
+      GltfAssetCache_getStats(app.gltfAssetCache!, stats);
+      expect(stats.ref.evictions, 0);
+      await app.destroyAsset(second);
+      GltfAssetCache_getStats(app.gltfAssetCache!, stats);
+      expect(stats.ref.evictions, 1);
+      expect(stats.ref.entryCount, 0);
+      expect(stats.ref.sizeInBytes, 0);
+
+      calloc.free(stats);
+      await app.disableGltfAssetCache();
+    });
+  });
+
   test('transform gltf to unit cube', () async {
     await testHelper.withViewer((viewer) async {
       var asset = await viewer
@@ -0,0 +1,57 @@
+import 'package:thermion_dart/src/bindings/bindings.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_filament_app.dart';
+import 'package:thermion_dart/thermion_dart.dart';
+import 'package:test/test.dart';
+import 'helpers.dart';
+
+void main() async {
+  final testHelper = TestHelper("collision");
+  await testHelper.setup();
+
+  test('collideAll reflects transforms set after colliders are added',
+      () async {
+    await testHelper.withViewer((viewer) async {
+      final app = FilamentApp.instance as FFIFilamentApp;
+      final collisionManager =
+          await withPointerCallback<TCollisionComponentManager>((cb) =>
+              CollisionManager_createRenderThread(app.transformManager, cb));
+
+      final box = calloc<Aabb3>();
+      box.ref
+        ..halfExtentX = 1
+        ..halfExtentY = 1
+        ..halfExtentZ = 1;
+      final cubes = [
+        for (int i = 0; i < 2; i++)
+          await viewer
+              .createGeometry(GeometryHelper.cube(normals: false, uvs: false))
+      ];
+      for (final cube in cubes) {
+        await withVoidCallback((requestId, onComplete) =>
+            CollisionManager_addComponentRenderThread(collisionManager,
+                cube.entity, box.ref, nullptr, false, requestId, onComplete));
+      }
+      calloc.free(box);
+
+      final pairs = calloc<EntityId>(2);
+      Future<int> collideAll() => withUInt32Callback((cb) =>
+          CollisionManager_collideAllRenderThread(
+              collisionManager, pairs, 1, cb));
+
+      expect(await collideAll(), 1);
+      expect({pairs[0], pairs[1]}, {cubes[0].entity, cubes[1].entity});
+
+      // move the second cube well beyond the broadphase margin
+      await cubes[1].setTransform(Matrix4.translation(Vector3(100, 0, 0)));
+      expect(await collideAll(), 0);
+
+      await cubes[0].setTransform(Matrix4.translation(Vector3(99.5, 0, 0)));
+      expect(await collideAll(), 1);
+
+      calloc.free(pairs);
+      await withVoidCallback((requestId, onComplete) =>
+          CollisionManager_destroyRenderThread(
+              collisionManager, requestId, onComplete));
+    });
+  });
+}
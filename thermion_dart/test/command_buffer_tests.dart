@@ -0,0 +1,70 @@
+// ignore_for_file: unused_local_variable
+
+import 'package:thermion_dart/src/filament/src/implementation/ffi_filament_app.dart';
+import 'package:thermion_dart/thermion_dart.dart';
+import 'package:test/test.dart';
+import 'helpers.dart';
+
+void main() async {
+  final testHelper = TestHelper("command_buffer");
+  await testHelper.setup();
+
+  const numUpdates = 10000;
+
+  test('set transforms (per-call vs command buffer)', () async {
+    await testHelper.withViewer((viewer) async {
+      final app = FilamentApp.instance as FFIFilamentApp;
+      final cube = await viewer
+          .createGeometry(GeometryHelper.cube(normals: false, uvs: false));
+      await viewer.addToScene(cube);
+
+      final transforms = List.generate(
+          numUpdates,
+          (i) => matrix4ToDouble4x4(
+              Matrix4.translation(Vector3(i / numUpdates, 0, 0))));
+
+      var stopwatch = Stopwatch()..start();
+      await Future.wait(transforms.map((transform) =>
+          withVoidCallback((requestId, onComplete) {
+            TransformManager_setTransformRenderThread(app.transformManager,
+                cube.entity, transform, requestId, onComplete);
+          })));
+      stopwatch.stop();
+      final perCallMs = stopwatch.elapsedMicroseconds / 1000;
+      expect(
+          TransformManager_getWorldTransform(app.transformManager, cube.entity)
+              .col4[0],
+          closeTo((numUpdates - 1) / numUpdates, 0.0001));
+
+      // applied in reverse, so the final transform differs from the per-call run
+      final commands = calloc<TSetTransformCommand>(numUpdates);
+      stopwatch
+        ..reset()
+        ..start();
+      for (int i = 0; i < numUpdates; i++) {
+        final command = commands[i];
+        command.header.opcode = TCommandOpcode.COMMAND_TRANSFORM_SET_TRANSFORM;
+        command.header.size = sizeOf<TSetTransformCommand>();
+        command.tTransformManager = app.transformManager;
+        command.entityId = cube.entity;
+        command.transform = transforms[numUpdates - 1 - i];
+      }
+      await withVoidCallback((requestId, onComplete) {
+        RenderThread_submitCommands(commands.cast<Uint8>(),
+            numUpdates * sizeOf<TSetTransformCommand>(), requestId, onComplete);
+      });
+      stopwatch.stop();
+      final commandBufferMs = stopwatch.elapsedMicroseconds / 1000;
+      calloc.free(commands);
+
+      print(
+          "$numUpdates transform updates: ${perCallMs}ms per-call, ${commandBufferMs}ms command buffer");
+
+      final worldTransform =
+          TransformManager_getWorldTransform(app.transformManager, cube.entity);
+      expect(worldTransform.col4[0], closeTo(0, 0.0001));
+
+      await testHelper.capture(viewer.view, "command_buffer_set_transform");
+    });
+  });
+}
@@ -1,6 +1,10 @@
 // ignore_for_file: unused_local_variable
 import 'dart:io';
 import 'dart:math';
+import 'package:thermion_dart/src/bindings/bindings.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_asset.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_filament_app.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_view.dart';
 import 'package:thermion_dart/thermion_dart.dart';
 import 'package:test/test.dart';
 import 'package:vector_math/vector_math_64.dart';
@@ -43,6 +47,233 @@ void main() async {
       });
     });
 
+    test('geometry with 32-bit indices', () async {
+      await testHelper.withViewer((viewer) async {
+        final app = FilamentApp.instance as FFIFilamentApp;
+        // a 257x257 grid of vertices (more than a 16-bit index can address)
+        const n = 257;
+        final vertices = calloc<Float>(n * n * 3);
+        for (int y = 0; y < n; y++) {
+          for (int x = 0; x < n; x++) {
+            final i = (y * n) + x;
+            vertices[i * 3] = x / (n - 1);
+            vertices[(i * 3) + 1] = y / (n - 1);
+            vertices[(i * 3) + 2] = 0;
+          }
+        }
+        final numIndices = (n - 1) * (n - 1) * 6;
+        final indices = calloc<Uint32>(numIndices);
+        int offset = 0;
+        for (int y = 0; y < n - 1; y++) {
+          for (int x = 0; x < n - 1; x++) {
+            final i = (y * n) + x;
+            for (final index in [i, i + 1, i + n, i + 1, i + n + 1, i + n]) {
+              indices[offset++] = index;
+            }
+          }
+        }
+
+        final asset = await withPointerCallback<TSceneAsset>((cb) =>
+            SceneAsset_createGeometryUint32RenderThread(
+                app.engine,
+                vertices,
+                n * n * 3,
+                nullptr,
+                0,
+                nullptr,
+                0,
+                indices,
+                numIndices,
+                PrimitiveType.TRIANGLES.index,
+                true,
+                nullptr,
+                0,
+                cb));
+        calloc.free(vertices);
+        calloc.free(indices);
+        expect(asset, isNot(nullptr));
+
+        final box = SceneAsset_getBoundingBox(asset);
+        expect(box.centerX, closeTo(0.5, 0.001));
+        expect(box.halfExtentY, closeTo(0.5, 0.001));
+        // pickable, so the triangles are available to simplify
+        expect(
+            await withBoolCallback(
+                (cb) => SceneAsset_generateLodsRenderThread(asset, 2, 0.5, cb)),
+            true);
+        await withVoidCallback((requestId, onComplete) =>
+            SceneAsset_destroyRenderThread(asset, requestId, onComplete));
+      });
+    });
+
+    test('geometry with quantized vertex formats', () async {
+      await testHelper.withViewer((viewer) async {
+        final app = FilamentApp.instance as FFIFilamentApp;
+        final cube = GeometryHelper.cube();
+        final vertices = calloc<Float>(cube.vertices.length);
+        vertices.asTypedList(cube.vertices.length).setAll(0, cube.vertices);
+        final normals = calloc<Float>(cube.normals.length);
+        normals.asTypedList(cube.normals.length).setAll(0, cube.normals);
+        final uvs = calloc<Float>(cube.uvs.length);
+        uvs.asTypedList(cube.uvs.length).setAll(0, cube.uvs);
+        final indices = calloc<Uint32>(cube.indices.length);
+        indices.asTypedList(cube.indices.length).setAll(0, cube.indices);
+
+        final format = calloc<TVertexFormat>();
+        format.ref.positions = TPositionFormat.POSITION_FORMAT_SHORT4;
+        format.ref.halfUVs = true;
+        format.ref.shortTangents = true;
+
+        final asset = await withPointerCallback<TSceneAsset>((cb) =>
+            SceneAsset_createGeometryWithFormatRenderThread(
+                app.engine,
+                vertices,
+                cube.vertices.length,
+                normals,
+                cube.normals.length,
+                uvs,
+                cube.uvs.length,
+                nullptr,
+                0,
+                indices,
+                cube.indices.length,
+                PrimitiveType.TRIANGLES.index,
+                false,
+                format.ref,
+                false,
+                nullptr,
+                nullptr,
+                0,
+                cb));
+        calloc.free(vertices);
+        calloc.free(normals);
+        calloc.free(uvs);
+        calloc.free(indices);
+        calloc.free(format);
+        expect(asset, isNot(nullptr));
+
+        // the renderable (with the decode transform) is a child of the asset's entity
+        expect(SceneAsset_getChildEntityCount(asset), 1);
+        final box = SceneAsset_getBoundingBox(asset);
+        expect(box.centerX, closeTo(0, 0.001));
+        expect(box.halfExtentX, closeTo(1, 0.001));
+        // not pickable, so no CPU-side copy of the triangles was kept
+        expect(
+            await withBoolCallback(
+                (cb) => SceneAsset_generateLodsRenderThread(asset, 2, 0.5, cb)),
+            false);
+        await withVoidCallback((requestId, onComplete) =>
+            SceneAsset_destroyRenderThread(asset, requestId, onComplete));
+      });
+    });
+
+    test('optimized geometry', () async {
+      await testHelper.withViewer((viewer) async {
+        final app = FilamentApp.instance as FFIFilamentApp;
+        // an unindexed quad (two triangles sharing two duplicated vertices)
+        final quad = [
+          0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, //
+          1.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 1.0, 0.0
+        ];
+        final vertices = calloc<Float>(quad.length);
+        vertices.asTypedList(quad.length).setAll(0, quad);
+        final indices = calloc<Uint32>(6);
+        indices.asTypedList(6).setAll(0, [0, 1, 2, 3, 4, 5]);
+        final format = calloc<TVertexFormat>();
+        final report = calloc<TOptimizationReport>();
+
+        final asset = await withPointerCallback<TSceneAsset>((cb) =>
+            SceneAsset_createGeometryWithFormatRenderThread(
+                app.engine,
+                vertices,
+                quad.length,
+                nullptr,
+                0,
+                nullptr,
+                0,
+                nullptr,
+                0,
+                indices,
+                6,
+                PrimitiveType.TRIANGLES.index,
+                false,
+                format.ref,
+                true,
+                report,
+                nullptr,
+                0,
+                cb));
+        calloc.free(vertices);
+        calloc.free(indices);
+        calloc.free(format);
+        expect(asset, isNot(nullptr));
+
+        // the two duplicated vertices are merged
+        expect(report.ref.vertexCountBefore, 6);
+        expect(report.ref.vertexCountAfter, 4);
+        expect(report.ref.acmrAfter,
+            lessThanOrEqualTo(report.ref.acmrBefore));
+        calloc.free(report);
+
+        final box = SceneAsset_getBoundingBox(asset);
+        expect(box.centerX, closeTo(0.5, 0.001));
+        expect(box.halfExtentY, closeTo(0.5, 0.001));
+        await withVoidCallback((requestId, onComplete) =>
+            SceneAsset_destroyRenderThread(asset, requestId, onComplete));
+      });
+    });
+
+    test('geometry levels of detail', () async {
+      await testHelper.withViewer((viewer) async {
+        final app = FilamentApp.instance as FFIFilamentApp;
+        final view = await viewer.view as FFIView;
+        final sphere = await viewer.createGeometry(GeometryHelper.sphere());
+        await viewer.addToScene(sphere);
+        final asset = (sphere as FFIAsset).asset;
+
+        expect(
+            await withBoolCallback(
+                (cb) => SceneAsset_generateLodsRenderThread(asset, 3, 0.5, cb)),
+            true);
+        final lodManager = await withPointerCallback<TLodManager>(
+            (cb) => LodManager_createRenderThread(app.engine, view.view, cb));
+        RenderTicker_setLodManager(app.renderTicker, lodManager);
+        expect(
+            await withBoolCallback((cb) =>
+                LodManager_addComponentRenderThread(lodManager, asset, cb)),
+            true);
+
+        // the simplified levels are generated in the background and uploaded before a frame
+        for (int i = 0;
+            i < 100 && SceneAsset_getLodLevelCount(asset) < 3;
+            i++) {
+          await viewer.render();
+        }
+        expect(SceneAsset_getLodLevelCount(asset), 3);
+        final triangles =
+            List.generate(3, (i) => SceneAsset_getLodTriangleCount(asset, i));
+        expect(triangles[1], lessThan(triangles[0]));
+        expect(triangles[2], lessThan(triangles[1]));
+
+        LodManager_setBias(lodManager, 20);
+        await viewer.render();
+        expect(LodManager_getCurrentLevel(lodManager, sphere.entity), 2);
+
+        LodManager_setBias(lodManager, -20);
+        await viewer.render();
+        expect(LodManager_getCurrentLevel(lodManager, sphere.entity), 0);
+
+        RenderTicker_setLodManager(app.renderTicker, nullptr);
+        await withVoidCallback((requestId, onComplete) =>
+            LodManager_removeComponentRenderThread(
+                lodManager, sphere.entity, requestId, onComplete));
+        await withVoidCallback((requestId, onComplete) =>
+            LodManager_destroyRenderThread(lodManager, requestId, onComplete));
+        await viewer.removeFromScene(sphere);
+        await viewer.destroyAsset(sphere);
+      });
+    });
+
     test('geometry with unlit (ubershader) material', () async {
       await testHelper.withViewer((viewer) async {
         final materialInstance = await FilamentApp.instance!
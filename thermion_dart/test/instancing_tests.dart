@@ -2,6 +2,7 @@
 import 'dart:math';
 
 import 'package:test/test.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_asset.dart';
 import 'package:thermion_dart/src/filament/src/interface/asset.dart';
 import 'package:thermion_dart/src/filament/src/interface/filament_app.dart';
 import 'package:thermion_dart/src/utils/src/geometry.dart';
@@ -110,6 +111,55 @@ void main() async {
     }, addSkybox: true);
   });
 
+  test('hardware instances of geometry asset', () async {
+    await testHelper.withViewer((viewer) async {
+      final cube = await viewer.createGeometry(GeometryHelper.cube(),
+          addToScene: false) as FFIAsset;
+
+      // a 10x10 grid of cubes, drawn with instance buffers
+      final instanced = await cube.createInstanced(100);
+      expect(instanced.isInstance, true);
+
+      final transforms = [
+        for (int i = 0; i < 100; i++)
+          Matrix4.compose(Vector3((i % 10) * 2.0 - 9.0, 0, (i ~/ 10) * -2.0),
+              Quaternion.identity(), Vector3.all(0.5))
+      ];
+      await instanced.setInstanceTransforms(transforms);
+      await viewer.addToScene(instanced);
+
+      // every renderable draws a batch of instances, so there are far fewer
+      // renderables than instances
+      final renderables = await instanced.getChildEntities();
+      expect(renderables, isNotEmpty);
+      expect(renderables.length, lessThan(100));
+
+      final camera = await viewer.getActiveCamera();
+      await camera.lookAt(Vector3(0, 15, 10), focus: Vector3(0, 0, -9));
+      await testHelper.capture(viewer.view, "hardware_instances");
+
+      // a subset of the instances can be moved on its own
+      await instanced.setInstanceTransforms([
+        for (int i = 0; i < 10; i++)
+          Matrix4.compose(Vector3(i * 2.0 - 9.0, 2.0, 0),
+              Quaternion.identity(), Vector3.all(0.5))
+      ], offset: 0);
+      await testHelper.capture(viewer.view, "hardware_instances_first_row_moved");
+
+      // ranges past the last instance are rejected
+      await expectLater(instanced.setInstanceTransforms(transforms, offset: 1),
+          throwsA(isA<Exception>()));
+
+      // hardware instances can't be created from non-geometry assets
+      await expectLater(instanced.createInstanced(2),
+          throwsA(isA<Exception>()));
+
+      await viewer.removeFromScene(instanced);
+      await viewer.destroyAsset(instanced);
+      await testHelper.capture(viewer.view, "hardware_instances_destroyed");
+    }, bg: kRed);
+  });
+
   // test('physics simulation with 100 instances', () async {
   //   await testHelper.withViewer((viewer) async {
   //     // --- Scene Setup ---
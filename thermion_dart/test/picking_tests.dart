@@ -1,4 +1,8 @@
 import 'dart:async';
+import 'package:thermion_dart/src/bindings/bindings.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_asset.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_filament_app.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_view.dart';
 import 'package:thermion_dart/thermion_dart.dart';
 import 'package:test/test.dart';
 import 'helpers.dart';
@@ -33,5 +37,140 @@ void main() async {
         expect(result.entity, cube.entity);
       }, cameraPosition: Vector3(0, 0, 10));
     });
+
+    test('ray pick cube synchronously', () async {
+      await testHelper.withViewer((viewer) async {
+        final app = FilamentApp.instance as FFIFilamentApp;
+        final cube = await viewer
+            .createGeometry(GeometryHelper.cube(normals: false, uvs: false));
+        await viewer.addToScene(cube);
+        final view = await viewer.view as FFIView;
+        final viewport = await view.getViewport();
+
+        final rayPicker = await withPointerCallback<TRayPicker>(
+            (cb) => RayPicker_createRenderThread(app.engine, cb));
+        expect(
+            await withBoolCallback((cb) => RayPicker_addSceneAssetRenderThread(
+                rayPicker, (cube as FFIAsset).asset, cb)),
+            true);
+
+        final hit = calloc<TRayHit>();
+        expect(
+            await withBoolCallback((cb) => RayPicker_pickViewRenderThread(
+                rayPicker,
+                view.view,
+                viewport.width ~/ 2,
+                viewport.height ~/ 2,
+                true,
+                hit,
+                cb)),
+            true);
+        expect(hit.ref.entity, cube.entity);
+        // the camera is at z=10, the front face of the (unit) cube at z=1
+        expect(hit.ref.distance, closeTo(9, 0.01));
+        expect(hit.ref.position.z, closeTo(1, 0.01));
+
+        // a batch of rays from the side; only the first hits the cube
+        final rays = calloc<TRay>(2);
+        rays[0].origin
+          ..x = 10
+          ..y = 0
+          ..z = 0;
+        rays[0].direction
+          ..x = -1
+          ..y = 0
+          ..z = 0;
+        rays[1].origin
+          ..x = 10
+          ..y = 5
+          ..z = 0;
+        rays[1].direction
+          ..x = -1
+          ..y = 0
+          ..z = 0;
+        final hits = calloc<TRayHit>(2);
+        expect(
+            await withUInt32Callback((cb) => RayPicker_pickRenderThread(
+                rayPicker, view.view, rays, 2, true, hits, cb)),
+            1);
+        expect(hits[0].entity, cube.entity);
+        expect(hits[0].position.x, closeTo(1, 0.01));
+        expect(hits[1].entity, 0);
+
+        calloc.free(hit);
+        calloc.free(rays);
+        calloc.free(hits);
+        await withVoidCallback((requestId, cb) =>
+            RayPicker_destroyRenderThread(rayPicker, requestId, cb));
+      }, cameraPosition: Vector3(0, 0, 10));
+    });
+
+    test('ray pick hardware instance', () async {
+      await testHelper.withViewer((viewer) async {
+        final app = FilamentApp.instance as FFIFilamentApp;
+        final cube = await viewer
+            .createGeometry(GeometryHelper.cube(normals: false, uvs: false));
+        final view = await viewer.view as FFIView;
+        final viewport = await view.getViewport();
+
+        final instanced = await (cube as FFIAsset).createInstanced(3);
+
+        // instances at x = -3, 0 and 3
+        await instanced.setInstanceTransforms([
+          for (int i = 0; i < 3; i++)
+            Matrix4.translation(Vector3((i - 1) * 3.0, 0, 0))
+        ]);
+        await viewer.addToScene(instanced);
+
+        final rayPicker = await withPointerCallback<TRayPicker>(
+            (cb) => RayPicker_createRenderThread(app.engine, cb));
+        expect(
+            await withBoolCallback((cb) =>
+                RayPicker_addSceneAssetRenderThread(
+                rayPicker, instanced.asset, cb)),
+            true);
+
+        final hit = calloc<TRayHit>();
+        expect(
+            await withBoolCallback((cb) => RayPicker_pickViewRenderThread(
+                rayPicker,
+                view.view,
+                viewport.width ~/ 2,
+                viewport.height ~/ 2,
+                true,
+                hit,
+                cb)),
+            true);
+        expect(hit.ref.instance, 1);
+        expect(hit.ref.distance, closeTo(9, 0.01));
+
+        // from the side, the nearest instance is hit first
+        final ray = calloc<TRay>();
+        ray.ref.origin
+          ..x = 10
+          ..y = 0
+          ..z = 0;
+        ray.ref.direction
+          ..x = -1
+          ..y = 0
+          ..z = 0;
+        expect(
+            await withUInt32Callback((cb) => RayPicker_pickRenderThread(
+                rayPicker, view.view, ray, 1, true, hit, cb)),
+            1);
+        expect(hit.ref.instance, 2);
+        expect(hit.ref.position.x, closeTo(4, 0.01));
+
+        calloc.free(hit);
+        calloc.free(ray);
+        await withVoidCallback((requestId, cb) =>
+            RayPicker_removeSceneAssetRenderThread(
+                rayPicker, instanced.asset, requestId, cb));
+        await withVoidCallback((requestId, cb) =>
+            RayPicker_destroyRenderThread(rayPicker, requestId, cb));
+        await viewer.removeFromScene(instanced);
+        await viewer.destroyAsset(instanced);
+      }, cameraPosition: Vector3(0, 0, 10));
+    });
   
 }
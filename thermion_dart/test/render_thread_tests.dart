@@ -1,7 +1,11 @@
 import 'dart:async';
+import 'dart:convert';
 import 'dart:ffi';
+import 'dart:io';
 import 'package:test/test.dart';
 import 'package:thermion_dart/thermion_dart.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_filament_app.dart';
+import 'package:thermion_dart/src/filament/src/implementation/ffi_view.dart';
 
 import 'helpers.dart';
 
@@ -20,4 +24,151 @@ void main() async {
       await testHelper.capture(viewer.view, "render_thread_2");
     }, addSkybox: true);
   });
+
+  test("render thread does not wake up while idle", () async {
+    await testHelper.withViewer((viewer) async {
+      await viewer.setRendering(false);
+      await viewer.render();
+
+      final stats = calloc<TRenderThreadStats>();
+      RenderThread_getStats(stats);
+      final wakeups = stats.ref.wakeups;
+      final idleTimeInNanos = stats.ref.idleTimeInNanos;
+      final busyTimeInNanos = stats.ref.busyTimeInNanos;
+
+      await Future.delayed(Duration(seconds: 1));
+
+      RenderThread_getStats(stats);
+      final idleMs = (stats.ref.idleTimeInNanos - idleTimeInNanos) / 1e6;
+      final busyMs = (stats.ref.busyTimeInNanos - busyTimeInNanos) / 1e6;
+      print(
+          "Idle for ${idleMs}ms, busy for ${busyMs}ms, ${stats.ref.wakeups - wakeups} wakeups");
+      expect(stats.ref.wakeups - wakeups, lessThan(10));
+      calloc.free(stats);
+    });
+  });
+
+  test("frame requests are paced to the target frame interval", () async {
+    await testHelper.withViewer((viewer) async {
+      final app = FilamentApp.instance as FFIFilamentApp;
+      await viewer.setFrameRate(30);
+
+      final stats = calloc<TFrameSchedulerStats>();
+      RenderTicker_getFrameSchedulerStats(app.renderTicker, stats);
+      final framesRendered = stats.ref.framesRendered;
+
+      final stopwatch = Stopwatch()..start();
+      while (stopwatch.elapsedMilliseconds < 1000) {
+        RenderThread_requestFrameAsync();
+        await Future.delayed(Duration(milliseconds: 1));
+      }
+
+      RenderTicker_getFrameSchedulerStats(app.renderTicker, stats);
+      final frames = stats.ref.framesRendered - framesRendered;
+      print(
+          "$frames frames in 1s (${stats.ref.coalescedRequests} coalesced, ${stats.ref.lateFrames} late, ${stats.ref.droppedFrames} dropped)");
+      expect(stats.ref.frameIntervalInNanos, (1e9 / 30).round());
+      expect(frames, lessThanOrEqualTo(32));
+      calloc.free(stats);
+      RenderTicker_setTargetFrameInterval(app.renderTicker, 0);
+    });
+  });
+
+  test("frame requests without a swapchain wait until one is added",
+      () async {
+    await testHelper.withViewer((viewer) async {
+      final app = FilamentApp.instance as FFIFilamentApp;
+      await viewer.setRendering(false);
+      await viewer.render();
+      final swapChain = testHelper.swapChain.getNativeHandle();
+      RenderTicker_removeSwapChain(app.renderTicker, swapChain);
+
+      final threadStats = calloc<TRenderThreadStats>();
+      final schedulerStats = calloc<TFrameSchedulerStats>();
+      RenderThread_getStats(threadStats);
+      RenderTicker_getFrameSchedulerStats(app.renderTicker, schedulerStats);
+      final wakeups = threadStats.ref.wakeups;
+      final framesRendered = schedulerStats.ref.framesRendered;
+      final skippedFrames = schedulerStats.ref.skippedFrames;
+
+      RenderThread_requestFrameAsync();
+      await Future.delayed(Duration(milliseconds: 500));
+
+      RenderThread_getStats(threadStats);
+      RenderTicker_getFrameSchedulerStats(app.renderTicker, schedulerStats);
+      expect(threadStats.ref.wakeups - wakeups, lessThan(10));
+      expect(schedulerStats.ref.framesRendered, framesRendered);
+      expect(schedulerStats.ref.skippedFrames, skippedFrames);
+
+      // the outstanding request is rendered once the swapchain is back
+      final views = calloc<Pointer<TView>>(1);
+      views[0] = (viewer.view as FFIView).view;
+      RenderTicker_setRenderable(app.renderTicker, swapChain, views, 1);
+      calloc.free(views);
+      await Future.delayed(Duration(milliseconds: 500));
+
+      RenderTicker_getFrameSchedulerStats(app.renderTicker, schedulerStats);
+      expect(schedulerStats.ref.framesRendered, framesRendered + 1);
+      calloc.free(threadStats);
+      calloc.free(schedulerStats);
+    });
+  });
+
+  test("per-frame CPU timings are recorded", () async {
+    await testHelper.withViewer((viewer) async {
+      final app = FilamentApp.instance as FFIFilamentApp;
+      for (int i = 0; i < 10; i++) {
+        await viewer.render();
+      }
+
+      final maxFrames = 10;
+      final timings = calloc<TFrameTiming>(maxFrames);
+      final numFrames =
+          RenderTicker_getFrameStats(app.renderTicker, timings, maxFrames);
+      expect(numFrames, greaterThan(0));
+      for (int i = 0; i < numFrames; i++) {
+        final timing = timings[i];
+        if (i > 0) {
+          expect(timing.frameIndex, timings[i - 1].frameIndex + 1);
+        }
+        var viewRenderTimeInNanos = 0;
+        for (int v = 0;
+            v < timing.numViews && v < FRAME_TIMING_MAX_VIEWS;
+            v++) {
+          viewRenderTimeInNanos += timing.viewRenderTimeInNanos[v];
+        }
+        print(
+            "Frame ${timing.frameIndex}: total ${timing.totalTimeInNanos / 1e6}ms, animation ${timing.animationUpdateTimeInNanos / 1e6}ms, beginFrame ${timing.beginFrameTimeInNanos / 1e6}ms, ${timing.numViews} views ${viewRenderTimeInNanos / 1e6}ms, overlay ${timing.overlayTimeInNanos / 1e6}ms, endFrame ${timing.endFrameTimeInNanos / 1e6}ms, ${timing.tasksExecuted} tasks ${timing.taskDrainTimeInNanos / 1e6}ms");
+        expect(
+            timing.totalTimeInNanos,
+            greaterThanOrEqualTo(timing.animationUpdateTimeInNanos +
+                timing.beginFrameTimeInNanos +
+                viewRenderTimeInNanos +
+                timing.endFrameTimeInNanos));
+      }
+      calloc.free(timings);
+    });
+  });
+
+  test("native spans are written as Chrome trace-event JSON", () async {
+    await testHelper.withViewer((viewer) async {
+      TraceRecorder_setEnabled(true);
+      TraceRecorder_clear();
+      for (int i = 0; i < 10; i++) {
+        await viewer.render();
+      }
+      TraceRecorder_setEnabled(false);
+
+      final outPath = "${testHelper.outDir.path}/trace.json";
+      final pathPtr = outPath.toNativeUtf8();
+      expect(TraceRecorder_dump(pathPtr.cast<Char>()), true);
+      calloc.free(pathPtr);
+
+      final trace = jsonDecode(File(outPath).readAsStringSync());
+      final names = (trace["traceEvents"] as List)
+          .map((event) => event["name"] as String)
+          .toSet();
+      expect(names, contains("RenderTicker::render"));
+    });
+  });
 }
@@ -33,6 +33,25 @@ void main() async {
       }, bg: kRed);
     });
 
+    test('decode image directly to texture', () async {
+      await testHelper.withViewer((viewer) async {
+        var imageData = File(
+          "${testHelper.testDir}/assets/cube_texture_512x512.png",
+        ).readAsBytesSync();
+        final texture = await FilamentApp.instance!
+            .decodeImageToTexture(imageData, generateMipmaps: true);
+        expect(await texture.getWidth(), 512);
+        expect(await texture.getHeight(), 512);
+        expect(await texture.getLevels(), 10);
+        await texture.dispose();
+
+        await expectLater(
+            FilamentApp.instance!
+                .decodeImageToTexture(Uint8List.fromList([0, 1, 2, 3])),
+            throwsException);
+      }, bg: kRed);
+    });
+
     test('set cubemap texture from pixel buffer', () async {
       await testHelper.withViewer((viewer) async {
         final texture = await FilamentApp.instance!.createTexture(
@@ -432,6 +432,30 @@ void main() async {
           render: false);
     }, postProcessing: false);
   });
+
+  test('show/hide stencil highlight for glTF asset', () async {
+    await testHelper.withViewer((viewer) async {
+      final asset = await viewer
+          .loadGltf("file://${testHelper.testDir}/assets/cube.glb");
+      await viewer.view.setStencilHighlight(asset);
+      await FilamentApp.instance!
+          .setClearOptions(1, 1, 1, 0, clear: true, discard: false);
+      await FilamentApp.instance!.requestFrame();
+
+      await testHelper.capture(null, "stencil_highlight_gltf_enabled",
+          render: false);
+
+      // the asset's own renderables are never modified, so removing the
+      // highlight leaves the asset as it was
+      await FilamentApp.instance!
+          .setClearOptions(1, 1, 1, 0, clear: true, discard: false);
+      await viewer.view.removeStencilHighlight(asset);
+      await FilamentApp.instance!.requestFrame();
+
+      await testHelper.capture(null, "stencil_highlight_gltf_removed",
+          render: false);
+    }, postProcessing: false);
+  });
 }
 // manually construct two views with stencil buffer
 // final viewportDimensions = (width: 500, height: 500);
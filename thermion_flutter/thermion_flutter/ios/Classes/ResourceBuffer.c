@@ -6,6 +6,7 @@ void *make_resource_loader(LoadFilamentResourceFromOwner loadFn, FreeFilamentRes
     rlw->loadResource = NULL;
     rlw->freeResource = NULL;
     rlw->loadToOut = NULL;
+    rlw->loadWithCallback = NULL;
     rlw->loadFromOwner = loadFn;
     rlw->freeFromOwner = freeFn;
     rlw->owner = owner;
@@ -29,6 +29,12 @@ typedef ResourceBuffer (*LoadFilamentResourceFromOwner)(const char *const, void
 typedef void (*FreeFilamentResource)(ResourceBuffer);
 typedef void (*FreeFilamentResourceFromOwner)(ResourceBuffer, void *const owner);
 
+// Invoked (on any thread) once a resource requested with LoadFilamentResourceWithCallback has been loaded.
+// A ResourceBuffer with a null [data] pointer indicates the resource could not be loaded.
+typedef void (*OnFilamentResourceLoaded)(ResourceBuffer, void *const userData);
+// Starts loading [uri] and returns immediately; [onLoaded] must be called exactly once with [userData].
+typedef void (*LoadFilamentResourceWithCallback)(const char *uri, OnFilamentResourceLoaded onLoaded, void *const userData, void *const owner);
+
 typedef struct ResourceLoaderWrapper
 {
   LoadFilamentResource loadResource;
@@ -37,6 +43,7 @@ typedef struct ResourceLoaderWrapper
   FreeFilamentResourceFromOwner freeFromOwner;
   void *owner;
   LoadFilamentResourceIntoOutPointer loadToOut;
+  LoadFilamentResourceWithCallback loadWithCallback;
 } ResourceLoaderWrapper;
 
 void *make_resource_loader(LoadFilamentResourceFromOwner loadFn, FreeFilamentResourceFromOwner freeFn, void *const owner);
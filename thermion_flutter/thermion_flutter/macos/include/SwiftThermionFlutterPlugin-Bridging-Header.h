@@ -11,6 +11,7 @@ ResourceLoaderWrapper *make_resource_loader(LoadFilamentResourceFromOwner loadFn
     rlw->loadResource = NULL;
     rlw->freeResource = NULL;
     rlw->loadToOut = NULL;
+    rlw->loadWithCallback = NULL;
     rlw->loadFromOwner = loadFn;
     rlw->freeFromOwner = freeFn;
     rlw->owner = owner;